@@ -41,6 +41,13 @@ public class ProximityInfo {
     @Nonnull
     private static final List<Key> EMPTY_KEY_LIST = Collections.emptyList();
     private static final float DEFAULT_TOUCH_POSITION_CORRECTION_RADIUS = 0.15f;
+    // Must be equal to ProximityInfoCache::NO_FINGERPRINT in native/jni/src/suggest/core/layout/
+    // proximity_info_cache.h
+    private static final long NO_FINGERPRINT = 0;
+    private static final long FNV_OFFSET_BASIS_64 = 0xcbf29ce484222325L;
+    private static final long FNV_PRIME_64 = 0x100000001b3L;
+    // The native layout cache is not thread safe.
+    private static final Object sNativeCacheLock = new Object();
 
     private final int mGridWidth;
     private final int mGridHeight;
@@ -91,7 +98,9 @@ public class ProximityInfo {
             int gridWidth, int gridHeight, int mostCommonKeyWidth, int mostCommonKeyHeight,
             int[] proximityCharsArray, int keyCount, int[] keyXCoordinates, int[] keyYCoordinates,
             int[] keyWidths, int[] keyHeights, int[] keyCharCodes, float[] sweetSpotCenterXs,
-            float[] sweetSpotCenterYs, float[] sweetSpotRadii);
+            float[] sweetSpotCenterYs, float[] sweetSpotRadii, long fingerprint);
+
+    private static native long getCachedProximityInfoNative(long fingerprint);
 
     private static native void releaseProximityInfoNative(long nativeProximityInfo);
 
@@ -110,8 +119,63 @@ public class ProximityInfo {
         return count;
     }
 
+    private static long addToFingerprint(final long fingerprint, final int value) {
+        return (fingerprint ^ (value & 0xFFFFFFFFL)) * FNV_PRIME_64;
+    }
+
+    /**
+     * Computes a fingerprint of everything the native proximity info is built from. The proximity
+     * grid is derived from the keys and the grid size.
+     */
+    private long computeFingerprint(
+            @Nonnull final TouchPositionCorrection touchPositionCorrection) {
+        long fingerprint = FNV_OFFSET_BASIS_64;
+        fingerprint = addToFingerprint(fingerprint, mKeyboardMinWidth);
+        fingerprint = addToFingerprint(fingerprint, mKeyboardHeight);
+        fingerprint = addToFingerprint(fingerprint, mGridWidth);
+        fingerprint = addToFingerprint(fingerprint, mGridHeight);
+        fingerprint = addToFingerprint(fingerprint, mMostCommonKeyWidth);
+        fingerprint = addToFingerprint(fingerprint, mMostCommonKeyHeight);
+        fingerprint = addToFingerprint(fingerprint, mSortedKeys.size());
+        for (final Key key : mSortedKeys) {
+            fingerprint = addToFingerprint(fingerprint, key.getCode());
+            fingerprint = addToFingerprint(fingerprint, key.getX());
+            fingerprint = addToFingerprint(fingerprint, key.getY());
+            fingerprint = addToFingerprint(fingerprint, key.getWidth());
+            fingerprint = addToFingerprint(fingerprint, key.getHeight());
+            final Rect hitBox = key.getHitBox();
+            fingerprint = addToFingerprint(fingerprint, hitBox.left);
+            fingerprint = addToFingerprint(fingerprint, hitBox.top);
+            fingerprint = addToFingerprint(fingerprint, hitBox.right);
+            fingerprint = addToFingerprint(fingerprint, hitBox.bottom);
+        }
+        if (touchPositionCorrection.isValid()) {
+            final int rows = touchPositionCorrection.getRows();
+            fingerprint = addToFingerprint(fingerprint, rows);
+            for (int row = 0; row < rows; ++row) {
+                fingerprint = addToFingerprint(fingerprint,
+                        Float.floatToIntBits(touchPositionCorrection.getX(row)));
+                fingerprint = addToFingerprint(fingerprint,
+                        Float.floatToIntBits(touchPositionCorrection.getY(row)));
+                fingerprint = addToFingerprint(fingerprint,
+                        Float.floatToIntBits(touchPositionCorrection.getRadius(row)));
+            }
+        } else {
+            fingerprint = addToFingerprint(fingerprint, -1);
+        }
+        return (fingerprint == NO_FINGERPRINT) ? FNV_OFFSET_BASIS_64 : fingerprint;
+    }
+
     private long createNativeProximityInfo(
             @Nonnull final TouchPositionCorrection touchPositionCorrection) {
+        // Switching back to a recent layout reuses its native proximity info.
+        final long fingerprint = computeFingerprint(touchPositionCorrection);
+        synchronized (sNativeCacheLock) {
+            final long cachedProximityInfo = getCachedProximityInfoNative(fingerprint);
+            if (cachedProximityInfo != 0) {
+                return cachedProximityInfo;
+            }
+        }
         final List<Key>[] gridNeighborKeys = mGridNeighbors;
         final int[] proximityCharsArray = new int[mGridSize * MAX_PROXIMITY_CHARS_SIZE];
         Arrays.fill(proximityCharsArray, Constants.NOT_A_CODE);
@@ -219,10 +283,13 @@ public class ProximityInfo {
         }
 
         // TODO: Stop passing proximityCharsArray
-        return setProximityInfoNative(mKeyboardMinWidth, mKeyboardHeight, mGridWidth, mGridHeight,
-                mMostCommonKeyWidth, mMostCommonKeyHeight, proximityCharsArray, keyCount,
-                keyXCoordinates, keyYCoordinates, keyWidths, keyHeights, keyCharCodes,
-                sweetSpotCenterXs, sweetSpotCenterYs, sweetSpotRadii);
+        synchronized (sNativeCacheLock) {
+            return setProximityInfoNative(mKeyboardMinWidth, mKeyboardHeight, mGridWidth,
+                    mGridHeight, mMostCommonKeyWidth, mMostCommonKeyHeight, proximityCharsArray,
+                    keyCount, keyXCoordinates, keyYCoordinates, keyWidths, keyHeights,
+                    keyCharCodes, sweetSpotCenterXs, sweetSpotCenterYs, sweetSpotRadii,
+                    fingerprint);
+        }
     }
 
     public long getNativeProximityInfo() {
@@ -233,7 +300,9 @@ public class ProximityInfo {
     protected void finalize() throws Throwable {
         try {
             if (mNativeProximityInfo != 0) {
-                releaseProximityInfoNative(mNativeProximityInfo);
+                synchronized (sNativeCacheLock) {
+                    releaseProximityInfoNative(mNativeProximityInfo);
+                }
                 mNativeProximityInfo = 0;
             }
         } finally {
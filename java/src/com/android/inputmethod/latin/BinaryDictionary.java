@@ -26,6 +26,7 @@ import com.android.inputmethod.latin.common.ComposedData;
 import com.android.inputmethod.latin.common.Constants;
 import com.android.inputmethod.latin.common.FileUtils;
 import com.android.inputmethod.latin.common.InputPointers;
+import com.android.inputmethod.latin.common.NativeSuggestOptions;
 import com.android.inputmethod.latin.common.StringUtils;
 import com.android.inputmethod.latin.makedict.DictionaryHeader;
 import com.android.inputmethod.latin.makedict.FormatSpec;
@@ -38,6 +39,8 @@ import com.android.inputmethod.latin.utils.JniUtils;
 import com.android.inputmethod.latin.utils.WordInputEventForPersonalization;
 
 import java.io.File;
+import java.io.IOException;
+import java.nio.ByteBuffer;
 import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.HashMap;
@@ -86,8 +89,33 @@ public final class BinaryDictionary extends Dictionary {
     public static final int FORMAT_WORD_PROPERTY_LEVEL_INDEX = 2;
     public static final int FORMAT_WORD_PROPERTY_COUNT_INDEX = 3;
 
+    // Format of the buffer filled by getNextWordsNative(). The buffer starts with the word count,
+    // followed by [code point count, probability, flags, code points...] for each word.
+    private static final int WORD_BATCH_BUFFER_SIZE = 16 * 1024;
+    private static final int FORMAT_WORD_BATCH_RECORD_HEADER_SIZE = 3;
+    private static final int FORMAT_WORD_BATCH_FLAG_IS_NOT_A_WORD = 0x1;
+    private static final int FORMAT_WORD_BATCH_FLAG_IS_POSSIBLY_OFFENSIVE = 0x2;
+    private static final int FORMAT_WORD_BATCH_FLAG_IS_BEGINNING_OF_SENTENCE = 0x4;
+
+    // Format of the buffer filled by getNextWordPropertiesNative(). The buffer starts with the word
+    // count, followed by [code point count, flags, probability info..., n-gram count,
+    // code points...] for each word and then [previous word count, (is beginning of sentence,
+    // code point count, code points...) for each previous word, target code point count,
+    // probability info..., target code points...] for each of its n-grams.
+    private static final int WORD_PROPERTY_BATCH_BUFFER_SIZE = 64 * 1024;
+    private static final int FORMAT_WORD_PROPERTY_BATCH_FLAG_IS_NOT_A_WORD = 0x1;
+    private static final int FORMAT_WORD_PROPERTY_BATCH_FLAG_IS_POSSIBLY_OFFENSIVE = 0x2;
+    private static final int FORMAT_WORD_PROPERTY_BATCH_FLAG_IS_BEGINNING_OF_SENTENCE = 0x4;
+    private static final int FORMAT_WORD_PROPERTY_BATCH_FLAG_HAS_NGRAMS = 0x8;
+    // The n-grams of the word did not fit in the buffer and have to be read by getWordProperty().
+    private static final int FORMAT_WORD_PROPERTY_BATCH_FLAG_NGRAMS_NOT_INCLUDED = 0x10;
+
     public static final String DICT_FILE_NAME_SUFFIX_FOR_MIGRATION = ".migrate";
     public static final String DIR_NAME_SUFFIX_FOR_RECORD_MIGRATION = ".migrating";
+    // Journal of committed sections appended by the native migration next to the temporary
+    // dictionary.
+    public static final String FILE_NAME_SUFFIX_FOR_MIGRATION_PROGRESS = ".progress";
+    private static final String FILE_NAME_FOR_RECORD_RESUMED_MIGRATION = "resumed";
 
     private long mNativeDict;
     private final long mDictSize;
@@ -190,6 +218,8 @@ public final class BinaryDictionary extends Dictionary {
             ArrayList<int[]> outShortcutTargets, ArrayList<Integer> outShortcutProbabilities);
     private static native int getNextWordNative(long dict, int token, int[] outCodePoints,
             boolean[] outIsBeginningOfSentence);
+    private static native int getNextWordsNative(long dict, int token, int[] outBuffer);
+    private static native int getNextWordPropertiesNative(long dict, int token, int[] outBuffer);
     private static native void getSuggestionsNative(long dict, long proximityInfo,
             long traverseSession, int[] xCoordinates, int[] yCoordinates, int[] times,
             int[] pointerIds, int[] inputCodePoints, int inputSize, int[] suggestOptions,
@@ -198,6 +228,19 @@ public final class BinaryDictionary extends Dictionary {
             int[] outputScores, int[] outputIndices, int[] outputTypes,
             int[] outputAutoCommitFirstWordConfidence,
             float[] inOutWeightOfLangModelVsSpatialModel);
+    private static native boolean prefetchPredictionsNative(long dict, long traverseSession,
+            int ngramContextId);
+    private static native boolean getSuggestionsWithBufferNative(long dict, long proximityInfo,
+            long traverseSession, ByteBuffer suggestionBuffer);
+    private static native void getSuggestionsFromDictionariesNative(long[] dicts,
+            long[] traverseSessions, float[] dictionaryWeights, long proximityInfo,
+            int[] xCoordinates, int[] yCoordinates, int[] times, int[] pointerIds,
+            int[] inputCodePoints, int inputSize, int[][] suggestOptions,
+            int[][] prevWordCodePointArrays, boolean[] isBeginningOfSentenceArray,
+            int prevWordCount, int[] outputSuggestionCount, int[] outputCodePoints,
+            int[] outputScores, int[] outputIndices, int[] outputTypes,
+            int[] outputAutoCommitFirstWordConfidence,
+            float[] inOutWeightOfLangModelVsSpatialModel, int[] outputSourceDictionaryIndices);
     private static native boolean addUnigramEntryNative(long dict, int[] word, int probability,
             int[] shortcutTarget, int shortcutProbability, boolean isBeginningOfSentence,
             boolean isNotAWord, boolean isPossiblyOffensive, int timestamp);
@@ -213,6 +256,8 @@ public final class BinaryDictionary extends Dictionary {
     private static native int updateEntriesForInputEventsNative(long dict,
             WordInputEventForPersonalization[] inputEvents, int startIndex);
     private static native String getPropertyNative(long dict, String query);
+    private static native void setTraceCountersEnabledNative(boolean enabled);
+    private static native String getTraceCountersNative();
     private static native boolean isCorruptedNative(long dict);
     private static native boolean migrateNative(long dict, String dictFilePath,
             long newFormatVersion);
@@ -275,8 +320,6 @@ public final class BinaryDictionary extends Dictionary {
         }
         final DicTraverseSession session = getTraverseSession(sessionId);
         Arrays.fill(session.mInputCodePoints, Constants.NOT_A_CODE);
-        ngramContext.outputToArray(session.mPrevWordCodePointArrays,
-                session.mIsBeginningOfSentenceArray);
         final InputPointers inputPointers = composedData.mInputPointers;
         final boolean isGesture = composedData.mIsBatchMode;
         final int inputSize;
@@ -302,17 +345,39 @@ public final class BinaryDictionary extends Dictionary {
             session.mInputOutputWeightOfLangModelVsSpatialModel[0] =
                     Dictionary.NOT_A_WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL;
         }
-        // TOOD: Pass multiple previous words information for n-gram.
-        getSuggestionsNative(mNativeDict, proximityInfoHandle,
-                getTraverseSession(sessionId).getSession(), inputPointers.getXCoordinates(),
-                inputPointers.getYCoordinates(), inputPointers.getTimes(),
-                inputPointers.getPointerIds(), session.mInputCodePoints, inputSize,
-                session.mNativeSuggestOptions.getOptions(), session.mPrevWordCodePointArrays,
-                session.mIsBeginningOfSentenceArray, ngramContext.getPrevWordCount(),
-                session.mOutputSuggestionCount, session.mOutputCodePoints, session.mOutputScores,
-                session.mSpaceIndices, session.mOutputTypes,
-                session.mOutputAutoCommitFirstWordConfidence,
-                session.mInputOutputWeightOfLangModelVsSpatialModel);
+        // The session can be used by prefetchPredictions() on a background thread.
+        synchronized (session) {
+            // Typing input is short, so it is passed through the buffer shared with native code
+            // to avoid the per-array JNI copies. Gesture input keeps using the arrays.
+            boolean usedSuggestionBuffer = false;
+            if (!isGesture && DicTraverseSession.canUseSuggestionBuffer(inputSize)) {
+                session.writeSuggestionBufferInput(inputPointers.getXCoordinates(),
+                        inputPointers.getYCoordinates(), inputPointers.getTimes(),
+                        inputPointers.getPointerIds(), inputSize,
+                        session.cacheNgramContext(ngramContext));
+                usedSuggestionBuffer = getSuggestionsWithBufferNative(mNativeDict,
+                        proximityInfoHandle, session.getSession(),
+                        session.getSuggestionBuffer());
+                if (usedSuggestionBuffer) {
+                    session.readSuggestionBufferOutput();
+                }
+            }
+            if (!usedSuggestionBuffer) {
+                ngramContext.outputToArray(session.mPrevWordCodePointArrays,
+                        session.mIsBeginningOfSentenceArray);
+                // TOOD: Pass multiple previous words information for n-gram.
+                getSuggestionsNative(mNativeDict, proximityInfoHandle, session.getSession(),
+                        inputPointers.getXCoordinates(), inputPointers.getYCoordinates(),
+                        inputPointers.getTimes(), inputPointers.getPointerIds(),
+                        session.mInputCodePoints, inputSize,
+                        session.mNativeSuggestOptions.getOptions(),
+                        session.mPrevWordCodePointArrays, session.mIsBeginningOfSentenceArray,
+                        ngramContext.getPrevWordCount(), session.mOutputSuggestionCount,
+                        session.mOutputCodePoints, session.mOutputScores, session.mSpaceIndices,
+                        session.mOutputTypes, session.mOutputAutoCommitFirstWordConfidence,
+                        session.mInputOutputWeightOfLangModelVsSpatialModel);
+            }
+        }
         if (inOutWeightOfLangModelVsSpatialModel != null) {
             inOutWeightOfLangModelVsSpatialModel[0] =
                     session.mInputOutputWeightOfLangModelVsSpatialModel[0];
@@ -340,6 +405,123 @@ public final class BinaryDictionary extends Dictionary {
         return suggestions;
     }
 
+    @Override
+    public void prefetchPredictions(final NgramContext ngramContext, final int sessionId) {
+        if (!isValidDictionary()) {
+            return;
+        }
+        final DicTraverseSession session = getTraverseSession(sessionId);
+        synchronized (session) {
+            prefetchPredictionsNative(mNativeDict, session.getSession(),
+                    session.cacheNgramContext(ngramContext));
+        }
+    }
+
+    /**
+     * Searches several dictionaries for the same input in one native call. The spatial input
+     * processing is done once with the traverse session of the first dictionary and shared by
+     * the others, and the results are merged natively. Each dictionary is searched with the
+     * options of its own session, e.g. whether to use the full edit distance.
+     *
+     * @param dictionaries the dictionaries to search. The first one should be the main dictionary.
+     * @param dictionaryWeights the multiplier applied to the scores of each dictionary.
+     * @return the merged suggestions, or null if any of the dictionaries is invalid.
+     */
+    public static ArrayList<SuggestedWordInfo> getSuggestionsFromDictionaries(
+            final BinaryDictionary[] dictionaries, final float[] dictionaryWeights,
+            final ComposedData composedData, final NgramContext ngramContext,
+            final long proximityInfoHandle,
+            final SettingsValuesForSuggestion settingsValuesForSuggestion,
+            final int sessionId, final float weightForLocale,
+            final float[] inOutWeightOfLangModelVsSpatialModel) {
+        if (dictionaries.length == 0 || dictionaries.length != dictionaryWeights.length) {
+            return null;
+        }
+        final long[] nativeDicts = new long[dictionaries.length];
+        final long[] nativeSessions = new long[dictionaries.length];
+        final DicTraverseSession[] sessions = new DicTraverseSession[dictionaries.length];
+        for (int i = 0; i < dictionaries.length; ++i) {
+            if (!dictionaries[i].isValidDictionary()) {
+                return null;
+            }
+            nativeDicts[i] = dictionaries[i].mNativeDict;
+            sessions[i] = dictionaries[i].getTraverseSession(sessionId);
+            nativeSessions[i] = sessions[i].getSession();
+        }
+        final DicTraverseSession session = sessions[0];
+        Arrays.fill(session.mInputCodePoints, Constants.NOT_A_CODE);
+        ngramContext.outputToArray(session.mPrevWordCodePointArrays,
+                session.mIsBeginningOfSentenceArray);
+        final InputPointers inputPointers = composedData.mInputPointers;
+        final boolean isGesture = composedData.mIsBatchMode;
+        final int inputSize;
+        if (!isGesture) {
+            inputSize =
+                    composedData.copyCodePointsExceptTrailingSingleQuotesAndReturnCodePointCount(
+                        session.mInputCodePoints);
+            if (inputSize < 0) {
+                return null;
+            }
+        } else {
+            inputSize = inputPointers.getPointerSize();
+        }
+        final int[][] suggestOptions = new int[dictionaries.length][];
+        for (int i = 0; i < dictionaries.length; ++i) {
+            final NativeSuggestOptions options = sessions[i].mNativeSuggestOptions;
+            options.setUseFullEditDistance(dictionaries[i].mUseFullEditDistance);
+            options.setIsGesture(isGesture);
+            options.setBlockOffensiveWords(settingsValuesForSuggestion.mBlockPotentiallyOffensive);
+            options.setWeightForLocale(weightForLocale);
+            suggestOptions[i] = options.getOptions();
+        }
+        if (inOutWeightOfLangModelVsSpatialModel != null) {
+            session.mInputOutputWeightOfLangModelVsSpatialModel[0] =
+                    inOutWeightOfLangModelVsSpatialModel[0];
+        } else {
+            session.mInputOutputWeightOfLangModelVsSpatialModel[0] =
+                    Dictionary.NOT_A_WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL;
+        }
+        // The session can be used by prefetchPredictions() on a background thread.
+        synchronized (session) {
+            getSuggestionsFromDictionariesNative(nativeDicts, nativeSessions, dictionaryWeights,
+                    proximityInfoHandle, inputPointers.getXCoordinates(),
+                    inputPointers.getYCoordinates(), inputPointers.getTimes(),
+                    inputPointers.getPointerIds(), session.mInputCodePoints, inputSize,
+                    suggestOptions, session.mPrevWordCodePointArrays,
+                    session.mIsBeginningOfSentenceArray, ngramContext.getPrevWordCount(),
+                    session.mOutputSuggestionCount, session.mOutputCodePoints,
+                    session.mOutputScores, session.mSpaceIndices, session.mOutputTypes,
+                    session.mOutputAutoCommitFirstWordConfidence,
+                    session.mInputOutputWeightOfLangModelVsSpatialModel,
+                    session.mOutputSourceDictionaryIndices);
+        }
+        if (inOutWeightOfLangModelVsSpatialModel != null) {
+            inOutWeightOfLangModelVsSpatialModel[0] =
+                    session.mInputOutputWeightOfLangModelVsSpatialModel[0];
+        }
+        final int count = session.mOutputSuggestionCount[0];
+        final ArrayList<SuggestedWordInfo> suggestions = new ArrayList<>();
+        for (int j = 0; j < count; ++j) {
+            final int start = j * DICTIONARY_MAX_WORD_LENGTH;
+            int len = 0;
+            while (len < DICTIONARY_MAX_WORD_LENGTH
+                    && session.mOutputCodePoints[start + len] != 0) {
+                ++len;
+            }
+            if (len > 0) {
+                suggestions.add(new SuggestedWordInfo(
+                        new String(session.mOutputCodePoints, start, len),
+                        "" /* prevWordsContext */,
+                        (int)(session.mOutputScores[j] * weightForLocale),
+                        session.mOutputTypes[j],
+                        dictionaries[session.mOutputSourceDictionaryIndices[j]] /* sourceDict */,
+                        session.mSpaceIndices[j] /* indexOfTouchPointOfSecondWord */,
+                        session.mOutputAutoCommitFirstWordConfidence[0]));
+            }
+        }
+        return suggestions;
+    }
+
     public boolean isValidDictionary() {
         return mNativeDict != 0;
     }
@@ -441,6 +623,130 @@ public final class BinaryDictionary extends Dictionary {
                 getWordProperty(word, isBeginningOfSentence[0]), nextToken);
     }
 
+    public static class WordBatchEntry {
+        public final String mWord;
+        public final int mProbability;
+        public final boolean mIsNotAWord;
+        public final boolean mIsPossiblyOffensive;
+        public final boolean mIsBeginningOfSentence;
+
+        public WordBatchEntry(final String word, final int probability, final int flags) {
+            mWord = word;
+            mProbability = probability;
+            mIsNotAWord = (flags & FORMAT_WORD_BATCH_FLAG_IS_NOT_A_WORD) != 0;
+            mIsPossiblyOffensive = (flags & FORMAT_WORD_BATCH_FLAG_IS_POSSIBLY_OFFENSIVE) != 0;
+            mIsBeginningOfSentence =
+                    (flags & FORMAT_WORD_BATCH_FLAG_IS_BEGINNING_OF_SENTENCE) != 0;
+        }
+    }
+
+    public static class GetNextWordsResult {
+        public final ArrayList<WordBatchEntry> mEntries;
+        public final int mNextToken;
+
+        public GetNextWordsResult(final ArrayList<WordBatchEntry> entries, final int nextToken) {
+            mEntries = entries;
+            mNextToken = nextToken;
+        }
+    }
+
+    /**
+     * Method to iterate all words in the dictionary many words at a time. This is much faster than
+     * getNextWordProperty() when the n-grams of the words are not needed.
+     * If token is 0, this method newly starts iterating the dictionary. The returned next token is
+     * 0 when all words have been returned.
+     */
+    public GetNextWordsResult getNextWords(final int token) {
+        final int[] buffer = new int[WORD_BATCH_BUFFER_SIZE];
+        final int nextToken = getNextWordsNative(mNativeDict, token, buffer);
+        final int wordCount = buffer[0];
+        final ArrayList<WordBatchEntry> entries = new ArrayList<>(wordCount);
+        int pos = 1;
+        for (int i = 0; i < wordCount; ++i) {
+            final int codePointCount = buffer[pos];
+            final int codePointsStart = pos + FORMAT_WORD_BATCH_RECORD_HEADER_SIZE;
+            entries.add(new WordBatchEntry(
+                    new String(buffer, codePointsStart, codePointCount),
+                    buffer[pos + 1] /* probability */, buffer[pos + 2] /* flags */));
+            pos = codePointsStart + codePointCount;
+        }
+        return new GetNextWordsResult(entries, nextToken);
+    }
+
+    public static class GetNextWordPropertiesResult {
+        public final ArrayList<WordProperty> mWordProperties;
+        public final int mNextToken;
+
+        public GetNextWordPropertiesResult(final ArrayList<WordProperty> wordProperties,
+                final int nextToken) {
+            mWordProperties = wordProperties;
+            mNextToken = nextToken;
+        }
+    }
+
+    /**
+     * Method to iterate the properties of all words in the dictionary many words at a time. This
+     * returns the same properties as getWordProperty() without a native call for each word.
+     * If token is 0, this method newly starts iterating the dictionary. The returned next token is
+     * 0 when all words have been returned.
+     */
+    public GetNextWordPropertiesResult getNextWordProperties(final int token) {
+        final int[] buffer = new int[WORD_PROPERTY_BATCH_BUFFER_SIZE];
+        final int nextToken = getNextWordPropertiesNative(mNativeDict, token, buffer);
+        final int wordCount = buffer[0];
+        final ArrayList<WordProperty> wordProperties = new ArrayList<>(wordCount);
+        int pos = 1;
+        for (int i = 0; i < wordCount; ++i) {
+            final int codePointCount = buffer[pos++];
+            final int flags = buffer[pos++];
+            final int[] probabilityInfo = Arrays.copyOfRange(buffer, pos,
+                    pos + FORMAT_WORD_PROPERTY_OUTPUT_PROBABILITY_INFO_COUNT);
+            pos += FORMAT_WORD_PROPERTY_OUTPUT_PROBABILITY_INFO_COUNT;
+            final int ngramCount = buffer[pos++];
+            final int[] codePoints = Arrays.copyOfRange(buffer, pos, pos + codePointCount);
+            pos += codePointCount;
+            final boolean isBeginningOfSentence =
+                    (flags & FORMAT_WORD_PROPERTY_BATCH_FLAG_IS_BEGINNING_OF_SENTENCE) != 0;
+            if ((flags & FORMAT_WORD_PROPERTY_BATCH_FLAG_NGRAMS_NOT_INCLUDED) != 0) {
+                wordProperties.add(getWordProperty(
+                        new String(codePoints, 0, codePoints.length), isBeginningOfSentence));
+                continue;
+            }
+            final ArrayList<int[][]> ngramPrevWordsArray = new ArrayList<>(ngramCount);
+            final ArrayList<boolean[]> ngramPrevWordIsBeginningOfSentenceArray =
+                    new ArrayList<>(ngramCount);
+            final ArrayList<int[]> ngramTargets = new ArrayList<>(ngramCount);
+            final ArrayList<int[]> ngramProbabilityInfo = new ArrayList<>(ngramCount);
+            for (int j = 0; j < ngramCount; ++j) {
+                final int prevWordCount = buffer[pos++];
+                final int[][] prevWords = new int[prevWordCount][];
+                final boolean[] prevWordIsBeginningOfSentence = new boolean[prevWordCount];
+                for (int k = 0; k < prevWordCount; ++k) {
+                    prevWordIsBeginningOfSentence[k] = buffer[pos++] != 0;
+                    final int prevWordCodePointCount = buffer[pos++];
+                    prevWords[k] = Arrays.copyOfRange(buffer, pos, pos + prevWordCodePointCount);
+                    pos += prevWordCodePointCount;
+                }
+                final int targetCodePointCount = buffer[pos++];
+                ngramProbabilityInfo.add(Arrays.copyOfRange(buffer, pos,
+                        pos + FORMAT_WORD_PROPERTY_OUTPUT_PROBABILITY_INFO_COUNT));
+                pos += FORMAT_WORD_PROPERTY_OUTPUT_PROBABILITY_INFO_COUNT;
+                ngramTargets.add(Arrays.copyOfRange(buffer, pos, pos + targetCodePointCount));
+                pos += targetCodePointCount;
+                ngramPrevWordsArray.add(prevWords);
+                ngramPrevWordIsBeginningOfSentenceArray.add(prevWordIsBeginningOfSentence);
+            }
+            wordProperties.add(new WordProperty(codePoints,
+                    (flags & FORMAT_WORD_PROPERTY_BATCH_FLAG_IS_NOT_A_WORD) != 0,
+                    (flags & FORMAT_WORD_PROPERTY_BATCH_FLAG_IS_POSSIBLY_OFFENSIVE) != 0,
+                    (flags & FORMAT_WORD_PROPERTY_BATCH_FLAG_HAS_NGRAMS) != 0,
+                    isBeginningOfSentence, probabilityInfo, ngramPrevWordsArray,
+                    ngramPrevWordIsBeginningOfSentenceArray, ngramTargets,
+                    ngramProbabilityInfo));
+        }
+        return new GetNextWordPropertiesResult(wordProperties, nextToken);
+    }
+
     // Add a unigram entry to binary dictionary with unigram attributes in native code.
     public boolean addUnigramEntry(
             final String word, final int probability, final boolean isBeginningOfSentence,
@@ -589,19 +895,41 @@ public final class BinaryDictionary extends Dictionary {
         }
         final File isMigratingDir =
                 new File(mDictFilePath + DIR_NAME_SUFFIX_FOR_RECORD_MIGRATION);
+        final String tmpDictFilePath = mDictFilePath + DICT_FILE_NAME_SUFFIX_FOR_MIGRATION;
+        final File progressFile =
+                new File(tmpDictFilePath + FILE_NAME_SUFFIX_FOR_MIGRATION_PROGRESS);
         if (isMigratingDir.exists()) {
-            isMigratingDir.delete();
-            Log.e(TAG, "Previous migration attempt failed probably due to a crash. "
-                        + "Giving up using the old dictionary (" + mDictFilePath + ").");
-            return false;
-        }
-        if (!isMigratingDir.mkdir()) {
+            // The previous attempt crashed. The native side resumes from its last committed
+            // section, but only one retry is allowed so that a crashing dictionary cannot loop
+            // forever. Without a committed section there is nothing to resume from, and running
+            // into the same failure, e.g. running out of memory, is all a retry would do.
+            final File resumedRecordFile =
+                    new File(isMigratingDir, FILE_NAME_FOR_RECORD_RESUMED_MIGRATION);
+            boolean canResume = false;
+            if (progressFile.exists()) {
+                try {
+                    canResume = resumedRecordFile.createNewFile();
+                } catch (final IOException e) {
+                    Log.e(TAG, "Cannot create a file (" + resumedRecordFile.getAbsolutePath()
+                            + ") to record resumed migration.", e);
+                }
+            }
+            if (!canResume) {
+                FileUtils.deleteRecursively(isMigratingDir);
+                FileUtils.deleteRecursively(new File(tmpDictFilePath));
+                progressFile.delete();
+                Log.e(TAG, "Previous migration attempts failed probably due to a crash. "
+                            + "Giving up using the old dictionary (" + mDictFilePath + ").");
+                return false;
+            }
+            Log.i(TAG, "Resuming the previous migration attempt of " + mDictFilePath + ".");
+        } else if (!isMigratingDir.mkdir()) {
             Log.e(TAG, "Cannot create a dir (" + isMigratingDir.getAbsolutePath()
                     + ") to record migration.");
             return false;
         }
+        boolean succeeded = false;
         try {
-            final String tmpDictFilePath = mDictFilePath + DICT_FILE_NAME_SUFFIX_FOR_MIGRATION;
             if (!migrateNative(mNativeDict, tmpDictFilePath, newFormatVersion)) {
                 return false;
             }
@@ -616,9 +944,16 @@ public final class BinaryDictionary extends Dictionary {
             }
             loadDictionary(dictFile.getAbsolutePath(), 0 /* startOffset */,
                     dictFile.length(), mIsUpdatable);
+            succeeded = true;
             return true;
         } finally {
-            isMigratingDir.delete();
+            // Only a crash leaves the files behind to be resumed from; any other failure would
+            // repeat.
+            if (!succeeded) {
+                FileUtils.deleteRecursively(new File(tmpDictFilePath));
+                progressFile.delete();
+            }
+            FileUtils.deleteRecursively(isMigratingDir);
         }
     }
 
@@ -630,6 +965,23 @@ public final class BinaryDictionary extends Dictionary {
         return getPropertyNative(mNativeDict, query);
     }
 
+    /**
+     * Enables or disables the native counters and latency histograms of the suggestion search and
+     * the dictionary flushes. They are shared by all dictionaries and cleared when enabled.
+     */
+    public static void setTraceCountersEnabled(final boolean enabled) {
+        setTraceCountersEnabledNative(enabled);
+    }
+
+    /**
+     * Returns the native counters as "name=count" lines and the histograms as
+     * "name=sampleCount,sampleSumInMicroseconds,bucket0,bucket1,..." lines, where bucket i > 0
+     * counts the durations in [2^(i-1), 2^i) microseconds.
+     */
+    public static String getTraceCounters() {
+        return getTraceCountersNative();
+    }
+
     @Override
     public boolean shouldAutoCommit(final SuggestedWordInfo candidate) {
         return candidate.mAutoCommitFirstWordConfidence > CONFIDENCE_TO_AUTO_COMMIT;
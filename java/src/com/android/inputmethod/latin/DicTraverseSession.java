@@ -20,6 +20,9 @@ import com.android.inputmethod.latin.common.NativeSuggestOptions;
 import com.android.inputmethod.latin.define.DecoderSpecificConstants;
 import com.android.inputmethod.latin.utils.JniUtils;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.IntBuffer;
 import java.util.Locale;
 
 public final class DicTraverseSession {
@@ -40,15 +43,58 @@ public final class DicTraverseSession {
     public final int[] mSpaceIndices = new int[MAX_RESULTS];
     public final int[] mOutputScores = new int[MAX_RESULTS];
     public final int[] mOutputTypes = new int[MAX_RESULTS];
+    // Index of the source dictionary of each result in a federated search
+    public final int[] mOutputSourceDictionaryIndices = new int[MAX_RESULTS];
     // Only one result is ever used
     public final int[] mOutputAutoCommitFirstWordConfidence = new int[1];
     public final float[] mInputOutputWeightOfLangModelVsSpatialModel = new float[1];
 
     public final NativeSuggestOptions mNativeSuggestOptions = new NativeSuggestOptions();
 
+    // Layout of the buffer shared with native code for typing input. Must be equal to
+    // SuggestionBuffer in native/jni/src/suggest/core/session/suggestion_buffer.h.
+    private static final int SUGGESTION_BUFFER_LAYOUT_VERSION = 1;
+    private static final int HEADER_LAYOUT_VERSION = 0;
+    private static final int HEADER_INPUT_CAPACITY = 1;
+    private static final int HEADER_INPUT_SIZE = 2;
+    private static final int HEADER_OPTION_COUNT = 3;
+    private static final int HEADER_NGRAM_CONTEXT_ID = 4;
+    private static final int HEADER_WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL = 5;
+    private static final int HEADER_OUT_SUGGESTION_COUNT = 6;
+    private static final int HEADER_OUT_AUTO_COMMIT_FIRST_WORD_CONFIDENCE = 7;
+    private static final int HEADER_FIELD_COUNT = 8;
+    private static final int MAX_OPTION_COUNT = 32;
+    private static final int SUGGESTION_BUFFER_INPUT_CAPACITY =
+            DecoderSpecificConstants.DICTIONARY_MAX_WORD_LENGTH;
+    private static final int X_COORDINATES_POS = HEADER_FIELD_COUNT;
+    private static final int Y_COORDINATES_POS =
+            X_COORDINATES_POS + SUGGESTION_BUFFER_INPUT_CAPACITY;
+    private static final int TIMES_POS = Y_COORDINATES_POS + SUGGESTION_BUFFER_INPUT_CAPACITY;
+    private static final int POINTER_IDS_POS = TIMES_POS + SUGGESTION_BUFFER_INPUT_CAPACITY;
+    private static final int INPUT_CODE_POINTS_POS =
+            POINTER_IDS_POS + SUGGESTION_BUFFER_INPUT_CAPACITY;
+    private static final int OPTIONS_POS =
+            INPUT_CODE_POINTS_POS + DecoderSpecificConstants.DICTIONARY_MAX_WORD_LENGTH;
+    private static final int OUT_CODE_POINTS_POS = OPTIONS_POS + MAX_OPTION_COUNT;
+    private static final int OUT_SCORES_POS = OUT_CODE_POINTS_POS
+            + DecoderSpecificConstants.DICTIONARY_MAX_WORD_LENGTH * MAX_RESULTS;
+    private static final int OUT_SPACE_INDICES_POS = OUT_SCORES_POS + MAX_RESULTS;
+    private static final int OUT_TYPES_POS = OUT_SPACE_INDICES_POS + MAX_RESULTS;
+    private static final int SUGGESTION_BUFFER_INT_COUNT = OUT_TYPES_POS + MAX_RESULTS;
+
+    private final ByteBuffer mSuggestionBuffer = ByteBuffer.allocateDirect(
+            SUGGESTION_BUFFER_INT_COUNT * 4).order(ByteOrder.nativeOrder());
+    private final IntBuffer mSuggestionIntBuffer = mSuggestionBuffer.asIntBuffer();
+    private NgramContext mCachedNgramContext = null;
+    private int mCachedNgramContextId = 0;
+
     private static native long setDicTraverseSessionNative(String locale, long dictSize);
     private static native void initDicTraverseSessionNative(long nativeDicTraverseSession,
             long dictionary, int[] previousWord, int previousWordLength);
+    private static native void cacheNgramContextNative(long nativeDicTraverseSession,
+            int ngramContextId, int[][] prevWordCodePointArrays,
+            boolean[] isBeginningOfSentenceArray, int prevWordCount);
+    private static native String getMemoryReportNative(long nativeDicTraverseSession);
     private static native void releaseDicTraverseSessionNative(long nativeDicTraverseSession);
 
     private long mNativeDicTraverseSession;
@@ -72,6 +118,96 @@ public final class DicTraverseSession {
                 mNativeDicTraverseSession, dictionary, previousWord, previousWordLength);
     }
 
+    /**
+     * Returns the native memory used by this session as "component=mapped,resident,heap,wasted"
+     * lines in bytes, followed by the total. The memory of a dictionary and of the keyboard
+     * layouts is returned by querying "MEMORY_REPORT" from
+     * {@link BinaryDictionary#getPropertyForGettingStats(String)}.
+     */
+    public String getMemoryReport() {
+        return getMemoryReportNative(mNativeDicTraverseSession);
+    }
+
+    public static boolean canUseSuggestionBuffer(final int inputSize) {
+        return inputSize <= SUGGESTION_BUFFER_INPUT_CAPACITY;
+    }
+
+    public ByteBuffer getSuggestionBuffer() {
+        return mSuggestionBuffer;
+    }
+
+    /**
+     * Makes the native session cache the given context and returns the id to refer to it. The
+     * previous words are only passed to native code when the context changes.
+     */
+    public int cacheNgramContext(final NgramContext ngramContext) {
+        if (mCachedNgramContext != null && mCachedNgramContext.equals(ngramContext)) {
+            return mCachedNgramContextId;
+        }
+        ngramContext.outputToArray(mPrevWordCodePointArrays, mIsBeginningOfSentenceArray);
+        ++mCachedNgramContextId;
+        cacheNgramContextNative(mNativeDicTraverseSession, mCachedNgramContextId,
+                mPrevWordCodePointArrays, mIsBeginningOfSentenceArray,
+                ngramContext.getPrevWordCount());
+        mCachedNgramContext = ngramContext;
+        return mCachedNgramContextId;
+    }
+
+    /**
+     * Writes the input of a getSuggestions call to the shared buffer. The input code points and
+     * the options are taken from {@link #mInputCodePoints} and {@link #mNativeSuggestOptions}.
+     */
+    public void writeSuggestionBufferInput(final int[] xCoordinates, final int[] yCoordinates,
+            final int[] times, final int[] pointerIds, final int inputSize,
+            final int ngramContextId) {
+        final IntBuffer buffer = mSuggestionIntBuffer;
+        final int[] options = mNativeSuggestOptions.getOptions();
+        buffer.put(HEADER_LAYOUT_VERSION, SUGGESTION_BUFFER_LAYOUT_VERSION);
+        buffer.put(HEADER_INPUT_CAPACITY, SUGGESTION_BUFFER_INPUT_CAPACITY);
+        buffer.put(HEADER_INPUT_SIZE, inputSize);
+        buffer.put(HEADER_OPTION_COUNT, options.length);
+        buffer.put(HEADER_NGRAM_CONTEXT_ID, ngramContextId);
+        buffer.put(HEADER_WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL,
+                Float.floatToRawIntBits(mInputOutputWeightOfLangModelVsSpatialModel[0]));
+        buffer.position(X_COORDINATES_POS);
+        buffer.put(xCoordinates, 0, inputSize);
+        buffer.position(Y_COORDINATES_POS);
+        buffer.put(yCoordinates, 0, inputSize);
+        buffer.position(TIMES_POS);
+        buffer.put(times, 0, inputSize);
+        buffer.position(POINTER_IDS_POS);
+        buffer.put(pointerIds, 0, inputSize);
+        buffer.position(INPUT_CODE_POINTS_POS);
+        buffer.put(mInputCodePoints);
+        buffer.position(OPTIONS_POS);
+        buffer.put(options);
+        buffer.rewind();
+    }
+
+    /**
+     * Reads the output of a getSuggestions call from the shared buffer into the output arrays of
+     * this session.
+     */
+    public void readSuggestionBufferOutput() {
+        final IntBuffer buffer = mSuggestionIntBuffer;
+        final int count = buffer.get(HEADER_OUT_SUGGESTION_COUNT);
+        mOutputSuggestionCount[0] = count;
+        mOutputAutoCommitFirstWordConfidence[0] =
+                buffer.get(HEADER_OUT_AUTO_COMMIT_FIRST_WORD_CONFIDENCE);
+        mInputOutputWeightOfLangModelVsSpatialModel[0] = Float.intBitsToFloat(
+                buffer.get(HEADER_WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL));
+        buffer.position(OUT_CODE_POINTS_POS);
+        buffer.get(mOutputCodePoints, 0,
+                count * DecoderSpecificConstants.DICTIONARY_MAX_WORD_LENGTH);
+        buffer.position(OUT_SCORES_POS);
+        buffer.get(mOutputScores, 0, count);
+        buffer.position(OUT_SPACE_INDICES_POS);
+        buffer.get(mSpaceIndices, 0, count);
+        buffer.position(OUT_TYPES_POS);
+        buffer.get(mOutputTypes, 0, count);
+        buffer.rewind();
+    }
+
     private static long createNativeDicTraverseSession(String locale, long dictSize) {
         return setDicTraverseSessionNative(locale, dictSize);
     }
@@ -153,6 +153,40 @@ public abstract class Dictionary {
         return true;
     }
 
+    /**
+     * Computes the next-word predictions for the given context ahead of the request for them, so
+     * that the following call of {@link #getSuggestions} with empty input can use the result.
+     * This may take time and has to be called on a background thread.
+     * @param ngramContext the context of the predictions.
+     * @param sessionId the session id of the following getSuggestions call.
+     */
+    public void prefetchPredictions(final NgramContext ngramContext, final int sessionId) {
+        // empty base implementation
+    }
+
+    /**
+     * Makes the binary dictionaries that {@link #getSuggestions} searches available to
+     * {@link BinaryDictionary#getSuggestionsFromDictionaries}, so that they can be searched
+     * together with other dictionaries in one native call. On success, the dictionaries whose
+     * read locks are now held are added to outLockedDictionaries and have to be released with
+     * {@link #releaseBinaryDictionaryForSuggestions}.
+     * @param outLockedDictionaries the dictionaries to release after the search.
+     * @param outBinaryDictionaries the binary dictionaries to search.
+     * @return true if this dictionary can be searched that way. Nothing is added otherwise.
+     */
+    public boolean acquireBinaryDictionariesForSuggestions(
+            final ArrayList<Dictionary> outLockedDictionaries,
+            final ArrayList<BinaryDictionary> outBinaryDictionaries) {
+        return false;
+    }
+
+    /**
+     * Releases a dictionary added by {@link #acquireBinaryDictionariesForSuggestions}.
+     */
+    public void releaseBinaryDictionaryForSuggestions() {
+        // empty base implementation
+    }
+
     /**
      * Override to clean up any resources.
      */
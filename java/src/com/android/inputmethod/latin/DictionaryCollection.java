@@ -82,6 +82,36 @@ public final class DictionaryCollection extends Dictionary {
         return suggestions;
     }
 
+    @Override
+    public boolean acquireBinaryDictionariesForSuggestions(
+            final ArrayList<Dictionary> outLockedDictionaries,
+            final ArrayList<BinaryDictionary> outBinaryDictionaries) {
+        final int lockedDictionaryCount = outLockedDictionaries.size();
+        final int binaryDictionaryCount = outBinaryDictionaries.size();
+        for (final Dictionary dictionary : mDictionaries) {
+            if (!dictionary.acquireBinaryDictionariesForSuggestions(outLockedDictionaries,
+                    outBinaryDictionaries)) {
+                // All or none of the dictionaries are searched together.
+                while (outLockedDictionaries.size() > lockedDictionaryCount) {
+                    outLockedDictionaries.remove(outLockedDictionaries.size() - 1)
+                            .releaseBinaryDictionaryForSuggestions();
+                }
+                while (outBinaryDictionaries.size() > binaryDictionaryCount) {
+                    outBinaryDictionaries.remove(outBinaryDictionaries.size() - 1);
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
+    @Override
+    public void prefetchPredictions(final NgramContext ngramContext, final int sessionId) {
+        for (final Dictionary dictionary : mDictionaries) {
+            dictionary.prefetchPredictions(ngramContext, sessionId);
+        }
+    }
+
     @Override
     public boolean isInDictionary(final String word) {
         for (int i = mDictionaries.size() - 1; i >= 0; --i)
@@ -39,6 +39,7 @@ import java.io.File;
 import java.lang.reflect.InvocationTargetException;
 import java.lang.reflect.Method;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collections;
 import java.util.HashMap;
 import java.util.HashSet;
@@ -514,6 +515,26 @@ public class DictionaryFacilitatorImpl implements DictionaryFacilitator {
             ngramContextForCurrentWord =
                     ngramContextForCurrentWord.getNextNgramContext(new WordInfo(currentWord));
         }
+        prefetchPredictions(ngramContextForCurrentWord);
+    }
+
+    /**
+     * Computes the next-word predictions for the context following the committed word on the
+     * keyboard executor. The user history updates are queued on the same executor, so the
+     * predictions already reflect the committed word.
+     */
+    private void prefetchPredictions(@Nonnull final NgramContext ngramContext) {
+        final DictionaryGroup dictionaryGroup = mDictionaryGroup;
+        ExecutorUtils.getBackgroundExecutor(ExecutorUtils.KEYBOARD).execute(new Runnable() {
+            @Override
+            public void run() {
+                for (final String dictType : ALL_DICTIONARY_TYPES) {
+                    final Dictionary dictionary = dictionaryGroup.getDict(dictType);
+                    if (null == dictionary) continue;
+                    dictionary.prefetchPredictions(ngramContext, Suggest.SESSION_ID_TYPING);
+                }
+            }
+        });
     }
 
     private void putWordIntoValidSpellingWordCache(
@@ -623,25 +644,58 @@ public class DictionaryFacilitatorImpl implements DictionaryFacilitator {
                 false /* firstSuggestionExceedsConfidenceThreshold */);
         final float[] weightOfLangModelVsSpatialModel =
                 new float[] { Dictionary.NOT_A_WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL };
-        for (final String dictType : ALL_DICTIONARY_TYPES) {
-            final Dictionary dictionary = mDictionaryGroup.getDict(dictType);
-            if (null == dictionary) continue;
-            final float weightForLocale = composedData.mIsBatchMode
-                    ? mDictionaryGroup.mWeightForGesturingInLocale
-                    : mDictionaryGroup.mWeightForTypingInLocale;
-            final ArrayList<SuggestedWordInfo> dictionarySuggestions =
-                    dictionary.getSuggestions(composedData, ngramContext,
-                            proximityInfoHandle, settingsValuesForSuggestion, sessionId,
-                            weightForLocale, weightOfLangModelVsSpatialModel);
-            if (null == dictionarySuggestions) continue;
-            suggestionResults.addAll(dictionarySuggestions);
-            if (null != suggestionResults.mRawSuggestions) {
-                suggestionResults.mRawSuggestions.addAll(dictionarySuggestions);
+        final float weightForLocale = composedData.mIsBatchMode
+                ? mDictionaryGroup.mWeightForGesturingInLocale
+                : mDictionaryGroup.mWeightForTypingInLocale;
+        // The binary dictionaries are searched in one native call so that the input is
+        // processed only once. The others are searched separately, as are predictions, which
+        // have no input to share and may have been prefetched for each dictionary.
+        final boolean searchesTogether =
+                composedData.mIsBatchMode || !composedData.mTypedWord.isEmpty();
+        final ArrayList<Dictionary> lockedDictionaries = new ArrayList<>();
+        final ArrayList<BinaryDictionary> binaryDictionaries = new ArrayList<>();
+        final ArrayList<Dictionary> separateDictionaries = new ArrayList<>();
+        try {
+            for (final String dictType : ALL_DICTIONARY_TYPES) {
+                final Dictionary dictionary = mDictionaryGroup.getDict(dictType);
+                if (null == dictionary) continue;
+                if (!searchesTogether || !dictionary.acquireBinaryDictionariesForSuggestions(
+                        lockedDictionaries, binaryDictionaries)) {
+                    separateDictionaries.add(dictionary);
+                }
+            }
+            if (!binaryDictionaries.isEmpty()) {
+                // The locale weight is applied to the scores as for the separate searches.
+                final float[] dictionaryWeights = new float[binaryDictionaries.size()];
+                Arrays.fill(dictionaryWeights, 1.0f);
+                addSuggestions(suggestionResults, BinaryDictionary.getSuggestionsFromDictionaries(
+                        binaryDictionaries.toArray(new BinaryDictionary[binaryDictionaries.size()]),
+                        dictionaryWeights, composedData, ngramContext, proximityInfoHandle,
+                        settingsValuesForSuggestion, sessionId, weightForLocale,
+                        weightOfLangModelVsSpatialModel));
             }
+        } finally {
+            for (final Dictionary dictionary : lockedDictionaries) {
+                dictionary.releaseBinaryDictionaryForSuggestions();
+            }
+        }
+        for (final Dictionary dictionary : separateDictionaries) {
+            addSuggestions(suggestionResults, dictionary.getSuggestions(composedData,
+                    ngramContext, proximityInfoHandle, settingsValuesForSuggestion, sessionId,
+                    weightForLocale, weightOfLangModelVsSpatialModel));
         }
         return suggestionResults;
     }
 
+    private static void addSuggestions(@Nonnull final SuggestionResults suggestionResults,
+            @Nullable final ArrayList<SuggestedWordInfo> dictionarySuggestions) {
+        if (null == dictionarySuggestions) return;
+        suggestionResults.addAll(dictionarySuggestions);
+        if (null != suggestionResults.mRawSuggestions) {
+            suggestionResults.mRawSuggestions.addAll(dictionarySuggestions);
+        }
+    }
+
     public boolean isValidSpellingWord(final String word) {
         if (mValidSpellingWordReadCache != null) {
             final Boolean cachedValue = mValidSpellingWordReadCache.get(word);
@@ -460,6 +460,61 @@ abstract public class ExpandableBinaryDictionary extends Dictionary {
         return null;
     }
 
+    @Override
+    public void prefetchPredictions(final NgramContext ngramContext, final int sessionId) {
+        reloadDictionaryIfRequired();
+        boolean lockAcquired = false;
+        try {
+            lockAcquired = mLock.readLock().tryLock(
+                    TIMEOUT_FOR_READ_OPS_IN_MILLISECONDS, TimeUnit.MILLISECONDS);
+            if (lockAcquired && mBinaryDictionary != null) {
+                mBinaryDictionary.prefetchPredictions(ngramContext, sessionId);
+            }
+        } catch (final InterruptedException e) {
+            Log.e(TAG, "Interrupted tryLock() in prefetchPredictions().", e);
+        } finally {
+            if (lockAcquired) {
+                mLock.readLock().unlock();
+            }
+        }
+    }
+
+    @Override
+    public boolean acquireBinaryDictionariesForSuggestions(
+            final ArrayList<Dictionary> outLockedDictionaries,
+            final ArrayList<BinaryDictionary> outBinaryDictionaries) {
+        reloadDictionaryIfRequired();
+        try {
+            if (!mLock.readLock().tryLock(
+                    TIMEOUT_FOR_READ_OPS_IN_MILLISECONDS, TimeUnit.MILLISECONDS)) {
+                return false;
+            }
+        } catch (final InterruptedException e) {
+            Log.e(TAG, "Interrupted tryLock() in acquireBinaryDictionariesForSuggestions().", e);
+            return false;
+        }
+        if (mBinaryDictionary == null || !mBinaryDictionary.isValidDictionary()) {
+            mLock.readLock().unlock();
+            return false;
+        }
+        outLockedDictionaries.add(this);
+        outBinaryDictionaries.add(mBinaryDictionary);
+        return true;
+    }
+
+    @Override
+    public void releaseBinaryDictionaryForSuggestions() {
+        try {
+            if (mBinaryDictionary != null && mBinaryDictionary.isCorrupted()) {
+                Log.i(TAG, "Dictionary (" + mDictName +") is corrupted. "
+                        + "Remove and regenerate it.");
+                removeBinaryDictionary();
+            }
+        } finally {
+            mLock.readLock().unlock();
+        }
+    }
+
     @Override
     public boolean isInDictionary(final String word) {
         reloadDictionaryIfRequired();
@@ -706,14 +761,15 @@ abstract public class ExpandableBinaryDictionary extends Dictionary {
                 }
                 int token = 0;
                 do {
-                    final BinaryDictionary.GetNextWordPropertyResult result =
-                            binaryDictionary.getNextWordProperty(token);
-                    final WordProperty wordProperty = result.mWordProperty;
-                    if (wordProperty == null) {
+                    final BinaryDictionary.GetNextWordPropertiesResult result =
+                            binaryDictionary.getNextWordProperties(token);
+                    if (token == 0 && result.mWordProperties.isEmpty()) {
                         Log.d(tag, " dictionary is empty.");
                         break;
                     }
-                    Log.d(tag, wordProperty.toString());
+                    for (final WordProperty wordProperty : result.mWordProperties) {
+                        Log.d(tag, wordProperty.toString());
+                    }
                     token = result.mNextToken;
                 } while (token != 0);
             }
@@ -738,14 +794,10 @@ abstract public class ExpandableBinaryDictionary extends Dictionary {
                 int token = 0;
                 do {
                     // TODO: We need a new API that returns *new* un-synced data.
-                    final BinaryDictionary.GetNextWordPropertyResult nextWordPropertyResult =
-                            binaryDictionary.getNextWordProperty(token);
-                    final WordProperty wordProperty = nextWordPropertyResult.mWordProperty;
-                    if (wordProperty == null) {
-                        break;
-                    }
-                    wordPropertyList.add(wordProperty);
-                    token = nextWordPropertyResult.mNextToken;
+                    final BinaryDictionary.GetNextWordPropertiesResult nextWordPropertiesResult =
+                            binaryDictionary.getNextWordProperties(token);
+                    wordPropertyList.addAll(nextWordPropertiesResult.mWordProperties);
+                    token = nextWordPropertiesResult.mNextToken;
                 } while (token != 0);
                 result.set(wordPropertyList.toArray(new WordProperty[wordPropertyList.size()]));
             }
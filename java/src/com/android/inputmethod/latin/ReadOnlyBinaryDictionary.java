@@ -67,6 +67,38 @@ public final class ReadOnlyBinaryDictionary extends Dictionary {
         return null;
     }
 
+    @Override
+    public boolean acquireBinaryDictionariesForSuggestions(
+            final ArrayList<Dictionary> outLockedDictionaries,
+            final ArrayList<BinaryDictionary> outBinaryDictionaries) {
+        if (!mLock.readLock().tryLock()) {
+            return false;
+        }
+        if (!mBinaryDictionary.isValidDictionary()) {
+            mLock.readLock().unlock();
+            return false;
+        }
+        outLockedDictionaries.add(this);
+        outBinaryDictionaries.add(mBinaryDictionary);
+        return true;
+    }
+
+    @Override
+    public void releaseBinaryDictionaryForSuggestions() {
+        mLock.readLock().unlock();
+    }
+
+    @Override
+    public void prefetchPredictions(final NgramContext ngramContext, final int sessionId) {
+        if (mLock.readLock().tryLock()) {
+            try {
+                mBinaryDictionary.prefetchPredictions(ngramContext, sessionId);
+            } finally {
+                mLock.readLock().unlock();
+            }
+        }
+    }
+
     @Override
     public boolean isInDictionary(final String word) {
         if (mLock.readLock().tryLock()) {
@@ -48,6 +48,8 @@ public final class DictionaryHeader {
     public static final String DICTIONARY_DESCRIPTION_KEY = "description";
     public static final String DICTIONARY_DATE_KEY = "date";
     public static final String HAS_HISTORICAL_INFO_KEY = "HAS_HISTORICAL_INFO";
+    public static final String USES_COMPACT_PROBABILITY_ENTRIES_KEY =
+            "USES_COMPACT_PROBABILITY_ENTRIES";
     public static final String USES_FORGETTING_CURVE_KEY = "USES_FORGETTING_CURVE";
     public static final String FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID_KEY =
             "FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID";
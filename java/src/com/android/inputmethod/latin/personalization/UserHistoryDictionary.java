@@ -120,6 +120,8 @@ public class UserHistoryDictionary extends ExpandableBinaryDictionary {
                 DictionaryHeader.ATTRIBUTE_VALUE_TRUE);
         attributeMap.put(DictionaryHeader.HAS_HISTORICAL_INFO_KEY,
                 DictionaryHeader.ATTRIBUTE_VALUE_TRUE);
+        attributeMap.put(DictionaryHeader.USES_COMPACT_PROBABILITY_ENTRIES_KEY,
+                DictionaryHeader.ATTRIBUTE_VALUE_TRUE);
         return attributeMap;
     }
 
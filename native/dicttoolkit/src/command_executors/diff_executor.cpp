@@ -16,21 +16,223 @@
 
 #include "command_executors/diff_executor.h"
 
-#include <cstdio>
+#include <cstdint>
+#include <string>
+
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "dictionary/property/ngram_context.h"
+#include "dictionary/property/ngram_property.h"
+#include "dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "dictionary/utils/file_utils.h"
+#include "utils/dictionary_diff.h"
+#include "utils/int_array_view.h"
+#include "utils/utf8_utils.h"
 
 namespace latinime {
 namespace dicttoolkit {
 
+namespace {
+
+enum EntryType {
+    ENTRY_TYPE_WORD,
+    ENTRY_TYPE_SHORTCUT,
+    ENTRY_TYPE_NGRAM,
+    ENTRY_TYPE_COUNT,
+};
+
+// Indexed by EntryType.
+const char *const ENTRY_TYPE_NAMES[] = { "word", "shortcut", "ngram" };
+const char *const ENTRY_TYPE_DISPLAY_NAMES[] = { "word", "shortcut", "n-gram" };
+
+std::string getWordString(const CodePointArrayView word) {
+    if (word.size() == 1 && word[0] == CODE_POINT_BEGINNING_OF_SENTENCE) {
+        return "<s>";
+    }
+    return Utf8Utils::getUtf8String(word);
+}
+
+std::string getUnigramValue(const UnigramProperty &unigramProperty) {
+    std::string value = std::to_string(unigramProperty.getProbability());
+    const std::pair<bool, const char *> flagNames[] = {
+        { unigramProperty.isNotAWord(), "not_a_word" },
+        { unigramProperty.isPossiblyOffensive(), "possibly_offensive" },
+        { unigramProperty.isBlacklisted(), "blacklisted" },
+    };
+    for (const auto &flagName : flagNames) {
+        if (flagName.first) {
+            value += std::string(",") + flagName.second;
+        }
+    }
+    return value;
+}
+
+// Prints "change<TAB>type<TAB>entry<TAB>value1<TAB>value2" lines in the plumbing mode, where the
+// value of the missing side is "-". Otherwise prints a line per difference and a summary.
+class DiffPrinter : public DictionaryDiff::DifferenceListener {
+ public:
+    DiffPrinter(FILE *const file, const bool isPlumbing)
+            : mFile(file), mIsPlumbing(isPlumbing), mAddedCounts(), mRemovedCounts(),
+              mChangedCounts() {}
+
+    void onWordDifference(const CodePointArrayView word,
+            const UnigramProperty *const unigramProperty1,
+            const UnigramProperty *const unigramProperty2) {
+        print(ENTRY_TYPE_WORD, getWordString(word),
+                unigramProperty1 ? getUnigramValue(*unigramProperty1) : "",
+                unigramProperty2 ? getUnigramValue(*unigramProperty2) : "");
+    }
+
+    void onShortcutDifference(const CodePointArrayView word,
+            const UnigramProperty::ShortcutProperty *const shortcutProperty1,
+            const UnigramProperty::ShortcutProperty *const shortcutProperty2) {
+        const UnigramProperty::ShortcutProperty *const shortcutProperty =
+                shortcutProperty1 ? shortcutProperty1 : shortcutProperty2;
+        print(ENTRY_TYPE_SHORTCUT, getWordString(word) + " -> "
+                + getWordString(CodePointArrayView(*shortcutProperty->getTargetCodePoints())),
+                shortcutProperty1 ? std::to_string(shortcutProperty1->getProbability()) : "",
+                shortcutProperty2 ? std::to_string(shortcutProperty2->getProbability()) : "");
+    }
+
+    void onNgramDifference(const NgramProperty *const ngramProperty1,
+            const NgramProperty *const ngramProperty2) {
+        const NgramProperty *const ngramProperty = ngramProperty1 ? ngramProperty1 : ngramProperty2;
+        const NgramContext *const ngramContext = ngramProperty->getNgramContext();
+        std::string entry;
+        for (size_t n = ngramContext->getPrevWordCount(); n > 0; --n) {
+            entry += ngramContext->isNthPrevWordBeginningOfSentence(n) ? "<s>"
+                    : getWordString(ngramContext->getNthPrevWordCodePoints(n));
+            entry += " ";
+        }
+        entry += getWordString(CodePointArrayView(*ngramProperty->getTargetCodePoints()));
+        print(ENTRY_TYPE_NGRAM, entry,
+                ngramProperty1 ? std::to_string(ngramProperty1->getProbability()) : "",
+                ngramProperty2 ? std::to_string(ngramProperty2->getProbability()) : "");
+    }
+
+    bool hasDifferences() const {
+        for (int i = 0; i < ENTRY_TYPE_COUNT; ++i) {
+            if (mAddedCounts[i] + mRemovedCounts[i] + mChangedCounts[i] > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void printSummary() const {
+        if (mIsPlumbing) {
+            return;
+        }
+        if (!hasDifferences()) {
+            fprintf(mFile, "No differences.\n");
+            return;
+        }
+        fprintf(mFile, "Summary (added, removed, changed):\n");
+        for (int i = 0; i < ENTRY_TYPE_COUNT; ++i) {
+            fprintf(mFile, "  %ss: %lld, %lld, %lld\n", ENTRY_TYPE_DISPLAY_NAMES[i],
+                    static_cast<long long>(mAddedCounts[i]),
+                    static_cast<long long>(mRemovedCounts[i]),
+                    static_cast<long long>(mChangedCounts[i]));
+        }
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(DiffPrinter);
+
+    // An empty value means that the dictionary doesn't have the entry.
+    void print(const EntryType entryType, const std::string &entry, const std::string &value1,
+            const std::string &value2) {
+        const char *change;
+        if (value1.empty()) {
+            change = "added";
+            ++mAddedCounts[entryType];
+        } else if (value2.empty()) {
+            change = "removed";
+            ++mRemovedCounts[entryType];
+        } else {
+            change = "changed";
+            ++mChangedCounts[entryType];
+        }
+        if (mIsPlumbing) {
+            fprintf(mFile, "%s\t%s\t%s\t%s\t%s\n", change, ENTRY_TYPE_NAMES[entryType],
+                    entry.c_str(), value1.empty() ? "-" : value1.c_str(),
+                    value2.empty() ? "-" : value2.c_str());
+        } else if (value1.empty()) {
+            fprintf(mFile, "+ %s: %s [%s]\n", ENTRY_TYPE_DISPLAY_NAMES[entryType],
+                    entry.c_str(), value2.c_str());
+        } else if (value2.empty()) {
+            fprintf(mFile, "- %s: %s [%s]\n", ENTRY_TYPE_DISPLAY_NAMES[entryType],
+                    entry.c_str(), value1.c_str());
+        } else {
+            fprintf(mFile, "~ %s: %s [%s] -> [%s]\n", ENTRY_TYPE_DISPLAY_NAMES[entryType],
+                    entry.c_str(), value1.c_str(), value2.c_str());
+        }
+    }
+
+    FILE *const mFile;
+    const bool mIsPlumbing;
+    int64_t mAddedCounts[ENTRY_TYPE_COUNT];
+    int64_t mRemovedCounts[ENTRY_TYPE_COUNT];
+    int64_t mChangedCounts[ENTRY_TYPE_COUNT];
+};
+
+DictionaryStructureWithBufferPolicy::StructurePolicyPtr openDictionary(
+        const std::string &dictPath) {
+    // The size is ignored for v4 dictionaries, which are directories.
+    const int dictSize = FileUtils::getFileSize(dictPath.c_str());
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+            DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+                    dictPath.c_str(), 0 /* bufOffset */, dictSize, false /* isUpdatable */);
+    if (!policy) {
+        fprintf(stderr, "Cannot open the dictionary: %s\n", dictPath.c_str());
+    }
+    return policy;
+}
+
+} // namespace
+
 const char *const DiffExecutor::COMMAND_NAME = "diff";
 
 /* static */ int DiffExecutor::run(const int argc, char **argv) {
-    fprintf(stderr, "Command '%s' has not been implemented yet.\n", COMMAND_NAME);
-    return 0;
+    const ArgumentsAndOptions argumentsAndOptions =
+            getArgumentsParser().parseArguments(argc, argv, true /* printErrorMessages */);
+    if (!argumentsAndOptions.isValid()) {
+        printUsage();
+        return 2;
+    }
+    const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy1 =
+            openDictionary(argumentsAndOptions.getSingleArgument("dict1"));
+    const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy2 =
+            openDictionary(argumentsAndOptions.getSingleArgument("dict2"));
+    if (!policy1 || !policy2) {
+        return 2;
+    }
+    bool hasDifferences = false;
+    if (!printDiff(stdout, policy1.get(), policy2.get(), argumentsAndOptions.hasOption("p"),
+            &hasDifferences)) {
+        fprintf(stderr, "The dictionaries are broken.\n");
+        return 2;
+    }
+    // Same as diff(1).
+    return hasDifferences ? 1 : 0;
+}
+
+/* static */ bool DiffExecutor::printDiff(FILE *const file,
+        const DictionaryStructureWithBufferPolicy *const policy1,
+        const DictionaryStructureWithBufferPolicy *const policy2, const bool isPlumbing,
+        bool *const outHasDifferences) {
+    DiffPrinter printer(file, isPlumbing);
+    if (!DictionaryDiff::diff(policy1, policy2, &printer)) {
+        return false;
+    }
+    printer.printSummary();
+    *outHasDifferences = printer.hasDifferences();
+    return true;
 }
 
 /* static */ void DiffExecutor::printUsage() {
     printf("*** %s\n", COMMAND_NAME);
-    getArgumentsParser().printUsage(COMMAND_NAME, "Shows differences between two dictionaries.");
+    getArgumentsParser().printUsage(COMMAND_NAME, "Shows differences between two dictionaries. "
+            "Exits with 0 when they are the same, 1 when they differ and 2 on errors.");
 }
 
 /* static */ const ArgumentsParser DiffExecutor::getArgumentsParser() {
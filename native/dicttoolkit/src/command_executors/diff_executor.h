@@ -17,10 +17,15 @@
 #ifndef LATINIME_DICT_TOOLKIT_DIFF_EXECUTOR_H
 #define LATINIME_DICT_TOOLKIT_DIFF_EXECUTOR_H
 
+#include <cstdio>
+
 #include "dict_toolkit_defines.h"
 #include "utils/arguments_parser.h"
 
 namespace latinime {
+
+class DictionaryStructureWithBufferPolicy;
+
 namespace dicttoolkit {
 
 class DiffExecutor final {
@@ -31,6 +36,13 @@ class DiffExecutor final {
     static void printUsage();
     static const ArgumentsParser getArgumentsParser();
 
+    // Prints the words, n-grams and shortcuts that are added, removed or changed in the second
+    // dictionary. Returns false when either dictionary is broken.
+    static bool printDiff(FILE *const file,
+            const DictionaryStructureWithBufferPolicy *const policy1,
+            const DictionaryStructureWithBufferPolicy *const policy2, const bool isPlumbing,
+            bool *const outHasDifferences);
+
  private:
     DISALLOW_IMPLICIT_CONSTRUCTORS(DiffExecutor);
 };
@@ -16,21 +16,291 @@
 
 #include "command_executors/info_executor.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "dictionary/header/header_policy.h"
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "dictionary/property/ngram_context.h"
+#include "dictionary/property/word_property.h"
+#include "dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "dictionary/utils/file_utils.h"
+#include "dictionary/utils/format_utils.h"
+#include "suggest/core/layout/proximity_info_cache.h"
+#include "utils/dictionary_statistics.h"
+#include "utils/int_array_view.h"
+#include "utils/memory_report.h"
+#include "utils/utf8_utils.h"
+
 namespace latinime {
 namespace dicttoolkit {
 
+namespace {
+
+// Prints "section.name=value" lines in the plumbing mode and indented "name: value" lines under
+// section titles otherwise.
+class InfoPrinter {
+ public:
+    InfoPrinter(FILE *const file, const bool isPlumbing)
+            : mFile(file), mIsPlumbing(isPlumbing), mSectionKey() {}
+
+    void beginSection(const std::string &title, const std::string &key) {
+        mSectionKey = key;
+        if (!mIsPlumbing) {
+            fprintf(mFile, "%s:\n", title.c_str());
+        }
+    }
+
+    void print(const std::string &name, const std::string &value) {
+        if (mIsPlumbing) {
+            fprintf(mFile, "%s.%s=%s\n", mSectionKey.c_str(), name.c_str(), value.c_str());
+        } else {
+            fprintf(mFile, "  %s: %s\n", name.c_str(), value.c_str());
+        }
+    }
+
+    void print(const std::string &name, const int64_t value) {
+        print(name, std::to_string(value));
+    }
+
+    void printHistogram(const std::vector<int64_t> &histogram) {
+        for (size_t i = 0; i < histogram.size(); ++i) {
+            if (histogram[i] > 0) {
+                print(std::to_string(i), histogram[i]);
+            }
+        }
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(InfoPrinter);
+
+    FILE *const mFile;
+    const bool mIsPlumbing;
+    std::string mSectionKey;
+};
+
+std::string toUtf8String(const std::vector<int> &codePoints) {
+    return Utf8Utils::getUtf8String(CodePointArrayView(codePoints));
+}
+
+std::string formatDouble(const double value) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.2f", value);
+    return buffer;
+}
+
+std::string formatCodePoint(const int codePoint) {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "U+%04X", codePoint);
+    return buffer;
+}
+
+void printHeader(const DictionaryStructureWithBufferPolicy *const policy,
+        InfoPrinter *const printer) {
+    const DictionaryHeaderStructurePolicy *const headerPolicy = policy->getHeaderStructurePolicy();
+    printer->beginSection("Header", "header");
+    printer->print("format_version", headerPolicy->getFormatVersionNumber());
+    printer->print("size", headerPolicy->getSize());
+    for (const auto &attribute : *headerPolicy->getAttributeMap()) {
+        printer->print(toUtf8String(attribute.first), toUtf8String(attribute.second));
+    }
+}
+
+void printNgramCounts(const DictionaryStructureWithBufferPolicy *const policy,
+        const DictionaryStatistics &statistics, InfoPrinter *const printer) {
+    const DictionaryHeaderStructurePolicy *const headerPolicy = policy->getHeaderStructurePolicy();
+    printer->beginSection("N-gram counts", "ngram_count");
+    if (headerPolicy->getFormatVersionNumber() < FormatUtils::VERSION_4_ONLY_FOR_TESTING) {
+        // Ver2 headers don't have entry counts. Only the unigrams are known from the PtNodes.
+        printer->print("1", statistics.getTerminalPtNodeCount());
+        return;
+    }
+    // HeaderPolicy is the only header structure policy. The counts are maintained by the
+    // dictionary and written to the header when it is flushed.
+    const EntryCounts &ngramCounts =
+            static_cast<const HeaderPolicy *>(headerPolicy)->getNgramCounts();
+    for (size_t i = 0; i < ngramCounts.getCountArray().size(); ++i) {
+        printer->print(std::to_string(i + 1), ngramCounts.getCountArray()[i]);
+    }
+}
+
+void printStatistics(const DictionaryStatistics &statistics, const bool isPlumbing,
+        const int maxCodePointCountToPrint, InfoPrinter *const printer) {
+    printer->beginSection("PtNodes", "pt_node");
+    printer->print("count", statistics.getPtNodeCount());
+    printer->print("terminal_count", statistics.getTerminalPtNodeCount());
+    printer->print("deleted_count", statistics.getDeletedPtNodeCount());
+    printer->print("array_count", statistics.getPtNodeArrayCount());
+    printer->print("total_size", statistics.getTotalPtNodeSize());
+    printer->print("average_size", formatDouble(statistics.getAveragePtNodeSize()));
+    printer->beginSection("Depth histogram (depth: PtNodes)", "depth_histogram");
+    printer->printHistogram(statistics.getDepthHistogram());
+    printer->beginSection("Fan-out histogram (PtNodes in array: arrays)", "fan_out_histogram");
+    printer->printHistogram(statistics.getFanOutHistogram());
+    printer->beginSection("Code points per PtNode (code points: PtNodes)",
+            "code_point_count_histogram");
+    printer->printHistogram(statistics.getCodePointCountHistogram());
+
+    std::vector<std::pair<int, int64_t>> codePointCounts(
+            statistics.getCodePointCounts().begin(), statistics.getCodePointCounts().end());
+    std::sort(codePointCounts.begin(), codePointCounts.end(),
+            [](const std::pair<int, int64_t> &left, const std::pair<int, int64_t> &right) {
+                return left.second != right.second ? left.second > right.second
+                        : left.first < right.first;
+            });
+    printer->beginSection("Code point distribution", "code_point");
+    for (size_t i = 0; i < codePointCounts.size(); ++i) {
+        if (!isPlumbing && static_cast<int>(i) >= maxCodePointCountToPrint) {
+            printer->print("others", std::to_string(codePointCounts.size() - i) + " code points");
+            break;
+        }
+        printer->print(formatCodePoint(codePointCounts[i].first), codePointCounts[i].second);
+    }
+}
+
+void printMemoryReport(const DictionaryStructureWithBufferPolicy *const policy,
+        InfoPrinter *const printer) {
+    MemoryReport memoryReport;
+    policy->getMemoryReport(&memoryReport);
+    // Same as the "MEMORY_REPORT" query. The tool has no keyboard layouts; only the empty cache
+    // is reported.
+    ProximityInfoCache::getInstance()->getMemoryReport(&memoryReport);
+    printer->beginSection("Memory (mapped,resident,heap,wasted)", "memory");
+    for (const auto &component : memoryReport.getComponents()) {
+        const MemoryUsage &memoryUsage = component.getMemoryUsage();
+        printer->print(component.getName(), std::to_string(memoryUsage.getMappedSize()) + ","
+                + std::to_string(memoryUsage.getResidentSize()) + ","
+                + std::to_string(memoryUsage.getHeapSize()) + ","
+                + std::to_string(memoryUsage.getWastedSize()));
+        // The language model of v4 dictionaries is a TrieMap whose wasted entries are the ones
+        // in its free lists.
+        if (component.getName() == "language_model") {
+            const int64_t totalSize = memoryUsage.getMappedSize() + memoryUsage.getHeapSize();
+            if (totalSize > 0) {
+                printer->print("trie_map_occupancy", formatDouble(1.0
+                        - static_cast<double>(memoryUsage.getWastedSize())
+                                / static_cast<double>(totalSize)));
+            }
+        }
+    }
+}
+
+std::string getNgramContextString(const NgramContext *const ngramContext) {
+    std::string contextString;
+    for (size_t n = ngramContext->getPrevWordCount(); n > 0; --n) {
+        if (!contextString.empty()) {
+            contextString += " ";
+        }
+        if (ngramContext->isNthPrevWordBeginningOfSentence(n)) {
+            contextString += "<s>";
+        } else {
+            const CodePointArrayView codePoints = ngramContext->getNthPrevWordCodePoints(n);
+            contextString += Utf8Utils::getUtf8String(codePoints);
+        }
+    }
+    return contextString;
+}
+
+void printWord(const DictionaryStructureWithBufferPolicy *const policy, const std::string &word,
+        InfoPrinter *const printer) {
+    const std::vector<int> codePoints = Utf8Utils::getCodePoints(word);
+    printer->beginSection("Word \"" + word + "\"", "word." + word);
+    if (policy->getWordId(CodePointArrayView(codePoints), false /* forceLowerCaseSearch */)
+            == NOT_A_WORD_ID) {
+        printer->print("found", "false");
+        return;
+    }
+    printer->print("found", "true");
+    const WordProperty wordProperty = policy->getWordProperty(CodePointArrayView(codePoints));
+    const UnigramProperty &unigramProperty = wordProperty.getUnigramProperty();
+    printer->print("probability", unigramProperty.getProbability());
+    std::string flags;
+    const std::pair<bool, const char *> flagNames[] = {
+        { unigramProperty.representsBeginningOfSentence(), "beginning_of_sentence" },
+        { unigramProperty.isNotAWord(), "not_a_word" },
+        { unigramProperty.isPossiblyOffensive(), "possibly_offensive" },
+        { unigramProperty.isBlacklisted(), "blacklisted" },
+    };
+    for (const auto &flagName : flagNames) {
+        if (flagName.first) {
+            flags += flags.empty() ? flagName.second : std::string(",") + flagName.second;
+        }
+    }
+    printer->print("flags", flags.empty() ? "none" : flags);
+    const HistoricalInfo historicalInfo = unigramProperty.getHistoricalInfo();
+    if (historicalInfo.isValid()) {
+        printer->print("historical_info", std::to_string(historicalInfo.getTimestamp()) + ","
+                + std::to_string(historicalInfo.getLevel()) + ","
+                + std::to_string(historicalInfo.getCount()));
+    }
+    for (const auto &shortcut : unigramProperty.getShortcuts()) {
+        printer->print("shortcut", toUtf8String(*shortcut.getTargetCodePoints()) + ":"
+                + std::to_string(shortcut.getProbability()));
+    }
+    // N-grams whose context ends with this word.
+    for (const auto &ngramProperty : wordProperty.getNgramProperties()) {
+        printer->print("ngram", getNgramContextString(ngramProperty.getNgramContext()) + " "
+                + toUtf8String(*ngramProperty.getTargetCodePoints()) + ":"
+                + std::to_string(ngramProperty.getProbability()));
+    }
+}
+
+} // namespace
+
 const char *const InfoExecutor::COMMAND_NAME = "info";
+const int InfoExecutor::MAX_CODE_POINT_COUNT_TO_PRINT = 32;
 
 /* static */ int InfoExecutor::run(const int argc, char **argv) {
-    fprintf(stderr, "Command '%s' has not been implemented yet.\n", COMMAND_NAME);
+    const ArgumentsAndOptions argumentsAndOptions =
+            getArgumentsParser().parseArguments(argc, argv, true /* printErrorMessages */);
+    if (!argumentsAndOptions.isValid()) {
+        printUsage();
+        return 1;
+    }
+    const std::string &dictPath = argumentsAndOptions.getSingleArgument("dict");
+    // The size is ignored for v4 dictionaries, which are directories.
+    const int dictSize = FileUtils::getFileSize(dictPath.c_str());
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+            DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+                    dictPath.c_str(), 0 /* bufOffset */, dictSize, false /* isUpdatable */);
+    if (!policy) {
+        fprintf(stderr, "Cannot open the dictionary: %s\n", dictPath.c_str());
+        return 1;
+    }
+    const std::vector<std::string> words = argumentsAndOptions.hasArgument("word") ?
+            argumentsAndOptions.getVariableLengthArguments("word") : std::vector<std::string>();
+    const int threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    if (!printInfo(stdout, policy.get(), words, argumentsAndOptions.hasOption("p"),
+            threadCount)) {
+        fprintf(stderr, "The dictionary is broken: %s\n", dictPath.c_str());
+        return 1;
+    }
     return 0;
 }
 
+/* static */ bool InfoExecutor::printInfo(FILE *const file,
+        const DictionaryStructureWithBufferPolicy *const policy,
+        const std::vector<std::string> &words, const bool isPlumbing, const int threadCount) {
+    DictionaryStatistics statistics;
+    if (!DictionaryStatistics::collect(policy, threadCount, &statistics)) {
+        return false;
+    }
+    InfoPrinter printer(file, isPlumbing);
+    printHeader(policy, &printer);
+    printNgramCounts(policy, statistics, &printer);
+    printStatistics(statistics, isPlumbing, MAX_CODE_POINT_COUNT_TO_PRINT, &printer);
+    printMemoryReport(policy, &printer);
+    for (const auto &word : words) {
+        printWord(policy, word, &printer);
+    }
+    return true;
+}
+
 /* static */ void InfoExecutor::printUsage() {
     printf("*** %s\n", COMMAND_NAME);
     getArgumentsParser().printUsage(COMMAND_NAME,
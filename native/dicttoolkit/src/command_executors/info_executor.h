@@ -17,10 +17,17 @@
 #ifndef LATINIME_DICT_TOOLKIT_INFO_EXECUTOR_H
 #define LATINIME_DICT_TOOLKIT_INFO_EXECUTOR_H
 
+#include <cstdio>
+#include <string>
+#include <vector>
+
 #include "dict_toolkit_defines.h"
 #include "utils/arguments_parser.h"
 
 namespace latinime {
+
+class DictionaryStructureWithBufferPolicy;
+
 namespace dicttoolkit {
 
 class InfoExecutor final {
@@ -31,8 +38,16 @@ class InfoExecutor final {
     static void printUsage();
     static const ArgumentsParser getArgumentsParser();
 
+    // Prints the header, the n-gram counts, the structure statistics, the memory usage and the
+    // details of the given words. Returns false when the dictionary is broken.
+    static bool printInfo(FILE *const file,
+            const DictionaryStructureWithBufferPolicy *const policy,
+            const std::vector<std::string> &words, const bool isPlumbing, const int threadCount);
+
  private:
     DISALLOW_IMPLICIT_CONSTRUCTORS(InfoExecutor);
+
+    static const int MAX_CODE_POINT_COUNT_TO_PRINT;
 };
 
 } // namepsace dicttoolkit
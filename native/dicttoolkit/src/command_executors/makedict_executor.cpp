@@ -16,12 +16,23 @@
 
 #include "command_executors/makedict_executor.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <memory>
+#include <thread>
+
+#include "makedict/binary_dict_decoder.h"
+#include "makedict/combined_format_utils.h"
+#include "makedict/ver4_dict_encoder.h"
+#include "offdevice_intermediate_dict/offdevice_intermediate_dict.h"
 
 namespace latinime {
 namespace dicttoolkit {
 
 const char *const MakedictExecutor::COMMAND_NAME = "makedict";
+const char *const MakedictExecutor::OUTPUT_FORMAT_VERSION_2 = "2";
+const char *const MakedictExecutor::OUTPUT_FORMAT_VERSION_4 = "4";
+const char *const MakedictExecutor::OUTPUT_FORMAT_COMBINED = "combined";
 
 /* static */ int MakedictExecutor::run(const int argc, char **argv) {
     const ArgumentsAndOptions argumentsAndOptions =
@@ -30,8 +41,60 @@ const char *const MakedictExecutor::COMMAND_NAME = "makedict";
         printUsage();
         return 1;
     }
-    fprintf(stderr, "Command '%s' has not been implemented yet.\n", COMMAND_NAME);
-    return 0;
+    const std::string &outputFormat = argumentsAndOptions.getOptionValue("o");
+    if (outputFormat != OUTPUT_FORMAT_VERSION_2 && outputFormat != OUTPUT_FORMAT_VERSION_4
+            && outputFormat != OUTPUT_FORMAT_COMBINED) {
+        fprintf(stderr, "Unknown output format: %s\n", outputFormat.c_str());
+        printUsage();
+        return 1;
+    }
+    const std::string &codePointTableSwitch = argumentsAndOptions.getOptionValue("t");
+    Ver2DictEncoder::CodePointTableMode codePointTableMode;
+    if (codePointTableSwitch == "on") {
+        codePointTableMode = Ver2DictEncoder::CODE_POINT_TABLE_ON;
+    } else if (codePointTableSwitch == "off") {
+        codePointTableMode = Ver2DictEncoder::CODE_POINT_TABLE_OFF;
+    } else if (codePointTableSwitch == "auto") {
+        codePointTableMode = Ver2DictEncoder::CODE_POINT_TABLE_AUTO;
+    } else {
+        fprintf(stderr, "Unknown code point table mode: %s\n", codePointTableSwitch.c_str());
+        printUsage();
+        return 1;
+    }
+    const int threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    return convertDictionary(argumentsAndOptions.getSingleArgument("src_dict"),
+            argumentsAndOptions.getSingleArgument("dest_dict"), outputFormat,
+            codePointTableMode, threadCount) ? 0 : 1;
+}
+
+/* static */ bool MakedictExecutor::convertDictionary(const std::string &srcDictPath,
+        const std::string &destDictPath, const std::string &outputFormat,
+        const Ver2DictEncoder::CodePointTableMode codePointTableMode, const int threadCount) {
+    std::unique_ptr<OffdeviceIntermediateDict> dict;
+    if (BinaryDictDecoder::isBinaryDictionary(srcDictPath.c_str())) {
+        dict = BinaryDictDecoder::readDictionary(srcDictPath.c_str());
+    } else if (FILE *const file = fopen(srcDictPath.c_str(), "r")) {
+        dict = CombinedFormatUtils::readDictionary(file);
+        fclose(file);
+    }
+    if (!dict) {
+        fprintf(stderr, "Cannot read the source dictionary: %s\n", srcDictPath.c_str());
+        return false;
+    }
+    bool succeeded = false;
+    if (outputFormat == OUTPUT_FORMAT_VERSION_2) {
+        succeeded = Ver2DictEncoder::writeDictionary(*dict, codePointTableMode, threadCount,
+                destDictPath.c_str());
+    } else if (outputFormat == OUTPUT_FORMAT_VERSION_4) {
+        succeeded = Ver4DictEncoder::writeDictionary(*dict, destDictPath.c_str());
+    } else if (FILE *const file = fopen(destDictPath.c_str(), "w")) {
+        succeeded = CombinedFormatUtils::writeDictionary(*dict, file);
+        succeeded &= fclose(file) == 0;
+    }
+    if (!succeeded) {
+        fprintf(stderr, "Cannot write the dictionary: %s\n", destDictPath.c_str());
+    }
+    return succeeded;
 }
 
 /* static */ void MakedictExecutor::printUsage() {
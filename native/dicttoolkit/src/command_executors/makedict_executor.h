@@ -17,7 +17,10 @@
 #ifndef LATINIME_DICT_TOOLKIT_MAKEDICT_EXECUTOR_H
 #define LATINIME_DICT_TOOLKIT_MAKEDICT_EXECUTOR_H
 
+#include <string>
+
 #include "dict_toolkit_defines.h"
+#include "makedict/ver2_dict_encoder.h"
 #include "utils/arguments_parser.h"
 
 namespace latinime {
@@ -31,8 +34,18 @@ class MakedictExecutor final {
     static void printUsage();
     static const ArgumentsParser getArgumentsParser();
 
+    // Reads a binary or combined format dictionary and writes it in the output format. The ver2
+    // output is encoded by threadCount threads.
+    static bool convertDictionary(const std::string &srcDictPath,
+            const std::string &destDictPath, const std::string &outputFormat,
+            const Ver2DictEncoder::CodePointTableMode codePointTableMode, const int threadCount);
+
  private:
     DISALLOW_IMPLICIT_CONSTRUCTORS(MakedictExecutor);
+
+    static const char *const OUTPUT_FORMAT_VERSION_2;
+    static const char *const OUTPUT_FORMAT_VERSION_4;
+    static const char *const OUTPUT_FORMAT_COMBINED;
 };
 
 } // namespace dicttoolkit
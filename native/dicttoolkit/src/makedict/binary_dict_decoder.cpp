@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "makedict/binary_dict_decoder.h"
+
+#include <cstdint>
+#include <cstdio>
+
+#include "dictionary/interface/dictionary_header_structure_policy.h"
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "dictionary/property/word_property.h"
+#include "dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "dictionary/utils/byte_array_utils.h"
+#include "dictionary/utils/file_utils.h"
+#include "dictionary/utils/format_utils.h"
+#include "offdevice_intermediate_dict/offdevice_intermediate_dict.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+namespace dicttoolkit {
+
+/* static */ std::unique_ptr<OffdeviceIntermediateDict> BinaryDictDecoder::readDictionary(
+        const char *const dictPath) {
+    // The size is ignored for v4 dictionaries, which are directories.
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+            DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(dictPath,
+                    0 /* bufOffset */, FileUtils::getFileSize(dictPath), false /* isUpdatable */);
+    if (!policy) {
+        return nullptr;
+    }
+    return readDictionary(policy.get());
+}
+
+/* static */ std::unique_ptr<OffdeviceIntermediateDict> BinaryDictDecoder::readDictionary(
+        DictionaryStructureWithBufferPolicy *const policy) {
+    std::unique_ptr<OffdeviceIntermediateDict> dict(new OffdeviceIntermediateDict(
+            OffdeviceIntermediateDictHeader(
+                    *policy->getHeaderStructurePolicy()->getAttributeMap())));
+    int codePoints[MAX_WORD_LENGTH];
+    int codePointCount = 0;
+    int token = 0;
+    do {
+        token = policy->getNextWordAndNextToken(token, codePoints, &codePointCount);
+        if (codePointCount == 0) {
+            continue;
+        }
+        const WordProperty wordProperty =
+                policy->getWordProperty(CodePointArrayView(codePoints, codePointCount));
+        if (!dict->addWord(wordProperty)) {
+            fprintf(stderr, "Cannot add a word of the dictionary.\n");
+            return nullptr;
+        }
+    } while (token != 0);
+    return dict;
+}
+
+/* static */ bool BinaryDictDecoder::isBinaryDictionary(const char *const path) {
+    if (FileUtils::existsDir(path)) {
+        // Ver4 dictionaries are directories.
+        return true;
+    }
+    FILE *const file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    uint8_t magicNumber[4];
+    const bool hasMagicNumber = fread(magicNumber, 1, sizeof(magicNumber), file)
+            == sizeof(magicNumber)
+            && ByteArrayUtils::readUint32(magicNumber, 0) == FormatUtils::MAGIC_NUMBER;
+    fclose(file);
+    return hasMagicNumber;
+}
+
+} // namespace dicttoolkit
+} // namespace latinime
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_DICT_TOOLKIT_BINARY_DICT_DECODER_H
+#define LATINIME_DICT_TOOLKIT_BINARY_DICT_DECODER_H
+
+#include <memory>
+
+#include "dict_toolkit_defines.h"
+
+namespace latinime {
+
+class DictionaryStructureWithBufferPolicy;
+
+namespace dicttoolkit {
+
+class OffdeviceIntermediateDict;
+
+// Reads the words of a binary dictionary of any supported version.
+class BinaryDictDecoder final {
+ public:
+    // Returns nullptr when the dictionary cannot be opened.
+    static std::unique_ptr<OffdeviceIntermediateDict> readDictionary(const char *const dictPath);
+    // Beginning-of-sentence entries are skipped because they have no code points.
+    static std::unique_ptr<OffdeviceIntermediateDict> readDictionary(
+            DictionaryStructureWithBufferPolicy *const policy);
+
+    // Returns whether the file is a binary dictionary rather than a combined format file.
+    static bool isBinaryDictionary(const char *const path);
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(BinaryDictDecoder);
+};
+
+} // namespace dicttoolkit
+} // namespace latinime
+#endif // LATINIME_DICT_TOOLKIT_BINARY_DICT_DECODER_H
@@ -0,0 +1,454 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "makedict/combined_format_utils.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dictionary/property/ngram_context.h"
+#include "dictionary/property/ngram_property.h"
+#include "dictionary/property/unigram_property.h"
+#include "dictionary/property/word_property.h"
+#include "offdevice_intermediate_dict/offdevice_intermediate_dict.h"
+#include "utils/int_array_view.h"
+#include "utils/utf8_utils.h"
+
+namespace latinime {
+namespace dicttoolkit {
+
+namespace {
+
+const char *const DICTIONARY_TAG = "dictionary";
+const char *const WORD_TAG = "word";
+const char *const PROBABILITY_TAG = "f";
+const char *const HISTORICAL_INFO_TAG = "historicalInfo";
+const char *const NOT_A_WORD_TAG = "not_a_word";
+const char *const POSSIBLY_OFFENSIVE_TAG = "possibly_offensive";
+const char *const BEGINNING_OF_SENTENCE_TAG = "beginning_of_sentence";
+const char *const SHORTCUT_TAG = "shortcut";
+const char *const BIGRAM_TAG = "bigram";
+const char *const NGRAM_TAG = "ngram";
+const char *const NGRAM_PREV_WORD_TAG = "prev_word";
+const char *const TRUE_VALUE = "true";
+const char *const WHITELIST_VALUE = "whitelist";
+const int WHITELIST_SHORTCUT_PROBABILITY = 15;
+
+using Fields = std::vector<std::pair<std::string, std::string>>;
+
+// Splits "key0=value0,key1=value1" into the pairs.
+Fields parseFields(const std::string &line) {
+    Fields fields;
+    size_t start = 0;
+    while (start <= line.size()) {
+        size_t end = line.find(',', start);
+        if (end == std::string::npos) {
+            end = line.size();
+        }
+        const std::string field = line.substr(start, end - start);
+        const size_t separatorPos = field.find('=');
+        if (separatorPos == std::string::npos) {
+            fields.emplace_back(field, "");
+        } else {
+            fields.emplace_back(field.substr(0, separatorPos), field.substr(separatorPos + 1));
+        }
+        start = end + 1;
+    }
+    return fields;
+}
+
+bool parseInt(const std::string &str, int *const outValue) {
+    if (str.empty()) {
+        return false;
+    }
+    char *end = nullptr;
+    errno = 0;
+    const long value = strtol(str.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0' || value < S_INT_MIN || value > S_INT_MAX) {
+        return false;
+    }
+    *outValue = static_cast<int>(value);
+    return true;
+}
+
+// "timestamp:level:count"
+bool parseHistoricalInfo(const std::string &str, int *const outTimestamp, int *const outLevel,
+        int *const outCount) {
+    const size_t firstSeparatorPos = str.find(':');
+    const size_t secondSeparatorPos = str.find(':', firstSeparatorPos + 1);
+    if (firstSeparatorPos == std::string::npos || secondSeparatorPos == std::string::npos) {
+        return false;
+    }
+    return parseInt(str.substr(0, firstSeparatorPos), outTimestamp)
+            && parseInt(str.substr(firstSeparatorPos + 1,
+                    secondSeparatorPos - firstSeparatorPos - 1), outLevel)
+            && parseInt(str.substr(secondSeparatorPos + 1), outCount);
+}
+
+std::string formatProbabilityInfo(const int probability, const HistoricalInfo &historicalInfo) {
+    std::string str = std::string(PROBABILITY_TAG) + "=" + std::to_string(probability);
+    if (historicalInfo.isValid()) {
+        str += std::string(",") + HISTORICAL_INFO_TAG + "="
+                + std::to_string(historicalInfo.getTimestamp()) + ":"
+                + std::to_string(historicalInfo.getLevel()) + ":"
+                + std::to_string(historicalInfo.getCount());
+    }
+    return str;
+}
+
+// Reads the lines of a combined format file and adds the words to the dictionary. A word is
+// added when the next word starts because its shortcuts and n-grams follow it.
+class CombinedFormatReader {
+ public:
+    CombinedFormatReader()
+            : mDict(), mLineNumber(0), mHasWord(false), mCodePoints(), mProbability(0),
+              mTimestamp(NOT_A_TIMESTAMP), mLevel(0), mCount(0), mIsNotAWord(false),
+              mIsPossiblyOffensive(false), mShortcuts(), mNgrams(), mPrevWords() {}
+
+    std::unique_ptr<OffdeviceIntermediateDict> read(FILE *const file) {
+        char *lineBuffer = nullptr;
+        size_t lineBufferSize = 0;
+        bool succeeded = true;
+        ssize_t lineLength;
+        while (succeeded && (lineLength = getline(&lineBuffer, &lineBufferSize, file)) >= 0) {
+            ++mLineNumber;
+            std::string line(lineBuffer, lineLength);
+            while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
+                line.pop_back();
+            }
+            succeeded = readLine(line);
+        }
+        free(lineBuffer);
+        if (!succeeded || !addWord()) {
+            return nullptr;
+        }
+        if (!mDict) {
+            fprintf(stderr, "The file has no header.\n");
+            return nullptr;
+        }
+        return std::move(mDict);
+    }
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(CombinedFormatReader);
+
+    bool readLine(const std::string &line) {
+        if (line.empty() || line[0] == '#') {
+            return true;
+        }
+        const size_t indent = line.find_first_not_of(' ');
+        if (indent == std::string::npos) {
+            return true;
+        }
+        const Fields fields = parseFields(line.substr(indent));
+        if (!mDict) {
+            return indent == 0 ? readHeader(fields) : printError("The header is missing");
+        }
+        if (indent == 1 && fields[0].first == WORD_TAG) {
+            return addWord() && readWord(fields);
+        }
+        if (indent != 2 || !mHasWord) {
+            return printError("Unexpected line");
+        }
+        if (fields[0].first == SHORTCUT_TAG) {
+            return readShortcut(fields);
+        } else if (fields[0].first == BIGRAM_TAG || fields[0].first == NGRAM_TAG) {
+            return readNgram(fields);
+        } else if (fields[0].first.compare(0, strlen(NGRAM_PREV_WORD_TAG), NGRAM_PREV_WORD_TAG)
+                == 0) {
+            return readPrevWord(fields);
+        }
+        return printError("Unknown entry");
+    }
+
+    bool readHeader(const Fields &fields) {
+        OffdeviceIntermediateDictHeader::AttributeMap attributeMap;
+        for (const auto &field : fields) {
+            if (field.first.empty()) {
+                return printError("Invalid header attribute");
+            }
+            attributeMap[Utf8Utils::getCodePoints(field.first)] =
+                    Utf8Utils::getCodePoints(field.second);
+        }
+        mDict.reset(new OffdeviceIntermediateDict(
+                OffdeviceIntermediateDictHeader(attributeMap)));
+        return true;
+    }
+
+    bool readWord(const Fields &fields) {
+        mCodePoints = Utf8Utils::getCodePoints(fields[0].second);
+        if (mCodePoints.empty() || mCodePoints.size() > MAX_WORD_LENGTH) {
+            return printError("Invalid word");
+        }
+        mHasWord = true;
+        mProbability = NOT_A_PROBABILITY;
+        mTimestamp = NOT_A_TIMESTAMP;
+        mLevel = 0;
+        mCount = 0;
+        mIsNotAWord = false;
+        mIsPossiblyOffensive = false;
+        bool representsBeginningOfSentence = false;
+        for (size_t i = 1; i < fields.size(); ++i) {
+            const std::string &key = fields[i].first;
+            const std::string &value = fields[i].second;
+            if (key == NOT_A_WORD_TAG) {
+                mIsNotAWord = value == TRUE_VALUE;
+            } else if (key == POSSIBLY_OFFENSIVE_TAG) {
+                mIsPossiblyOffensive = value == TRUE_VALUE;
+            } else if (key == BEGINNING_OF_SENTENCE_TAG) {
+                representsBeginningOfSentence = value == TRUE_VALUE;
+            } else if (!readProbabilityInfo(key, value, &mProbability, &mTimestamp, &mLevel,
+                    &mCount)) {
+                return false;
+            }
+        }
+        if (representsBeginningOfSentence) {
+            return printError("Beginning-of-sentence entries are not supported");
+        }
+        if (mProbability == NOT_A_PROBABILITY) {
+            return printError("The probability is missing");
+        }
+        return true;
+    }
+
+    bool readShortcut(const Fields &fields) {
+        std::vector<int> targetCodePoints = Utf8Utils::getCodePoints(fields[0].second);
+        if (targetCodePoints.empty() || targetCodePoints.size() > MAX_WORD_LENGTH) {
+            return printError("Invalid shortcut target");
+        }
+        int probability = NOT_A_PROBABILITY;
+        for (size_t i = 1; i < fields.size(); ++i) {
+            if (fields[i].first != PROBABILITY_TAG) {
+                // Ignore the other attributes as the Java tools do.
+                continue;
+            }
+            if (fields[i].second == WHITELIST_VALUE) {
+                probability = WHITELIST_SHORTCUT_PROBABILITY;
+            } else if (!parseInt(fields[i].second, &probability)) {
+                return printError("Invalid probability");
+            }
+        }
+        if (probability == NOT_A_PROBABILITY) {
+            return printError("The probability is missing");
+        }
+        mShortcuts.emplace_back(std::move(targetCodePoints), probability);
+        return true;
+    }
+
+    bool readPrevWord(const Fields &fields) {
+        // prev_word[n] is the (n + 1)-th previous word of the n-gram that follows.
+        const std::string &key = fields[0].first;
+        int n = 0;
+        if (key.size() < strlen(NGRAM_PREV_WORD_TAG) + 3 || key[strlen(NGRAM_PREV_WORD_TAG)] != '['
+                || key.back() != ']'
+                || !parseInt(key.substr(strlen(NGRAM_PREV_WORD_TAG) + 1,
+                        key.size() - strlen(NGRAM_PREV_WORD_TAG) - 2), &n)
+                || n < 1 || n >= MAX_PREV_WORD_COUNT_FOR_N_GRAM) {
+            return printError("Invalid previous word");
+        }
+        const std::vector<int> codePoints = Utf8Utils::getCodePoints(fields[0].second);
+        bool isBeginningOfSentence = false;
+        for (size_t i = 1; i < fields.size(); ++i) {
+            if (fields[i].first == BEGINNING_OF_SENTENCE_TAG) {
+                isBeginningOfSentence = fields[i].second == TRUE_VALUE;
+            }
+        }
+        if (codePoints.size() > MAX_WORD_LENGTH
+                || (codePoints.empty() && !isBeginningOfSentence)) {
+            return printError("Invalid previous word");
+        }
+        if (mPrevWords.size() < static_cast<size_t>(n)) {
+            mPrevWords.resize(n);
+        }
+        mPrevWords[n - 1] = std::make_pair(codePoints, isBeginningOfSentence);
+        return true;
+    }
+
+    bool readNgram(const Fields &fields) {
+        std::vector<int> targetCodePoints = Utf8Utils::getCodePoints(fields[0].second);
+        if (targetCodePoints.empty() || targetCodePoints.size() > MAX_WORD_LENGTH) {
+            return printError("Invalid n-gram target");
+        }
+        int probability = NOT_A_PROBABILITY;
+        int timestamp = NOT_A_TIMESTAMP;
+        int level = 0;
+        int count = 0;
+        for (size_t i = 1; i < fields.size(); ++i) {
+            if (!readProbabilityInfo(fields[i].first, fields[i].second, &probability, &timestamp,
+                    &level, &count)) {
+                return false;
+            }
+        }
+        if (probability == NOT_A_PROBABILITY) {
+            return printError("The probability is missing");
+        }
+        // The word is the first previous word of its n-grams.
+        int prevWordCodePoints[MAX_PREV_WORD_COUNT_FOR_N_GRAM][MAX_WORD_LENGTH];
+        int prevWordCodePointCounts[MAX_PREV_WORD_COUNT_FOR_N_GRAM];
+        bool isBeginningOfSentence[MAX_PREV_WORD_COUNT_FOR_N_GRAM];
+        const size_t prevWordCount = mPrevWords.size() + 1;
+        for (size_t i = 0; i < prevWordCount; ++i) {
+            const std::vector<int> &codePoints = i == 0 ? mCodePoints : mPrevWords[i - 1].first;
+            std::copy(codePoints.begin(), codePoints.end(), prevWordCodePoints[i]);
+            prevWordCodePointCounts[i] = static_cast<int>(codePoints.size());
+            isBeginningOfSentence[i] = i == 0 ? false : mPrevWords[i - 1].second;
+        }
+        mPrevWords.clear();
+        mNgrams.emplace_back(NgramContext(prevWordCodePoints, prevWordCodePointCounts,
+                isBeginningOfSentence, prevWordCount), std::move(targetCodePoints), probability,
+                HistoricalInfo(timestamp, level, count));
+        return true;
+    }
+
+    bool readProbabilityInfo(const std::string &key, const std::string &value,
+            int *const outProbability, int *const outTimestamp, int *const outLevel,
+            int *const outCount) {
+        if (key == PROBABILITY_TAG) {
+            if (!parseInt(value, outProbability) || *outProbability < 0) {
+                return printError("Invalid probability");
+            }
+        } else if (key == HISTORICAL_INFO_TAG) {
+            if (!parseHistoricalInfo(value, outTimestamp, outLevel, outCount)) {
+                return printError("Invalid historical info");
+            }
+        }
+        // Other attributes, e.g. "originalFreq", are ignored as the Java tools do.
+        return true;
+    }
+
+    bool addWord() {
+        if (!mHasWord) {
+            return true;
+        }
+        mHasWord = false;
+        const std::string word = Utf8Utils::getUtf8String(CodePointArrayView(mCodePoints));
+        const WordProperty wordProperty(std::move(mCodePoints),
+                UnigramProperty(false /* representsBeginningOfSentence */, mIsNotAWord,
+                        mIsPossiblyOffensive, mProbability,
+                        HistoricalInfo(mTimestamp, mLevel, mCount),
+                        std::move(mShortcuts)), mNgrams);
+        mCodePoints.clear();
+        mShortcuts.clear();
+        mNgrams.clear();
+        mPrevWords.clear();
+        if (!mDict->addWord(wordProperty)) {
+            fprintf(stderr, "Cannot add the word \"%s\". It may be duplicated.\n", word.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool printError(const char *const message) const {
+        fprintf(stderr, "%s at line %d.\n", message, mLineNumber);
+        return false;
+    }
+
+    std::unique_ptr<OffdeviceIntermediateDict> mDict;
+    int mLineNumber;
+    // The word being read.
+    bool mHasWord;
+    std::vector<int> mCodePoints;
+    int mProbability;
+    int mTimestamp;
+    int mLevel;
+    int mCount;
+    bool mIsNotAWord;
+    bool mIsPossiblyOffensive;
+    std::vector<UnigramProperty::ShortcutProperty> mShortcuts;
+    std::vector<NgramProperty> mNgrams;
+    // The previous words of the next n-gram except the word itself.
+    std::vector<std::pair<std::vector<int>, bool>> mPrevWords;
+};
+
+} // namespace
+
+/* static */ std::unique_ptr<OffdeviceIntermediateDict> CombinedFormatUtils::readDictionary(
+        FILE *const file) {
+    CombinedFormatReader reader;
+    return reader.read(file);
+}
+
+/* static */ bool CombinedFormatUtils::writeDictionary(const OffdeviceIntermediateDict &dict,
+        FILE *const file) {
+    const OffdeviceIntermediateDictHeader::AttributeMap &attributeMap =
+            dict.getHeader().getAttributeMap();
+    const std::vector<int> dictionaryKey = Utf8Utils::getCodePoints(DICTIONARY_TAG);
+    std::string headerLine;
+    // The dictionary attribute comes first.
+    const auto dictionaryIt = attributeMap.find(dictionaryKey);
+    if (dictionaryIt != attributeMap.end()) {
+        headerLine = std::string(DICTIONARY_TAG) + "="
+                + Utf8Utils::getUtf8String(CodePointArrayView(dictionaryIt->second));
+    }
+    for (const auto &attribute : attributeMap) {
+        if (attribute.first == dictionaryKey) {
+            continue;
+        }
+        if (!headerLine.empty()) {
+            headerLine += ",";
+        }
+        headerLine += Utf8Utils::getUtf8String(CodePointArrayView(attribute.first)) + "="
+                + Utf8Utils::getUtf8String(CodePointArrayView(attribute.second));
+    }
+    fprintf(file, "%s\n", headerLine.c_str());
+    for (const WordProperty *const wordProperty : dict.getWordProperties()) {
+        const UnigramProperty &unigramProperty = wordProperty->getUnigramProperty();
+        std::string wordLine = std::string(" ") + WORD_TAG + "="
+                + Utf8Utils::getUtf8String(wordProperty->getCodePoints()) + ","
+                + formatProbabilityInfo(unigramProperty.getProbability(),
+                        unigramProperty.getHistoricalInfo());
+        if (unigramProperty.isNotAWord()) {
+            wordLine += std::string(",") + NOT_A_WORD_TAG + "=" + TRUE_VALUE;
+        }
+        if (unigramProperty.isPossiblyOffensive()) {
+            wordLine += std::string(",") + POSSIBLY_OFFENSIVE_TAG + "=" + TRUE_VALUE;
+        }
+        fprintf(file, "%s\n", wordLine.c_str());
+        for (const auto &shortcut : unigramProperty.getShortcuts()) {
+            fprintf(file, "  %s=%s,%s=%d\n", SHORTCUT_TAG,
+                    Utf8Utils::getUtf8String(CodePointArrayView(
+                            *shortcut.getTargetCodePoints())).c_str(),
+                    PROBABILITY_TAG, shortcut.getProbability());
+        }
+        for (const auto &ngramProperty : wordProperty->getNgramProperties()) {
+            const NgramContext *const ngramContext = ngramProperty.getNgramContext();
+            // The first previous word is the word itself.
+            for (size_t n = 2; n <= ngramContext->getPrevWordCount(); ++n) {
+                std::string prevWordLine = std::string("  ") + NGRAM_PREV_WORD_TAG + "["
+                        + std::to_string(n - 1) + "]="
+                        + Utf8Utils::getUtf8String(ngramContext->getNthPrevWordCodePoints(n));
+                if (ngramContext->isNthPrevWordBeginningOfSentence(n)) {
+                    prevWordLine +=
+                            std::string(",") + BEGINNING_OF_SENTENCE_TAG + "=" + TRUE_VALUE;
+                }
+                fprintf(file, "%s\n", prevWordLine.c_str());
+            }
+            fprintf(file, "  %s=%s,%s\n", NGRAM_TAG,
+                    Utf8Utils::getUtf8String(CodePointArrayView(
+                            *ngramProperty.getTargetCodePoints())).c_str(),
+                    formatProbabilityInfo(ngramProperty.getProbability(),
+                            ngramProperty.getHistoricalInfo()).c_str());
+        }
+    }
+    return !ferror(file);
+}
+
+} // namespace dicttoolkit
+} // namespace latinime
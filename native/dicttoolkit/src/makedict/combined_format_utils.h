@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_DICT_TOOLKIT_COMBINED_FORMAT_UTILS_H
+#define LATINIME_DICT_TOOLKIT_COMBINED_FORMAT_UTILS_H
+
+#include <cstdio>
+#include <memory>
+
+#include "dict_toolkit_defines.h"
+
+namespace latinime {
+namespace dicttoolkit {
+
+class OffdeviceIntermediateDict;
+
+/**
+ * Reads and writes the combined format, the text format of the word lists.
+ *
+ * The first line has the header attributes, e.g. "dictionary=main:en,locale=en,version=1".
+ * Each word is on a line indented by one space, e.g. " word=hello,f=200,not_a_word=true", and
+ * is followed by its shortcuts and n-grams on lines indented by two spaces:
+ * "  shortcut=hi,f=10" ("f=whitelist" for whitelisted shortcuts), "  bigram=world,f=120" and
+ * "  ngram=you,f=100" preceded by "  prev_word[1]=thank" for each additional previous word.
+ * Lines starting with '#' are comments.
+ */
+class CombinedFormatUtils final {
+ public:
+    // Returns nullptr after printing an error message when the file is broken.
+    static std::unique_ptr<OffdeviceIntermediateDict> readDictionary(FILE *const file);
+    static bool writeDictionary(const OffdeviceIntermediateDict &dict, FILE *const file);
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(CombinedFormatUtils);
+};
+
+} // namespace dicttoolkit
+} // namespace latinime
+#endif // LATINIME_DICT_TOOLKIT_COMBINED_FORMAT_UTILS_H
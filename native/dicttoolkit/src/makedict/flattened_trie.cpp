@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "makedict/flattened_trie.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "offdevice_intermediate_dict/offdevice_intermediate_dict.h"
+#include "offdevice_intermediate_dict/offdevice_intermediate_dict_pt_node.h"
+
+namespace latinime {
+namespace dicttoolkit {
+
+FlattenedTrie::FlattenedTrie(const OffdeviceIntermediateDict &dict, const int threadCount)
+        : mCodePoints(), mPtNodes(), mPtNodeArrays() {
+    std::vector<int> subtreeRoots;
+    addPtNodeArray(dict, dict.getRootPtNodeIndex(), &subtreeRoots);
+    // Each thread takes the next subtree and flattens it into its own instance. The subtrees are
+    // appended in order at the end so that the output doesn't depend on the thread count.
+    std::vector<std::unique_ptr<FlattenedTrie>> subtrees(subtreeRoots.size());
+    std::atomic<size_t> nextSubtreeIndex(0);
+    const auto flattenSubtrees = [&]() {
+        for (size_t i = nextSubtreeIndex++; i < subtreeRoots.size(); i = nextSubtreeIndex++) {
+            if (subtreeRoots[i] != NOT_AN_INDEX) {
+                subtrees[i].reset(new FlattenedTrie());
+                subtrees[i]->addSubtree(dict, subtreeRoots[i]);
+            }
+        }
+    };
+    const int workerCount = std::max(1, std::min(threadCount,
+            static_cast<int>(subtreeRoots.size())));
+    std::vector<std::thread> threads;
+    // The calling thread works as the first worker.
+    for (int i = 1; i < workerCount; ++i) {
+        threads.emplace_back(flattenSubtrees);
+    }
+    flattenSubtrees();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < subtrees.size(); ++i) {
+        if (subtrees[i]) {
+            mPtNodes[i].mChildrenPtNodeArrayIndex = static_cast<int>(mPtNodeArrays.size());
+            appendSubtree(*subtrees[i]);
+        }
+    }
+}
+
+int FlattenedTrie::getTerminalPtNodeIndex(const CodePointArrayView codePoints) const {
+    if (codePoints.empty() || mPtNodeArrays.empty()) {
+        return NOT_AN_INDEX;
+    }
+    int ptNodeArrayIndex = 0;
+    size_t matchedCodePointCount = 0;
+    while (ptNodeArrayIndex != NOT_AN_INDEX) {
+        const PtNodeArray &ptNodeArray = mPtNodeArrays[ptNodeArrayIndex];
+        ptNodeArrayIndex = NOT_AN_INDEX;
+        for (int i = 0; i < ptNodeArray.mPtNodeCount; ++i) {
+            const int ptNodeIndex = ptNodeArray.mFirstPtNodeIndex + i;
+            const CodePointArrayView ptNodeCodePoints = getPtNodeCodePoints(mPtNodes[ptNodeIndex]);
+            if (ptNodeCodePoints[0] != codePoints[matchedCodePointCount]) {
+                continue;
+            }
+            const CodePointArrayView remainingCodePoints = codePoints.skip(matchedCodePointCount);
+            if (remainingCodePoints.size() < ptNodeCodePoints.size()
+                    || !std::equal(ptNodeCodePoints.begin(), ptNodeCodePoints.end(),
+                            remainingCodePoints.begin())) {
+                return NOT_AN_INDEX;
+            }
+            matchedCodePointCount += ptNodeCodePoints.size();
+            if (matchedCodePointCount == codePoints.size()) {
+                return mPtNodes[ptNodeIndex].mWordProperty ? ptNodeIndex : NOT_AN_INDEX;
+            }
+            ptNodeArrayIndex = mPtNodes[ptNodeIndex].mChildrenPtNodeArrayIndex;
+            break;
+        }
+    }
+    return NOT_AN_INDEX;
+}
+
+int FlattenedTrie::addPtNodeArray(const OffdeviceIntermediateDict &dict,
+        const int firstPtNodeIndex, std::vector<int> *const outFirstChildPtNodeIndices) {
+    const int ptNodeArrayIndex = static_cast<int>(mPtNodeArrays.size());
+    const int firstFlattenedPtNodeIndex = static_cast<int>(mPtNodes.size());
+    for (int ptNodeIndex = firstPtNodeIndex; ptNodeIndex != NOT_AN_INDEX;
+            ptNodeIndex = dict.getPtNode(ptNodeIndex).getNextSiblingPtNodeIndex()) {
+        const int codePointStart = static_cast<int>(mCodePoints.size());
+        const OffdeviceIntermediateDictPtNode *ptNode = &dict.getPtNode(ptNodeIndex);
+        const CodePointArrayView codePoints = dict.getPtNodeCodePoints(*ptNode);
+        mCodePoints.insert(mCodePoints.end(), codePoints.begin(), codePoints.end());
+        // Non-terminal PtNodes with a single child are merged with the child.
+        while (ptNode->getWordPropertyIndex() == NOT_AN_INDEX
+                && ptNode->getFirstChildPtNodeIndex() != NOT_AN_INDEX
+                && dict.getPtNode(ptNode->getFirstChildPtNodeIndex())
+                        .getNextSiblingPtNodeIndex() == NOT_AN_INDEX) {
+            ptNode = &dict.getPtNode(ptNode->getFirstChildPtNodeIndex());
+            const CodePointArrayView childCodePoints = dict.getPtNodeCodePoints(*ptNode);
+            mCodePoints.insert(mCodePoints.end(), childCodePoints.begin(), childCodePoints.end());
+        }
+        mPtNodes.emplace_back(codePointStart,
+                static_cast<int>(mCodePoints.size()) - codePointStart,
+                dict.getPtNodeWordProperty(*ptNode));
+        outFirstChildPtNodeIndices->push_back(ptNode->getFirstChildPtNodeIndex());
+    }
+    mPtNodeArrays.emplace_back(firstFlattenedPtNodeIndex,
+            static_cast<int>(mPtNodes.size()) - firstFlattenedPtNodeIndex);
+    return ptNodeArrayIndex;
+}
+
+int FlattenedTrie::addSubtree(const OffdeviceIntermediateDict &dict, const int firstPtNodeIndex) {
+    std::vector<int> firstChildPtNodeIndices;
+    const int ptNodeArrayIndex = addPtNodeArray(dict, firstPtNodeIndex, &firstChildPtNodeIndices);
+    const int firstFlattenedPtNodeIndex = mPtNodeArrays[ptNodeArrayIndex].mFirstPtNodeIndex;
+    for (size_t i = 0; i < firstChildPtNodeIndices.size(); ++i) {
+        if (firstChildPtNodeIndices[i] != NOT_AN_INDEX) {
+            // mPtNodes may be reallocated while the children are added.
+            const int childrenPtNodeArrayIndex = addSubtree(dict, firstChildPtNodeIndices[i]);
+            mPtNodes[firstFlattenedPtNodeIndex + i].mChildrenPtNodeArrayIndex =
+                    childrenPtNodeArrayIndex;
+        }
+    }
+    return ptNodeArrayIndex;
+}
+
+void FlattenedTrie::appendSubtree(const FlattenedTrie &subtree) {
+    const int codePointOffset = static_cast<int>(mCodePoints.size());
+    const int ptNodeOffset = static_cast<int>(mPtNodes.size());
+    const int ptNodeArrayOffset = static_cast<int>(mPtNodeArrays.size());
+    mCodePoints.insert(mCodePoints.end(), subtree.mCodePoints.begin(), subtree.mCodePoints.end());
+    for (const PtNode &ptNode : subtree.mPtNodes) {
+        mPtNodes.push_back(ptNode);
+        mPtNodes.back().mCodePointStart += codePointOffset;
+        if (ptNode.mChildrenPtNodeArrayIndex != NOT_AN_INDEX) {
+            mPtNodes.back().mChildrenPtNodeArrayIndex += ptNodeArrayOffset;
+        }
+    }
+    for (const PtNodeArray &ptNodeArray : subtree.mPtNodeArrays) {
+        mPtNodeArrays.push_back(ptNodeArray);
+        mPtNodeArrays.back().mFirstPtNodeIndex += ptNodeOffset;
+    }
+}
+
+} // namespace dicttoolkit
+} // namespace latinime
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_DICT_TOOLKIT_FLATTENED_TRIE_H
+#define LATINIME_DICT_TOOLKIT_FLATTENED_TRIE_H
+
+#include <vector>
+
+#include "dict_toolkit_defines.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+
+class WordProperty;
+
+namespace dicttoolkit {
+
+class OffdeviceIntermediateDict;
+
+/**
+ * Flat copy of the patricia trie of an OffdeviceIntermediateDict to be encoded. PtNodes and
+ * PtNode arrays are stored in vectors and refer to each other by index, and the code points of
+ * all PtNodes are stored in a single buffer. Non-terminal PtNodes that have only one child are
+ * merged with the child.
+ *
+ * PtNode arrays are stored in depth-first order: each array is followed by the subtrees of its
+ * PtNodes. Every subtree is contiguous, which the ver2 format requires to find the word of a
+ * terminal PtNode from its position. PtNodes in an array are sorted by their first code points.
+ */
+class FlattenedTrie final {
+ public:
+    struct PtNode {
+        PtNode(const int codePointStart, const int codePointCount,
+                const WordProperty *const wordProperty)
+                : mCodePointStart(codePointStart), mCodePointCount(codePointCount),
+                  mChildrenPtNodeArrayIndex(NOT_AN_INDEX), mWordProperty(wordProperty) {}
+
+        int mCodePointStart;
+        int mCodePointCount;
+        int mChildrenPtNodeArrayIndex;
+        // nullptr for non-terminal PtNodes.
+        const WordProperty *mWordProperty;
+    };
+
+    struct PtNodeArray {
+        PtNodeArray(const int firstPtNodeIndex, const int ptNodeCount)
+                : mFirstPtNodeIndex(firstPtNodeIndex), mPtNodeCount(ptNodeCount) {}
+
+        int mFirstPtNodeIndex;
+        int mPtNodeCount;
+    };
+
+    // The subtrees of the root PtNodes are flattened by threadCount threads. The dictionary must
+    // not be modified while this instance is used.
+    FlattenedTrie(const OffdeviceIntermediateDict &dict, const int threadCount);
+
+    const std::vector<PtNode> &getPtNodes() const { return mPtNodes; }
+    // The first array is the root PtNode array.
+    const std::vector<PtNodeArray> &getPtNodeArrays() const { return mPtNodeArrays; }
+
+    const CodePointArrayView getPtNodeCodePoints(const PtNode &ptNode) const {
+        return CodePointArrayView(mCodePoints).skip(ptNode.mCodePointStart)
+                .limit(ptNode.mCodePointCount);
+    }
+
+    // Returns NOT_AN_INDEX when the word is not in the trie.
+    int getTerminalPtNodeIndex(const CodePointArrayView codePoints) const;
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(FlattenedTrie);
+
+    // For the subtrees flattened by each thread.
+    FlattenedTrie() : mCodePoints(), mPtNodes(), mPtNodeArrays() {}
+
+    // Adds the PtNodes of the array starting at firstPtNodeIndex in the dictionary. The first
+    // children of the merged PtNodes are added to outFirstChildPtNodeIndices; NOT_AN_INDEX for
+    // PtNodes without children.
+    int addPtNodeArray(const OffdeviceIntermediateDict &dict, const int firstPtNodeIndex,
+            std::vector<int> *const outFirstChildPtNodeIndices);
+    int addSubtree(const OffdeviceIntermediateDict &dict, const int firstPtNodeIndex);
+    void appendSubtree(const FlattenedTrie &subtree);
+
+    std::vector<int> mCodePoints;
+    std::vector<PtNode> mPtNodes;
+    std::vector<PtNodeArray> mPtNodeArrays;
+};
+
+} // namespace dicttoolkit
+} // namespace latinime
+#endif // LATINIME_DICT_TOOLKIT_FLATTENED_TRIE_H
@@ -0,0 +1,557 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "makedict/ver2_dict_encoder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "dictionary/header/header_read_write_utils.h"
+#include "dictionary/property/ngram_property.h"
+#include "dictionary/property/word_property.h"
+#include "dictionary/structure/pt_common/patricia_trie_reading_utils.h"
+#include "dictionary/utils/byte_array_utils.h"
+#include "dictionary/utils/format_utils.h"
+#include "dictionary/utils/probability_utils.h"
+#include "makedict/flattened_trie.h"
+#include "offdevice_intermediate_dict/offdevice_intermediate_dict.h"
+
+namespace latinime {
+namespace dicttoolkit {
+
+namespace {
+
+const int MINIMUM_ONE_BYTE_CHARACTER_VALUE = 0x20;
+const int MAXIMUM_ONE_BYTE_CHARACTER_VALUE = 0xFF;
+const int CHARACTER_ARRAY_TERMINATOR = 0x1F;
+const int MAGIC_NUMBER_SIZE = 4;
+const int VERSION_SIZE = 2;
+const int FLAGS_SIZE = 2;
+const int HEADER_SIZE_FIELD_SIZE = 4;
+const char *const CODE_POINT_TABLE_KEY = "codePointTable";
+
+// Calls function(begin, end) for consecutive ranges of [0, count) on threadCount threads.
+template<typename Function>
+void runInParallel(const int count, const int threadCount, const Function &function) {
+    const int workerCount = std::max(1, std::min(threadCount, count));
+    const int rangeSize = (count + workerCount - 1) / workerCount;
+    std::vector<std::thread> threads;
+    for (int i = 1; i < workerCount; ++i) {
+        threads.emplace_back(function, std::min(count, i * rangeSize),
+                std::min(count, (i + 1) * rangeSize));
+    }
+    // The calling thread works on the first range.
+    function(0, std::min(count, rangeSize));
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+int clampProbability(const int probability) {
+    return std::min(std::max(probability, 0), MAX_PROBABILITY);
+}
+
+int getCodePointSizeWithoutTable(const int codePoint) {
+    return (codePoint < MINIMUM_ONE_BYTE_CHARACTER_VALUE
+            || codePoint > MAXIMUM_ONE_BYTE_CHARACTER_VALUE) ? 3 : 1;
+}
+
+int getStringSizeWithoutTable(const std::vector<int> &codePoints) {
+    int size = 1 /* terminator */;
+    for (const int codePoint : codePoints) {
+        size += getCodePointSizeWithoutTable(codePoint);
+    }
+    return size;
+}
+
+} // namespace
+
+const int Ver2DictEncoder::MAX_CODE_POINT_TABLE_SIZE =
+        MAXIMUM_ONE_BYTE_CHARACTER_VALUE - MINIMUM_ONE_BYTE_CHARACTER_VALUE + 1;
+const int Ver2DictEncoder::MAX_PT_NODE_ARRAY_SIZE = 0x7FFF;
+const int Ver2DictEncoder::MAX_ONE_BYTE_PT_NODE_ARRAY_SIZE = 0x7F;
+const int Ver2DictEncoder::MAX_OFFSET = 0xFFFFFF;
+const int Ver2DictEncoder::SHORTCUT_LIST_SIZE_FIELD_SIZE = 2;
+const int Ver2DictEncoder::MAX_SHORTCUT_LIST_SIZE = 0xFFFF;
+const uint8_t Ver2DictEncoder::FLAG_ATTRIBUTE_HAS_NEXT = 0x80;
+const uint8_t Ver2DictEncoder::FLAG_BIGRAM_OFFSET_NEGATIVE = 0x40;
+const uint8_t Ver2DictEncoder::FLAG_BIGRAM_ADDRESS_TYPE_ONEBYTE = 0x10;
+const uint8_t Ver2DictEncoder::MASK_ATTRIBUTE_PROBABILITY = 0x0F;
+
+// The fields of the PtNodes of a FlattenedTrie. The PtNodes are stored in the order of their
+// indices; each PtNode array is preceded by its PtNode count.
+class Ver2DictEncoder::PtNodeLayout {
+ public:
+    PtNodeLayout(const FlattenedTrie &trie, const std::vector<int> &codePointTable)
+            : mTrie(trie), mCodePointTableIndices(), mPtNodeInfos(), mBigramInfos(),
+              mPtNodeArrayPositions(trie.getPtNodeArrays().size(), 0), mBodySize(0) {
+        for (size_t i = 0; i < codePointTable.size(); ++i) {
+            mCodePointTableIndices[codePointTable[i]] = static_cast<int>(i);
+        }
+        mPtNodeInfos.resize(trie.getPtNodes().size());
+        mBigramInfos.resize(trie.getPtNodes().size());
+    }
+
+    // Computes the fields that don't depend on the positions and starts with the largest
+    // position fields.
+    bool initPtNodes(const int begin, const int end) {
+        for (int i = begin; i < end; ++i) {
+            const FlattenedTrie::PtNode &ptNode = mTrie.getPtNodes()[i];
+            PtNodeInfo &info = mPtNodeInfos[i];
+            for (const int codePoint : mTrie.getPtNodeCodePoints(ptNode)) {
+                info.mCodePointsSize += getCodePointSize(codePoint);
+            }
+            if (ptNode.mCodePointCount > 1) {
+                info.mCodePointsSize += 1 /* terminator */;
+            }
+            info.mChildrenFieldSize =
+                    ptNode.mChildrenPtNodeArrayIndex == NOT_AN_INDEX ? 0 : 3;
+            // The size with the largest position fields.
+            info.mSize = 1 /* flags */ + info.mCodePointsSize + info.mChildrenFieldSize;
+            if (!ptNode.mWordProperty) {
+                continue;
+            }
+            info.mProbability =
+                    clampProbability(ptNode.mWordProperty->getUnigramProperty().getProbability());
+            const auto &shortcuts = ptNode.mWordProperty->getUnigramProperty().getShortcuts();
+            if (!shortcuts.empty()) {
+                info.mShortcutListSize = SHORTCUT_LIST_SIZE_FIELD_SIZE;
+                for (const auto &shortcut : shortcuts) {
+                    info.mShortcutListSize += 1 /* flags */
+                            + getStringSizeWithoutTable(*shortcut.getTargetCodePoints());
+                }
+                if (info.mShortcutListSize > MAX_SHORTCUT_LIST_SIZE) {
+                    return false;
+                }
+            }
+            for (const auto &ngramProperty : ptNode.mWordProperty->getNgramProperties()) {
+                // Ver2 dictionaries only have bigrams and no beginning-of-sentence context.
+                const NgramContext *const ngramContext = ngramProperty.getNgramContext();
+                if (ngramContext->getPrevWordCount() != 1
+                        || ngramContext->isNthPrevWordBeginningOfSentence(1 /* n */)) {
+                    continue;
+                }
+                const int targetPtNodeIndex = mTrie.getTerminalPtNodeIndex(
+                        CodePointArrayView(*ngramProperty.getTargetCodePoints()));
+                if (targetPtNodeIndex == NOT_AN_INDEX) {
+                    continue;
+                }
+                const int targetProbability = clampProbability(mTrie.getPtNodes()[
+                        targetPtNodeIndex].mWordProperty->getUnigramProperty().getProbability());
+                mBigramInfos[i].emplace_back(targetPtNodeIndex,
+                        encodeBigramProbability(targetProbability,
+                                clampProbability(ngramProperty.getProbability())));
+            }
+            info.mSize += 1 /* probability */ + info.mShortcutListSize
+                    + static_cast<int>(mBigramInfos[i].size()) * (1 /* flags */ + 3);
+        }
+        return true;
+    }
+
+    void computePositions() {
+        int pos = 0;
+        int ptNodeIndex = 0;
+        const auto &ptNodeArrays = mTrie.getPtNodeArrays();
+        for (size_t i = 0; i < ptNodeArrays.size(); ++i) {
+            mPtNodeArrayPositions[i] = pos;
+            pos += ptNodeArrays[i].mPtNodeCount > MAX_ONE_BYTE_PT_NODE_ARRAY_SIZE ? 2 : 1;
+            // The PtNodes of the arrays are consecutive in the order of the arrays.
+            for (int j = 0; j < ptNodeArrays[i].mPtNodeCount; ++j, ++ptNodeIndex) {
+                mPtNodeInfos[ptNodeIndex].mPos = pos;
+                pos += mPtNodeInfos[ptNodeIndex].mSize;
+            }
+        }
+        mBodySize = pos;
+    }
+
+    // Recomputes the sizes of the position fields from the current positions. Returns whether a
+    // size has changed.
+    bool updateFieldSizes(const int begin, const int end) {
+        bool updated = false;
+        for (int i = begin; i < end; ++i) {
+            const FlattenedTrie::PtNode &ptNode = mTrie.getPtNodes()[i];
+            PtNodeInfo &info = mPtNodeInfos[i];
+            int pos = info.mPos + 1 /* flags */ + info.mCodePointsSize
+                    + (ptNode.mWordProperty ? 1 : 0);
+            if (ptNode.mChildrenPtNodeArrayIndex != NOT_AN_INDEX) {
+                const int childrenFieldSize = getFieldSizeForOffset(
+                        mPtNodeArrayPositions[ptNode.mChildrenPtNodeArrayIndex] - pos);
+                updated |= childrenFieldSize != info.mChildrenFieldSize;
+                info.mChildrenFieldSize = childrenFieldSize;
+            }
+            pos += info.mChildrenFieldSize + info.mShortcutListSize;
+            for (BigramInfo &bigramInfo : mBigramInfos[i]) {
+                const int addressPos = pos + 1 /* flags */;
+                const int addressSize = getFieldSizeForOffset(
+                        mPtNodeInfos[bigramInfo.mTargetPtNodeIndex].mPos - addressPos);
+                updated |= addressSize != bigramInfo.mAddressSize;
+                bigramInfo.mAddressSize = addressSize;
+                pos = addressPos + addressSize;
+            }
+            const int size = pos - info.mPos;
+            updated |= size != info.mSize;
+            info.mSize = size;
+        }
+        return updated;
+    }
+
+    bool hasValidOffsets() const {
+        for (size_t i = 0; i < mPtNodeInfos.size(); ++i) {
+            if (mPtNodeInfos[i].mChildrenFieldSize > 3) {
+                return false;
+            }
+            for (const BigramInfo &bigramInfo : mBigramInfos[i]) {
+                if (bigramInfo.mAddressSize > 3) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void writePtNodeArraySizes(uint8_t *const body) const {
+        const auto &ptNodeArrays = mTrie.getPtNodeArrays();
+        for (size_t i = 0; i < ptNodeArrays.size(); ++i) {
+            int pos = mPtNodeArrayPositions[i];
+            const int ptNodeCount = ptNodeArrays[i].mPtNodeCount;
+            if (ptNodeCount > MAX_ONE_BYTE_PT_NODE_ARRAY_SIZE) {
+                ByteArrayUtils::writeUintAndAdvancePosition(body, ptNodeCount | 0x8000, 2, &pos);
+            } else {
+                ByteArrayUtils::writeUintAndAdvancePosition(body, ptNodeCount, 1, &pos);
+            }
+        }
+    }
+
+    void writePtNodes(const int begin, const int end, uint8_t *const body) const {
+        for (int i = begin; i < end; ++i) {
+            const FlattenedTrie::PtNode &ptNode = mTrie.getPtNodes()[i];
+            const PtNodeInfo &info = mPtNodeInfos[i];
+            const WordProperty *const wordProperty = ptNode.mWordProperty;
+            const UnigramProperty *const unigramProperty =
+                    wordProperty ? &wordProperty->getUnigramProperty() : nullptr;
+            const CodePointArrayView codePoints = mTrie.getPtNodeCodePoints(ptNode);
+            const std::vector<BigramInfo> &bigramInfos = mBigramInfos[i];
+            int pos = info.mPos;
+            ByteArrayUtils::writeUintAndAdvancePosition(body,
+                    PatriciaTrieReadingUtils::createAndGetFlags(
+                            unigramProperty && unigramProperty->isPossiblyOffensive(),
+                            unigramProperty && unigramProperty->isNotAWord(),
+                            unigramProperty != nullptr, info.mShortcutListSize > 0,
+                            !bigramInfos.empty(), codePoints.size() > 1,
+                            info.mChildrenFieldSize), 1, &pos);
+            for (const int codePoint : codePoints) {
+                writeCodePoint(codePoint, body, &pos);
+            }
+            if (codePoints.size() > 1) {
+                ByteArrayUtils::writeUintAndAdvancePosition(body, CHARACTER_ARRAY_TERMINATOR, 1,
+                        &pos);
+            }
+            if (wordProperty) {
+                ByteArrayUtils::writeUintAndAdvancePosition(body, info.mProbability, 1, &pos);
+            }
+            if (info.mChildrenFieldSize > 0) {
+                ByteArrayUtils::writeUintAndAdvancePosition(body,
+                        mPtNodeArrayPositions[ptNode.mChildrenPtNodeArrayIndex] - pos,
+                        info.mChildrenFieldSize, &pos);
+            }
+            if (info.mShortcutListSize > 0) {
+                ByteArrayUtils::writeUintAndAdvancePosition(body, info.mShortcutListSize,
+                        SHORTCUT_LIST_SIZE_FIELD_SIZE, &pos);
+                const auto &shortcuts = unigramProperty->getShortcuts();
+                for (size_t j = 0; j < shortcuts.size(); ++j) {
+                    const std::vector<int> &target = *shortcuts[j].getTargetCodePoints();
+                    const int probability = std::min(std::max(shortcuts[j].getProbability(), 0),
+                            static_cast<int>(MASK_ATTRIBUTE_PROBABILITY));
+                    ByteArrayUtils::writeUintAndAdvancePosition(body,
+                            (j + 1 < shortcuts.size() ? FLAG_ATTRIBUTE_HAS_NEXT : 0) | probability,
+                            1, &pos);
+                    // Shortcut targets don't use the code point table.
+                    ByteArrayUtils::writeCodePointsAndAdvancePosition(body, target.data(),
+                            static_cast<int>(target.size()), true /* writesTerminator */, &pos);
+                }
+            }
+            for (size_t j = 0; j < bigramInfos.size(); ++j) {
+                const int offset =
+                        mPtNodeInfos[bigramInfos[j].mTargetPtNodeIndex].mPos - (pos + 1);
+                ByteArrayUtils::writeUintAndAdvancePosition(body,
+                        (j + 1 < bigramInfos.size() ? FLAG_ATTRIBUTE_HAS_NEXT : 0)
+                                | (offset < 0 ? FLAG_BIGRAM_OFFSET_NEGATIVE : 0)
+                                | (FLAG_BIGRAM_ADDRESS_TYPE_ONEBYTE * bigramInfos[j].mAddressSize)
+                                | bigramInfos[j].mEncodedProbability, 1, &pos);
+                ByteArrayUtils::writeUintAndAdvancePosition(body, abs(offset),
+                        bigramInfos[j].mAddressSize, &pos);
+            }
+        }
+    }
+
+    int getBodySize() const { return mBodySize; }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(PtNodeLayout);
+
+    struct PtNodeInfo {
+        PtNodeInfo()
+                : mCodePointsSize(0), mProbability(0), mShortcutListSize(0),
+                  mChildrenFieldSize(0), mSize(0), mPos(0) {}
+
+        int mCodePointsSize;
+        int mProbability;
+        int mShortcutListSize;
+        int mChildrenFieldSize;
+        int mSize;
+        int mPos;
+    };
+
+    struct BigramInfo {
+        BigramInfo(const int targetPtNodeIndex, const int encodedProbability)
+                : mTargetPtNodeIndex(targetPtNodeIndex),
+                  mEncodedProbability(encodedProbability), mAddressSize(3) {}
+
+        int mTargetPtNodeIndex;
+        int mEncodedProbability;
+        int mAddressSize;
+    };
+
+    int getCodePointSize(const int codePoint) const {
+        if (mCodePointTableIndices.empty()) {
+            return getCodePointSizeWithoutTable(codePoint);
+        }
+        return mCodePointTableIndices.count(codePoint) > 0 ? 1 : 3;
+    }
+
+    void writeCodePoint(const int codePoint, uint8_t *const body, int *const pos) const {
+        if (mCodePointTableIndices.empty()) {
+            ByteArrayUtils::writeCodePointsAndAdvancePosition(body, &codePoint, 1,
+                    false /* writesTerminator */, pos);
+            return;
+        }
+        const auto it = mCodePointTableIndices.find(codePoint);
+        if (it == mCodePointTableIndices.end()) {
+            ByteArrayUtils::writeUintAndAdvancePosition(body, codePoint, 3, pos);
+        } else {
+            ByteArrayUtils::writeUintAndAdvancePosition(body,
+                    MINIMUM_ONE_BYTE_CHARACTER_VALUE + it->second, 1, pos);
+        }
+    }
+
+    const FlattenedTrie &mTrie;
+    std::unordered_map<int, int> mCodePointTableIndices;
+    std::vector<PtNodeInfo> mPtNodeInfos;
+    // Bigrams of each PtNode whose targets are in the trie.
+    std::vector<std::vector<BigramInfo>> mBigramInfos;
+    std::vector<int> mPtNodeArrayPositions;
+    int mBodySize;
+};
+
+/* static */ bool Ver2DictEncoder::encodeDictionary(const OffdeviceIntermediateDict &dict,
+        const CodePointTableMode codePointTableMode, const int threadCount,
+        std::vector<uint8_t> *const outBuffer) {
+    const FlattenedTrie trie(dict, threadCount);
+    for (const auto &ptNodeArray : trie.getPtNodeArrays()) {
+        if (ptNodeArray.mPtNodeCount > MAX_PT_NODE_ARRAY_SIZE) {
+            fprintf(stderr, "Too many PtNodes in an array: %d\n", ptNodeArray.mPtNodeCount);
+            return false;
+        }
+    }
+    const std::vector<int> codePointTable = createCodePointTable(trie, codePointTableMode);
+    PtNodeLayout layout(trie, codePointTable);
+    const int ptNodeCount = static_cast<int>(trie.getPtNodes().size());
+    std::atomic<bool> hasTooLargeShortcutList(false);
+    runInParallel(ptNodeCount, threadCount, [&](const int begin, const int end) {
+        if (!layout.initPtNodes(begin, end)) {
+            hasTooLargeShortcutList = true;
+        }
+    });
+    if (hasTooLargeShortcutList) {
+        fprintf(stderr, "A shortcut list is too large.\n");
+        return false;
+    }
+    std::atomic<bool> updated(true);
+    while (updated) {
+        layout.computePositions();
+        updated = false;
+        runInParallel(ptNodeCount, threadCount, [&](const int begin, const int end) {
+            if (layout.updateFieldSizes(begin, end)) {
+                updated = true;
+            }
+        });
+        if (!layout.hasValidOffsets()) {
+            fprintf(stderr, "The dictionary is too large for the ver2 format.\n");
+            return false;
+        }
+    }
+
+    // Header
+    DictionaryHeaderStructurePolicy::AttributeMap attributeMap =
+            dict.getHeader().getAttributeMap();
+    DictionaryHeaderStructurePolicy::AttributeMap::key_type codePointTableKey;
+    HeaderReadWriteUtils::insertCharactersIntoVector(CODE_POINT_TABLE_KEY, &codePointTableKey);
+    attributeMap.erase(codePointTableKey);
+    if (!codePointTable.empty()) {
+        attributeMap[codePointTableKey] = codePointTable;
+    }
+    int headerSize = MAGIC_NUMBER_SIZE + VERSION_SIZE + FLAGS_SIZE + HEADER_SIZE_FIELD_SIZE;
+    for (const auto &attribute : attributeMap) {
+        if (!attribute.first.empty() && !attribute.second.empty()) {
+            headerSize += ByteArrayUtils::calculateRequiredByteCountToStoreCodePoints(
+                    attribute.first.data(), static_cast<int>(attribute.first.size()),
+                    true /* writesTerminator */);
+            headerSize += ByteArrayUtils::calculateRequiredByteCountToStoreCodePoints(
+                    attribute.second.data(), static_cast<int>(attribute.second.size()),
+                    true /* writesTerminator */);
+        }
+    }
+    outBuffer->assign(headerSize + layout.getBodySize(), 0);
+    uint8_t *const buffer = outBuffer->data();
+    int pos = 0;
+    ByteArrayUtils::writeUintAndAdvancePosition(buffer, FormatUtils::MAGIC_NUMBER,
+            MAGIC_NUMBER_SIZE, &pos);
+    ByteArrayUtils::writeUintAndAdvancePosition(buffer, FormatUtils::VERSION_202, VERSION_SIZE,
+            &pos);
+    ByteArrayUtils::writeUintAndAdvancePosition(buffer,
+            HeaderReadWriteUtils::createAndGetDictionaryFlagsUsingAttributeMap(&attributeMap),
+            FLAGS_SIZE, &pos);
+    ByteArrayUtils::writeUintAndAdvancePosition(buffer, headerSize, HEADER_SIZE_FIELD_SIZE, &pos);
+    for (const auto &attribute : attributeMap) {
+        // Same as HeaderReadWriteUtils::writeHeaderAttributes().
+        if (!attribute.first.empty() && !attribute.second.empty()) {
+            ByteArrayUtils::writeCodePointsAndAdvancePosition(buffer, attribute.first.data(),
+                    static_cast<int>(attribute.first.size()), true /* writesTerminator */, &pos);
+            ByteArrayUtils::writeCodePointsAndAdvancePosition(buffer, attribute.second.data(),
+                    static_cast<int>(attribute.second.size()), true /* writesTerminator */, &pos);
+        }
+    }
+
+    // Body
+    uint8_t *const body = buffer + headerSize;
+    layout.writePtNodeArraySizes(body);
+    runInParallel(ptNodeCount, threadCount, [&](const int begin, const int end) {
+        layout.writePtNodes(begin, end, body);
+    });
+    return true;
+}
+
+/* static */ bool Ver2DictEncoder::writeDictionary(const OffdeviceIntermediateDict &dict,
+        const CodePointTableMode codePointTableMode, const int threadCount,
+        const char *const filePath) {
+    std::vector<uint8_t> buffer;
+    if (!encodeDictionary(dict, codePointTableMode, threadCount, &buffer)) {
+        return false;
+    }
+    FILE *const file = fopen(filePath, "wb");
+    if (!file) {
+        fprintf(stderr, "Cannot open the file: %s\n", filePath);
+        return false;
+    }
+    const bool succeeded = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    if (fclose(file) != 0 || !succeeded) {
+        fprintf(stderr, "Cannot write the file: %s\n", filePath);
+        return false;
+    }
+    return true;
+}
+
+// The table maps the most frequent code points to single bytes, which makes the other code points
+// take three bytes each.
+/* static */ const std::vector<int> Ver2DictEncoder::createCodePointTable(
+        const FlattenedTrie &trie, const CodePointTableMode codePointTableMode) {
+    if (codePointTableMode == CODE_POINT_TABLE_OFF) {
+        return std::vector<int>();
+    }
+    std::unordered_map<int, int64_t> codePointCounts;
+    for (const auto &ptNode : trie.getPtNodes()) {
+        for (const int codePoint : trie.getPtNodeCodePoints(ptNode)) {
+            ++codePointCounts[codePoint];
+        }
+    }
+    std::vector<std::pair<int, int64_t>> sortedCodePointCounts;
+    for (const auto &codePointCount : codePointCounts) {
+        // Code points below 0x20 would conflict with the terminator in the header.
+        if (codePointCount.first >= MINIMUM_ONE_BYTE_CHARACTER_VALUE) {
+            sortedCodePointCounts.push_back(codePointCount);
+        }
+    }
+    std::sort(sortedCodePointCounts.begin(), sortedCodePointCounts.end(),
+            [](const std::pair<int, int64_t> &left, const std::pair<int, int64_t> &right) {
+                return left.second != right.second ? left.second > right.second
+                        : left.first < right.first;
+            });
+    if (static_cast<int>(sortedCodePointCounts.size()) > MAX_CODE_POINT_TABLE_SIZE) {
+        sortedCodePointCounts.resize(MAX_CODE_POINT_TABLE_SIZE);
+    }
+    std::vector<int> codePointTable;
+    int64_t sizeWithTable = 0;
+    for (const auto &codePointCount : sortedCodePointCounts) {
+        codePointTable.push_back(codePointCount.first);
+        // The table itself is stored in the header.
+        sizeWithTable +=
+                getCodePointSizeWithoutTable(codePointCount.first) + codePointCount.second;
+        codePointCounts.erase(codePointCount.first);
+    }
+    if (codePointTableMode == CODE_POINT_TABLE_ON) {
+        return codePointTable;
+    }
+    int64_t sizeWithoutTable = 0;
+    for (const auto &codePointCount : sortedCodePointCounts) {
+        sizeWithoutTable +=
+                getCodePointSizeWithoutTable(codePointCount.first) * codePointCount.second;
+    }
+    for (const auto &codePointCount : codePointCounts) {
+        sizeWithTable += 3 * codePointCount.second;
+        sizeWithoutTable +=
+                getCodePointSizeWithoutTable(codePointCount.first) * codePointCount.second;
+    }
+    return sizeWithTable < sizeWithoutTable ? codePointTable : std::vector<int>();
+}
+
+/* static */ int Ver2DictEncoder::getFieldSizeForOffset(const int offset) {
+    const int absOffset = abs(offset);
+    if (absOffset <= 0xFF) {
+        return 1;
+    } else if (absOffset <= 0xFFFF) {
+        return 2;
+    } else if (absOffset <= MAX_OFFSET) {
+        return 3;
+    }
+    // Too large to be stored.
+    return 4;
+}
+
+// Ver2 bigram probabilities are 4-bit steps above the unigram probability of the target. Picks
+// the step that ProbabilityUtils::computeProbabilityForBigram() decodes closest to the
+// probability.
+/* static */ int Ver2DictEncoder::encodeBigramProbability(const int unigramProbability,
+        const int probability) {
+    int encodedProbability = 0;
+    int minDiff = S_INT_MAX;
+    for (int i = 0; i <= MAX_BIGRAM_ENCODED_PROBABILITY; ++i) {
+        const int diff = abs(ProbabilityUtils::computeProbabilityForBigram(unigramProbability, i)
+                - probability);
+        if (diff < minDiff) {
+            minDiff = diff;
+            encodedProbability = i;
+        }
+    }
+    return encodedProbability;
+}
+
+} // namespace dicttoolkit
+} // namespace latinime
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_DICT_TOOLKIT_VER2_DICT_ENCODER_H
+#define LATINIME_DICT_TOOLKIT_VER2_DICT_ENCODER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "dict_toolkit_defines.h"
+
+namespace latinime {
+namespace dicttoolkit {
+
+class FlattenedTrie;
+class OffdeviceIntermediateDict;
+
+/**
+ * Encodes a dictionary in the ver2 (version 202) binary format.
+ *
+ * The sizes of the position fields depend on the positions of the PtNodes, which depend on the
+ * sizes of the preceding PtNodes. The encoder starts with the largest fields and recomputes the
+ * sizes from the resulting positions until they don't change; the distances only shrink, so it
+ * converges in a few passes. The sizes and the bytes of the PtNodes are computed by threadCount
+ * threads.
+ */
+class Ver2DictEncoder final {
+ public:
+    enum CodePointTableMode {
+        CODE_POINT_TABLE_OFF,
+        CODE_POINT_TABLE_ON,
+        // Uses the table when it makes the dictionary smaller.
+        CODE_POINT_TABLE_AUTO,
+    };
+
+    // Returns false when the dictionary cannot be represented in the ver2 format.
+    static bool encodeDictionary(const OffdeviceIntermediateDict &dict,
+            const CodePointTableMode codePointTableMode, const int threadCount,
+            std::vector<uint8_t> *const outBuffer);
+    static bool writeDictionary(const OffdeviceIntermediateDict &dict,
+            const CodePointTableMode codePointTableMode, const int threadCount,
+            const char *const filePath);
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(Ver2DictEncoder);
+
+    class PtNodeLayout;
+
+    static const int MAX_CODE_POINT_TABLE_SIZE;
+    static const int MAX_PT_NODE_ARRAY_SIZE;
+    static const int MAX_ONE_BYTE_PT_NODE_ARRAY_SIZE;
+    static const int MAX_OFFSET;
+    static const int SHORTCUT_LIST_SIZE_FIELD_SIZE;
+    static const int MAX_SHORTCUT_LIST_SIZE;
+    static const uint8_t FLAG_ATTRIBUTE_HAS_NEXT;
+    static const uint8_t FLAG_BIGRAM_OFFSET_NEGATIVE;
+    static const uint8_t FLAG_BIGRAM_ADDRESS_TYPE_ONEBYTE;
+    static const uint8_t MASK_ATTRIBUTE_PROBABILITY;
+
+    static const std::vector<int> createCodePointTable(const FlattenedTrie &trie,
+            const CodePointTableMode codePointTableMode);
+    static int getFieldSizeForOffset(const int offset);
+    static int encodeBigramProbability(const int unigramProbability, const int probability);
+};
+
+} // namespace dicttoolkit
+} // namespace latinime
+#endif // LATINIME_DICT_TOOLKIT_VER2_DICT_ENCODER_H
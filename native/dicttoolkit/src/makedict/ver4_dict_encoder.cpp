@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "makedict/ver4_dict_encoder.h"
+
+#include <cstdio>
+#include <vector>
+
+#include "dictionary/header/header_read_write_utils.h"
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "dictionary/property/ngram_property.h"
+#include "dictionary/property/word_property.h"
+#include "dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "dictionary/utils/format_utils.h"
+#include "offdevice_intermediate_dict/offdevice_intermediate_dict.h"
+
+namespace latinime {
+namespace dicttoolkit {
+
+namespace {
+
+// The buffers of an on-memory dictionary have size limits. The dictionary is written with GC and
+// reopened when it gets close to them, as the keyboard does for its dynamic dictionaries.
+// The GC of a decaying dictionary applies the forgetting curve, which would drop and truncate
+// the entries of the source. Such dictionaries are never compacted; they are small enough, and
+// adding an entry fails when the buffers are full.
+bool compactDictionaryIfNeeded(const char *const dictDirPath, const bool isDecayingDict,
+        DictionaryStructureWithBufferPolicy::StructurePolicyPtr *const policy) {
+    if (isDecayingDict || !(*policy)->needsToRunGC(false /* mindsBlockByGC */)) {
+        return true;
+    }
+    if (!(*policy)->flushWithGC(dictDirPath)) {
+        return false;
+    }
+    *policy = DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+            dictDirPath, 0 /* bufOffset */, 0 /* size */, true /* isUpdatable */);
+    return *policy != nullptr;
+}
+
+} // namespace
+
+// Same as the keys in HeaderPolicy.
+const char *const Ver4DictEncoder::LOCALE_KEY = "locale";
+const char *const Ver4DictEncoder::USES_FORGETTING_CURVE_KEY = "USES_FORGETTING_CURVE";
+const char *const Ver4DictEncoder::NGRAM_COUNT_KEYS[] =
+        {"UNIGRAM_COUNT", "BIGRAM_COUNT", "TRIGRAM_COUNT", "QUADGRAM_COUNT"};
+
+/* static */ bool Ver4DictEncoder::writeDictionary(const OffdeviceIntermediateDict &dict,
+        const char *const dictDirPath) {
+    DictionaryHeaderStructurePolicy::AttributeMap attributeMap =
+            dict.getHeader().getAttributeMap();
+    // The entry counts of a ver4 source would be added to the counts of the new entries.
+    for (const char *const ngramCountKey : NGRAM_COUNT_KEYS) {
+        DictionaryHeaderStructurePolicy::AttributeMap::key_type key;
+        HeaderReadWriteUtils::insertCharactersIntoVector(ngramCountKey, &key);
+        attributeMap.erase(key);
+    }
+    const std::vector<int> locale =
+            HeaderReadWriteUtils::readCodePointVectorAttributeValue(&attributeMap, LOCALE_KEY);
+    const bool isDecayingDict = HeaderReadWriteUtils::readBoolAttributeValue(&attributeMap,
+            USES_FORGETTING_CURVE_KEY, false /* defaultValue */);
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+            DictionaryStructureWithBufferPolicyFactory::newPolicyForOnMemoryDict(
+                    FormatUtils::VERSION_403, locale, &attributeMap);
+    if (!policy) {
+        return false;
+    }
+    const std::vector<const WordProperty *> wordProperties = dict.getWordProperties();
+    for (const WordProperty *const wordProperty : wordProperties) {
+        if (!compactDictionaryIfNeeded(dictDirPath, isDecayingDict, &policy)) {
+            return false;
+        }
+        if (!policy->addUnigramEntry(wordProperty->getCodePoints(),
+                &wordProperty->getUnigramProperty())) {
+            fprintf(stderr, "Cannot add a unigram entry.\n");
+            return false;
+        }
+    }
+    // N-grams are added after all unigrams because their targets have to exist.
+    int skippedNgramCount = 0;
+    for (const WordProperty *const wordProperty : wordProperties) {
+        for (const auto &ngramProperty : wordProperty->getNgramProperties()) {
+            if (!compactDictionaryIfNeeded(dictDirPath, isDecayingDict, &policy)) {
+                return false;
+            }
+            if (!policy->addNgramEntry(&ngramProperty)) {
+                ++skippedNgramCount;
+            }
+        }
+    }
+    if (skippedNgramCount > 0) {
+        fprintf(stderr, "%d n-gram entries whose words are not in the dictionary are skipped.\n",
+                skippedNgramCount);
+    }
+    // Entries of a decaying dictionary are written as they are, without the forgetting curve.
+    return isDecayingDict ? policy->flush(dictDirPath) : policy->flushWithGC(dictDirPath);
+}
+
+} // namespace dicttoolkit
+} // namespace latinime
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_DICT_TOOLKIT_VER4_DICT_ENCODER_H
+#define LATINIME_DICT_TOOLKIT_VER4_DICT_ENCODER_H
+
+#include "dict_toolkit_defines.h"
+
+namespace latinime {
+namespace dicttoolkit {
+
+class OffdeviceIntermediateDict;
+
+// Writes a dictionary in the ver4 (version 403) format through an on-memory ver4 dictionary.
+class Ver4DictEncoder final {
+ public:
+    // The dictionary is written to the directory at dictDirPath.
+    static bool writeDictionary(const OffdeviceIntermediateDict &dict,
+            const char *const dictDirPath);
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(Ver4DictEncoder);
+
+    static const char *const LOCALE_KEY;
+    static const char *const USES_FORGETTING_CURVE_KEY;
+    static const char *const NGRAM_COUNT_KEYS[];
+};
+
+} // namespace dicttoolkit
+} // namespace latinime
+#endif // LATINIME_DICT_TOOLKIT_VER4_DICT_ENCODER_H
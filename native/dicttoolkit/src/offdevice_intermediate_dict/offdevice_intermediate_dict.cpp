@@ -16,8 +16,6 @@
 
 #include "offdevice_intermediate_dict/offdevice_intermediate_dict.h"
 
-#include "offdevice_intermediate_dict/offdevice_intermediate_dict_pt_node.h"
-
 namespace latinime {
 namespace dicttoolkit {
 
@@ -26,101 +24,141 @@ bool OffdeviceIntermediateDict::addWord(const WordProperty &wordProperty) {
     if (codePoints.empty() || codePoints.size() > MAX_WORD_LENGTH) {
         return false;
     }
-    return addWordInner(codePoints, wordProperty, mRootPtNodeArray);
-}
-
-bool OffdeviceIntermediateDict::addWordInner(const CodePointArrayView codePoints,
-        const WordProperty &wordProperty, OffdeviceIntermediateDictPtNodeArray &ptNodeArray) {
-    auto ptNodeList = ptNodeArray.getMutablePtNodeList();
-    auto ptNodeIt = ptNodeList->begin();
-    for (; ptNodeIt != ptNodeList->end(); ++ptNodeIt) {
-        const auto &ptNode = *ptNodeIt;
-        const CodePointArrayView ptNodeCodePoints = ptNode->getPtNodeCodePoints();
-        if (codePoints[0] < ptNodeCodePoints[0]) {
-            continue;
+    int parentPtNodeIndex = NOT_AN_INDEX;
+    size_t matchedCodePointCount = 0;
+    while (true) {
+        int prevSiblingPtNodeIndex = NOT_AN_INDEX;
+        int ptNodeIndex = getPtNodeLink(parentPtNodeIndex, NOT_AN_INDEX);
+        const int codePoint = codePoints[matchedCodePointCount];
+        while (ptNodeIndex != NOT_AN_INDEX
+                && mCodePoints[mPtNodes[ptNodeIndex].mCodePointStart] < codePoint) {
+            prevSiblingPtNodeIndex = ptNodeIndex;
+            ptNodeIndex = mPtNodes[ptNodeIndex].mNextSiblingPtNodeIndex;
         }
-        if (codePoints[0] > ptNodeCodePoints[0]) {
-            break;
+        if (ptNodeIndex == NOT_AN_INDEX
+                || mCodePoints[mPtNodes[ptNodeIndex].mCodePointStart] != codePoint) {
+            // Add a new PtNode for the rest of the word.
+            const int newPtNodeIndex =
+                    createPtNode(codePoints.skip(matchedCodePointCount), &wordProperty);
+            mPtNodes[newPtNodeIndex].mNextSiblingPtNodeIndex = ptNodeIndex;
+            getPtNodeLink(parentPtNodeIndex, prevSiblingPtNodeIndex) = newPtNodeIndex;
+            return true;
         }
-        size_t i = 1;
-        for (; i < codePoints.size(); ++i) {
-            if (i >= ptNodeCodePoints.size()) {
-                // Add new child.
-                return addWordInner(codePoints.skip(i), wordProperty,
-                        ptNode->getChildrenPtNodeArray());
-            }
-            if (codePoints[i] != ptNodeCodePoints[i]) {
-                break;
-            }
+        const CodePointArrayView ptNodeCodePoints = getPtNodeCodePoints(mPtNodes[ptNodeIndex]);
+        size_t commonCodePointCount = 1;
+        while (commonCodePointCount < ptNodeCodePoints.size()
+                && matchedCodePointCount + commonCodePointCount < codePoints.size()
+                && ptNodeCodePoints[commonCodePointCount]
+                        == codePoints[matchedCodePointCount + commonCodePointCount]) {
+            ++commonCodePointCount;
+        }
+        if (commonCodePointCount < ptNodeCodePoints.size()) {
+            // The PtNode keeps the common part and the rest is moved to a new child.
+            splitPtNode(ptNodeIndex, static_cast<int>(commonCodePointCount));
         }
-        if (codePoints.size() == i && codePoints.size() == ptNodeCodePoints.size()) {
-            // All code points matched.
-            if (ptNode->getWordProperty()) {
+        matchedCodePointCount += commonCodePointCount;
+        if (matchedCodePointCount == codePoints.size()) {
+            if (mPtNodes[ptNodeIndex].mWordPropertyIndex != NOT_AN_INDEX) {
                 //  Adding the same word multiple times is not supported.
                 return false;
             }
-            ptNodeList->insert(ptNodeIt,
-                    std::make_shared<OffdeviceIntermediateDictPtNode>(wordProperty, *ptNode));
-            ptNodeList->erase(ptNodeIt);
+            const int wordPropertyIndex = addWordProperty(wordProperty);
+            mPtNodes[ptNodeIndex].mWordPropertyIndex = wordPropertyIndex;
             return true;
         }
-        // The (i+1)-th elements are different.
-        // Create and Add new parent ptNode for the common part.
-        auto newPtNode = codePoints.size() == i
-                ? std::make_shared<OffdeviceIntermediateDictPtNode>(codePoints, wordProperty)
-                : std::make_shared<OffdeviceIntermediateDictPtNode>(codePoints.limit(i));
-        ptNodeList->insert(ptNodeIt, newPtNode);
-        OffdeviceIntermediateDictPtNodeArray &childrenPtNodeArray =
-                newPtNode->getChildrenPtNodeArray();
-        // Add new child for the existing ptNode.
-        childrenPtNodeArray.getMutablePtNodeList()->push_back(
-                std::make_shared<OffdeviceIntermediateDictPtNode>(
-                        ptNodeCodePoints.skip(i), *ptNode));
-        ptNodeList->erase(ptNodeIt);
-        if (codePoints.size() != i) {
-            // Add a child for the new word.
-            return addWordInner(codePoints.skip(i), wordProperty, childrenPtNodeArray);
-        }
-        return true;
+        parentPtNodeIndex = ptNodeIndex;
     }
-    ptNodeList->insert(ptNodeIt,
-            std::make_shared<OffdeviceIntermediateDictPtNode>(codePoints, wordProperty));
-    return true;
 }
 
 const WordProperty *OffdeviceIntermediateDict::getWordProperty(
         const CodePointArrayView codePoints) const {
-    const OffdeviceIntermediateDictPtNodeArray *ptNodeArray = &mRootPtNodeArray;
-    for (size_t i = 0; i < codePoints.size();) {
-        bool foundNext = false;
-        for (const auto& ptNode : ptNodeArray->getPtNodeList()) {
-            const CodePointArrayView ptNodeCodePoints = ptNode->getPtNodeCodePoints();
-            if (codePoints[i] < ptNodeCodePoints[0]) {
-                continue;
-            }
-            if (codePoints[i] > ptNodeCodePoints[0]
-                     || codePoints.size() < ptNodeCodePoints.size()) {
+    int ptNodeIndex = mRootPtNodeIndex;
+    size_t matchedCodePointCount = 0;
+    while (ptNodeIndex != NOT_AN_INDEX && matchedCodePointCount < codePoints.size()) {
+        const OffdeviceIntermediateDictPtNode &ptNode = mPtNodes[ptNodeIndex];
+        const CodePointArrayView ptNodeCodePoints = getPtNodeCodePoints(ptNode);
+        if (codePoints[matchedCodePointCount] > ptNodeCodePoints[0]) {
+            ptNodeIndex = ptNode.mNextSiblingPtNodeIndex;
+            continue;
+        }
+        if (codePoints[matchedCodePointCount] < ptNodeCodePoints[0]
+                || codePoints.size() - matchedCodePointCount < ptNodeCodePoints.size()) {
+            return nullptr;
+        }
+        for (size_t i = 1; i < ptNodeCodePoints.size(); ++i) {
+            if (codePoints[matchedCodePointCount + i] != ptNodeCodePoints[i]) {
                 return nullptr;
             }
-            for (size_t j = 1; j < ptNodeCodePoints.size(); ++j) {
-                if (codePoints[i + j] != ptNodeCodePoints[j]) {
-                    return nullptr;
-                }
-            }
-            i += ptNodeCodePoints.size();
-            if (i == codePoints.size()) {
-                return ptNode->getWordProperty();
-            }
-            ptNodeArray = &ptNode->getChildrenPtNodeArray();
-            foundNext = true;
-            break;
         }
-        if (!foundNext) {
-            break;
+        matchedCodePointCount += ptNodeCodePoints.size();
+        if (matchedCodePointCount == codePoints.size()) {
+            return getPtNodeWordProperty(ptNode);
         }
+        ptNodeIndex = ptNode.mFirstChildPtNodeIndex;
     }
     return nullptr;
 }
 
+const std::vector<const WordProperty *> OffdeviceIntermediateDict::getWordProperties() const {
+    std::vector<const WordProperty *> wordProperties;
+    wordProperties.reserve(mWordProperties.size());
+    getWordPropertiesInner(mRootPtNodeIndex, &wordProperties);
+    return wordProperties;
+}
+
+int OffdeviceIntermediateDict::createPtNode(const CodePointArrayView codePoints,
+        const WordProperty *const wordProperty) {
+    const int codePointStart = static_cast<int>(mCodePoints.size());
+    mCodePoints.insert(mCodePoints.end(), codePoints.begin(), codePoints.end());
+    const int wordPropertyIndex = wordProperty ? addWordProperty(*wordProperty) : NOT_AN_INDEX;
+    mPtNodes.emplace_back(codePointStart, static_cast<int>(codePoints.size()), wordPropertyIndex);
+    return static_cast<int>(mPtNodes.size()) - 1;
+}
+
+int OffdeviceIntermediateDict::addWordProperty(const WordProperty &wordProperty) {
+    mWordProperties.emplace_back(wordProperty);
+    return static_cast<int>(mWordProperties.size()) - 1;
+}
+
+void OffdeviceIntermediateDict::splitPtNode(const int ptNodeIndex, const int codePointCount) {
+    const OffdeviceIntermediateDictPtNode &ptNode = mPtNodes[ptNodeIndex];
+    // The new child takes over the rest of the code points, the children and the word property.
+    OffdeviceIntermediateDictPtNode childPtNode(ptNode.mCodePointStart + codePointCount,
+            ptNode.mCodePointCount - codePointCount, ptNode.mWordPropertyIndex);
+    childPtNode.mFirstChildPtNodeIndex = ptNode.mFirstChildPtNodeIndex;
+    // ptNode is invalidated here.
+    mPtNodes.push_back(childPtNode);
+    OffdeviceIntermediateDictPtNode &parentPtNode = mPtNodes[ptNodeIndex];
+    parentPtNode.mCodePointCount = codePointCount;
+    parentPtNode.mFirstChildPtNodeIndex = static_cast<int>(mPtNodes.size()) - 1;
+    parentPtNode.mWordPropertyIndex = NOT_AN_INDEX;
+}
+
+// Returns the field that links to the PtNode after prevSiblingPtNodeIndex in the children of
+// parentPtNodeIndex. NOT_AN_INDEX is used for the root PtNode array and for the first child. The
+// returned reference is invalidated by adding PtNodes.
+int &OffdeviceIntermediateDict::getPtNodeLink(const int parentPtNodeIndex,
+        const int prevSiblingPtNodeIndex) {
+    if (prevSiblingPtNodeIndex != NOT_AN_INDEX) {
+        return mPtNodes[prevSiblingPtNodeIndex].mNextSiblingPtNodeIndex;
+    }
+    if (parentPtNodeIndex != NOT_AN_INDEX) {
+        return mPtNodes[parentPtNodeIndex].mFirstChildPtNodeIndex;
+    }
+    return mRootPtNodeIndex;
+}
+
+void OffdeviceIntermediateDict::getWordPropertiesInner(const int firstPtNodeIndex,
+        std::vector<const WordProperty *> *const outWordProperties) const {
+    for (int ptNodeIndex = firstPtNodeIndex; ptNodeIndex != NOT_AN_INDEX;
+            ptNodeIndex = mPtNodes[ptNodeIndex].mNextSiblingPtNodeIndex) {
+        const OffdeviceIntermediateDictPtNode &ptNode = mPtNodes[ptNodeIndex];
+        if (const WordProperty *const wordProperty = getPtNodeWordProperty(ptNode)) {
+            outWordProperties->push_back(wordProperty);
+        }
+        getWordPropertiesInner(ptNode.mFirstChildPtNodeIndex, outWordProperties);
+    }
+}
+
 } // namespace dicttoolkit
 } // namespace latinime
@@ -17,9 +17,12 @@
 #ifndef LATINIME_DICT_TOOLKIT_OFFDEVICE_INTERMEDIATE_DICT_H
 #define LATINIME_DICT_TOOLKIT_OFFDEVICE_INTERMEDIATE_DICT_H
 
+#include <deque>
+#include <vector>
+
 #include "dict_toolkit_defines.h"
 #include "offdevice_intermediate_dict/offdevice_intermediate_dict_header.h"
-#include "offdevice_intermediate_dict/offdevice_intermediate_dict_pt_node_array.h"
+#include "offdevice_intermediate_dict/offdevice_intermediate_dict_pt_node.h"
 #include "dictionary/property/word_property.h"
 #include "utils/int_array_view.h"
 
@@ -28,25 +31,60 @@ namespace dicttoolkit {
 
 /**
  * On memory patricia trie to represent a dictionary.
+ *
+ * PtNodes, their code points and word properties are kept in arenas that only grow, and PtNodes
+ * refer to each other by indices. The code points of a PtNode are a span of the shared code point
+ * array; a split PtNode and its new child share the span of the original PtNode.
  */
 class OffdeviceIntermediateDict final {
  public:
     OffdeviceIntermediateDict(const OffdeviceIntermediateDictHeader &header)
-            : mHeader(header), mRootPtNodeArray() {}
+            : mHeader(header), mRootPtNodeIndex(NOT_AN_INDEX), mPtNodes(), mCodePoints(),
+              mWordProperties() {}
 
     bool addWord(const WordProperty &wordProperty);
     // The returned value will be invalid after modifying the dictionary. e.g. calling addWord().
     const WordProperty *getWordProperty(const CodePointArrayView codePoints) const;
     const OffdeviceIntermediateDictHeader &getHeader() const { return mHeader; }
+    // Returns the words in the ascending order of their code points. The returned values will be
+    // invalid after modifying the dictionary.
+    const std::vector<const WordProperty *> getWordProperties() const;
+
+    // The first PtNode of the root PtNode array. NOT_AN_INDEX when the dictionary is empty.
+    int getRootPtNodeIndex() const { return mRootPtNodeIndex; }
+
+    const OffdeviceIntermediateDictPtNode &getPtNode(const int ptNodeIndex) const {
+        return mPtNodes[ptNodeIndex];
+    }
+
+    const CodePointArrayView getPtNodeCodePoints(
+            const OffdeviceIntermediateDictPtNode &ptNode) const {
+        return CodePointArrayView(mCodePoints).skip(ptNode.getCodePointStart())
+                .limit(ptNode.getCodePointCount());
+    }
+
+    // nullptr for non-terminal PtNodes.
+    const WordProperty *getPtNodeWordProperty(const OffdeviceIntermediateDictPtNode &ptNode) const {
+        return ptNode.getWordPropertyIndex() == NOT_AN_INDEX ? nullptr
+                : &mWordProperties[ptNode.getWordPropertyIndex()];
+    }
 
  private:
     DISALLOW_ASSIGNMENT_OPERATOR(OffdeviceIntermediateDict);
 
     const OffdeviceIntermediateDictHeader mHeader;
-    OffdeviceIntermediateDictPtNodeArray mRootPtNodeArray;
+    int mRootPtNodeIndex;
+    std::vector<OffdeviceIntermediateDictPtNode> mPtNodes;
+    std::vector<int> mCodePoints;
+    // A deque keeps the addresses of the word properties while it grows.
+    std::deque<WordProperty> mWordProperties;
 
-    bool addWordInner(const CodePointArrayView codePoints, const WordProperty &wordProperty,
-            OffdeviceIntermediateDictPtNodeArray &ptNodeArray);
+    int createPtNode(const CodePointArrayView codePoints, const WordProperty *const wordProperty);
+    int addWordProperty(const WordProperty &wordProperty);
+    void splitPtNode(const int ptNodeIndex, const int codePointCount);
+    int &getPtNodeLink(const int parentPtNodeIndex, const int prevSiblingPtNodeIndex);
+    void getWordPropertiesInner(const int firstPtNodeIndex,
+            std::vector<const WordProperty *> *const outWordProperties) const;
 };
 
 } // namespace dicttoolkit
@@ -32,6 +32,10 @@ class OffdeviceIntermediateDictHeader final {
     OffdeviceIntermediateDictHeader(const AttributeMap &attributesMap)
             : mAttributeMap(attributesMap) {}
 
+    const AttributeMap &getAttributeMap() const {
+        return mAttributeMap;
+    }
+
  private:
     DISALLOW_DEFAULT_CONSTRUCTOR(OffdeviceIntermediateDictHeader);
     DISALLOW_ASSIGNMENT_OPERATOR(OffdeviceIntermediateDictHeader);
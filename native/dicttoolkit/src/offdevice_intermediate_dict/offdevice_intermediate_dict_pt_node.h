@@ -17,61 +17,57 @@
 #ifndef LATINIME_DICT_TOOLKIT_OFFDEVICE_INTERMEDIATE_DICT_PT_NODE_H
 #define LATINIME_DICT_TOOLKIT_OFFDEVICE_INTERMEDIATE_DICT_PT_NODE_H
 
-#include <memory>
-
 #include "dict_toolkit_defines.h"
-#include "offdevice_intermediate_dict/offdevice_intermediate_dict_pt_node_array.h"
-#include "dictionary/property/word_property.h"
-#include "utils/int_array_view.h"
 
 namespace latinime {
 namespace dicttoolkit {
 
+class OffdeviceIntermediateDict;
+
+// A PtNode in the arena of OffdeviceIntermediateDict. The code points, the children, the siblings
+// and the word property are indices into the arrays of the dictionary, so splitting a PtNode
+// only moves indices.
 class OffdeviceIntermediateDictPtNode final {
  public:
-    // Non-terminal
-    OffdeviceIntermediateDictPtNode(const CodePointArrayView ptNodeCodePoints)
-            : mPtNodeCodePoints(ptNodeCodePoints.toVector()), mChildrenPtNodeArray(),
-              mWortProperty(nullptr) {}
-
-    // Terminal
-    OffdeviceIntermediateDictPtNode(const CodePointArrayView ptNodeCodePoints,
-            const WordProperty &wordProperty)
-             : mPtNodeCodePoints(ptNodeCodePoints.toVector()), mChildrenPtNodeArray(),
-               mWortProperty(new WordProperty(wordProperty)) {}
+    OffdeviceIntermediateDictPtNode(const int codePointStart, const int codePointCount,
+            const int wordPropertyIndex)
+            : mCodePointStart(codePointStart), mCodePointCount(codePointCount),
+              mFirstChildPtNodeIndex(NOT_AN_INDEX), mNextSiblingPtNodeIndex(NOT_AN_INDEX),
+              mWordPropertyIndex(wordPropertyIndex) {}
 
-    // Replacing PtNodeCodePoints.
-    OffdeviceIntermediateDictPtNode(const CodePointArrayView ptNodeCodePoints,
-            const OffdeviceIntermediateDictPtNode &ptNode)
-            : mPtNodeCodePoints(ptNodeCodePoints.toVector()),
-              mChildrenPtNodeArray(ptNode.mChildrenPtNodeArray),
-              mWortProperty(new WordProperty(*ptNode.mWortProperty)) {}
+    int getCodePointStart() const {
+        return mCodePointStart;
+    }
 
-    // Replacing WordProperty.
-    OffdeviceIntermediateDictPtNode(const WordProperty &wordProperty,
-            const OffdeviceIntermediateDictPtNode &ptNode)
-            : mPtNodeCodePoints(ptNode.mPtNodeCodePoints),
-              mChildrenPtNodeArray(ptNode.mChildrenPtNodeArray),
-              mWortProperty(new WordProperty(wordProperty)) {}
+    int getCodePointCount() const {
+        return mCodePointCount;
+    }
 
-    const WordProperty *getWordProperty() const {
-        return mWortProperty.get();
+    // NOT_AN_INDEX when the PtNode has no children.
+    int getFirstChildPtNodeIndex() const {
+        return mFirstChildPtNodeIndex;
     }
 
-    const CodePointArrayView getPtNodeCodePoints() const {
-        return CodePointArrayView(mPtNodeCodePoints);
+    // Siblings are linked in the ascending order of their first code points. NOT_AN_INDEX for the
+    // last sibling.
+    int getNextSiblingPtNodeIndex() const {
+        return mNextSiblingPtNodeIndex;
     }
 
-    OffdeviceIntermediateDictPtNodeArray &getChildrenPtNodeArray() {
-        return mChildrenPtNodeArray;
+    // NOT_AN_INDEX for non-terminal PtNodes.
+    int getWordPropertyIndex() const {
+        return mWordPropertyIndex;
     }
 
  private:
-    DISALLOW_COPY_AND_ASSIGN(OffdeviceIntermediateDictPtNode);
+    // Only the dictionary links and splits PtNodes.
+    friend class OffdeviceIntermediateDict;
 
-    const std::vector<int> mPtNodeCodePoints;
-    OffdeviceIntermediateDictPtNodeArray mChildrenPtNodeArray;
-    const std::unique_ptr<WordProperty> mWortProperty;
+    int mCodePointStart;
+    int mCodePointCount;
+    int mFirstChildPtNodeIndex;
+    int mNextSiblingPtNodeIndex;
+    int mWordPropertyIndex;
 };
 
 } // namespace dicttoolkit
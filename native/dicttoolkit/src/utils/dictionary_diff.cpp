@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/dictionary_diff.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "dictionary/property/ngram_context.h"
+#include "dictionary/property/ngram_property.h"
+#include "dictionary/property/word_property.h"
+#include "dictionary/structure/pt_common/dynamic_pt_reading_helper.h"
+#include "dictionary/structure/pt_common/pt_node_params.h"
+#include "dictionary/structure/pt_common/pt_node_reader.h"
+
+namespace latinime {
+namespace dicttoolkit {
+
+namespace {
+
+// Used in the keys of n-grams to separate the words and to mark the beginning of the sentence.
+const int WORD_SEPARATOR = -1;
+const int BEGINNING_OF_SENTENCE_MARKER = -2;
+
+// A position in the code points of a PtNode. PtNodes are compared one code point at a time
+// because the same words can be split into PtNodes differently in the two dictionaries.
+struct PtNodeCursor {
+    PtNodeCursor(const int ptNodePos, const int codePointIndex, const int codePoint)
+            : mPtNodePos(ptNodePos), mCodePointIndex(codePointIndex), mCodePoint(codePoint) {}
+
+    int mPtNodePos;
+    int mCodePointIndex;
+    int mCodePoint;
+};
+
+bool compareCursors(const PtNodeCursor &left, const PtNodeCursor &right) {
+    return left.mCodePoint < right.mCodePoint;
+}
+
+const std::vector<int> getNgramKey(const NgramProperty &ngramProperty) {
+    const NgramContext *const ngramContext = ngramProperty.getNgramContext();
+    std::vector<int> key;
+    for (size_t n = ngramContext->getPrevWordCount(); n > 0; --n) {
+        if (ngramContext->isNthPrevWordBeginningOfSentence(n)) {
+            key.push_back(BEGINNING_OF_SENTENCE_MARKER);
+        } else {
+            const CodePointArrayView codePoints = ngramContext->getNthPrevWordCodePoints(n);
+            key.insert(key.end(), codePoints.begin(), codePoints.end());
+        }
+        key.push_back(WORD_SEPARATOR);
+    }
+    key.insert(key.end(), ngramProperty.getTargetCodePoints()->begin(),
+            ngramProperty.getTargetCodePoints()->end());
+    return key;
+}
+
+bool isSameUnigram(const UnigramProperty &left, const UnigramProperty &right) {
+    return left.getProbability() == right.getProbability()
+            && left.isNotAWord() == right.isNotAWord()
+            && left.isPossiblyOffensive() == right.isPossiblyOffensive()
+            && left.isBlacklisted() == right.isBlacklisted()
+            && left.representsBeginningOfSentence() == right.representsBeginningOfSentence();
+}
+
+// Merges two entry lists by their keys and calls onDifference(entry1, entry2) for the entries that
+// are only in one of them or whose probabilities differ.
+template<typename Entry, typename GetKey, typename OnDifference>
+void diffEntries(const std::vector<Entry> &entries1, const std::vector<Entry> &entries2,
+        const GetKey &getKey, const OnDifference &onDifference) {
+    std::vector<std::pair<std::vector<int>, const Entry *>> keyedEntries1;
+    for (const Entry &entry : entries1) {
+        keyedEntries1.emplace_back(getKey(entry), &entry);
+    }
+    std::vector<std::pair<std::vector<int>, const Entry *>> keyedEntries2;
+    for (const Entry &entry : entries2) {
+        keyedEntries2.emplace_back(getKey(entry), &entry);
+    }
+    std::sort(keyedEntries1.begin(), keyedEntries1.end());
+    std::sort(keyedEntries2.begin(), keyedEntries2.end());
+    auto it1 = keyedEntries1.begin();
+    auto it2 = keyedEntries2.begin();
+    while (it1 != keyedEntries1.end() || it2 != keyedEntries2.end()) {
+        if (it2 == keyedEntries2.end() || (it1 != keyedEntries1.end() && it1->first < it2->first)) {
+            onDifference(it1->second, nullptr);
+            ++it1;
+        } else if (it1 == keyedEntries1.end() || it2->first < it1->first) {
+            onDifference(nullptr, it2->second);
+            ++it2;
+        } else {
+            if (it1->second->getProbability() != it2->second->getProbability()) {
+                onDifference(it1->second, it2->second);
+            }
+            ++it1;
+            ++it2;
+        }
+    }
+}
+
+class TrieDiffer {
+ public:
+    TrieDiffer(const DictionaryStructureWithBufferPolicy *const policy1,
+            const DictionaryStructureWithBufferPolicy *const policy2,
+            DictionaryDiff::DifferenceListener *const listener)
+            : mPolicies{policy1, policy2}, mListener(listener), mWordCodePoints() {}
+
+    bool diff() {
+        std::vector<PtNodeCursor> cursors1;
+        std::vector<PtNodeCursor> cursors2;
+        return readPtNodeArray(0 /* dictIndex */, mPolicies[0]->getRootPosition(), &cursors1)
+                && readPtNodeArray(1 /* dictIndex */, mPolicies[1]->getRootPosition(), &cursors2)
+                && diffCursors(&cursors1, &cursors2);
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(TrieDiffer);
+
+    // Adds cursors at the first code points of the PtNodes in the array and its forward links.
+    bool readPtNodeArray(const int dictIndex, const int ptNodeArrayPos,
+            std::vector<PtNodeCursor> *const outCursors) const {
+        DynamicPtReadingHelper readingHelper(mPolicies[dictIndex]->getPtNodeReader(),
+                mPolicies[dictIndex]->getPtNodeArrayReader());
+        readingHelper.initWithPtNodeArrayPos(ptNodeArrayPos);
+        while (!readingHelper.isEnd()) {
+            const PtNodeParams ptNodeParams = readingHelper.getPtNodeParams();
+            if (!ptNodeParams.isValid() || ptNodeParams.getCodePointCount() <= 0) {
+                return false;
+            }
+            // Deleted PtNodes without children don't have any words.
+            if (!ptNodeParams.isDeleted() || ptNodeParams.hasChildren()) {
+                outCursors->emplace_back(ptNodeParams.getHeadPos(), 0 /* codePointIndex */,
+                        ptNodeParams.getCodePoints()[0]);
+            }
+            readingHelper.readNextSiblingNode(ptNodeParams);
+        }
+        return !readingHelper.isError();
+    }
+
+    // Moves the cursors to the next code point. Cursors at the last code points of PtNodes are
+    // replaced with the cursors of their children.
+    bool advanceCursors(const int dictIndex, const std::vector<PtNodeCursor>::const_iterator begin,
+            const std::vector<PtNodeCursor>::const_iterator end,
+            std::vector<PtNodeCursor> *const outCursors, bool *const outIsTerminal) const {
+        const PtNodeReader *const ptNodeReader = mPolicies[dictIndex]->getPtNodeReader();
+        for (auto it = begin; it != end; ++it) {
+            const PtNodeParams ptNodeParams =
+                    ptNodeReader->fetchPtNodeParamsInBufferFromPtNodePos(it->mPtNodePos);
+            const int nextCodePointIndex = it->mCodePointIndex + 1;
+            if (nextCodePointIndex < ptNodeParams.getCodePointCount()) {
+                outCursors->emplace_back(it->mPtNodePos, nextCodePointIndex,
+                        ptNodeParams.getCodePoints()[nextCodePointIndex]);
+                continue;
+            }
+            if (ptNodeParams.isTerminal() && !ptNodeParams.isDeleted()) {
+                *outIsTerminal = true;
+            }
+            if (ptNodeParams.hasChildren()
+                    && !readPtNodeArray(dictIndex, ptNodeParams.getChildrenPos(), outCursors)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Merges the cursors of the two dictionaries by their code points. Only the cursors on the
+    // current path are kept while descending.
+    bool diffCursors(std::vector<PtNodeCursor> *const cursors1,
+            std::vector<PtNodeCursor> *const cursors2) {
+        if (mWordCodePoints.size() >= MAX_WORD_LENGTH) {
+            // The tries are broken or have loops.
+            return false;
+        }
+        std::stable_sort(cursors1->begin(), cursors1->end(), compareCursors);
+        std::stable_sort(cursors2->begin(), cursors2->end(), compareCursors);
+        auto it1 = cursors1->cbegin();
+        auto it2 = cursors2->cbegin();
+        while (it1 != cursors1->cend() || it2 != cursors2->cend()) {
+            int codePoint;
+            if (it1 == cursors1->cend()) {
+                codePoint = it2->mCodePoint;
+            } else if (it2 == cursors2->cend()) {
+                codePoint = it1->mCodePoint;
+            } else {
+                codePoint = std::min(it1->mCodePoint, it2->mCodePoint);
+            }
+            auto groupEnd1 = it1;
+            while (groupEnd1 != cursors1->cend() && groupEnd1->mCodePoint == codePoint) {
+                ++groupEnd1;
+            }
+            auto groupEnd2 = it2;
+            while (groupEnd2 != cursors2->cend() && groupEnd2->mCodePoint == codePoint) {
+                ++groupEnd2;
+            }
+            std::vector<PtNodeCursor> nextCursors1;
+            std::vector<PtNodeCursor> nextCursors2;
+            bool isTerminal1 = false;
+            bool isTerminal2 = false;
+            if (!advanceCursors(0 /* dictIndex */, it1, groupEnd1, &nextCursors1, &isTerminal1)
+                    || !advanceCursors(1 /* dictIndex */, it2, groupEnd2, &nextCursors2,
+                            &isTerminal2)) {
+                return false;
+            }
+            mWordCodePoints.push_back(codePoint);
+            if (isTerminal1 || isTerminal2) {
+                diffWords(isTerminal1, isTerminal2);
+            }
+            if ((!nextCursors1.empty() || !nextCursors2.empty())
+                    && !diffCursors(&nextCursors1, &nextCursors2)) {
+                return false;
+            }
+            mWordCodePoints.pop_back();
+            it1 = groupEnd1;
+            it2 = groupEnd2;
+        }
+        return true;
+    }
+
+    void diffWords(const bool isInDict1, const bool isInDict2) {
+        const CodePointArrayView word(mWordCodePoints);
+        const WordProperty wordProperty1 =
+                isInDict1 ? mPolicies[0]->getWordProperty(word) : WordProperty();
+        const WordProperty wordProperty2 =
+                isInDict2 ? mPolicies[1]->getWordProperty(word) : WordProperty();
+        const UnigramProperty &unigramProperty1 = wordProperty1.getUnigramProperty();
+        const UnigramProperty &unigramProperty2 = wordProperty2.getUnigramProperty();
+        if (!isInDict1 || !isInDict2 || !isSameUnigram(unigramProperty1, unigramProperty2)) {
+            mListener->onWordDifference(word, isInDict1 ? &unigramProperty1 : nullptr,
+                    isInDict2 ? &unigramProperty2 : nullptr);
+        }
+        diffEntries(unigramProperty1.getShortcuts(), unigramProperty2.getShortcuts(),
+                [](const UnigramProperty::ShortcutProperty &shortcutProperty) {
+                    return *shortcutProperty.getTargetCodePoints();
+                },
+                [this, word](const UnigramProperty::ShortcutProperty *const shortcutProperty1,
+                        const UnigramProperty::ShortcutProperty *const shortcutProperty2) {
+                    mListener->onShortcutDifference(word, shortcutProperty1, shortcutProperty2);
+                });
+        diffEntries(wordProperty1.getNgramProperties(), wordProperty2.getNgramProperties(),
+                getNgramKey,
+                [this](const NgramProperty *const ngramProperty1,
+                        const NgramProperty *const ngramProperty2) {
+                    mListener->onNgramDifference(ngramProperty1, ngramProperty2);
+                });
+    }
+
+    const DictionaryStructureWithBufferPolicy *const mPolicies[2];
+    DictionaryDiff::DifferenceListener *const mListener;
+    // The code points of the current path.
+    std::vector<int> mWordCodePoints;
+};
+
+} // namespace
+
+/* static */ bool DictionaryDiff::diff(const DictionaryStructureWithBufferPolicy *const policy1,
+        const DictionaryStructureWithBufferPolicy *const policy2,
+        DifferenceListener *const listener) {
+    TrieDiffer trieDiffer(policy1, policy2, listener);
+    return trieDiffer.diff();
+}
+
+} // namespace dicttoolkit
+} // namespace latinime
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_DICT_TOOLKIT_DICTIONARY_DIFF_H
+#define LATINIME_DICT_TOOLKIT_DICTIONARY_DIFF_H
+
+#include "dict_toolkit_defines.h"
+#include "dictionary/property/unigram_property.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+
+class DictionaryStructureWithBufferPolicy;
+class NgramProperty;
+
+namespace dicttoolkit {
+
+// Compares the words, n-grams and shortcuts of two dictionaries. The tries are walked in lockstep
+// by merging the sorted sibling lists at each depth, so the memory usage is bounded by the depth
+// of the tries rather than the size of the dictionaries.
+class DictionaryDiff final {
+ public:
+    // The properties are nullptr for the dictionary that doesn't have the entry. Words are
+    // reported in the code point order, each followed by the differences of its shortcuts and of
+    // the n-grams whose context ends with it.
+    class DifferenceListener {
+     public:
+        virtual ~DifferenceListener() {}
+
+        virtual void onWordDifference(const CodePointArrayView word,
+                const UnigramProperty *const unigramProperty1,
+                const UnigramProperty *const unigramProperty2) = 0;
+        virtual void onShortcutDifference(const CodePointArrayView word,
+                const UnigramProperty::ShortcutProperty *const shortcutProperty1,
+                const UnigramProperty::ShortcutProperty *const shortcutProperty2) = 0;
+        virtual void onNgramDifference(const NgramProperty *const ngramProperty1,
+                const NgramProperty *const ngramProperty2) = 0;
+
+     protected:
+        DifferenceListener() {}
+
+     private:
+        DISALLOW_COPY_AND_ASSIGN(DifferenceListener);
+    };
+
+    // Returns false when either dictionary is broken.
+    static bool diff(const DictionaryStructureWithBufferPolicy *const policy1,
+            const DictionaryStructureWithBufferPolicy *const policy2,
+            DifferenceListener *const listener);
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(DictionaryDiff);
+};
+
+} // namespace dicttoolkit
+} // namespace latinime
+#endif // LATINIME_DICT_TOOLKIT_DICTIONARY_DIFF_H
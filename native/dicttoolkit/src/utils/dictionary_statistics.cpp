@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/dictionary_statistics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "dictionary/structure/pt_common/dynamic_pt_reading_helper.h"
+#include "dictionary/structure/pt_common/pt_node_params.h"
+
+namespace latinime {
+namespace dicttoolkit {
+
+namespace {
+
+// Adds the PtNodes and PtNode arrays below a root PtNode to the statistics.
+class SubtreeStatisticsCollector : public DynamicPtReadingHelper::TraversingEventListener {
+ public:
+    explicit SubtreeStatisticsCollector(DictionaryStatistics *const statistics)
+            : mStatistics(statistics), mPtNodeCountsInArrays() {}
+
+    bool onAscend() {
+        if (mPtNodeCountsInArrays.empty()) {
+            return false;
+        }
+        mStatistics->addPtNodeArray(mPtNodeCountsInArrays.back());
+        mPtNodeCountsInArrays.pop_back();
+        return true;
+    }
+
+    bool onDescend(const int ptNodeArrayPos) {
+        mPtNodeCountsInArrays.push_back(0);
+        return true;
+    }
+
+    bool onReadingPtNodeArrayTail() { return true; }
+
+    bool onVisitingPtNode(const PtNodeParams *const ptNodeParams) {
+        ++mPtNodeCountsInArrays.back();
+        // The subtrees start at the children of the root PtNodes, which have the depth 2.
+        mStatistics->addPtNode(*ptNodeParams, static_cast<int>(mPtNodeCountsInArrays.size()) + 1);
+        return true;
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(SubtreeStatisticsCollector);
+
+    DictionaryStatistics *const mStatistics;
+    std::vector<int> mPtNodeCountsInArrays;
+};
+
+} // namespace
+
+/* static */ bool DictionaryStatistics::collect(
+        const DictionaryStructureWithBufferPolicy *const policy, const int threadCount,
+        DictionaryStatistics *const outStatistics) {
+    const PtNodeReader *const ptNodeReader = policy->getPtNodeReader();
+    const PtNodeArrayReader *const ptNodeArrayReader = policy->getPtNodeArrayReader();
+    // The root PtNode array is read here; the subtrees of its PtNodes are the units of work.
+    std::vector<int> subtreePtNodeArrayPositions;
+    int rootPtNodeCount = 0;
+    DynamicPtReadingHelper readingHelper(ptNodeReader, ptNodeArrayReader);
+    readingHelper.initWithPtNodeArrayPos(policy->getRootPosition());
+    while (!readingHelper.isEnd()) {
+        const PtNodeParams ptNodeParams = readingHelper.getPtNodeParams();
+        if (!ptNodeParams.isValid()) {
+            break;
+        }
+        outStatistics->addPtNode(ptNodeParams, 1 /* depth */);
+        ++rootPtNodeCount;
+        if (ptNodeParams.hasChildren()) {
+            subtreePtNodeArrayPositions.push_back(ptNodeParams.getChildrenPos());
+        }
+        readingHelper.readNextSiblingNode(ptNodeParams);
+    }
+    if (readingHelper.isError()) {
+        return false;
+    }
+    outStatistics->addPtNodeArray(rootPtNodeCount);
+
+    // Each thread takes the next unvisited subtree so that large subtrees don't serialize the
+    // pass, and collects into its own statistics that are merged at the end.
+    std::atomic<size_t> nextSubtreeIndex(0);
+    std::atomic<bool> isBroken(false);
+    const auto collectSubtrees = [&](DictionaryStatistics *const statistics) {
+        DynamicPtReadingHelper subtreeReadingHelper(ptNodeReader, ptNodeArrayReader);
+        SubtreeStatisticsCollector collector(statistics);
+        for (size_t i = nextSubtreeIndex++; i < subtreePtNodeArrayPositions.size();
+                i = nextSubtreeIndex++) {
+            subtreeReadingHelper.initWithPtNodeArrayPos(subtreePtNodeArrayPositions[i]);
+            if (!subtreeReadingHelper.traverseAllPtNodesInPostorderDepthFirstManner(
+                    &collector)) {
+                isBroken = true;
+                return;
+            }
+        }
+    };
+    const int workerCount = std::max(1, std::min(threadCount,
+            static_cast<int>(subtreePtNodeArrayPositions.size())));
+    std::vector<std::unique_ptr<DictionaryStatistics>> workerStatistics;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < workerCount; ++i) {
+        workerStatistics.emplace_back(new DictionaryStatistics());
+    }
+    // The calling thread works as the first worker.
+    for (int i = 1; i < workerCount; ++i) {
+        threads.emplace_back(collectSubtrees, workerStatistics[i].get());
+    }
+    collectSubtrees(workerStatistics[0].get());
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (const auto &statistics : workerStatistics) {
+        outStatistics->merge(*statistics);
+    }
+    return !isBroken;
+}
+
+double DictionaryStatistics::getAveragePtNodeSize() const {
+    if (mPtNodeCount == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(mTotalPtNodeSize) / static_cast<double>(mPtNodeCount);
+}
+
+void DictionaryStatistics::addPtNode(const PtNodeParams &ptNodeParams, const int depth) {
+    ++mPtNodeCount;
+    if (ptNodeParams.isDeleted()) {
+        ++mDeletedPtNodeCount;
+    } else if (ptNodeParams.isTerminal()) {
+        ++mTerminalPtNodeCount;
+    }
+    mTotalPtNodeSize += ptNodeParams.getSiblingNodePos() - ptNodeParams.getHeadPos();
+    incrementHistogram(depth, 1 /* count */, &mDepthHistogram);
+    incrementHistogram(ptNodeParams.getCodePointCount(), 1 /* count */,
+            &mCodePointCountHistogram);
+    const int *const codePoints = ptNodeParams.getCodePoints();
+    for (int i = 0; i < ptNodeParams.getCodePointCount(); ++i) {
+        ++mCodePointCounts[codePoints[i]];
+    }
+}
+
+void DictionaryStatistics::addPtNodeArray(const int ptNodeCount) {
+    ++mPtNodeArrayCount;
+    incrementHistogram(ptNodeCount, 1 /* count */, &mFanOutHistogram);
+}
+
+void DictionaryStatistics::merge(const DictionaryStatistics &statistics) {
+    mPtNodeCount += statistics.mPtNodeCount;
+    mPtNodeArrayCount += statistics.mPtNodeArrayCount;
+    mTerminalPtNodeCount += statistics.mTerminalPtNodeCount;
+    mDeletedPtNodeCount += statistics.mDeletedPtNodeCount;
+    mTotalPtNodeSize += statistics.mTotalPtNodeSize;
+    for (size_t i = 0; i < statistics.mDepthHistogram.size(); ++i) {
+        incrementHistogram(static_cast<int>(i), statistics.mDepthHistogram[i], &mDepthHistogram);
+    }
+    for (size_t i = 0; i < statistics.mFanOutHistogram.size(); ++i) {
+        incrementHistogram(static_cast<int>(i), statistics.mFanOutHistogram[i], &mFanOutHistogram);
+    }
+    for (size_t i = 0; i < statistics.mCodePointCountHistogram.size(); ++i) {
+        incrementHistogram(static_cast<int>(i), statistics.mCodePointCountHistogram[i],
+                &mCodePointCountHistogram);
+    }
+    for (const auto &codePointCount : statistics.mCodePointCounts) {
+        mCodePointCounts[codePointCount.first] += codePointCount.second;
+    }
+}
+
+/* static */ void DictionaryStatistics::incrementHistogram(const int index, const int64_t count,
+        std::vector<int64_t> *const histogram) {
+    if (static_cast<int>(histogram->size()) <= index) {
+        histogram->resize(index + 1, 0);
+    }
+    (*histogram)[index] += count;
+}
+
+} // namespace dicttoolkit
+} // namespace latinime
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_DICT_TOOLKIT_DICTIONARY_STATISTICS_H
+#define LATINIME_DICT_TOOLKIT_DICTIONARY_STATISTICS_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "dict_toolkit_defines.h"
+
+namespace latinime {
+
+class DictionaryStructureWithBufferPolicy;
+class PtNodeParams;
+
+namespace dicttoolkit {
+
+// Structural statistics of the PtNodes of a dictionary.
+class DictionaryStatistics final {
+ public:
+    DictionaryStatistics()
+            : mPtNodeCount(0), mPtNodeArrayCount(0), mTerminalPtNodeCount(0),
+              mDeletedPtNodeCount(0), mTotalPtNodeSize(0), mDepthHistogram(),
+              mFanOutHistogram(), mCodePointCountHistogram(), mCodePointCounts() {}
+
+    // Collects the statistics of all PtNodes in a single pass. The subtrees of the root PtNodes
+    // are distributed over threadCount threads. Returns false when the dictionary is broken.
+    static bool collect(const DictionaryStructureWithBufferPolicy *const policy,
+            const int threadCount, DictionaryStatistics *const outStatistics);
+
+    int64_t getPtNodeCount() const { return mPtNodeCount; }
+    int64_t getPtNodeArrayCount() const { return mPtNodeArrayCount; }
+    // Terminal PtNodes that have not been deleted, i.e. the unigrams.
+    int64_t getTerminalPtNodeCount() const { return mTerminalPtNodeCount; }
+    int64_t getDeletedPtNodeCount() const { return mDeletedPtNodeCount; }
+    int64_t getTotalPtNodeSize() const { return mTotalPtNodeSize; }
+    double getAveragePtNodeSize() const;
+
+    // PtNode counts indexed by depth. PtNodes in the root PtNode array have the depth 1.
+    const std::vector<int64_t> &getDepthHistogram() const { return mDepthHistogram; }
+    // PtNode array counts indexed by the number of PtNodes in the array.
+    const std::vector<int64_t> &getFanOutHistogram() const { return mFanOutHistogram; }
+    // PtNode counts indexed by the number of code points in the PtNode.
+    const std::vector<int64_t> &getCodePointCountHistogram() const {
+        return mCodePointCountHistogram;
+    }
+    // Occurrences of each code point in the PtNodes.
+    const std::unordered_map<int, int64_t> &getCodePointCounts() const {
+        return mCodePointCounts;
+    }
+
+    void addPtNode(const PtNodeParams &ptNodeParams, const int depth);
+    void addPtNodeArray(const int ptNodeCount);
+    void merge(const DictionaryStatistics &statistics);
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(DictionaryStatistics);
+
+    static void incrementHistogram(const int index, const int64_t count,
+            std::vector<int64_t> *const histogram);
+
+    int64_t mPtNodeCount;
+    int64_t mPtNodeArrayCount;
+    int64_t mTerminalPtNodeCount;
+    int64_t mDeletedPtNodeCount;
+    int64_t mTotalPtNodeSize;
+    std::vector<int64_t> mDepthHistogram;
+    std::vector<int64_t> mFanOutHistogram;
+    std::vector<int64_t> mCodePointCountHistogram;
+    std::unordered_map<int, int64_t> mCodePointCounts;
+};
+} // namespace dicttoolkit
+} // namespace latinime
+#endif // LATINIME_DICT_TOOLKIT_DICTIONARY_STATISTICS_H
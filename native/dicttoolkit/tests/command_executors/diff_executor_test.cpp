@@ -18,14 +18,57 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "test_utils/dict_toolkit_test_utils.h"
+
 namespace latinime {
 namespace dicttoolkit {
 namespace {
 
+using tests::DictToolkitTestUtils;
+
 TEST(DiffExecutorTests, TestArguemntSpecs) {
     EXPECT_TRUE(DiffExecutor::getArgumentsParser().validateSpecs());
 }
 
+std::string printDiff(const DictionaryStructureWithBufferPolicy *const policy1,
+        const DictionaryStructureWithBufferPolicy *const policy2, const bool isPlumbing,
+        bool *const outHasDifferences) {
+    FILE *const file = tmpfile();
+    EXPECT_TRUE(DiffExecutor::printDiff(file, policy1, policy2, isPlumbing, outHasDifferences));
+    return DictToolkitTestUtils::readAndCloseTmpFile(file);
+}
+
+TEST(DiffExecutorTests, TestPrintDiff) {
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy1 =
+            DictToolkitTestUtils::createDictionaryWithWords({ "hello", "help" },
+                    100 /* probability */);
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy2 =
+            DictToolkitTestUtils::createDictionaryWithWords({ "hello", "world" },
+                    120 /* probability */);
+    ASSERT_NE(nullptr, policy1.get());
+    ASSERT_NE(nullptr, policy2.get());
+    bool hasDifferences = false;
+    EXPECT_EQ("changed\tword\thello\t100\t120\n"
+            "removed\tword\thelp\t100\t-\n"
+            "added\tword\tworld\t-\t120\n",
+            printDiff(policy1.get(), policy2.get(), true /* isPlumbing */, &hasDifferences));
+    EXPECT_TRUE(hasDifferences);
+
+    const std::string humanReadableOutput =
+            printDiff(policy1.get(), policy2.get(), false /* isPlumbing */, &hasDifferences);
+    EXPECT_NE(std::string::npos, humanReadableOutput.find("~ word: hello [100] -> [120]\n"));
+    EXPECT_NE(std::string::npos, humanReadableOutput.find("  words: 1, 1, 1\n"));
+
+    EXPECT_EQ("No differences.\n",
+            printDiff(policy1.get(), policy1.get(), false /* isPlumbing */, &hasDifferences));
+    EXPECT_FALSE(hasDifferences);
+}
+
 } // namespace
 } // namespace dicttoolkit
 } // namespace latinime
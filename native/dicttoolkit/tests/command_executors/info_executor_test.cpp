@@ -18,14 +18,53 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "test_utils/dict_toolkit_test_utils.h"
+
 namespace latinime {
 namespace dicttoolkit {
 namespace {
 
+using tests::DictToolkitTestUtils;
+
 TEST(InfoExecutorTests, TestArguemntSpecs) {
     EXPECT_TRUE(InfoExecutor::getArgumentsParser().validateSpecs());
 }
 
+std::string printInfo(const DictionaryStructureWithBufferPolicy *const policy,
+        const std::vector<std::string> &words, const bool isPlumbing) {
+    FILE *const file = tmpfile();
+    EXPECT_TRUE(InfoExecutor::printInfo(file, policy, words, isPlumbing, 2 /* threadCount */));
+    return DictToolkitTestUtils::readAndCloseTmpFile(file);
+}
+
+TEST(InfoExecutorTests, TestPrintInfo) {
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+            DictToolkitTestUtils::createDictionary(
+                    { { "hello", 100, false }, { "help", 100, true /* isNotAWord */ } }, {});
+    ASSERT_NE(nullptr, policy.get());
+
+    const std::string output = printInfo(policy.get(), { "help", "world" }, true /* isPlumbing */);
+    EXPECT_NE(std::string::npos, output.find("header.format_version=403\n"));
+    EXPECT_NE(std::string::npos, output.find("pt_node.count=3\n"));
+    EXPECT_NE(std::string::npos, output.find("pt_node.terminal_count=2\n"));
+    EXPECT_NE(std::string::npos, output.find("depth_histogram.2=2\n"));
+    EXPECT_NE(std::string::npos, output.find("fan_out_histogram.2=1\n"));
+    EXPECT_NE(std::string::npos, output.find("code_point.U+006C=2\n"));
+    EXPECT_NE(std::string::npos, output.find("word.help.found=true\n"));
+    EXPECT_NE(std::string::npos, output.find("word.help.probability=100\n"));
+    EXPECT_NE(std::string::npos, output.find("word.help.flags=not_a_word\n"));
+    EXPECT_NE(std::string::npos, output.find("word.world.found=false\n"));
+
+    const std::string humanReadableOutput =
+            printInfo(policy.get(), { "hello" }, false /* isPlumbing */);
+    EXPECT_NE(std::string::npos, humanReadableOutput.find("Word \"hello\":\n  found: true\n"));
+}
+
 } // namespace
 } // namespace dicttoolkit
 } // namespace latinime
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "makedict/combined_format_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dictionary/property/word_property.h"
+#include "offdevice_intermediate_dict/offdevice_intermediate_dict.h"
+#include "test_utils/dict_toolkit_test_utils.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+namespace dicttoolkit {
+namespace {
+
+using tests::DictToolkitTestUtils;
+
+std::string writeDictionary(const OffdeviceIntermediateDict &dict) {
+    FILE *const file = tmpfile();
+    EXPECT_TRUE(CombinedFormatUtils::writeDictionary(dict, file));
+    return DictToolkitTestUtils::readAndCloseTmpFile(file);
+}
+
+const WordProperty *getWordProperty(const OffdeviceIntermediateDict &dict, const char *const word) {
+    return dict.getWordProperty(CodePointArrayView(DictToolkitTestUtils::toCodePoints(word)));
+}
+
+TEST(CombinedFormatUtilsTest, TestReadDictionary) {
+    const std::unique_ptr<OffdeviceIntermediateDict> dict =
+            DictToolkitTestUtils::readCombinedDictionary(DictToolkitTestUtils::COMBINED_DICT);
+    ASSERT_NE(nullptr, dict.get());
+    EXPECT_EQ(3u, dict->getHeader().getAttributeMap().size());
+    EXPECT_EQ(6u, dict->getWordProperties().size());
+
+    const WordProperty *const sample = getWordProperty(*dict, "sample");
+    ASSERT_NE(nullptr, sample);
+    EXPECT_EQ(200, sample->getUnigramProperty().getProbability());
+    ASSERT_EQ(1u, sample->getNgramProperties().size());
+    EXPECT_EQ(243, sample->getNgramProperties()[0].getProbability());
+
+    const WordProperty *const wordlist = getWordProperty(*dict, "wordlist");
+    ASSERT_NE(nullptr, wordlist);
+    ASSERT_EQ(1u, wordlist->getNgramProperties().size());
+    EXPECT_EQ(2u, wordlist->getNgramProperties()[0].getNgramContext()->getPrevWordCount());
+
+    const WordProperty *const witelisted = getWordProperty(*dict, "witelisted");
+    ASSERT_NE(nullptr, witelisted);
+    EXPECT_TRUE(witelisted->getUnigramProperty().isNotAWord());
+    ASSERT_EQ(1u, witelisted->getUnigramProperty().getShortcuts().size());
+    EXPECT_EQ(15, witelisted->getUnigramProperty().getShortcuts()[0].getProbability());
+
+    const WordProperty *const wordlists = getWordProperty(*dict, "wordlists");
+    ASSERT_NE(nullptr, wordlists);
+    EXPECT_TRUE(wordlists->getUnigramProperty().isPossiblyOffensive());
+
+    const std::vector<int> naive = { 'n', 'a', 0xEF, 'v', 'e' };
+    EXPECT_NE(nullptr, dict->getWordProperty(CodePointArrayView(naive)));
+}
+
+TEST(CombinedFormatUtilsTest, TestReadBrokenDictionary) {
+    EXPECT_EQ(nullptr, DictToolkitTestUtils::readCombinedDictionary(
+            "dictionary=main:en\n word=sample,f=x\n").get());
+    EXPECT_EQ(nullptr, DictToolkitTestUtils::readCombinedDictionary(
+            "dictionary=main:en\n  shortcut=target,f=10\n").get());
+    EXPECT_EQ(nullptr, DictToolkitTestUtils::readCombinedDictionary(
+            " word=sample,f=200\n").get());
+}
+
+TEST(CombinedFormatUtilsTest, TestWriteDictionary) {
+    const std::unique_ptr<OffdeviceIntermediateDict> dict =
+            DictToolkitTestUtils::readCombinedDictionary(DictToolkitTestUtils::COMBINED_DICT);
+    ASSERT_NE(nullptr, dict.get());
+    const std::string output = writeDictionary(*dict);
+    EXPECT_EQ(0u, output.find("dictionary=main:en,"));
+    EXPECT_NE(std::string::npos, output.find(" word=sample,f=200\n  ngram=wordlist,f=243\n"));
+    EXPECT_NE(std::string::npos, output.find(
+            " word=witelisted,f=10,not_a_word=true\n  shortcut=whitelisted,f=15\n"));
+
+    const std::unique_ptr<OffdeviceIntermediateDict> rereadDict =
+            DictToolkitTestUtils::readCombinedDictionary(output);
+    ASSERT_NE(nullptr, rereadDict.get());
+    EXPECT_EQ(output, writeDictionary(*rereadDict));
+}
+
+} // namespace
+} // namespace dicttoolkit
+} // namespace latinime
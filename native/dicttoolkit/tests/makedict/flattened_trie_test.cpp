@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "makedict/flattened_trie.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "dictionary/property/word_property.h"
+#include "offdevice_intermediate_dict/offdevice_intermediate_dict.h"
+#include "test_utils/dict_toolkit_test_utils.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+namespace dicttoolkit {
+namespace {
+
+using tests::DictToolkitTestUtils;
+
+void addWords(const std::vector<std::string> &words, OffdeviceIntermediateDict *const dict) {
+    for (const std::string &word : words) {
+        ASSERT_TRUE(dict->addWord(WordProperty(DictToolkitTestUtils::toCodePoints(word),
+                UnigramProperty(), std::vector<NgramProperty>())));
+    }
+}
+
+std::string getPtNodeString(const FlattenedTrie &trie, const int ptNodeIndex) {
+    const CodePointArrayView codePoints =
+            trie.getPtNodeCodePoints(trie.getPtNodes()[ptNodeIndex]);
+    return std::string(codePoints.begin(), codePoints.end());
+}
+
+TEST(FlattenedTrieTest, TestFlattenDictionary) {
+    OffdeviceIntermediateDict dict = OffdeviceIntermediateDict(
+            OffdeviceIntermediateDictHeader(OffdeviceIntermediateDictHeader::AttributeMap()));
+    addWords({ "abc", "abd", "a", "xyz", "xyzw" }, &dict);
+    const FlattenedTrie trie(dict, 1 /* threadCount */);
+
+    // a -> b -> { c, d } and xyz -> w
+    const std::vector<FlattenedTrie::PtNodeArray> &ptNodeArrays = trie.getPtNodeArrays();
+    const std::vector<FlattenedTrie::PtNode> &ptNodes = trie.getPtNodes();
+    ASSERT_EQ(4u, ptNodeArrays.size());
+    ASSERT_EQ(6u, ptNodes.size());
+    EXPECT_EQ(2, ptNodeArrays[0].mPtNodeCount);
+    EXPECT_EQ("a", getPtNodeString(trie, 0));
+    EXPECT_EQ("xyz", getPtNodeString(trie, 1));
+    // The arrays are in preorder and each array is followed by its descendants.
+    EXPECT_EQ(1, ptNodes[0].mChildrenPtNodeArrayIndex);
+    EXPECT_EQ("b", getPtNodeString(trie, ptNodeArrays[1].mFirstPtNodeIndex));
+    EXPECT_EQ(nullptr, ptNodes[ptNodeArrays[1].mFirstPtNodeIndex].mWordProperty);
+    EXPECT_EQ(2, ptNodes[ptNodeArrays[1].mFirstPtNodeIndex].mChildrenPtNodeArrayIndex);
+    EXPECT_EQ(2, ptNodeArrays[2].mPtNodeCount);
+    EXPECT_EQ(3, ptNodes[1].mChildrenPtNodeArrayIndex);
+    for (size_t i = 1; i < ptNodeArrays.size(); ++i) {
+        EXPECT_EQ(ptNodeArrays[i - 1].mFirstPtNodeIndex + ptNodeArrays[i - 1].mPtNodeCount,
+                ptNodeArrays[i].mFirstPtNodeIndex);
+    }
+
+    for (const std::string word : { "abc", "abd", "a", "xyz", "xyzw" }) {
+        const std::vector<int> codePoints = DictToolkitTestUtils::toCodePoints(word);
+        const int ptNodeIndex = trie.getTerminalPtNodeIndex(CodePointArrayView(codePoints));
+        ASSERT_NE(NOT_AN_INDEX, ptNodeIndex) << word;
+        EXPECT_EQ(dict.getWordProperty(CodePointArrayView(codePoints)),
+                ptNodes[ptNodeIndex].mWordProperty);
+    }
+    for (const std::string word : { "ab", "x", "xy", "abcd", "b" }) {
+        EXPECT_EQ(NOT_AN_INDEX, trie.getTerminalPtNodeIndex(
+                CodePointArrayView(DictToolkitTestUtils::toCodePoints(word)))) << word;
+    }
+}
+
+TEST(FlattenedTrieTest, TestThreadCount) {
+    OffdeviceIntermediateDict dict = OffdeviceIntermediateDict(
+            OffdeviceIntermediateDictHeader(OffdeviceIntermediateDictHeader::AttributeMap()));
+    std::vector<std::string> words;
+    for (char first = 'a'; first <= 'z'; ++first) {
+        for (char second = 'a'; second <= 'f'; ++second) {
+            words.push_back(std::string(1, first) + second);
+            words.push_back(std::string(1, first) + second + "ing");
+        }
+    }
+    addWords(words, &dict);
+    const FlattenedTrie singleThreadTrie(dict, 1 /* threadCount */);
+    const FlattenedTrie multiThreadTrie(dict, 4 /* threadCount */);
+    ASSERT_EQ(singleThreadTrie.getPtNodes().size(), multiThreadTrie.getPtNodes().size());
+    ASSERT_EQ(singleThreadTrie.getPtNodeArrays().size(),
+            multiThreadTrie.getPtNodeArrays().size());
+    for (size_t i = 0; i < singleThreadTrie.getPtNodes().size(); ++i) {
+        EXPECT_EQ(getPtNodeString(singleThreadTrie, i), getPtNodeString(multiThreadTrie, i));
+        EXPECT_EQ(singleThreadTrie.getPtNodes()[i].mChildrenPtNodeArrayIndex,
+                multiThreadTrie.getPtNodes()[i].mChildrenPtNodeArrayIndex);
+        EXPECT_EQ(singleThreadTrie.getPtNodes()[i].mWordProperty,
+                multiThreadTrie.getPtNodes()[i].mWordProperty);
+    }
+}
+
+} // namespace
+} // namespace dicttoolkit
+} // namespace latinime
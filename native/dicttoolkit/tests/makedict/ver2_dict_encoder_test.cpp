@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "makedict/ver2_dict_encoder.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "dictionary/property/word_property.h"
+#include "offdevice_intermediate_dict/offdevice_intermediate_dict.h"
+#include "test_utils/dict_toolkit_test_utils.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+namespace dicttoolkit {
+namespace {
+
+using tests::DictToolkitTestUtils;
+
+void checkDictionary(const Ver2DictEncoder::CodePointTableMode codePointTableMode) {
+    const std::unique_ptr<OffdeviceIntermediateDict> dict =
+            DictToolkitTestUtils::readCombinedDictionary(DictToolkitTestUtils::COMBINED_DICT);
+    ASSERT_NE(nullptr, dict.get());
+    std::vector<uint8_t> buffer;
+    ASSERT_TRUE(Ver2DictEncoder::encodeDictionary(*dict, codePointTableMode,
+            2 /* threadCount */, &buffer));
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+            DictToolkitTestUtils::openDictionary(buffer);
+    ASSERT_NE(nullptr, policy.get());
+
+    for (const WordProperty *const expected : dict->getWordProperties()) {
+        const WordProperty actual = policy->getWordProperty(expected->getCodePoints());
+        const UnigramProperty &expectedUnigram = expected->getUnigramProperty();
+        const UnigramProperty &actualUnigram = actual.getUnigramProperty();
+        ASSERT_EQ(expected->getCodePoints().size(), actual.getCodePoints().size());
+        EXPECT_EQ(expectedUnigram.getProbability(), actualUnigram.getProbability());
+        EXPECT_EQ(expectedUnigram.isNotAWord(), actualUnigram.isNotAWord());
+        EXPECT_EQ(expectedUnigram.isPossiblyOffensive(), actualUnigram.isPossiblyOffensive());
+        ASSERT_EQ(expectedUnigram.getShortcuts().size(), actualUnigram.getShortcuts().size());
+        for (size_t i = 0; i < expectedUnigram.getShortcuts().size(); ++i) {
+            EXPECT_EQ(*expectedUnigram.getShortcuts()[i].getTargetCodePoints(),
+                    *actualUnigram.getShortcuts()[i].getTargetCodePoints());
+            EXPECT_EQ(expectedUnigram.getShortcuts()[i].getProbability(),
+                    actualUnigram.getShortcuts()[i].getProbability());
+        }
+        // The ver2 format only has bigrams; trigrams are dropped.
+        std::vector<const NgramProperty *> expectedBigrams;
+        for (const NgramProperty &ngramProperty : expected->getNgramProperties()) {
+            if (ngramProperty.getNgramContext()->getPrevWordCount() == 1) {
+                expectedBigrams.push_back(&ngramProperty);
+            }
+        }
+        ASSERT_EQ(expectedBigrams.size(), actual.getNgramProperties().size());
+        for (size_t i = 0; i < expectedBigrams.size(); ++i) {
+            EXPECT_EQ(*expectedBigrams[i]->getTargetCodePoints(),
+                    *actual.getNgramProperties()[i].getTargetCodePoints());
+            // Bigram probabilities are quantized relative to the unigram probability.
+            EXPECT_NEAR(expectedBigrams[i]->getProbability(),
+                    actual.getNgramProperties()[i].getProbability(), 8);
+        }
+    }
+    EXPECT_EQ(NOT_A_WORD_ID, policy->getWordId(
+            CodePointArrayView(DictToolkitTestUtils::toCodePoints("word")),
+            false /* forceLowerCaseSearch */));
+}
+
+TEST(Ver2DictEncoderTest, TestEncodeDictionary) {
+    checkDictionary(Ver2DictEncoder::CODE_POINT_TABLE_OFF);
+}
+
+TEST(Ver2DictEncoderTest, TestEncodeDictionaryWithCodePointTable) {
+    checkDictionary(Ver2DictEncoder::CODE_POINT_TABLE_ON);
+    checkDictionary(Ver2DictEncoder::CODE_POINT_TABLE_AUTO);
+}
+
+TEST(Ver2DictEncoderTest, TestThreadCount) {
+    const std::unique_ptr<OffdeviceIntermediateDict> dict =
+            DictToolkitTestUtils::readCombinedDictionary(DictToolkitTestUtils::COMBINED_DICT);
+    ASSERT_NE(nullptr, dict.get());
+    std::vector<uint8_t> singleThreadBuffer;
+    ASSERT_TRUE(Ver2DictEncoder::encodeDictionary(*dict, Ver2DictEncoder::CODE_POINT_TABLE_ON,
+            1 /* threadCount */, &singleThreadBuffer));
+    std::vector<uint8_t> multiThreadBuffer;
+    ASSERT_TRUE(Ver2DictEncoder::encodeDictionary(*dict, Ver2DictEncoder::CODE_POINT_TABLE_ON,
+            4 /* threadCount */, &multiThreadBuffer));
+    EXPECT_EQ(singleThreadBuffer, multiThreadBuffer);
+}
+
+} // namespace
+} // namespace dicttoolkit
+} // namespace latinime
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "makedict/ver4_dict_encoder.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dictionary/property/historical_info.h"
+#include "dictionary/property/word_property.h"
+#include "dictionary/utils/file_utils.h"
+#include "makedict/binary_dict_decoder.h"
+#include "offdevice_intermediate_dict/offdevice_intermediate_dict.h"
+#include "test_utils/dict_toolkit_test_utils.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+namespace dicttoolkit {
+namespace {
+
+using tests::DictToolkitTestUtils;
+
+TEST(Ver4DictEncoderTest, TestWriteDictionary) {
+    // The bigram to the missing word is dropped by the encoder.
+    const std::unique_ptr<OffdeviceIntermediateDict> dict =
+            DictToolkitTestUtils::readCombinedDictionary(
+                    std::string(DictToolkitTestUtils::COMBINED_DICT)
+                            + " word=extra,f=100\n  bigram=missing,f=100\n");
+    ASSERT_NE(nullptr, dict.get());
+    char tmpDirPath[] = "/tmp/ver4_dict_encoder_test_XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(tmpDirPath));
+    const std::string dictDirPath = std::string(tmpDirPath) + "/dict";
+    ASSERT_TRUE(Ver4DictEncoder::writeDictionary(*dict, dictDirPath.c_str()));
+    EXPECT_TRUE(BinaryDictDecoder::isBinaryDictionary(dictDirPath.c_str()));
+
+    const std::unique_ptr<OffdeviceIntermediateDict> decodedDict =
+            BinaryDictDecoder::readDictionary(dictDirPath.c_str());
+    ASSERT_NE(nullptr, decodedDict.get());
+    ASSERT_EQ(7u, decodedDict->getWordProperties().size());
+    const WordProperty *const sampleProperty = decodedDict->getWordProperty(
+            CodePointArrayView(DictToolkitTestUtils::toCodePoints("sample")));
+    ASSERT_NE(nullptr, sampleProperty);
+    EXPECT_EQ(200, sampleProperty->getUnigramProperty().getProbability());
+    ASSERT_EQ(1u, sampleProperty->getNgramProperties().size());
+    EXPECT_EQ(243, sampleProperty->getNgramProperties()[0].getProbability());
+    const WordProperty *const extraProperty = decodedDict->getWordProperty(
+            CodePointArrayView(DictToolkitTestUtils::toCodePoints("extra")));
+    ASSERT_NE(nullptr, extraProperty);
+    EXPECT_TRUE(extraProperty->getNgramProperties().empty());
+    const WordProperty *const wordlistProperty = decodedDict->getWordProperty(
+            CodePointArrayView(DictToolkitTestUtils::toCodePoints("wordlist")));
+    ASSERT_NE(nullptr, wordlistProperty);
+    ASSERT_EQ(1u, wordlistProperty->getNgramProperties().size());
+    EXPECT_EQ(2u, wordlistProperty->getNgramProperties()[0].getNgramContext()
+            ->getPrevWordCount());
+    const WordProperty *const shortcutProperty = decodedDict->getWordProperty(
+            CodePointArrayView(DictToolkitTestUtils::toCodePoints("shortcut")));
+    ASSERT_NE(nullptr, shortcutProperty);
+    EXPECT_EQ(1u, shortcutProperty->getUnigramProperty().getShortcuts().size());
+    EXPECT_TRUE(FileUtils::removeDirAndFiles(tmpDirPath));
+}
+
+TEST(Ver4DictEncoderTest, TestWriteDecayingDictionary) {
+    // The entries are long past the time the forgetting curve discards them. The encoder has to
+    // write them as they are instead of decaying them. Levels are 0 as v403 doesn't store them.
+    const std::unique_ptr<OffdeviceIntermediateDict> dict =
+            DictToolkitTestUtils::readCombinedDictionary(
+                    "dictionary=main:en,locale=en,version=1,USES_FORGETTING_CURVE=1,"
+                            "HAS_HISTORICAL_INFO=1\n"
+                    " word=hello,f=100,historicalInfo=1000:0:3\n"
+                    "  bigram=world,f=90,historicalInfo=1200:0:2\n"
+                    " word=world,f=110,historicalInfo=1100:0:1\n");
+    ASSERT_NE(nullptr, dict.get());
+    char tmpDirPath[] = "/tmp/ver4_dict_encoder_test_XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(tmpDirPath));
+    const std::string dictDirPath = std::string(tmpDirPath) + "/dict";
+    ASSERT_TRUE(Ver4DictEncoder::writeDictionary(*dict, dictDirPath.c_str()));
+
+    const std::unique_ptr<OffdeviceIntermediateDict> decodedDict =
+            BinaryDictDecoder::readDictionary(dictDirPath.c_str());
+    ASSERT_NE(nullptr, decodedDict.get());
+    ASSERT_EQ(2u, decodedDict->getWordProperties().size());
+    const WordProperty *const helloProperty = decodedDict->getWordProperty(
+            CodePointArrayView(DictToolkitTestUtils::toCodePoints("hello")));
+    ASSERT_NE(nullptr, helloProperty);
+    const HistoricalInfo helloHistoricalInfo =
+            helloProperty->getUnigramProperty().getHistoricalInfo();
+    EXPECT_EQ(1000, helloHistoricalInfo.getTimestamp());
+    EXPECT_EQ(3, helloHistoricalInfo.getCount());
+    ASSERT_EQ(1u, helloProperty->getNgramProperties().size());
+    const HistoricalInfo bigramHistoricalInfo =
+            helloProperty->getNgramProperties()[0].getHistoricalInfo();
+    EXPECT_EQ(1200, bigramHistoricalInfo.getTimestamp());
+    EXPECT_EQ(2, bigramHistoricalInfo.getCount());
+    const WordProperty *const worldProperty = decodedDict->getWordProperty(
+            CodePointArrayView(DictToolkitTestUtils::toCodePoints("world")));
+    ASSERT_NE(nullptr, worldProperty);
+    const HistoricalInfo worldHistoricalInfo =
+            worldProperty->getUnigramProperty().getHistoricalInfo();
+    EXPECT_EQ(1100, worldHistoricalInfo.getTimestamp());
+    EXPECT_EQ(1, worldHistoricalInfo.getCount());
+    EXPECT_TRUE(FileUtils::removeDirAndFiles(tmpDirPath));
+}
+
+} // namespace
+} // namespace dicttoolkit
+} // namespace latinime
@@ -80,6 +80,51 @@ TEST(OffdeviceIntermediateDictTest, TestAddWordProperties) {
     EXPECT_NE(nullptr, dict.getWordProperty(wordProperty5.getCodePoints()));
 }
 
+TEST(OffdeviceIntermediateDictTest, TestSplitPtNodes) {
+    OffdeviceIntermediateDict dict = OffdeviceIntermediateDict(
+            OffdeviceIntermediateDictHeader(OffdeviceIntermediateDictHeader::AttributeMap()));
+    EXPECT_EQ(NOT_AN_INDEX, dict.getRootPtNodeIndex());
+    EXPECT_TRUE(dict.addWord(getDummpWordProperty(getCodePointVector("abc"))));
+    const WordProperty *const abcWordProperty =
+            dict.getWordProperty(CodePointArrayView(getCodePointVector("abc")));
+    ASSERT_NE(nullptr, abcWordProperty);
+    // Splits "abc" into the non-terminal "ab" and "c".
+    EXPECT_TRUE(dict.addWord(getDummpWordProperty(getCodePointVector("abd"))));
+    // Splits the non-terminal "ab" into the terminal "a" and "b".
+    EXPECT_TRUE(dict.addWord(getDummpWordProperty(getCodePointVector("a"))));
+    // The split PtNodes don't copy the word properties.
+    EXPECT_EQ(abcWordProperty, dict.getWordProperty(CodePointArrayView(getCodePointVector("abc"))));
+    EXPECT_EQ(nullptr, dict.getWordProperty(CodePointArrayView(getCodePointVector("ab"))));
+    EXPECT_FALSE(dict.addWord(getDummpWordProperty(getCodePointVector("a"))));
+    EXPECT_TRUE(dict.addWord(getDummpWordProperty(getCodePointVector("ab"))));
+    EXPECT_TRUE(dict.addWord(getDummpWordProperty(getCodePointVector("0"))));
+
+    // 0 -> a -> b -> { c, d }
+    const OffdeviceIntermediateDictPtNode &zeroPtNode = dict.getPtNode(dict.getRootPtNodeIndex());
+    EXPECT_EQ(1u, dict.getPtNodeCodePoints(zeroPtNode).size());
+    const OffdeviceIntermediateDictPtNode &aPtNode =
+            dict.getPtNode(zeroPtNode.getNextSiblingPtNodeIndex());
+    EXPECT_EQ(NOT_AN_INDEX, aPtNode.getNextSiblingPtNodeIndex());
+    EXPECT_EQ('a', dict.getPtNodeCodePoints(aPtNode)[0]);
+    const OffdeviceIntermediateDictPtNode &bPtNode =
+            dict.getPtNode(aPtNode.getFirstChildPtNodeIndex());
+    EXPECT_EQ(1u, dict.getPtNodeCodePoints(bPtNode).size());
+    EXPECT_NE(nullptr, dict.getPtNodeWordProperty(bPtNode));
+    const OffdeviceIntermediateDictPtNode &cPtNode =
+            dict.getPtNode(bPtNode.getFirstChildPtNodeIndex());
+    EXPECT_EQ('c', dict.getPtNodeCodePoints(cPtNode)[0]);
+    EXPECT_EQ('d', dict.getPtNodeCodePoints(
+            dict.getPtNode(cPtNode.getNextSiblingPtNodeIndex()))[0]);
+
+    const std::vector<const WordProperty *> wordProperties = dict.getWordProperties();
+    ASSERT_EQ(5u, wordProperties.size());
+    const char *const expectedWords[] = { "0", "a", "ab", "abc", "abd" };
+    for (size_t i = 0; i < wordProperties.size(); ++i) {
+        EXPECT_EQ(getCodePointVector(expectedWords[i]),
+                wordProperties[i]->getCodePoints().toVector());
+    }
+}
+
 } // namespace
 } // namespace dicttoolkit
 } // namespace latinime
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_DICT_TOOLKIT_TEST_UTILS_H
+#define LATINIME_DICT_TOOLKIT_TEST_UTILS_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "dict_toolkit_defines.h"
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "dictionary/property/historical_info.h"
+#include "dictionary/property/ngram_context.h"
+#include "dictionary/property/ngram_property.h"
+#include "dictionary/property/unigram_property.h"
+#include "dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "dictionary/utils/format_utils.h"
+#include "makedict/combined_format_utils.h"
+#include "offdevice_intermediate_dict/offdevice_intermediate_dict.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+namespace dicttoolkit {
+namespace tests {
+
+// Builds the dictionaries the dicttoolkit tests work on: the combined format fixture, on-memory
+// v4 dictionaries and binary dictionaries written to temporary files.
+class DictToolkitTestUtils {
+ public:
+    // A combined format dictionary covering bigrams, a trigram, shortcuts, a whitelist entry,
+    // word flags and a non-ASCII word.
+    static constexpr const char *COMBINED_DICT =
+            "# A comment line.\n"
+            "dictionary=main:en,locale=en,version=1\n"
+            " word=sample,f=200\n"
+            "  bigram=wordlist,f=243\n"
+            " word=wordlist,f=180\n"
+            "  prev_word[1]=sample\n"
+            "  ngram=shortcut,f=160\n"
+            " word=wordlists,f=120,possibly_offensive=true\n"
+            " word=shortcut,f=176\n"
+            "  shortcut=target,f=10\n"
+            " word=witelisted,f=10,not_a_word=true\n"
+            "  shortcut=whitelisted,f=whitelist\n"
+            " word=na\xc3\xafve,f=150\n";
+
+    struct Unigram {
+        std::string mWord;
+        int mProbability;
+        bool mIsNotAWord;
+    };
+
+    struct Bigram {
+        std::string mPrevWord;
+        std::string mWord;
+        int mProbability;
+    };
+
+    static std::unique_ptr<OffdeviceIntermediateDict> readCombinedDictionary(
+            const std::string &content) {
+        FILE *const file = tmpfile();
+        if (!file) {
+            return nullptr;
+        }
+        fputs(content.c_str(), file);
+        rewind(file);
+        std::unique_ptr<OffdeviceIntermediateDict> dict =
+                CombinedFormatUtils::readDictionary(file);
+        fclose(file);
+        return dict;
+    }
+
+    // Reads back everything written to the temporary file and closes it.
+    static std::string readAndCloseTmpFile(FILE *const file) {
+        std::string output;
+        rewind(file);
+        char buffer[256];
+        while (fgets(buffer, sizeof(buffer), file)) {
+            output += buffer;
+        }
+        fclose(file);
+        return output;
+    }
+
+    // Creates an updatable on-memory v4 dictionary containing the given unigrams and bigrams.
+    static DictionaryStructureWithBufferPolicy::StructurePolicyPtr createDictionary(
+            const std::vector<Unigram> &unigrams, const std::vector<Bigram> &bigrams) {
+        DictionaryHeaderStructurePolicy::AttributeMap attributeMap;
+        DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+                DictionaryStructureWithBufferPolicyFactory::newPolicyForOnMemoryDict(
+                        FormatUtils::VERSION_403, std::vector<int>(), &attributeMap);
+        if (!policy) {
+            return nullptr;
+        }
+        for (const Unigram &unigram : unigrams) {
+            const UnigramProperty unigramProperty(false /* representsBeginningOfSentence */,
+                    unigram.mIsNotAWord, false /* isPossiblyOffensive */, unigram.mProbability,
+                    HistoricalInfo());
+            if (!policy->addUnigramEntry(CodePointArrayView(toCodePoints(unigram.mWord)),
+                    &unigramProperty)) {
+                return nullptr;
+            }
+        }
+        for (const Bigram &bigram : bigrams) {
+            const std::vector<int> prevWord = toCodePoints(bigram.mPrevWord);
+            const NgramProperty ngramProperty(NgramContext(prevWord.data(), prevWord.size(),
+                    false /* isBeginningOfSentence */), toCodePoints(bigram.mWord),
+                    bigram.mProbability, HistoricalInfo());
+            if (!policy->addNgramEntry(&ngramProperty)) {
+                return nullptr;
+            }
+        }
+        return policy;
+    }
+
+    // Creates a dictionary of the given words sharing one probability.
+    static DictionaryStructureWithBufferPolicy::StructurePolicyPtr createDictionaryWithWords(
+            const std::vector<std::string> &words, const int probability) {
+        std::vector<Unigram> unigrams;
+        for (const std::string &word : words) {
+            unigrams.push_back({ word, probability, false /* isNotAWord */ });
+        }
+        return createDictionary(unigrams, std::vector<Bigram>());
+    }
+
+    // Opens a binary dictionary image through a temporary file. The file is unlinked right away;
+    // the policy keeps it mapped.
+    static DictionaryStructureWithBufferPolicy::StructurePolicyPtr openDictionary(
+            const std::vector<uint8_t> &buffer) {
+        char path[] = "/tmp/dict_toolkit_test_XXXXXX";
+        const int fd = mkstemp(path);
+        if (fd == -1) {
+            return nullptr;
+        }
+        const bool written =
+                write(fd, buffer.data(), buffer.size()) == static_cast<ssize_t>(buffer.size());
+        close(fd);
+        DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy;
+        if (written) {
+            policy = DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+                    path, 0 /* bufOffset */, static_cast<int>(buffer.size()),
+                    false /* isUpdatable */);
+        }
+        unlink(path);
+        return policy;
+    }
+
+    static std::vector<int> toCodePoints(const std::string &str) {
+        return std::vector<int>(str.begin(), str.end());
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(DictToolkitTestUtils);
+};
+
+} // namespace tests
+} // namespace dicttoolkit
+} // namespace latinime
+#endif // LATINIME_DICT_TOOLKIT_TEST_UTILS_H
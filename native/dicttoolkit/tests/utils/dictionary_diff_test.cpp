@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/dictionary_diff.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "dictionary/property/ngram_context.h"
+#include "dictionary/property/ngram_property.h"
+#include "makedict/binary_dict_decoder.h"
+#include "makedict/ver2_dict_encoder.h"
+#include "offdevice_intermediate_dict/offdevice_intermediate_dict.h"
+#include "test_utils/dict_toolkit_test_utils.h"
+
+namespace latinime {
+namespace dicttoolkit {
+namespace {
+
+using tests::DictToolkitTestUtils;
+using Unigram = DictToolkitTestUtils::Unigram;
+
+// Records the differences as "change:type:entry" strings.
+class DifferenceRecorder : public DictionaryDiff::DifferenceListener {
+ public:
+    DifferenceRecorder() : mDifferences() {}
+
+    void onWordDifference(const CodePointArrayView word,
+            const UnigramProperty *const unigramProperty1,
+            const UnigramProperty *const unigramProperty2) {
+        record("word", unigramProperty1, unigramProperty2, std::string(word.begin(), word.end()));
+    }
+
+    void onShortcutDifference(const CodePointArrayView word,
+            const UnigramProperty::ShortcutProperty *const shortcutProperty1,
+            const UnigramProperty::ShortcutProperty *const shortcutProperty2) {
+        record("shortcut", shortcutProperty1, shortcutProperty2,
+                std::string(word.begin(), word.end()));
+    }
+
+    void onNgramDifference(const NgramProperty *const ngramProperty1,
+            const NgramProperty *const ngramProperty2) {
+        const NgramProperty *const ngramProperty = ngramProperty1 ? ngramProperty1 : ngramProperty2;
+        const CodePointArrayView prevWord =
+                ngramProperty->getNgramContext()->getNthPrevWordCodePoints(1 /* n */);
+        record("ngram", ngramProperty1, ngramProperty2,
+                std::string(prevWord.begin(), prevWord.end()) + " " + std::string(
+                        ngramProperty->getTargetCodePoints()->begin(),
+                        ngramProperty->getTargetCodePoints()->end()));
+    }
+
+    const std::vector<std::string> &getDifferences() const { return mDifferences; }
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(DifferenceRecorder);
+
+    template<typename Property>
+    void record(const char *const type, const Property *const property1,
+            const Property *const property2, const std::string &entry) {
+        const char *const change = !property1 ? "added" : (!property2 ? "removed" : "changed");
+        mDifferences.push_back(std::string(change) + ":" + type + ":" + entry);
+    }
+
+    std::vector<std::string> mDifferences;
+};
+
+TEST(DictionaryDiffTest, TestDiff) {
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy1 =
+            DictToolkitTestUtils::createDictionary(
+                    { { "hello", 100, false }, { "help", 100, false }, { "world", 80, false },
+                      { "word", 90, false } },
+                    { { "hello", "world", 150 }, { "help", "word", 120 } });
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy2 =
+            DictToolkitTestUtils::createDictionary(
+                    { { "word", 90, false }, { "world", 80, true }, { "helpful", 90, false },
+                      { "hello", 120, false } },
+                    { { "hello", "world", 160 }, { "hello", "word", 100 } });
+    ASSERT_NE(nullptr, policy1.get());
+    ASSERT_NE(nullptr, policy2.get());
+    DifferenceRecorder recorder;
+    ASSERT_TRUE(DictionaryDiff::diff(policy1.get(), policy2.get(), &recorder));
+    const std::vector<std::string> expectedDifferences = {
+        "changed:word:hello",
+        "added:ngram:hello word",
+        "changed:ngram:hello world",
+        "removed:word:help",
+        "removed:ngram:help word",
+        "added:word:helpful",
+        "changed:word:world",
+    };
+    EXPECT_EQ(expectedDifferences, recorder.getDifferences());
+
+    DifferenceRecorder sameRecorder;
+    ASSERT_TRUE(DictionaryDiff::diff(policy1.get(), policy1.get(), &sameRecorder));
+    EXPECT_TRUE(sameRecorder.getDifferences().empty());
+}
+
+TEST(DictionaryDiffTest, TestDiffDifferentFormats) {
+    // The ver2 dictionary has different PtNode splits and orders from the ver4 dictionary.
+    const std::vector<Unigram> unigrams = { { "zebra", 60, false }, { "abcdef", 100, false },
+            { "abc", 90, true }, { "abx", 80, false }, { "b", 70, false } };
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr ver4Policy =
+            DictToolkitTestUtils::createDictionary(unigrams, {});
+    ASSERT_NE(nullptr, ver4Policy.get());
+    const std::unique_ptr<OffdeviceIntermediateDict> dict =
+            BinaryDictDecoder::readDictionary(ver4Policy.get());
+    ASSERT_NE(nullptr, dict.get());
+    std::vector<uint8_t> buffer;
+    ASSERT_TRUE(Ver2DictEncoder::encodeDictionary(*dict, Ver2DictEncoder::CODE_POINT_TABLE_OFF,
+            1 /* threadCount */, &buffer));
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr ver2Policy =
+            DictToolkitTestUtils::openDictionary(buffer);
+    ASSERT_NE(nullptr, ver2Policy.get());
+
+    DifferenceRecorder recorder;
+    ASSERT_TRUE(DictionaryDiff::diff(ver4Policy.get(), ver2Policy.get(), &recorder));
+    EXPECT_TRUE(recorder.getDifferences().empty());
+
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr otherPolicy =
+            DictToolkitTestUtils::createDictionary(
+                    { { "abcdef", 100, false }, { "abcd", 70, false }, { "b", 70, false } }, {});
+    DifferenceRecorder otherRecorder;
+    ASSERT_TRUE(DictionaryDiff::diff(ver2Policy.get(), otherPolicy.get(), &otherRecorder));
+    const std::vector<std::string> expectedDifferences = {
+        "removed:word:abc",
+        "added:word:abcd",
+        "removed:word:abx",
+        "removed:word:zebra",
+    };
+    EXPECT_EQ(expectedDifferences, otherRecorder.getDifferences());
+}
+
+} // namespace
+} // namespace dicttoolkit
+} // namespace latinime
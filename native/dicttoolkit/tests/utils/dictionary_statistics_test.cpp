@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/dictionary_statistics.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "test_utils/dict_toolkit_test_utils.h"
+
+namespace latinime {
+namespace dicttoolkit {
+namespace {
+
+using tests::DictToolkitTestUtils;
+
+DictionaryStructureWithBufferPolicy::StructurePolicyPtr createPolicy(
+        const std::vector<std::string> &words) {
+    return DictToolkitTestUtils::createDictionaryWithWords(words, 100 /* probability */);
+}
+
+TEST(DictionaryStatisticsTests, TestCollect) {
+    const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+            createPolicy({ "a", "ab", "abc", "b", "bcd" });
+    DictionaryStatistics statistics;
+    ASSERT_TRUE(DictionaryStatistics::collect(policy.get(), 1 /* threadCount */, &statistics));
+    // a _ b _ c
+    // b _ cd
+    EXPECT_EQ(5, statistics.getPtNodeCount());
+    EXPECT_EQ(5, statistics.getTerminalPtNodeCount());
+    EXPECT_EQ(0, statistics.getDeletedPtNodeCount());
+    EXPECT_EQ(4, statistics.getPtNodeArrayCount());
+    EXPECT_EQ((std::vector<int64_t>{ 0, 2, 2, 1 }), statistics.getDepthHistogram());
+    EXPECT_EQ((std::vector<int64_t>{ 0, 3, 1 }), statistics.getFanOutHistogram());
+    EXPECT_EQ((std::vector<int64_t>{ 0, 4, 1 }), statistics.getCodePointCountHistogram());
+    EXPECT_EQ(1, statistics.getCodePointCounts().at('a'));
+    EXPECT_EQ(2, statistics.getCodePointCounts().at('b'));
+    EXPECT_EQ(2, statistics.getCodePointCounts().at('c'));
+    EXPECT_EQ(1, statistics.getCodePointCounts().at('d'));
+    EXPECT_GT(statistics.getAveragePtNodeSize(), 0.0);
+}
+
+TEST(DictionaryStatisticsTests, TestCollectWithThreads) {
+    std::vector<std::string> words;
+    for (char first = 'a'; first <= 'z'; ++first) {
+        for (char second = 'a'; second <= 'z'; second += 3) {
+            words.push_back(std::string(1, first) + second);
+            words.push_back(std::string(1, first) + second + "ing");
+        }
+    }
+    const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy = createPolicy(words);
+    DictionaryStatistics expectedStatistics;
+    ASSERT_TRUE(DictionaryStatistics::collect(policy.get(), 1 /* threadCount */,
+            &expectedStatistics));
+    EXPECT_EQ(static_cast<int64_t>(words.size()), expectedStatistics.getTerminalPtNodeCount());
+    for (const int threadCount : { 2, 4, 64 }) {
+        DictionaryStatistics statistics;
+        ASSERT_TRUE(DictionaryStatistics::collect(policy.get(), threadCount, &statistics));
+        EXPECT_EQ(expectedStatistics.getPtNodeCount(), statistics.getPtNodeCount());
+        EXPECT_EQ(expectedStatistics.getTerminalPtNodeCount(),
+                statistics.getTerminalPtNodeCount());
+        EXPECT_EQ(expectedStatistics.getPtNodeArrayCount(), statistics.getPtNodeArrayCount());
+        EXPECT_EQ(expectedStatistics.getTotalPtNodeSize(), statistics.getTotalPtNodeSize());
+        EXPECT_EQ(expectedStatistics.getDepthHistogram(), statistics.getDepthHistogram());
+        EXPECT_EQ(expectedStatistics.getFanOutHistogram(), statistics.getFanOutHistogram());
+        EXPECT_EQ(expectedStatistics.getCodePointCounts(), statistics.getCodePointCounts());
+    }
+}
+
+} // namespace
+} // namespace dicttoolkit
+} // namespace latinime
@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host benchmark of the suggestion search. Replays typing and gesture traces on a synthetic
+// QWERTY layout and reports latency percentiles, expanded dic nodes and heap allocations per
+// getSuggestions call.
+//
+// The dictionary is read from the file given by the LATINIME_BENCHMARK_DICT environment variable
+// when it is set, otherwise a synthetic dictionary is generated.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+#include "defines.h"
+#include "dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "suggest/core/dictionary/dictionary.h"
+#include "suggest/core/layout/proximity_info.h"
+#include "suggest/core/result/suggestion_results.h"
+#include "suggest/core/session/dic_traverse_session.h"
+#include "suggest/policyimpl/gesture/gesture_suggest_policy_factory.h"
+#include "test_utils/suggest_test_utils.h"
+
+namespace {
+
+std::atomic<int64_t> sAllocationCount(0);
+
+} // namespace
+
+void *operator new(size_t size) {
+    sAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *const ptr = malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+// GCC doesn't know that operator new above allocates with malloc. Once the replacements are
+// inlined into code that calls new, it takes free() for a release of memory from new.
+#if defined(__GNUC__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void *ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t /* size */) noexcept {
+    free(ptr);
+}
+#if defined(__GNUC__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+namespace latinime {
+namespace {
+
+using tests::SuggestTestUtils;
+
+const int SYNTHETIC_WORD_COUNT = 50000;
+// Makes the sessions use the large cache as for main dictionaries.
+const int64_t MAIN_DICTIONARY_SIZE = 1024 * 1024;
+
+// Words replayed by the benchmarks. They are also added to the synthetic dictionary.
+const char *const REPLAYED_WORDS[] = { "the", "hello", "keyboard", "because", "something",
+        "information", "yesterday", "probably", "wonderful", "question" };
+
+// Generates pronounceable lowercase words with a Zipf-like probability distribution.
+std::unique_ptr<Dictionary> createSyntheticDictionary() {
+    static const char *const CONSONANTS = "bcdfghjklmnprstvwz";
+    static const char *const VOWELS = "aeiouy";
+    std::vector<std::string> words;
+    std::vector<int> probabilities;
+    for (const char *const word : REPLAYED_WORDS) {
+        words.push_back(word);
+        probabilities.push_back(200);
+    }
+    uint32_t seed = 1;
+    for (int i = 0; i < SYNTHETIC_WORD_COUNT; ++i) {
+        std::string word;
+        seed = seed * 1103515245u + 12345u;
+        const int syllableCount = 1 + static_cast<int>((seed >> 16) % 4);
+        for (int j = 0; j < syllableCount; ++j) {
+            seed = seed * 1103515245u + 12345u;
+            word.push_back(CONSONANTS[(seed >> 16) % 18]);
+            word.push_back(VOWELS[(seed >> 8) % 6]);
+        }
+        words.push_back(word);
+        probabilities.push_back(std::max(1, 220 - 32 * static_cast<int>(log10(i + 1.0) * 2)));
+    }
+    return SuggestTestUtils::createDictionary(words, probabilities);
+}
+
+std::unique_ptr<Dictionary> createDictionary() {
+    const char *const dictPath = getenv("LATINIME_BENCHMARK_DICT");
+    if (!dictPath) {
+        return createSyntheticDictionary();
+    }
+    struct stat statBuf;
+    if (stat(dictPath, &statBuf) != 0) {
+        return nullptr;
+    }
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+            DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(dictPath,
+                    0 /* bufOffset */, static_cast<int>(statBuf.st_size),
+                    false /* isUpdatable */);
+    if (!policy) {
+        return nullptr;
+    }
+    return std::unique_ptr<Dictionary>(new Dictionary(std::move(policy)));
+}
+
+// The dictionary and the layout are shared by all benchmarks.
+struct BenchmarkEnvironment {
+    std::unique_ptr<Dictionary> mDictionary;
+    std::unique_ptr<ProximityInfo> mProximityInfo;
+
+    static BenchmarkEnvironment *getInstance() {
+        static BenchmarkEnvironment *const sInstance = new BenchmarkEnvironment();
+        return sInstance;
+    }
+
+ private:
+    BenchmarkEnvironment()
+            : mDictionary(createDictionary()),
+              mProximityInfo(SuggestTestUtils::createQwertyProximityInfo()) {}
+};
+
+// Collects the per call measurements and reports them as counters.
+class CallStats {
+ public:
+    CallStats() : mLatenciesInMicroseconds(), mExpandedDicNodeCount(0), mAllocationCount(0) {}
+
+    template<typename Function>
+    void measure(DicTraverseSession *const traverseSession, const Function &function) {
+        const int64_t allocationCountBefore = sAllocationCount.load(std::memory_order_relaxed);
+        const auto startTime = std::chrono::steady_clock::now();
+        function();
+        const auto endTime = std::chrono::steady_clock::now();
+        mAllocationCount += sAllocationCount.load(std::memory_order_relaxed)
+                - allocationCountBefore;
+        mExpandedDicNodeCount += traverseSession->getExpandedDicNodeCount();
+        mLatenciesInMicroseconds.push_back(static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count())
+                        / 1000.0);
+    }
+
+    void report(benchmark::State *const state) {
+        if (mLatenciesInMicroseconds.empty()) {
+            return;
+        }
+        std::sort(mLatenciesInMicroseconds.begin(), mLatenciesInMicroseconds.end());
+        const double callCount = static_cast<double>(mLatenciesInMicroseconds.size());
+        state->counters["p50_us"] = getPercentile(0.5);
+        state->counters["p90_us"] = getPercentile(0.9);
+        state->counters["p99_us"] = getPercentile(0.99);
+        state->counters["nodes_per_call"] = static_cast<double>(mExpandedDicNodeCount) / callCount;
+        state->counters["allocs_per_call"] = static_cast<double>(mAllocationCount) / callCount;
+    }
+
+ private:
+    double getPercentile(const double ratio) const {
+        const size_t index = static_cast<size_t>(
+                ratio * static_cast<double>(mLatenciesInMicroseconds.size() - 1));
+        return mLatenciesInMicroseconds[index];
+    }
+
+    std::vector<double> mLatenciesInMicroseconds;
+    int64_t mExpandedDicNodeCount;
+    int64_t mAllocationCount;
+};
+
+// Replays a typed word one key at a time, as the keyboard asks for suggestions on every key.
+void BM_TypingSuggestions(benchmark::State &state) {
+    BenchmarkEnvironment *const environment = BenchmarkEnvironment::getInstance();
+    if (!environment->mDictionary) {
+        state.SkipWithError("Cannot load the dictionary.");
+        return;
+    }
+    const SuggestTestUtils::InputTrace wordTrace =
+            SuggestTestUtils::createTypingTrace(REPLAYED_WORDS[state.range(0)]);
+    std::unique_ptr<DicTraverseSession> session(
+            DicTraverseSession::getSessionInstance(MAIN_DICTIONARY_SIZE));
+    CallStats callStats;
+    for (auto _ : state) {
+        for (int inputSize = 1; inputSize <= wordTrace.size(); ++inputSize) {
+            SuggestTestUtils::InputTrace trace = wordTrace;
+            trace.mCodePoints.resize(inputSize);
+            trace.mXCoordinates.resize(inputSize);
+            trace.mYCoordinates.resize(inputSize);
+            trace.mTimes.resize(inputSize);
+            trace.mPointerIds.resize(inputSize);
+            SuggestionResults suggestionResults(MAX_RESULTS);
+            callStats.measure(session.get(), [&]() {
+                SuggestTestUtils::getSuggestions(environment->mDictionary.get(), session.get(),
+                        environment->mProximityInfo.get(), &trace, false /* isGesture */,
+                        &suggestionResults);
+            });
+            benchmark::DoNotOptimize(suggestionResults.getSuggestionCount());
+        }
+    }
+    callStats.report(&state);
+    state.SetLabel(REPLAYED_WORDS[state.range(0)]);
+}
+
+void BM_GestureSuggestions(benchmark::State &state) {
+    BenchmarkEnvironment *const environment = BenchmarkEnvironment::getInstance();
+    if (!environment->mDictionary) {
+        state.SkipWithError("Cannot load the dictionary.");
+        return;
+    }
+    if (!GestureSuggestPolicyFactory::getGestureSuggestPolicy()) {
+        state.SkipWithError("No gesture suggest policy is available.");
+        return;
+    }
+    SuggestTestUtils::InputTrace trace =
+            SuggestTestUtils::createGestureTrace(REPLAYED_WORDS[state.range(0)]);
+    std::unique_ptr<DicTraverseSession> session(
+            DicTraverseSession::getSessionInstance(MAIN_DICTIONARY_SIZE));
+    CallStats callStats;
+    for (auto _ : state) {
+        SuggestionResults suggestionResults(MAX_RESULTS);
+        callStats.measure(session.get(), [&]() {
+            SuggestTestUtils::getSuggestions(environment->mDictionary.get(), session.get(),
+                    environment->mProximityInfo.get(), &trace, true /* isGesture */,
+                    &suggestionResults);
+        });
+        benchmark::DoNotOptimize(suggestionResults.getSuggestionCount());
+    }
+    callStats.report(&state);
+    state.SetLabel(REPLAYED_WORDS[state.range(0)]);
+}
+
+BENCHMARK(BM_TypingSuggestions)->DenseRange(0, NELEMS(REPLAYED_WORDS) - 1);
+BENCHMARK(BM_GestureSuggestions)->DenseRange(0, NELEMS(REPLAYED_WORDS) - 1);
+
+} // namespace
+} // namespace latinime
+
+BENCHMARK_MAIN();
@@ -22,6 +22,7 @@
 #include "jni.h"
 #include "jni_common.h"
 #include "suggest/core/layout/proximity_info.h"
+#include "suggest/core/layout/proximity_info_cache.h"
 
 namespace latinime {
 
@@ -30,25 +31,36 @@ static jlong latinime_Keyboard_setProximityInfo(JNIEnv *env, jclass clazz,
         jint mostCommonkeyWidth, jint mostCommonkeyHeight, jintArray proximityChars, jint keyCount,
         jintArray keyXCoordinates, jintArray keyYCoordinates, jintArray keyWidths,
         jintArray keyHeights, jintArray keyCharCodes, jfloatArray sweetSpotCenterXs,
-        jfloatArray sweetSpotCenterYs, jfloatArray sweetSpotRadii) {
+        jfloatArray sweetSpotCenterYs, jfloatArray sweetSpotRadii, jlong fingerprint) {
     ProximityInfo *proximityInfo = new ProximityInfo(env, displayWidth, displayHeight,
             gridWidth, gridHeight, mostCommonkeyWidth, mostCommonkeyHeight, proximityChars,
             keyCount, keyXCoordinates, keyYCoordinates, keyWidths, keyHeights, keyCharCodes,
             sweetSpotCenterXs, sweetSpotCenterYs, sweetSpotRadii);
-    return reinterpret_cast<jlong>(proximityInfo);
+    return reinterpret_cast<jlong>(
+            ProximityInfoCache::getInstance()->add(fingerprint, proximityInfo));
+}
+
+static jlong latinime_Keyboard_getCachedProximityInfo(JNIEnv *env, jclass clazz,
+        jlong fingerprint) {
+    return reinterpret_cast<jlong>(ProximityInfoCache::getInstance()->acquire(fingerprint));
 }
 
 static void latinime_Keyboard_release(JNIEnv *env, jclass clazz, jlong proximityInfo) {
-    ProximityInfo *pi = reinterpret_cast<ProximityInfo *>(proximityInfo);
-    delete pi;
+    ProximityInfoCache::getInstance()->release(
+            reinterpret_cast<ProximityInfo *>(proximityInfo));
 }
 
 static const JNINativeMethod sMethods[] = {
     {
         const_cast<char *>("setProximityInfoNative"),
-        const_cast<char *>("(IIIIII[II[I[I[I[I[I[F[F[F)J"),
+        const_cast<char *>("(IIIIII[II[I[I[I[I[I[F[F[FJ)J"),
         reinterpret_cast<void *>(latinime_Keyboard_setProximityInfo)
     },
+    {
+        const_cast<char *>("getCachedProximityInfoNative"),
+        const_cast<char *>("(J)J"),
+        reinterpret_cast<void *>(latinime_Keyboard_getCachedProximityInfo)
+    },
     {
         const_cast<char *>("releaseProximityInfoNative"),
         const_cast<char *>("(J)V"),
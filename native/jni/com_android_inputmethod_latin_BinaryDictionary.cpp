@@ -19,6 +19,7 @@
 #include "com_android_inputmethod_latin_BinaryDictionary.h"
 
 #include <cstring> // for memset()
+#include <memory>
 #include <vector>
 
 #include "defines.h"
@@ -26,10 +27,14 @@
 #include "dictionary/property/ngram_context.h"
 #include "dictionary/property/word_property.h"
 #include "dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "dictionary/utils/word_batch.h"
+#include "dictionary/utils/word_property_batch.h"
 #include "jni.h"
 #include "jni_common.h"
 #include "suggest/core/dictionary/dictionary.h"
 #include "suggest/core/result/suggestion_results.h"
+#include "suggest/core/session/dic_traverse_session.h"
+#include "suggest/core/session/suggestion_buffer.h"
 #include "suggest/core/suggest_options.h"
 #include "utils/char_utils.h"
 #include "utils/int_array_view.h"
@@ -37,6 +42,7 @@
 #include "utils/log_utils.h"
 #include "utils/profiler.h"
 #include "utils/time_keeper.h"
+#include "utils/trace_counters.h"
 
 namespace latinime {
 
@@ -245,6 +251,7 @@ static void latinime_BinaryDictionary_getSuggestions(JNIEnv *env, jclass clazz,
     const NgramContext ngramContext = JniDataUtils::constructNgramContext(env,
             prevWordCodePointArrays, isBeginningOfSentenceArray, prevWordCount);
     if (givenSuggestOptions.isGesture() || inputSize > 0) {
+        traverseSession->setSharedInputSession(nullptr);
         // TODO: Use SuggestionResults to return suggestions.
         dictionary->getSuggestions(pInfo, traverseSession, xCoordinates, yCoordinates,
                 times, pointerIds, inputCodePoints, inputSize, &ngramContext,
@@ -257,7 +264,177 @@ static void latinime_BinaryDictionary_getSuggestions(JNIEnv *env, jclass clazz,
     }
     suggestionResults.outputSuggestions(env, outSuggestionCount, outCodePointsArray,
             outScoresArray, outSpaceIndicesArray, outTypesArray,
-            outAutoCommitFirstWordConfidenceArray, inOutWeightOfLangModelVsSpatialModel);
+            outAutoCommitFirstWordConfidenceArray, inOutWeightOfLangModelVsSpatialModel,
+            nullptr /* outSourceDictionaryIndicesArray */);
+}
+
+static void latinime_BinaryDictionary_getSuggestionsFromDictionaries(JNIEnv *env, jclass clazz,
+        jlongArray dicts, jlongArray dicTraverseSessions, jfloatArray dictionaryWeightsArray,
+        jlong proximityInfo, jintArray xCoordinatesArray, jintArray yCoordinatesArray,
+        jintArray timesArray, jintArray pointerIdsArray, jintArray inputCodePointsArray,
+        jint inputSize, jobjectArray suggestOptionsArrays,
+        jobjectArray prevWordCodePointArrays, jbooleanArray isBeginningOfSentenceArray,
+        jint prevWordCount, jintArray outSuggestionCount, jintArray outCodePointsArray,
+        jintArray outScoresArray, jintArray outSpaceIndicesArray, jintArray outTypesArray,
+        jintArray outAutoCommitFirstWordConfidenceArray,
+        jfloatArray inOutWeightOfLangModelVsSpatialModel,
+        jintArray outSourceDictionaryIndicesArray) {
+    // Assign 0 to outSuggestionCount here in case of returning earlier in this method.
+    JniDataUtils::putIntToArray(env, outSuggestionCount, 0 /* index */, 0);
+    const jsize dictionaryCount = env->GetArrayLength(dicts);
+    if (dictionaryCount <= 0 || env->GetArrayLength(dicTraverseSessions) != dictionaryCount
+            || env->GetArrayLength(dictionaryWeightsArray) != dictionaryCount
+            || env->GetArrayLength(suggestOptionsArrays) != dictionaryCount) {
+        AKLOGE("Invalid dictionary count: %d", dictionaryCount);
+        return;
+    }
+    jlong dictHandles[dictionaryCount];
+    jlong sessionHandles[dictionaryCount];
+    float dictionaryWeights[dictionaryCount];
+    env->GetLongArrayRegion(dicts, 0, dictionaryCount, dictHandles);
+    env->GetLongArrayRegion(dicTraverseSessions, 0, dictionaryCount, sessionHandles);
+    env->GetFloatArrayRegion(dictionaryWeightsArray, 0, dictionaryCount, dictionaryWeights);
+    const Dictionary *dictionaries[dictionaryCount];
+    DicTraverseSession *traverseSessions[dictionaryCount];
+    for (int i = 0; i < dictionaryCount; ++i) {
+        dictionaries[i] = reinterpret_cast<Dictionary *>(dictHandles[i]);
+        traverseSessions[i] = reinterpret_cast<DicTraverseSession *>(sessionHandles[i]);
+        if (!dictionaries[i] || !traverseSessions[i]) {
+            return;
+        }
+    }
+    ProximityInfo *pInfo = reinterpret_cast<ProximityInfo *>(proximityInfo);
+    // Input values
+    int xCoordinates[inputSize];
+    int yCoordinates[inputSize];
+    int times[inputSize];
+    int pointerIds[inputSize];
+    const jsize inputCodePointsLength = env->GetArrayLength(inputCodePointsArray);
+    int inputCodePoints[inputCodePointsLength];
+    env->GetIntArrayRegion(xCoordinatesArray, 0, inputSize, xCoordinates);
+    env->GetIntArrayRegion(yCoordinatesArray, 0, inputSize, yCoordinates);
+    env->GetIntArrayRegion(timesArray, 0, inputSize, times);
+    env->GetIntArrayRegion(pointerIdsArray, 0, inputSize, pointerIds);
+    env->GetIntArrayRegion(inputCodePointsArray, 0, inputCodePointsLength, inputCodePoints);
+
+    // Each dictionary is searched with its own options, e.g. whether to use the full edit
+    // distance.
+    std::vector<std::vector<int>> options(dictionaryCount);
+    std::vector<std::unique_ptr<const SuggestOptions>> givenSuggestOptions;
+    const SuggestOptions *suggestOptions[dictionaryCount];
+    for (int i = 0; i < dictionaryCount; ++i) {
+        jintArray optionsArray =
+                static_cast<jintArray>(env->GetObjectArrayElement(suggestOptionsArrays, i));
+        if (!optionsArray) {
+            AKLOGE("The options of dictionary %d are null.", i);
+            return;
+        }
+        options[i].resize(env->GetArrayLength(optionsArray));
+        env->GetIntArrayRegion(optionsArray, 0, options[i].size(), options[i].data());
+        env->DeleteLocalRef(optionsArray);
+        givenSuggestOptions.emplace_back(new SuggestOptions(options[i].data(),
+                options[i].size()));
+        suggestOptions[i] = givenSuggestOptions.back().get();
+    }
+
+    // Output values
+    const jsize outputCodePointsLength = env->GetArrayLength(outCodePointsArray);
+    if (outputCodePointsLength != (MAX_WORD_LENGTH * MAX_RESULTS)) {
+        AKLOGE("Invalid outputCodePointsLength: %d", outputCodePointsLength);
+        ASSERT(false);
+        return;
+    }
+    const jsize scoresLength = env->GetArrayLength(outScoresArray);
+    if (scoresLength != MAX_RESULTS
+            || env->GetArrayLength(outSourceDictionaryIndicesArray) != MAX_RESULTS) {
+        AKLOGE("Invalid scoresLength: %d", scoresLength);
+        ASSERT(false);
+        return;
+    }
+    float weightOfLangModelVsSpatialModel;
+    env->GetFloatArrayRegion(inOutWeightOfLangModelVsSpatialModel, 0, 1 /* len */,
+            &weightOfLangModelVsSpatialModel);
+    SuggestionResults suggestionResults(MAX_RESULTS);
+    const NgramContext ngramContext = JniDataUtils::constructNgramContext(env,
+            prevWordCodePointArrays, isBeginningOfSentenceArray, prevWordCount);
+    if (suggestOptions[0]->isGesture() || inputSize > 0) {
+        Dictionary::getSuggestionsFromDictionaries(dictionaries, traverseSessions, suggestOptions,
+                dictionaryWeights, dictionaryCount, pInfo, xCoordinates, yCoordinates, times,
+                pointerIds, inputCodePoints, inputSize, &ngramContext,
+                weightOfLangModelVsSpatialModel, &suggestionResults);
+    } else {
+        SuggestionResults allPredictionResults(MAX_RESULTS * dictionaryCount);
+        for (int i = 0; i < dictionaryCount; ++i) {
+            SuggestionResults predictionResults(MAX_RESULTS);
+            dictionaries[i]->getPredictions(&ngramContext, &predictionResults);
+            allPredictionResults.addSuggestionsFrom(&predictionResults, dictionaryWeights[i],
+                    i /* sourceDictionaryIndex */);
+        }
+        suggestionResults.addUniqueSuggestionsFrom(&allPredictionResults);
+    }
+    if (DEBUG_DICT) {
+        suggestionResults.dumpSuggestions();
+    }
+    suggestionResults.outputSuggestions(env, outSuggestionCount, outCodePointsArray,
+            outScoresArray, outSpaceIndicesArray, outTypesArray,
+            outAutoCommitFirstWordConfidenceArray, inOutWeightOfLangModelVsSpatialModel,
+            outSourceDictionaryIndicesArray);
+}
+
+static jboolean latinime_BinaryDictionary_getSuggestionsWithBuffer(JNIEnv *env, jclass clazz,
+        jlong dict, jlong proximityInfo, jlong dicTraverseSession, jobject suggestionByteBuffer) {
+    Dictionary *dictionary = reinterpret_cast<Dictionary *>(dict);
+    DicTraverseSession *traverseSession =
+            reinterpret_cast<DicTraverseSession *>(dicTraverseSession);
+    if (!dictionary || !traverseSession) {
+        return false;
+    }
+    const jlong bufferSize = env->GetDirectBufferCapacity(suggestionByteBuffer);
+    const SuggestionBuffer suggestionBuffer(
+            static_cast<int32_t *>(env->GetDirectBufferAddress(suggestionByteBuffer)),
+            bufferSize > 0 ? static_cast<size_t>(bufferSize) : 0);
+    if (!suggestionBuffer.isValid()) {
+        return false;
+    }
+    *suggestionBuffer.getOutSuggestionCount() = 0;
+    const NgramContext *const ngramContext =
+            traverseSession->getCachedNgramContext(suggestionBuffer.getNgramContextId());
+    if (!ngramContext) {
+        AKLOGE("N-gram context %d is not cached.", suggestionBuffer.getNgramContextId());
+        return false;
+    }
+    const SuggestOptions givenSuggestOptions(suggestionBuffer.getOptions(),
+            suggestionBuffer.getOptionCount());
+    const int inputSize = suggestionBuffer.getInputSize();
+    SuggestionResults suggestionResults(MAX_RESULTS);
+    if (givenSuggestOptions.isGesture() || inputSize > 0) {
+        traverseSession->setSharedInputSession(nullptr);
+        dictionary->getSuggestions(reinterpret_cast<ProximityInfo *>(proximityInfo),
+                traverseSession, suggestionBuffer.getXCoordinates(),
+                suggestionBuffer.getYCoordinates(), suggestionBuffer.getTimes(),
+                suggestionBuffer.getPointerIds(), suggestionBuffer.getInputCodePoints(),
+                inputSize, ngramContext, &givenSuggestOptions,
+                suggestionBuffer.getWeightOfLangModelVsSpatialModel(), &suggestionResults);
+    } else if (!traverseSession->consumePrefetchedPredictions(dictionary,
+            suggestionBuffer.getNgramContextId(), &suggestionResults)) {
+        dictionary->getPredictions(ngramContext, &suggestionResults);
+    }
+    if (DEBUG_DICT) {
+        suggestionResults.dumpSuggestions();
+    }
+    suggestionResults.outputSuggestions(&suggestionBuffer);
+    return true;
+}
+
+static jboolean latinime_BinaryDictionary_prefetchPredictions(JNIEnv *env, jclass clazz,
+        jlong dict, jlong dicTraverseSession, jint ngramContextId) {
+    Dictionary *dictionary = reinterpret_cast<Dictionary *>(dict);
+    DicTraverseSession *traverseSession =
+            reinterpret_cast<DicTraverseSession *>(dicTraverseSession);
+    if (!dictionary || !traverseSession) {
+        return false;
+    }
+    return traverseSession->prefetchPredictions(dictionary, ngramContextId);
 }
 
 static jint latinime_BinaryDictionary_getProbability(JNIEnv *env, jclass clazz, jlong dict,
@@ -325,6 +502,46 @@ static jint latinime_BinaryDictionary_getNextWord(JNIEnv *env, jclass clazz,
     return nextToken;
 }
 
+// Method to iterate all words in the dictionary in batches. See WordBatch for the format of
+// outBuffer. If token is 0, this method newly starts iterating the dictionary. This method returns
+// 0 when the dictionary does not have more words.
+static jint latinime_BinaryDictionary_getNextWords(JNIEnv *env, jclass clazz,
+        jlong dict, jint token, jintArray outBuffer) {
+    Dictionary *dictionary = reinterpret_cast<Dictionary *>(dict);
+    if (!dictionary) return 0;
+    const jsize bufferSize = env->GetArrayLength(outBuffer);
+    if (bufferSize < WordBatch::MIN_BUFFER_SIZE) {
+        AKLOGE("Invalid outBuffer length: %d", bufferSize);
+        ASSERT(false);
+        return 0;
+    }
+    std::vector<int> buffer(bufferSize);
+    WordBatch wordBatch(buffer.data(), bufferSize);
+    const int nextToken = dictionary->getNextWordsAndNextToken(token, &wordBatch);
+    env->SetIntArrayRegion(outBuffer, 0, wordBatch.getUsedSize(), buffer.data());
+    return nextToken;
+}
+
+// Method to iterate the properties of all words in the dictionary in batches. See
+// WordPropertyBatch for the format of outBuffer. If token is 0, this method newly starts iterating
+// the dictionary. This method returns 0 when the dictionary does not have more words.
+static jint latinime_BinaryDictionary_getNextWordProperties(JNIEnv *env, jclass clazz,
+        jlong dict, jint token, jintArray outBuffer) {
+    Dictionary *dictionary = reinterpret_cast<Dictionary *>(dict);
+    if (!dictionary) return 0;
+    const jsize bufferSize = env->GetArrayLength(outBuffer);
+    if (bufferSize < WordPropertyBatch::MIN_BUFFER_SIZE) {
+        AKLOGE("Invalid outBuffer length: %d", bufferSize);
+        ASSERT(false);
+        return 0;
+    }
+    std::vector<int> buffer(bufferSize);
+    WordPropertyBatch wordPropertyBatch(buffer.data(), bufferSize);
+    const int nextToken = dictionary->getNextWordPropertiesAndNextToken(token, &wordPropertyBatch);
+    env->SetIntArrayRegion(outBuffer, 0, wordPropertyBatch.getUsedSize(), buffer.data());
+    return nextToken;
+}
+
 static void latinime_BinaryDictionary_getWordProperty(JNIEnv *env, jclass clazz,
         jlong dict, jintArray word, jboolean isBeginningOfSentence, jintArray outCodePoints,
         jbooleanArray outFlags, jintArray outProbabilityInfo, jobject outNgramPrevWordsArray,
@@ -518,13 +735,26 @@ static jstring latinime_BinaryDictionary_getProperty(JNIEnv *env, jclass clazz,
     char queryChars[queryUtf8Length + 1];
     env->GetStringUTFRegion(query, 0, env->GetStringLength(query), queryChars);
     queryChars[queryUtf8Length] = '\0';
-    static const int GET_PROPERTY_RESULT_LENGTH = 100;
+    // Large enough for the memory report.
+    static const int GET_PROPERTY_RESULT_LENGTH = 1024;
     char resultChars[GET_PROPERTY_RESULT_LENGTH];
     resultChars[0] = '\0';
     dictionary->getProperty(queryChars, queryUtf8Length, resultChars, GET_PROPERTY_RESULT_LENGTH);
     return env->NewStringUTF(resultChars);
 }
 
+static void latinime_BinaryDictionary_setTraceCountersEnabled(JNIEnv *env, jclass clazz,
+        jboolean enabled) {
+    TraceCounters::setEnabled(enabled == JNI_TRUE);
+}
+
+static jstring latinime_BinaryDictionary_getTraceCounters(JNIEnv *env, jclass clazz) {
+    static const int TRACE_COUNTERS_RESULT_LENGTH = 4096;
+    char resultChars[TRACE_COUNTERS_RESULT_LENGTH];
+    TraceCounters::dump(resultChars, TRACE_COUNTERS_RESULT_LENGTH);
+    return env->NewStringUTF(resultChars);
+}
+
 static bool latinime_BinaryDictionary_isCorruptedNative(JNIEnv *env, jclass clazz, jlong dict) {
     Dictionary *dictionary = reinterpret_cast<Dictionary *>(dict);
     if (!dictionary) {
@@ -533,15 +763,6 @@ static bool latinime_BinaryDictionary_isCorruptedNative(JNIEnv *env, jclass claz
     return dictionary->getDictionaryStructurePolicy()->isCorrupted();
 }
 
-static DictionaryStructureWithBufferPolicy::StructurePolicyPtr runGCAndGetNewStructurePolicy(
-        DictionaryStructureWithBufferPolicy::StructurePolicyPtr structurePolicy,
-        const char *const dictFilePath) {
-    structurePolicy->flushWithGC(dictFilePath);
-    structurePolicy.release();
-    return DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
-            dictFilePath, 0 /* offset */, 0 /* size */, true /* isUpdatable */);
-}
-
 static bool latinime_BinaryDictionary_migrateNative(JNIEnv *env, jclass clazz, jlong dict,
         jstring dictFilePath, jlong newFormatVersion) {
     Dictionary *dictionary = reinterpret_cast<Dictionary *>(dict);
@@ -552,67 +773,10 @@ static bool latinime_BinaryDictionary_migrateNative(JNIEnv *env, jclass clazz, j
     char dictFilePathChars[filePathUtf8Length + 1];
     env->GetStringUTFRegion(dictFilePath, 0, env->GetStringLength(dictFilePath), dictFilePathChars);
     dictFilePathChars[filePathUtf8Length] = '\0';
-
-    const DictionaryHeaderStructurePolicy *const headerPolicy =
-            dictionary->getDictionaryStructurePolicy()->getHeaderStructurePolicy();
-    DictionaryStructureWithBufferPolicy::StructurePolicyPtr dictionaryStructureWithBufferPolicy =
-            DictionaryStructureWithBufferPolicyFactory::newPolicyForOnMemoryDict(
-                    newFormatVersion, *headerPolicy->getLocale(), headerPolicy->getAttributeMap());
-    if (!dictionaryStructureWithBufferPolicy) {
-        LogUtils::logToJava(env, "Cannot migrate header.");
+    if (!dictionary->migrateTo(dictFilePathChars, newFormatVersion)) {
+        LogUtils::logToJava(env, "Cannot migrate the dictionary to %s.", dictFilePathChars);
         return false;
     }
-
-    int wordCodePoints[MAX_WORD_LENGTH];
-    int wordCodePointCount = 0;
-    int token = 0;
-    // Add unigrams.
-    do {
-        token = dictionary->getNextWordAndNextToken(token, wordCodePoints, &wordCodePointCount);
-        const WordProperty wordProperty = dictionary->getWordProperty(
-                CodePointArrayView(wordCodePoints, wordCodePointCount));
-        if (wordCodePoints[0] == CODE_POINT_BEGINNING_OF_SENTENCE) {
-            // Skip beginning-of-sentence unigram.
-            continue;
-        }
-        if (dictionaryStructureWithBufferPolicy->needsToRunGC(true /* mindsBlockByGC */)) {
-            dictionaryStructureWithBufferPolicy = runGCAndGetNewStructurePolicy(
-                    std::move(dictionaryStructureWithBufferPolicy), dictFilePathChars);
-            if (!dictionaryStructureWithBufferPolicy) {
-                LogUtils::logToJava(env, "Cannot open dict after GC.");
-                return false;
-            }
-        }
-        if (!dictionaryStructureWithBufferPolicy->addUnigramEntry(
-                CodePointArrayView(wordCodePoints, wordCodePointCount),
-                &wordProperty.getUnigramProperty())) {
-            LogUtils::logToJava(env, "Cannot add unigram to the new dict.");
-            return false;
-        }
-    } while (token != 0);
-
-    // Add ngrams.
-    do {
-        token = dictionary->getNextWordAndNextToken(token, wordCodePoints, &wordCodePointCount);
-        const WordProperty wordProperty = dictionary->getWordProperty(
-                CodePointArrayView(wordCodePoints, wordCodePointCount));
-        if (dictionaryStructureWithBufferPolicy->needsToRunGC(true /* mindsBlockByGC */)) {
-            dictionaryStructureWithBufferPolicy = runGCAndGetNewStructurePolicy(
-                    std::move(dictionaryStructureWithBufferPolicy), dictFilePathChars);
-            if (!dictionaryStructureWithBufferPolicy) {
-                LogUtils::logToJava(env, "Cannot open dict after GC.");
-                return false;
-            }
-        }
-        for (const NgramProperty &ngramProperty : wordProperty.getNgramProperties()) {
-            if (!dictionaryStructureWithBufferPolicy->addNgramEntry(&ngramProperty)) {
-                LogUtils::logToJava(env, "Cannot add ngram to the new dict.");
-                return false;
-            }
-        }
-    } while (token != 0);
-    // Save to File.
-    dictionaryStructureWithBufferPolicy->flushWithGC(dictFilePathChars);
     return true;
 }
 
@@ -662,6 +826,21 @@ static const JNINativeMethod sMethods[] = {
         const_cast<char *>("(JJJ[I[I[I[I[II[I[[I[ZI[I[I[I[I[I[I[F)V"),
         reinterpret_cast<void *>(latinime_BinaryDictionary_getSuggestions)
     },
+    {
+        const_cast<char *>("getSuggestionsWithBufferNative"),
+        const_cast<char *>("(JJJLjava/nio/ByteBuffer;)Z"),
+        reinterpret_cast<void *>(latinime_BinaryDictionary_getSuggestionsWithBuffer)
+    },
+    {
+        const_cast<char *>("prefetchPredictionsNative"),
+        const_cast<char *>("(JJI)Z"),
+        reinterpret_cast<void *>(latinime_BinaryDictionary_prefetchPredictions)
+    },
+    {
+        const_cast<char *>("getSuggestionsFromDictionariesNative"),
+        const_cast<char *>("([J[J[FJ[I[I[I[I[II[[I[[I[ZI[I[I[I[I[I[I[F[I)V"),
+        reinterpret_cast<void *>(latinime_BinaryDictionary_getSuggestionsFromDictionaries)
+    },
     {
         const_cast<char *>("getProbabilityNative"),
         const_cast<char *>("(J[I)I"),
@@ -689,6 +868,16 @@ static const JNINativeMethod sMethods[] = {
         const_cast<char *>("(JI[I[Z)I"),
         reinterpret_cast<void *>(latinime_BinaryDictionary_getNextWord)
     },
+    {
+        const_cast<char *>("getNextWordsNative"),
+        const_cast<char *>("(JI[I)I"),
+        reinterpret_cast<void *>(latinime_BinaryDictionary_getNextWords)
+    },
+    {
+        const_cast<char *>("getNextWordPropertiesNative"),
+        const_cast<char *>("(JI[I)I"),
+        reinterpret_cast<void *>(latinime_BinaryDictionary_getNextWordProperties)
+    },
     {
         const_cast<char *>("addUnigramEntryNative"),
         const_cast<char *>("(J[II[IIZZZI)Z"),
@@ -725,6 +914,16 @@ static const JNINativeMethod sMethods[] = {
         const_cast<char *>("(JLjava/lang/String;)Ljava/lang/String;"),
         reinterpret_cast<void *>(latinime_BinaryDictionary_getProperty)
     },
+    {
+        const_cast<char *>("setTraceCountersEnabledNative"),
+        const_cast<char *>("(Z)V"),
+        reinterpret_cast<void *>(latinime_BinaryDictionary_setTraceCountersEnabled)
+    },
+    {
+        const_cast<char *>("getTraceCountersNative"),
+        const_cast<char *>("()Ljava/lang/String;"),
+        reinterpret_cast<void *>(latinime_BinaryDictionary_getTraceCounters)
+    },
     {
         const_cast<char *>("isCorruptedNative"),
         const_cast<char *>("(J)Z"),
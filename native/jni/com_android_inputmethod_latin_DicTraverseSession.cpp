@@ -23,6 +23,8 @@
 #include "jni.h"
 #include "jni_common.h"
 #include "suggest/core/session/dic_traverse_session.h"
+#include "utils/jni_data_utils.h"
+#include "utils/memory_report.h"
 
 namespace latinime {
 class Dictionary;
@@ -50,6 +52,32 @@ static void latinime_initDicTraverseSession(JNIEnv *env, jclass clazz, jlong tra
     ts->init(dict, &ngramContext, 0 /* suggestOptions */);
 }
 
+static void latinime_cacheNgramContext(JNIEnv *env, jclass clazz, jlong traverseSession,
+        jint ngramContextId, jobjectArray prevWordCodePointArrays,
+        jbooleanArray isBeginningOfSentenceArray, jint prevWordCount) {
+    DicTraverseSession *ts = reinterpret_cast<DicTraverseSession *>(traverseSession);
+    if (!ts) {
+        return;
+    }
+    const NgramContext ngramContext = JniDataUtils::constructNgramContext(env,
+            prevWordCodePointArrays, isBeginningOfSentenceArray, prevWordCount);
+    ts->cacheNgramContext(ngramContextId, &ngramContext);
+}
+
+static jstring latinime_getDicTraverseSessionMemoryReport(JNIEnv *env, jclass clazz,
+        jlong traverseSession) {
+    DicTraverseSession *ts = reinterpret_cast<DicTraverseSession *>(traverseSession);
+    if (!ts) {
+        return env->NewStringUTF("");
+    }
+    MemoryReport memoryReport;
+    ts->getMemoryReport(&memoryReport);
+    static const int MEMORY_REPORT_RESULT_LENGTH = 1024;
+    char resultChars[MEMORY_REPORT_RESULT_LENGTH];
+    memoryReport.dump(resultChars, MEMORY_REPORT_RESULT_LENGTH);
+    return env->NewStringUTF(resultChars);
+}
+
 static void latinime_releaseDicTraverseSession(JNIEnv *env, jclass clazz, jlong traverseSession) {
     DicTraverseSession *ts = reinterpret_cast<DicTraverseSession *>(traverseSession);
     DicTraverseSession::releaseSessionInstance(ts);
@@ -66,6 +94,16 @@ static const JNINativeMethod sMethods[] = {
         const_cast<char *>("(JJ[II)V"),
         reinterpret_cast<void *>(latinime_initDicTraverseSession)
     },
+    {
+        const_cast<char *>("cacheNgramContextNative"),
+        const_cast<char *>("(JI[[I[ZI)V"),
+        reinterpret_cast<void *>(latinime_cacheNgramContext)
+    },
+    {
+        const_cast<char *>("getMemoryReportNative"),
+        const_cast<char *>("(J)Ljava/lang/String;"),
+        reinterpret_cast<void *>(latinime_getDicTraverseSessionMemoryReport)
+    },
     {
         const_cast<char *>("releaseDicTraverseSessionNative"),
         const_cast<char *>("(J)V"),
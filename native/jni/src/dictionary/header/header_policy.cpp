@@ -40,6 +40,10 @@ const char *const HeaderPolicy::EXTENDED_REGION_SIZE_KEY = "EXTENDED_REGION_SIZE
 // Historical info is information that is needed to support decaying such as timestamp, level and
 // count.
 const char *const HeaderPolicy::HAS_HISTORICAL_INFO_KEY = "HAS_HISTORICAL_INFO";
+// Compact probability entries store timestamps relative to the last decayed time, so they can be
+// stored inline in the language model TrieMap.
+const char *const HeaderPolicy::USES_COMPACT_PROBABILITY_ENTRIES_KEY =
+        "USES_COMPACT_PROBABILITY_ENTRIES";
 const char *const HeaderPolicy::LOCALE_KEY = "locale"; // match Java declaration
 const char *const HeaderPolicy::FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID_KEY =
         "FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID";
@@ -149,6 +153,11 @@ void HeaderPolicy::fillInHeader(const bool updatesLastDecayedTime,
         // Set current time as the last updated time.
         HeaderReadWriteUtils::setIntAttribute(outAttributeMap, LAST_DECAYED_TIME_KEY,
                 TimeKeeper::peekCurrentTime());
+    } else if (mUsesCompactProbabilityEntries) {
+        // Compact probability entries are relative to the last decayed time. Always write it
+        // because it cannot be recovered from the entries.
+        HeaderReadWriteUtils::setIntAttribute(outAttributeMap, LAST_DECAYED_TIME_KEY,
+                mLastDecayedTime);
     }
 }
 
@@ -51,6 +51,9 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
                       EXTENDED_REGION_SIZE_KEY, 0 /* defaultValue */)),
               mHasHistoricalInfoOfWords(HeaderReadWriteUtils::readBoolAttributeValue(
                       &mAttributeMap, HAS_HISTORICAL_INFO_KEY, false /* defaultValue */)),
+              mUsesCompactProbabilityEntries(HeaderReadWriteUtils::readBoolAttributeValue(
+                      &mAttributeMap, USES_COMPACT_PROBABILITY_ENTRIES_KEY,
+                      false /* defaultValue */)),
               mForgettingCurveProbabilityValuesTableId(HeaderReadWriteUtils::readIntAttributeValue(
                       &mAttributeMap, FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID_KEY,
                       DEFAULT_FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID)),
@@ -75,6 +78,9 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
               mExtendedRegionSize(0),
               mHasHistoricalInfoOfWords(HeaderReadWriteUtils::readBoolAttributeValue(
                       &mAttributeMap, HAS_HISTORICAL_INFO_KEY, false /* defaultValue */)),
+              mUsesCompactProbabilityEntries(HeaderReadWriteUtils::readBoolAttributeValue(
+                      &mAttributeMap, USES_COMPACT_PROBABILITY_ENTRIES_KEY,
+                      false /* defaultValue */)),
               mForgettingCurveProbabilityValuesTableId(HeaderReadWriteUtils::readIntAttributeValue(
                       &mAttributeMap, FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID_KEY,
                       DEFAULT_FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID)),
@@ -93,6 +99,7 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
               mMaxNgramCounts(headerPolicy->mMaxNgramCounts),
               mExtendedRegionSize(headerPolicy->mExtendedRegionSize),
               mHasHistoricalInfoOfWords(headerPolicy->mHasHistoricalInfoOfWords),
+              mUsesCompactProbabilityEntries(headerPolicy->mUsesCompactProbabilityEntries),
               mForgettingCurveProbabilityValuesTableId(
                       headerPolicy->mForgettingCurveProbabilityValuesTableId),
               mCodePointTable(headerPolicy->mCodePointTable) {}
@@ -104,6 +111,7 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
               mRequiresGermanUmlautProcessing(false), mIsDecayingDict(false),
               mDate(0), mLastDecayedTime(0), mNgramCounts(), mMaxNgramCounts(),
               mExtendedRegionSize(0), mHasHistoricalInfoOfWords(false),
+              mUsesCompactProbabilityEntries(false),
               mForgettingCurveProbabilityValuesTableId(0), mCodePointTable(nullptr) {}
 
     ~HeaderPolicy() {}
@@ -182,6 +190,10 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
         return mHasHistoricalInfoOfWords;
     }
 
+    AK_FORCE_INLINE bool usesCompactProbabilityEntries() const {
+        return mUsesCompactProbabilityEntries;
+    }
+
     AK_FORCE_INLINE bool shouldBoostExactMatches() const {
         // TODO: Investigate better ways to handle exact matches for personalized dictionaries.
         return !isDecayingDict();
@@ -231,6 +243,7 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
     static const int DEFAULT_MAX_NGRAM_COUNTS[];
     static const char *const EXTENDED_REGION_SIZE_KEY;
     static const char *const HAS_HISTORICAL_INFO_KEY;
+    static const char *const USES_COMPACT_PROBABILITY_ENTRIES_KEY;
     static const char *const LOCALE_KEY;
     static const char *const FORGETTING_CURVE_OCCURRENCES_TO_LEVEL_UP_KEY;
     static const char *const FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID_KEY;
@@ -253,6 +266,7 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
     const EntryCounts mMaxNgramCounts;
     const int mExtendedRegionSize;
     const bool mHasHistoricalInfoOfWords;
+    const bool mUsesCompactProbabilityEntries;
     const int mForgettingCurveProbabilityValuesTableId;
     const int *const mCodePointTable;
 
@@ -31,10 +31,15 @@ namespace latinime {
 class DicNode;
 class DicNodeVector;
 class DictionaryHeaderStructurePolicy;
+class MemoryReport;
 class MultiBigramMap;
 class NgramListener;
 class NgramContext;
+class PtNodeArrayReader;
+class PtNodeReader;
 class UnigramProperty;
+class WordBatch;
+class WordPropertyBatch;
 
 /*
  * This class abstracts the structure of dictionaries.
@@ -106,12 +111,32 @@ class DictionaryStructureWithBufferPolicy {
 
     virtual const WordProperty getWordProperty(const CodePointArrayView wordCodePoints) const = 0;
 
+    // Adds the memory used by the dictionary buffers and contents to outMemoryReport.
+    virtual void getMemoryReport(MemoryReport *const outMemoryReport) const = 0;
+
+    // Readers of the underlying PtNode structure, used by tools that walk the whole trie.
+    virtual const PtNodeReader *getPtNodeReader() const = 0;
+
+    virtual const PtNodeArrayReader *getPtNodeArrayReader() const = 0;
+
     // Method to iterate all words in the dictionary.
     // The returned token has to be used to get the next word. If token is 0, this method newly
     // starts iterating the dictionary.
     virtual int getNextWordAndNextToken(const int token, int *const outCodePoints,
             int *const outCodePointCount) = 0;
 
+    // Method to iterate all words in the dictionary in batches.
+    // Adds words to outWordBatch until it is full and returns the token to get the following
+    // words, or 0 when all words have been added. If token is 0, this method newly starts
+    // iterating the dictionary.
+    virtual int getNextWordsAndNextToken(const int token, WordBatch *const outWordBatch) = 0;
+
+    // Same as getNextWordsAndNextToken() but adds the properties of the words to
+    // outWordPropertyBatch. Both methods share the iteration state; tokens of one cannot be passed
+    // to the other.
+    virtual int getNextWordPropertiesAndNextToken(const int token,
+            WordPropertyBatch *const outWordPropertyBatch) = 0;
+
     virtual bool isCorrupted() const = 0;
 
  protected:
@@ -38,6 +38,9 @@
 #include "dictionary/utils/forgetting_curve_utils.h"
 #include "dictionary/utils/multi_bigram_map.h"
 #include "dictionary/utils/probability_utils.h"
+#include "dictionary/utils/word_batch.h"
+#include "dictionary/utils/word_property_batch.h"
+#include "utils/memory_report.h"
 
 namespace latinime {
 namespace backward {
@@ -546,6 +549,13 @@ void Ver4PatriciaTriePolicy::getProperty(const char *const query, const int quer
     }
 }
 
+void Ver4PatriciaTriePolicy::getMemoryReport(MemoryReport *const outMemoryReport) const {
+    // Only the trie is reported for this old format.
+    outMemoryReport->addComponent("trie", mDictBuffer->getMemoryUsage());
+    outMemoryReport->addComponent("word_iteration",
+            MemoryReport::getVectorMemoryUsage(mTerminalPtNodePositionsForIteratingWords));
+}
+
 const WordProperty Ver4PatriciaTriePolicy::getWordProperty(
         const CodePointArrayView wordCodePoints) const {
     const int ptNodePos = getTerminalPtNodePosFromWordId(
@@ -657,6 +667,62 @@ int Ver4PatriciaTriePolicy::getTerminalPtNodePosFromWordId(const int wordId) con
     return wordId == NOT_A_WORD_ID ? NOT_A_DICT_POS : wordId;
 }
 
+int Ver4PatriciaTriePolicy::getNextWordsAndNextToken(const int token,
+        WordBatch *const outWordBatch) {
+    if (token == 0) {
+        // Start iterating the dictionary.
+        mWordIterator.init(getRootPosition());
+    } else if (token != mNextWordBatchToken) {
+        AKLOGE("Given token %d is invalid.", token);
+        return 0;
+    }
+    while (mWordIterator.hasWord()) {
+        const PtNodeParams ptNodeParams(mWordIterator.getPtNodeParams());
+        const WordAttributes wordAttributes =
+                getWordAttributes(ptNodeParams.getProbability(), ptNodeParams);
+        if (!outWordBatch->addWord(mWordIterator.getCodePoints(), wordAttributes)) {
+            // The batch is full. The current word is the first word of the next batch.
+            mNextWordBatchToken = token + 1;
+            return mNextWordBatchToken;
+        }
+        mWordIterator.readNextWord();
+    }
+    if (mWordIterator.isError()) {
+        mIsCorrupted = true;
+        AKLOGE("Dictionary reading error in getNextWordsAndNextToken().");
+    }
+    // All words have been iterated.
+    mNextWordBatchToken = 0;
+    return 0;
+}
+
+int Ver4PatriciaTriePolicy::getNextWordPropertiesAndNextToken(const int token,
+        WordPropertyBatch *const outWordPropertyBatch) {
+    if (token == 0) {
+        // Start iterating the dictionary.
+        mWordIterator.init(getRootPosition());
+    } else if (token != mNextWordBatchToken) {
+        AKLOGE("Given token %d is invalid.", token);
+        return 0;
+    }
+    while (mWordIterator.hasWord()) {
+        if (!outWordPropertyBatch->addWordProperty(
+                getWordProperty(mWordIterator.getCodePoints()))) {
+            // The batch is full. The current word is the first word of the next batch.
+            mNextWordBatchToken = token + 1;
+            return mNextWordBatchToken;
+        }
+        mWordIterator.readNextWord();
+    }
+    if (mWordIterator.isError()) {
+        mIsCorrupted = true;
+        AKLOGE("Dictionary reading error in getNextWordPropertiesAndNextToken().");
+    }
+    // All words have been iterated.
+    mNextWordBatchToken = 0;
+    return 0;
+}
+
 } // namespace v402
 } // namespace backward
 } // namespace latinime
@@ -31,6 +31,7 @@
 #include "dictionary/header/header_policy.h"
 #include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
 #include "dictionary/structure/pt_common/dynamic_pt_updating_helper.h"
+#include "dictionary/structure/pt_common/dynamic_pt_word_iterator.h"
 #include "dictionary/structure/backward/v402/bigram/ver4_bigram_list_policy.h"
 #include "dictionary/structure/backward/v402/shortcut/ver4_shortcut_list_policy.h"
 #include "dictionary/structure/backward/v402/ver4_dict_buffers.h"
@@ -77,7 +78,9 @@ class Ver4PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
               mUpdatingHelper(mDictBuffer, &mNodeReader, &mNodeWriter),
               mWritingHelper(mBuffers.get()),
               mEntryCounters(mHeaderPolicy->getNgramCounts().getCountArray()),
-              mTerminalPtNodePositionsForIteratingWords(), mIsCorrupted(false) {};
+              mTerminalPtNodePositionsForIteratingWords(),
+              mWordIterator(&mNodeReader, &mPtNodeArrayReader), mNextWordBatchToken(0),
+              mIsCorrupted(false) {};
 
     virtual int getRootPosition() const {
         return 0;
@@ -132,9 +135,24 @@ class Ver4PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
 
     const WordProperty getWordProperty(const CodePointArrayView wordCodePoints) const;
 
+    void getMemoryReport(MemoryReport *const outMemoryReport) const;
+
+    const PtNodeReader *getPtNodeReader() const {
+        return &mNodeReader;
+    }
+
+    const PtNodeArrayReader *getPtNodeArrayReader() const {
+        return &mPtNodeArrayReader;
+    }
+
     int getNextWordAndNextToken(const int token, int *const outCodePoints,
             int *const outCodePointCount);
 
+    int getNextWordsAndNextToken(const int token, WordBatch *const outWordBatch);
+
+    int getNextWordPropertiesAndNextToken(const int token,
+            WordPropertyBatch *const outWordPropertyBatch);
+
     bool isCorrupted() const {
         return mIsCorrupted;
     }
@@ -164,6 +182,8 @@ class Ver4PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
     Ver4PatriciaTrieWritingHelper mWritingHelper;
     MutableEntryCounters mEntryCounters;
     std::vector<int> mTerminalPtNodePositionsForIteratingWords;
+    DynamicPtWordIterator mWordIterator;
+    int mNextWordBatchToken;
     mutable bool mIsCorrupted;
 
     int getBigramsPositionOfPtNode(const int ptNodePos) const;
@@ -16,6 +16,8 @@
 
 #include "dictionary/structure/pt_common/dynamic_pt_reading_helper.h"
 
+#include <cstring>
+
 #include "dictionary/structure/pt_common/pt_node_array_reader.h"
 #include "utils/char_utils.h"
 
@@ -175,6 +177,32 @@ bool DynamicPtReadingHelper::traverseAllPtNodesInPtNodeArrayLevelPreorderDepthFi
     return !isError();
 }
 
+// Moves from the current PtNode to the next PtNode in pre-order depth first manner, which can be
+// resumed at any PtNode. For example, visits a -> b -> c -> x -> y for the following dictionary:
+// a _ b _ c
+//   \ x _ y
+void DynamicPtReadingHelper::readNextPtNodeInPreorder(const PtNodeParams &ptNodeParams) {
+    if (ptNodeParams.hasChildren()) {
+        pushReadingStateToStack();
+        if (isError()) {
+            return;
+        }
+        readChildNode(ptNodeParams);
+        if (!isEnd() || isError()) {
+            return;
+        }
+        // The children PtNode array is empty.
+        popReadingStateFromStack();
+    }
+    readNextSiblingNode(ptNodeParams);
+    while (isEnd() && !isError() && !mReadingStateStack.empty()) {
+        // All PtNodes in the current linked PtNode arrays have been visited. Move to the next
+        // sibling of the parent.
+        popReadingStateFromStack();
+        readNextSiblingNode(getPtNodeParams());
+    }
+}
+
 int DynamicPtReadingHelper::getCodePointsAndReturnCodePointCount(const int maxCodePointCount,
         int *const outCodePoints) {
     // This method traverses parent nodes from the terminal by following parent pointers; thus,
@@ -215,8 +243,10 @@ int DynamicPtReadingHelper::getCodePointsAndReturnCodePointCount(const int maxCo
 int DynamicPtReadingHelper::getTerminalPtNodePositionOfWord(const int *const inWord,
         const size_t length, const bool forceLowerCaseSearch) {
     int searchCodePoints[length];
-    for (size_t i = 0; i < length; ++i) {
-        searchCodePoints[i] = forceLowerCaseSearch ? CharUtils::toLowerCase(inWord[i]) : inWord[i];
+    if (forceLowerCaseSearch) {
+        CharUtils::toLowerCaseCodePoints(inWord, static_cast<int>(length), searchCodePoints);
+    } else {
+        memmove(searchCodePoints, inWord, sizeof(searchCodePoints[0]) * length);
     }
     while (!isEnd()) {
         const PtNodeParams ptNodeParams(getPtNodeParams());
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dictionary/structure/pt_common/dynamic_pt_word_iterator.h"
+
+namespace latinime {
+
+void DynamicPtWordIterator::init(const int rootPtNodeArrayPos) {
+    mCodePointCount = 0;
+    mIsError = false;
+    mReadingHelper.initWithPtNodeArrayPos(rootPtNodeArrayPos);
+    readPtNodesUntilTerminal();
+}
+
+void DynamicPtWordIterator::readNextWord() {
+    if (!hasWord()) {
+        return;
+    }
+    mReadingHelper.readNextPtNodeInPreorder(mReadingHelper.getPtNodeParams());
+    readPtNodesUntilTerminal();
+}
+
+void DynamicPtWordIterator::readPtNodesUntilTerminal() {
+    while (!mReadingHelper.isEnd()) {
+        const PtNodeParams ptNodeParams(mReadingHelper.getPtNodeParams());
+        if (!ptNodeParams.isValid()) {
+            mIsError = true;
+            break;
+        }
+        // The code points of the ancestors have already been stored in the preceding positions.
+        const int prevCodePointCount =
+                static_cast<int>(mReadingHelper.getPrevTotalCodePointCount());
+        const int codePointCount = prevCodePointCount + ptNodeParams.getCodePointCount();
+        if (codePointCount > MAX_WORD_LENGTH) {
+            AKLOGE("Too long word in the dictionary. codePointCount: %d", codePointCount);
+            mIsError = true;
+            break;
+        }
+        const int *const nodeCodePoints = ptNodeParams.getCodePoints();
+        for (int i = prevCodePointCount; i < codePointCount; ++i) {
+            mCodePoints[i] = nodeCodePoints[i - prevCodePointCount];
+        }
+        if (ptNodeParams.isTerminal() && !ptNodeParams.isDeleted()) {
+            mCodePointCount = codePointCount;
+            return;
+        }
+        mReadingHelper.readNextPtNodeInPreorder(ptNodeParams);
+    }
+    // All words have been read.
+    mReadingHelper.initWithPtNodeArrayPos(NOT_A_DICT_POS);
+    mCodePointCount = 0;
+}
+
+} // namespace latinime
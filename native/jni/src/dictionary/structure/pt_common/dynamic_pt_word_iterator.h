@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_DYNAMIC_PT_WORD_ITERATOR_H
+#define LATINIME_DYNAMIC_PT_WORD_ITERATOR_H
+
+#include "defines.h"
+#include "dictionary/structure/pt_common/dynamic_pt_reading_helper.h"
+#include "dictionary/structure/pt_common/pt_node_params.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+
+class PtNodeArrayReader;
+class PtNodeReader;
+
+/*
+ * This class iterates all words in a patricia trie with a single pre-order depth first traversal.
+ * The code points of the current word are kept while traversing; thus, words can be read without
+ * following the parent links and the iteration can be resumed at any word.
+ */
+class DynamicPtWordIterator {
+ public:
+    DynamicPtWordIterator(const PtNodeReader *const ptNodeReader,
+            const PtNodeArrayReader *const ptNodeArrayReader)
+            : mReadingHelper(ptNodeReader, ptNodeArrayReader), mCodePointCount(0),
+              mIsError(false) {}
+
+    ~DynamicPtWordIterator() {}
+
+    // Moves to the first word in the PtNode array at rootPtNodeArrayPos.
+    void init(const int rootPtNodeArrayPos);
+
+    // Moves to the next word.
+    void readNextWord();
+
+    AK_FORCE_INLINE bool hasWord() const {
+        return !mReadingHelper.isEnd();
+    }
+
+    AK_FORCE_INLINE bool isError() const {
+        return mIsError || mReadingHelper.isError();
+    }
+
+    // Returns the terminal PtNode of the current word.
+    AK_FORCE_INLINE const PtNodeParams getPtNodeParams() const {
+        return mReadingHelper.getPtNodeParams();
+    }
+
+    AK_FORCE_INLINE const CodePointArrayView getCodePoints() const {
+        return CodePointArrayView(mCodePoints, mCodePointCount);
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(DynamicPtWordIterator);
+
+    DynamicPtReadingHelper mReadingHelper;
+    // The code points of the current PtNode and all its ancestors.
+    int mCodePoints[MAX_WORD_LENGTH];
+    int mCodePointCount;
+    bool mIsError;
+
+    void readPtNodesUntilTerminal();
+};
+} // namespace latinime
+#endif /* LATINIME_DYNAMIC_PT_WORD_ITERATOR_H */
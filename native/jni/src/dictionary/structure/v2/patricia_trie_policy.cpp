@@ -26,7 +26,10 @@
 #include "dictionary/utils/binary_dictionary_bigrams_iterator.h"
 #include "dictionary/utils/multi_bigram_map.h"
 #include "dictionary/utils/probability_utils.h"
+#include "dictionary/utils/word_batch.h"
+#include "dictionary/utils/word_property_batch.h"
 #include "utils/char_utils.h"
+#include "utils/memory_report.h"
 
 namespace latinime {
 
@@ -423,6 +426,13 @@ int PatriciaTriePolicy::createAndGetLeavingChildNode(const DicNode *const dicNod
     return siblingPos;
 }
 
+void PatriciaTriePolicy::getMemoryReport(MemoryReport *const outMemoryReport) const {
+    // The header, the trie and the bigram lists are all in the mapped dictionary file.
+    outMemoryReport->addComponent("dict_file", mMmappedBuffer->getMemoryUsage());
+    outMemoryReport->addComponent("word_iteration",
+            MemoryReport::getVectorMemoryUsage(mTerminalPtNodePositionsForIteratingWords));
+}
+
 const WordProperty PatriciaTriePolicy::getWordProperty(
         const CodePointArrayView wordCodePoints) const {
     const int wordId = getWordId(wordCodePoints, false /* forceLowerCaseSearch */);
@@ -523,4 +533,59 @@ bool PatriciaTriePolicy::isValidPos(const int pos) const {
     return pos >= 0 && pos < static_cast<int>(mBuffer.size());
 }
 
+int PatriciaTriePolicy::getNextWordsAndNextToken(const int token, WordBatch *const outWordBatch) {
+    if (token == 0) {
+        // Start iterating the dictionary.
+        mWordIterator.init(getRootPosition());
+    } else if (token != mNextWordBatchToken) {
+        AKLOGE("Given token %d is invalid.", token);
+        return 0;
+    }
+    while (mWordIterator.hasWord()) {
+        const PtNodeParams ptNodeParams(mWordIterator.getPtNodeParams());
+        const WordAttributes wordAttributes =
+                getWordAttributes(ptNodeParams.getProbability(), ptNodeParams);
+        if (!outWordBatch->addWord(mWordIterator.getCodePoints(), wordAttributes)) {
+            // The batch is full. The current word is the first word of the next batch.
+            mNextWordBatchToken = token + 1;
+            return mNextWordBatchToken;
+        }
+        mWordIterator.readNextWord();
+    }
+    if (mWordIterator.isError()) {
+        mIsCorrupted = true;
+        AKLOGE("Dictionary reading error in getNextWordsAndNextToken().");
+    }
+    // All words have been iterated.
+    mNextWordBatchToken = 0;
+    return 0;
+}
+
+int PatriciaTriePolicy::getNextWordPropertiesAndNextToken(const int token,
+        WordPropertyBatch *const outWordPropertyBatch) {
+    if (token == 0) {
+        // Start iterating the dictionary.
+        mWordIterator.init(getRootPosition());
+    } else if (token != mNextWordBatchToken) {
+        AKLOGE("Given token %d is invalid.", token);
+        return 0;
+    }
+    while (mWordIterator.hasWord()) {
+        if (!outWordPropertyBatch->addWordProperty(
+                getWordProperty(mWordIterator.getCodePoints()))) {
+            // The batch is full. The current word is the first word of the next batch.
+            mNextWordBatchToken = token + 1;
+            return mNextWordBatchToken;
+        }
+        mWordIterator.readNextWord();
+    }
+    if (mWordIterator.isError()) {
+        mIsCorrupted = true;
+        AKLOGE("Dictionary reading error in getNextWordPropertiesAndNextToken().");
+    }
+    // All words have been iterated.
+    mNextWordBatchToken = 0;
+    return 0;
+}
+
 } // namespace latinime
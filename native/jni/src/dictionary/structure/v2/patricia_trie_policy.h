@@ -23,6 +23,7 @@
 #include "defines.h"
 #include "dictionary/header/header_policy.h"
 #include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "dictionary/structure/pt_common/dynamic_pt_word_iterator.h"
 #include "dictionary/structure/v2/bigram/bigram_list_policy.h"
 #include "dictionary/structure/v2/shortcut/shortcut_list_policy.h"
 #include "dictionary/structure/v2/ver2_patricia_trie_node_reader.h"
@@ -50,6 +51,7 @@ class PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
               mPtNodeReader(mBuffer, &mBigramListPolicy, &mShortcutListPolicy,
                       mHeaderPolicy.getCodePointTable()),
               mPtNodeArrayReader(mBuffer), mTerminalPtNodePositionsForIteratingWords(),
+              mWordIterator(&mPtNodeReader, &mPtNodeArrayReader), mNextWordBatchToken(0),
               mIsCorrupted(false) {}
 
     AK_FORCE_INLINE int getRootPosition() const {
@@ -143,9 +145,24 @@ class PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
 
     const WordProperty getWordProperty(const CodePointArrayView wordCodePoints) const;
 
+    void getMemoryReport(MemoryReport *const outMemoryReport) const;
+
+    const PtNodeReader *getPtNodeReader() const {
+        return &mPtNodeReader;
+    }
+
+    const PtNodeArrayReader *getPtNodeArrayReader() const {
+        return &mPtNodeArrayReader;
+    }
+
     int getNextWordAndNextToken(const int token, int *const outCodePoints,
             int *const outCodePointCount);
 
+    int getNextWordsAndNextToken(const int token, WordBatch *const outWordBatch);
+
+    int getNextWordPropertiesAndNextToken(const int token,
+            WordPropertyBatch *const outWordPropertyBatch);
+
     bool isCorrupted() const {
         return mIsCorrupted;
     }
@@ -161,6 +178,8 @@ class PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
     const Ver2ParticiaTrieNodeReader mPtNodeReader;
     const Ver2PtNodeArrayReader mPtNodeArrayReader;
     std::vector<int> mTerminalPtNodePositionsForIteratingWords;
+    DynamicPtWordIterator mWordIterator;
+    int mNextWordBatchToken;
     mutable bool mIsCorrupted;
 
     int getCodePointsAndProbabilityAndReturnCodePointCount(const int wordId,
@@ -39,7 +39,9 @@ bool Ver2PtNodeArrayReader::readPtNodeArrayInfoAndReturnIfValid(const int ptNode
 
 bool Ver2PtNodeArrayReader::readForwardLinkAndReturnIfValid(const int forwordLinkPos,
         int *const outNextPtNodeArrayPos) const {
-    if (forwordLinkPos < 0 || forwordLinkPos >=  static_cast<int>(mBuffer.size())) {
+    // The last PtNode array can end at the end of the buffer. Nothing is read from the position
+    // because ver2 dicts don't have forward links.
+    if (forwordLinkPos < 0 || forwordLinkPos > static_cast<int>(mBuffer.size())) {
         // Reading invalid position because of bug or broken dictionary.
         AKLOGE("Reading forward link from invalid dictionary position: %d, dict size: %zd",
                 forwordLinkPos, mBuffer.size());
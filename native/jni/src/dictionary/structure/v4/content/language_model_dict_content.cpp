@@ -17,11 +17,11 @@
 #include "dictionary/structure/v4/content/language_model_dict_content.h"
 
 #include <algorithm>
-#include <cstring>
 
 #include "dictionary/structure/v4/content/dynamic_language_model_probability_utils.h"
 #include "dictionary/utils/probability_utils.h"
 #include "utils/ngram_utils.h"
+#include "utils/time_keeper.h"
 
 namespace latinime {
 
@@ -35,8 +35,11 @@ bool LanguageModelDictContent::save(FILE *const file) const {
 bool LanguageModelDictContent::runGC(
         const TerminalPositionLookupTable::TerminalIdMap *const terminalIdMap,
         const LanguageModelDictContent *const originalContent) {
-    return runGCInner(terminalIdMap, originalContent->mTrieMap.getEntriesInRootLevel(),
-            0 /* nextLevelBitmapEntryIndex */);
+    if (mUsesCompactProbabilityEntries) {
+        mBaseTimestamp = TimeKeeper::peekCurrentTime();
+    }
+    return runGCInner(terminalIdMap, originalContent,
+            originalContent->mTrieMap.getEntriesInRootLevel(), 0 /* nextLevelBitmapEntryIndex */);
 }
 
 const WordAttributes LanguageModelDictContent::getWordAttributes(const WordIdArrayView prevWordIds,
@@ -69,7 +72,7 @@ const WordAttributes LanguageModelDictContent::getWordAttributes(const WordIdArr
             continue;
         }
         const ProbabilityEntry probabilityEntry =
-                ProbabilityEntry::decode(result.mValue, mHasHistoricalInfo);
+                decodeProbabilityEntry(result.mValue);
         int probability = NOT_A_PROBABILITY;
         if (mHasHistoricalInfo) {
             const HistoricalInfo *const historicalInfo = probabilityEntry.getHistoricalInfo();
@@ -125,7 +128,7 @@ ProbabilityEntry LanguageModelDictContent::getNgramProbabilityEntry(
         // Not found.
         return ProbabilityEntry();
     }
-    return ProbabilityEntry::decode(result.mValue, mHasHistoricalInfo);
+    return decodeProbabilityEntry(result.mValue);
 }
 
 bool LanguageModelDictContent::setNgramProbabilityEntry(const WordIdArrayView prevWordIds,
@@ -137,7 +140,7 @@ bool LanguageModelDictContent::setNgramProbabilityEntry(const WordIdArrayView pr
     if (bitmapEntryIndex == TrieMap::INVALID_INDEX) {
         return false;
     }
-    return mTrieMap.put(wordId, probabilityEntry->encode(mHasHistoricalInfo), bitmapEntryIndex);
+    return mTrieMap.put(wordId, encodeProbabilityEntry(*probabilityEntry), bitmapEntryIndex);
 }
 
 bool LanguageModelDictContent::removeNgramProbabilityEntry(const WordIdArrayView prevWordIds,
@@ -153,7 +156,7 @@ bool LanguageModelDictContent::removeNgramProbabilityEntry(const WordIdArrayView
 LanguageModelDictContent::EntryRange LanguageModelDictContent::getProbabilityEntries(
         const WordIdArrayView prevWordIds) const {
     const int bitmapEntryIndex = getBitmapEntryIndex(prevWordIds);
-    return EntryRange(mTrieMap.getEntriesInSpecifiedLevel(bitmapEntryIndex), mHasHistoricalInfo);
+    return EntryRange(mTrieMap.getEntriesInSpecifiedLevel(bitmapEntryIndex), this);
 }
 
 std::vector<LanguageModelDictContent::DumppedFullEntryInfo>
@@ -178,7 +181,7 @@ void LanguageModelDictContent::exportAllNgramEntriesRelatedToWordInner(
     for (const auto &entry : mTrieMap.getEntriesInSpecifiedLevel(bitmapEntryIndex)) {
         const int wordId = entry.key();
         const ProbabilityEntry probabilityEntry =
-                ProbabilityEntry::decode(entry.value(), mHasHistoricalInfo);
+                decodeProbabilityEntry(entry.value());
         if (probabilityEntry.isValid()) {
             const WordAttributes wordAttributes = getWordAttributes(
                     WordIdArrayView(*prevWordIds), wordId, true /* mustMatchAllPrevWords */,
@@ -209,6 +212,7 @@ bool LanguageModelDictContent::truncateEntries(const EntryCounts &currentEntryCo
         }
         int entryCount = 0;
         if (!turncateEntriesInSpecifiedLevel(headerPolicy,
+                currentEntryCounts.getNgramCount(ngramType),
                 maxEntryCounts.getNgramCount(ngramType), prevWordCount, &entryCount)) {
             return false;
         }
@@ -273,18 +277,24 @@ const ProbabilityEntry LanguageModelDictContent::createUpdatedEntryFrom(
 
 bool LanguageModelDictContent::runGCInner(
         const TerminalPositionLookupTable::TerminalIdMap *const terminalIdMap,
+        const LanguageModelDictContent *const originalContent,
         const TrieMap::TrieMapRange trieMapRange, const int nextLevelBitmapEntryIndex) {
+    const bool needsToReencode = mUsesCompactProbabilityEntries
+            || originalContent->mUsesCompactProbabilityEntries;
     for (auto &entry : trieMapRange) {
         const auto it = terminalIdMap->find(entry.key());
         if (it == terminalIdMap->end() || it->second == Ver4DictConstants::NOT_A_TERMINAL_ID) {
             // The word has been removed.
             continue;
         }
-        if (!mTrieMap.put(it->second, entry.value(), nextLevelBitmapEntryIndex)) {
+        const uint64_t value = needsToReencode
+                ? encodeProbabilityEntry(originalContent->decodeProbabilityEntry(entry.value()))
+                : entry.value();
+        if (!mTrieMap.put(it->second, value, nextLevelBitmapEntryIndex)) {
             return false;
         }
         if (entry.hasNextLevelMap()) {
-            if (!runGCInner(terminalIdMap, entry.getEntriesInNextLevel(),
+            if (!runGCInner(terminalIdMap, originalContent, entry.getEntriesInNextLevel(),
                     mTrieMap.getNextLevelBitmapEntryIndex(it->second, nextLevelBitmapEntryIndex))) {
                 return false;
             }
@@ -302,7 +312,7 @@ int LanguageModelDictContent::createAndGetBitmapEntryIndex(const WordIdArrayView
             continue;
         }
         if (!result.mIsValid) {
-            if (!mTrieMap.put(wordId, ProbabilityEntry().encode(mHasHistoricalInfo),
+            if (!mTrieMap.put(wordId, encodeProbabilityEntry(ProbabilityEntry()),
                     lastBitmapEntryIndex)) {
                 AKLOGE("Failed to update trie map. wordId: %d, lastBitmapEntryIndex %d", wordId,
                         lastBitmapEntryIndex);
@@ -337,7 +347,7 @@ bool LanguageModelDictContent::updateAllProbabilityEntriesForGCInner(const int b
             return false;
         }
         const ProbabilityEntry probabilityEntry =
-                ProbabilityEntry::decode(entry.value(), mHasHistoricalInfo);
+                decodeProbabilityEntry(entry.value());
         if (prevWordCount > 0 && probabilityEntry.isValid()
                 && !mTrieMap.getRoot(entry.key()).mIsValid) {
             // The entry is related to a word that has been removed. Remove the entry.
@@ -369,7 +379,7 @@ bool LanguageModelDictContent::updateAllProbabilityEntriesForGCInner(const int b
                         originalHistoricalInfo->getLevel(), updatedCount);
                 const ProbabilityEntry updatedEntry(probabilityEntry.getFlags(),
                         &historicalInfoToSave);
-                if (!mTrieMap.put(entry.key(), updatedEntry.encode(mHasHistoricalInfo),
+                if (!mTrieMap.put(entry.key(), encodeProbabilityEntry(updatedEntry),
                         bitmapEntryIndex)) {
                     return false;
                 }
@@ -389,59 +399,78 @@ bool LanguageModelDictContent::updateAllProbabilityEntriesForGCInner(const int b
 }
 
 bool LanguageModelDictContent::turncateEntriesInSpecifiedLevel(
-        const HeaderPolicy *const headerPolicy, const int maxEntryCount, const int targetLevel,
-        int *const outEntryCount) {
-    std::vector<int> prevWordIds;
-    std::vector<EntryInfoToTurncate> entryInfoVector;
+        const HeaderPolicy *const headerPolicy, const int currentEntryCount,
+        const int maxEntryCount, const int targetLevel, int *const outEntryCount) {
+    // currentEntryCount can be larger than the actual count when entries in lower levels have
+    // already been removed, so it only bounds the number of candidates to keep in the heap.
+    const int maxEntryCountToRemove = currentEntryCount - maxEntryCount;
+    std::vector<EntryInfoToTurncate> entryInfoHeap;
+    entryInfoHeap.reserve(maxEntryCountToRemove);
+    int entryCount = 0;
     if (!getEntryInfo(headerPolicy, targetLevel, mTrieMap.getRootBitmapEntryIndex(),
-            &prevWordIds, &entryInfoVector)) {
+            0 /* prevWordCount */, maxEntryCountToRemove, &entryInfoHeap, &entryCount)) {
         return false;
     }
-    if (static_cast<int>(entryInfoVector.size()) <= maxEntryCount) {
-        *outEntryCount = static_cast<int>(entryInfoVector.size());
+    const int entryCountToRemove = std::min(entryCount - maxEntryCount,
+            static_cast<int>(entryInfoHeap.size()));
+    if (entryCountToRemove <= 0) {
+        *outEntryCount = entryCount;
         return true;
     }
-    *outEntryCount = maxEntryCount;
-    const int entryCountToRemove = static_cast<int>(entryInfoVector.size()) - maxEntryCount;
-    std::partial_sort(entryInfoVector.begin(), entryInfoVector.begin() + entryCountToRemove,
-            entryInfoVector.end(),
-            EntryInfoToTurncate::Comparator());
-    for (int i = 0; i < entryCountToRemove; ++i) {
-        const EntryInfoToTurncate &entryInfo = entryInfoVector[i];
-        if (!removeNgramProbabilityEntry(
-                WordIdArrayView(entryInfo.mPrevWordIds, entryInfo.mPrevWordCount),
-                entryInfo.mKey)) {
+    // The top of the heap is the candidate that has the highest priority to be kept.
+    while (static_cast<int>(entryInfoHeap.size()) > entryCountToRemove) {
+        std::pop_heap(entryInfoHeap.begin(), entryInfoHeap.end(),
+                EntryInfoToTurncate::Comparator());
+        entryInfoHeap.pop_back();
+    }
+    for (const EntryInfoToTurncate &entryInfo : entryInfoHeap) {
+        // Removing an entry only frees tables in higher levels; bitmap entry indices in the target
+        // level stay valid.
+        if (!mTrieMap.remove(entryInfo.mKey, entryInfo.mBitmapEntryIndex)) {
             return false;
         }
     }
+    *outEntryCount = entryCount - entryCountToRemove;
     return true;
 }
 
 bool LanguageModelDictContent::getEntryInfo(const HeaderPolicy *const headerPolicy,
-        const int targetLevel, const int bitmapEntryIndex,  std::vector<int> *const prevWordIds,
-        std::vector<EntryInfoToTurncate> *const outEntryInfo) const {
-    const int prevWordCount = prevWordIds->size();
+        const int targetLevel, const int bitmapEntryIndex, const int prevWordCount,
+        const int maxEntryInfoCount, std::vector<EntryInfoToTurncate> *const outEntryInfoHeap,
+        int *const outEntryCount) const {
     for (const auto &entry : mTrieMap.getEntriesInSpecifiedLevel(bitmapEntryIndex)) {
         if (prevWordCount < targetLevel) {
             if (!entry.hasNextLevelMap()) {
                 continue;
             }
-            prevWordIds->push_back(entry.key());
             if (!getEntryInfo(headerPolicy, targetLevel, entry.getNextLevelBitmapEntryIndex(),
-                    prevWordIds, outEntryInfo)) {
+                    prevWordCount + 1, maxEntryInfoCount, outEntryInfoHeap, outEntryCount)) {
                 return false;
             }
-            prevWordIds->pop_back();
             continue;
         }
+        ++(*outEntryCount);
         const ProbabilityEntry probabilityEntry =
-                ProbabilityEntry::decode(entry.value(), mHasHistoricalInfo);
+                decodeProbabilityEntry(entry.value());
         const int priority = mHasHistoricalInfo
                 ? DynamicLanguageModelProbabilityUtils::getPriorityToPreventFromEviction(
                         *probabilityEntry.getHistoricalInfo())
                 : probabilityEntry.getProbability();
-        outEntryInfo->emplace_back(priority, probabilityEntry.getHistoricalInfo()->getCount(),
-                entry.key(), targetLevel, prevWordIds->data());
+        const EntryInfoToTurncate entryInfo(priority,
+                probabilityEntry.getHistoricalInfo()->getCount(), entry.key(), bitmapEntryIndex);
+        // Keep the maxEntryInfoCount entries that are the most eligible for removal in a max-heap.
+        if (static_cast<int>(outEntryInfoHeap->size()) < maxEntryInfoCount) {
+            outEntryInfoHeap->push_back(entryInfo);
+            std::push_heap(outEntryInfoHeap->begin(), outEntryInfoHeap->end(),
+                    EntryInfoToTurncate::Comparator());
+        } else if (maxEntryInfoCount > 0
+                && EntryInfoToTurncate::Comparator()(entryInfo, outEntryInfoHeap->front())) {
+            std::pop_heap(outEntryInfoHeap->begin(), outEntryInfoHeap->end(),
+                    EntryInfoToTurncate::Comparator());
+            outEntryInfoHeap->back() = entryInfo;
+            std::push_heap(outEntryInfoHeap->begin(), outEntryInfoHeap->end(),
+                    EntryInfoToTurncate::Comparator());
+        }
     }
     return true;
 }
@@ -457,22 +486,15 @@ bool LanguageModelDictContent::EntryInfoToTurncate::Comparator::operator()(
     if (left.mKey != right.mKey) {
         return left.mKey < right.mKey;
     }
-    if (left.mPrevWordCount != right.mPrevWordCount) {
-        return left.mPrevWordCount > right.mPrevWordCount;
-    }
-    for (int i = 0; i < left.mPrevWordCount; ++i) {
-        if (left.mPrevWordIds[i] != right.mPrevWordIds[i]) {
-            return left.mPrevWordIds[i] < right.mPrevWordIds[i];
-        }
+    if (left.mBitmapEntryIndex != right.mBitmapEntryIndex) {
+        return left.mBitmapEntryIndex < right.mBitmapEntryIndex;
     }
     // left and rigth represent the same entry.
     return false;
 }
 
 LanguageModelDictContent::EntryInfoToTurncate::EntryInfoToTurncate(const int priority,
-        const int count, const int key, const int prevWordCount, const int *const prevWordIds)
-        : mPriority(priority), mCount(count), mKey(key), mPrevWordCount(prevWordCount) {
-    memmove(mPrevWordIds, prevWordIds, mPrevWordCount * sizeof(mPrevWordIds[0]));
-}
+        const int count, const int key, const int bitmapEntryIndex)
+        : mPriority(priority), mCount(count), mKey(key), mBitmapEntryIndex(bitmapEntryIndex) {}
 
 } // namespace latinime
@@ -63,13 +63,14 @@ class LanguageModelDictContent {
     class EntryIterator {
      public:
         EntryIterator(const TrieMap::TrieMapIterator &trieMapIterator,
-                const bool hasHistoricalInfo)
-                : mTrieMapIterator(trieMapIterator), mHasHistoricalInfo(hasHistoricalInfo) {}
+                const LanguageModelDictContent *const languageModelDictContent)
+                : mTrieMapIterator(trieMapIterator),
+                  mLanguageModelDictContent(languageModelDictContent) {}
 
         const WordIdAndProbabilityEntry operator*() const {
             const TrieMap::TrieMapIterator::IterationResult &result = *mTrieMapIterator;
-            return WordIdAndProbabilityEntry(
-                    result.key(), ProbabilityEntry::decode(result.value(), mHasHistoricalInfo));
+            return WordIdAndProbabilityEntry(result.key(),
+                    mLanguageModelDictContent->decodeProbabilityEntry(result.value()));
         }
 
         bool operator!=(const EntryIterator &other) const {
@@ -86,21 +87,23 @@ class LanguageModelDictContent {
         DISALLOW_ASSIGNMENT_OPERATOR(EntryIterator);
 
         TrieMap::TrieMapIterator mTrieMapIterator;
-        const bool mHasHistoricalInfo;
+        const LanguageModelDictContent *const mLanguageModelDictContent;
     };
 
     // Class represents range to use range base for loops.
     class EntryRange {
      public:
-        EntryRange(const TrieMap::TrieMapRange trieMapRange, const bool hasHistoricalInfo)
-                : mTrieMapRange(trieMapRange), mHasHistoricalInfo(hasHistoricalInfo) {}
+        EntryRange(const TrieMap::TrieMapRange trieMapRange,
+                const LanguageModelDictContent *const languageModelDictContent)
+                : mTrieMapRange(trieMapRange),
+                  mLanguageModelDictContent(languageModelDictContent) {}
 
         EntryIterator begin() const {
-            return EntryIterator(mTrieMapRange.begin(), mHasHistoricalInfo);
+            return EntryIterator(mTrieMapRange.begin(), mLanguageModelDictContent);
         }
 
         EntryIterator end() const {
-            return EntryIterator(mTrieMapRange.end(), mHasHistoricalInfo);
+            return EntryIterator(mTrieMapRange.end(), mLanguageModelDictContent);
         }
 
      private:
@@ -108,7 +111,7 @@ class LanguageModelDictContent {
         DISALLOW_ASSIGNMENT_OPERATOR(EntryRange);
 
         const TrieMap::TrieMapRange mTrieMapRange;
-        const bool mHasHistoricalInfo;
+        const LanguageModelDictContent *const mLanguageModelDictContent;
     };
 
     class DumppedFullEntryInfo {
@@ -134,19 +137,44 @@ class LanguageModelDictContent {
 
     LanguageModelDictContent(const ReadWriteByteArrayView *const buffers,
             const bool hasHistoricalInfo)
+            : LanguageModelDictContent(buffers, hasHistoricalInfo,
+                      false /* usesCompactProbabilityEntries */, 0 /* baseTimestamp */) {}
+
+    // baseTimestamp is the timestamp compact entries are relative to. It has to be the last
+    // decayed time written in the header of the dictionary.
+    LanguageModelDictContent(const ReadWriteByteArrayView *const buffers,
+            const bool hasHistoricalInfo, const bool usesCompactProbabilityEntries,
+            const int baseTimestamp)
             : mTrieMap(buffers[TRIE_MAP_BUFFER_INDEX]),
               mGlobalCounters(buffers[GLOBAL_COUNTERS_BUFFER_INDEX]),
-              mHasHistoricalInfo(hasHistoricalInfo) {}
+              mHasHistoricalInfo(hasHistoricalInfo),
+              mUsesCompactProbabilityEntries(usesCompactProbabilityEntries),
+              mBaseTimestamp(baseTimestamp) {}
 
     explicit LanguageModelDictContent(const bool hasHistoricalInfo)
-            : mTrieMap(), mGlobalCounters(), mHasHistoricalInfo(hasHistoricalInfo) {}
+            : LanguageModelDictContent(hasHistoricalInfo,
+                      false /* usesCompactProbabilityEntries */, 0 /* baseTimestamp */) {}
+
+    LanguageModelDictContent(const bool hasHistoricalInfo,
+            const bool usesCompactProbabilityEntries, const int baseTimestamp)
+            : mTrieMap(), mGlobalCounters(), mHasHistoricalInfo(hasHistoricalInfo),
+              mUsesCompactProbabilityEntries(usesCompactProbabilityEntries),
+              mBaseTimestamp(baseTimestamp) {}
 
     bool isNearSizeLimit() const {
         return mTrieMap.isNearSizeLimit() || mGlobalCounters.needsToHalveCounters();
     }
 
+    const MemoryUsage getMemoryUsage() const {
+        MemoryUsage memoryUsage = mTrieMap.getMemoryUsage();
+        memoryUsage.add(mGlobalCounters.getMemoryUsage());
+        return memoryUsage;
+    }
+
     bool save(FILE *const file) const;
 
+    // Compact entries are re-encoded relative to the current time, which is written in the
+    // header of the GCed dictionary as its last decayed time.
     bool runGC(const TerminalPositionLookupTable::TerminalIdMap *const terminalIdMap,
             const LanguageModelDictContent *const originalContent);
 
@@ -215,14 +243,15 @@ class LanguageModelDictContent {
         };
 
         EntryInfoToTurncate(const int priority, const int count, const int key,
-                const int prevWordCount, const int *const prevWordIds);
+                const int bitmapEntryIndex);
 
         int mPriority;
         // TODO: Remove.
         int mCount;
         int mKey;
-        int mPrevWordCount;
-        int mPrevWordIds[MAX_PREV_WORD_COUNT_FOR_N_GRAM + 1];
+        // The bitmap entry index of the level that contains the entry. The entry can be removed
+        // with this and mKey without walking the trie map from the root.
+        int mBitmapEntryIndex;
 
      private:
         DISALLOW_DEFAULT_CONSTRUCTOR(EntryInfoToTurncate);
@@ -234,8 +263,24 @@ class LanguageModelDictContent {
     TrieMap mTrieMap;
     LanguageModelDictContentGlobalCounters mGlobalCounters;
     const bool mHasHistoricalInfo;
+    const bool mUsesCompactProbabilityEntries;
+    int mBaseTimestamp;
+
+    AK_FORCE_INLINE uint64_t encodeProbabilityEntry(
+            const ProbabilityEntry &probabilityEntry) const {
+        return mUsesCompactProbabilityEntries
+                ? probabilityEntry.encodeCompact(mHasHistoricalInfo, mBaseTimestamp)
+                : probabilityEntry.encode(mHasHistoricalInfo);
+    }
+
+    AK_FORCE_INLINE ProbabilityEntry decodeProbabilityEntry(const uint64_t encodedEntry) const {
+        return mUsesCompactProbabilityEntries
+                ? ProbabilityEntry::decodeCompact(encodedEntry, mHasHistoricalInfo, mBaseTimestamp)
+                : ProbabilityEntry::decode(encodedEntry, mHasHistoricalInfo);
+    }
 
     bool runGCInner(const TerminalPositionLookupTable::TerminalIdMap *const terminalIdMap,
+            const LanguageModelDictContent *const originalContent,
             const TrieMap::TrieMapRange trieMapRange, const int nextLevelBitmapEntryIndex);
     int createAndGetBitmapEntryIndex(const WordIdArrayView prevWordIds);
     int getBitmapEntryIndex(const WordIdArrayView prevWordIds) const;
@@ -243,10 +288,12 @@ class LanguageModelDictContent {
             const HeaderPolicy *const headerPolicy, const bool needsToHalveCounters,
             MutableEntryCounters *const outEntryCounters);
     bool turncateEntriesInSpecifiedLevel(const HeaderPolicy *const headerPolicy,
-            const int maxEntryCount, const int targetLevel, int *const outEntryCount);
+            const int currentEntryCount, const int maxEntryCount, const int targetLevel,
+            int *const outEntryCount);
     bool getEntryInfo(const HeaderPolicy *const headerPolicy, const int targetLevel,
-            const int bitmapEntryIndex, std::vector<int> *const prevWordIds,
-            std::vector<EntryInfoToTurncate> *const outEntryInfo) const;
+            const int bitmapEntryIndex, const int prevWordCount, const int maxEntryInfoCount,
+            std::vector<EntryInfoToTurncate> *const outEntryInfoHeap,
+            int *const outEntryCount) const;
     const ProbabilityEntry createUpdatedEntryFrom(const ProbabilityEntry &originalProbabilityEntry,
             const bool isValid, const HistoricalInfo historicalInfo,
             const HeaderPolicy *const headerPolicy) const;
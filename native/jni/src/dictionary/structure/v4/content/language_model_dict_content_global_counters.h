@@ -45,6 +45,10 @@ class LanguageModelDictContentGlobalCounters {
         return mTotalCount;
     }
 
+    const MemoryUsage getMemoryUsage() const {
+        return mBuffer.getMemoryUsage();
+    }
+
     bool save(FILE *const file) const {
         BufferWithExtendableBuffer bufferToWrite(
                 BufferWithExtendableBuffer::DEFAULT_MAX_ADDITIONAL_BUFFER_SIZE);
@@ -141,6 +141,57 @@ class ProbabilityEntry {
         }
     }
 
+    // Encodes the entry for dictionaries using compact probability entries. Entries without
+    // historical information already fit in the value field of a TrieMap terminal entry, so they
+    // use the regular layout. Entries with historical information are packed into a compact
+    // layout having a timestamp relative to baseTimestamp when possible, and otherwise use the
+    // regular layout marked with COMPACT_MODE_FULL_ENTRY_MARKER.
+    uint64_t encodeCompact(const bool hasHistoricalInfo, const int baseTimestamp) const {
+        if (!hasHistoricalInfo) {
+            return encode(false /* hasHistoricalInfo */);
+        }
+        const int timestampDelta = getCompactTimestampDelta(baseTimestamp);
+        if (!mHistoricalInfo.isValid() || timestampDelta < getMinCompactTimestampDelta()
+                || timestampDelta > getMaxCompactTimestampDelta()
+                || mHistoricalInfo.getCount() < 0
+                || mHistoricalInfo.getCount() > getMaxCompactCount()
+                || (mFlags >> Ver4DictConstants::COMPACT_FLAGS_BIT_COUNT) != 0) {
+            return encode(true /* hasHistoricalInfo */)
+                    | Ver4DictConstants::COMPACT_MODE_FULL_ENTRY_MARKER;
+        }
+        uint64_t encodedEntry = mFlags;
+        encodedEntry = (encodedEntry << Ver4DictConstants::COMPACT_WORD_COUNT_BIT_COUNT)
+                | static_cast<uint64_t>(mHistoricalInfo.getCount());
+        encodedEntry = (encodedEntry << Ver4DictConstants::COMPACT_TIME_STAMP_DELTA_BIT_COUNT)
+                | (static_cast<uint64_t>(timestampDelta - getMinCompactTimestampDelta()));
+        return encodedEntry;
+    }
+
+    static ProbabilityEntry decodeCompact(const uint64_t encodedEntry,
+            const bool hasHistoricalInfo, const int baseTimestamp) {
+        if (!hasHistoricalInfo) {
+            return decode(encodedEntry, false /* hasHistoricalInfo */);
+        }
+        if ((encodedEntry & Ver4DictConstants::COMPACT_MODE_FULL_ENTRY_MARKER) != 0) {
+            return decode(encodedEntry & ~Ver4DictConstants::COMPACT_MODE_FULL_ENTRY_MARKER,
+                    true /* hasHistoricalInfo */);
+        }
+        const int timestampDelta = readBitsFromEncodedEntry(encodedEntry,
+                Ver4DictConstants::COMPACT_TIME_STAMP_DELTA_BIT_COUNT, 0 /* pos */)
+                        + getMinCompactTimestampDelta();
+        const int count = readBitsFromEncodedEntry(encodedEntry,
+                Ver4DictConstants::COMPACT_WORD_COUNT_BIT_COUNT,
+                Ver4DictConstants::COMPACT_TIME_STAMP_DELTA_BIT_COUNT);
+        const int flags = readBitsFromEncodedEntry(encodedEntry,
+                Ver4DictConstants::COMPACT_FLAGS_BIT_COUNT,
+                Ver4DictConstants::COMPACT_TIME_STAMP_DELTA_BIT_COUNT
+                        + Ver4DictConstants::COMPACT_WORD_COUNT_BIT_COUNT);
+        const HistoricalInfo historicalInfo(baseTimestamp
+                + timestampDelta * Ver4DictConstants::COMPACT_TIME_STAMP_GRANULARITY_IN_SECONDS,
+                0 /* level */, count);
+        return ProbabilityEntry(flags, &historicalInfo);
+    }
+
  private:
     // Copy constructor is public to use this class as a type of return value.
     DISALLOW_ASSIGNMENT_OPERATOR(ProbabilityEntry);
@@ -154,6 +205,38 @@ class ProbabilityEntry {
                 (encodedEntry >> (pos * CHAR_BIT)) & ((1ull << (size * CHAR_BIT)) - 1));
     }
 
+    static int getMinCompactTimestampDelta() {
+        return -(1 << (Ver4DictConstants::COMPACT_TIME_STAMP_DELTA_BIT_COUNT - 1));
+    }
+
+    static int getMaxCompactTimestampDelta() {
+        return (1 << (Ver4DictConstants::COMPACT_TIME_STAMP_DELTA_BIT_COUNT - 1)) - 1;
+    }
+
+    static int getMaxCompactCount() {
+        return (1 << Ver4DictConstants::COMPACT_WORD_COUNT_BIT_COUNT) - 1;
+    }
+
+    static int readBitsFromEncodedEntry(const uint64_t encodedEntry, const int bitCount,
+            const int bitPos) {
+        return static_cast<int>((encodedEntry >> bitPos) & ((1ull << bitCount) - 1));
+    }
+
+    // Returns the timestamp delta rounded down to the compact granularity so that decoded
+    // timestamps never get ahead of the original ones.
+    int getCompactTimestampDelta(const int baseTimestamp) const {
+        const int64_t delta = static_cast<int64_t>(mHistoricalInfo.getTimestamp())
+                - static_cast<int64_t>(baseTimestamp);
+        const int64_t granularity = Ver4DictConstants::COMPACT_TIME_STAMP_GRANULARITY_IN_SECONDS;
+        const int64_t quantizedDelta =
+                (delta >= 0) ? delta / granularity : -((-delta + granularity - 1) / granularity);
+        if (quantizedDelta < getMinCompactTimestampDelta()
+                || quantizedDelta > getMaxCompactTimestampDelta()) {
+            return S_INT_MIN;
+        }
+        return static_cast<int>(quantizedDelta);
+    }
+
     static uint8_t createFlags(const bool representsBeginningOfSentence,
             const bool isNotAWord, const bool isBlacklisted, const bool isPossiblyOffensive) {
         uint8_t flags = 0;
@@ -24,6 +24,7 @@
 #include "dictionary/utils/buffer_with_extendable_buffer.h"
 #include "dictionary/utils/dict_file_writing_utils.h"
 #include "utils/byte_array_view.h"
+#include "utils/memory_report.h"
 
 namespace latinime {
 
@@ -42,6 +43,10 @@ class SingleDictContent {
         return mExpandableContentBuffer.isNearSizeLimit();
     }
 
+    const MemoryUsage getMemoryUsage() const {
+        return mExpandableContentBuffer.getMemoryUsage();
+    }
+
  protected:
     BufferWithExtendableBuffer *getWritableBuffer() {
         return &mExpandableContentBuffer;
@@ -24,6 +24,7 @@
 #include "dictionary/utils/buffer_with_extendable_buffer.h"
 #include "dictionary/utils/sparse_table.h"
 #include "utils/byte_array_view.h"
+#include "utils/memory_report.h"
 
 namespace latinime {
 
@@ -56,6 +57,13 @@ class SparseTableDictContent {
                 || mExpandableContentBuffer.isNearSizeLimit();
     }
 
+    const MemoryUsage getMemoryUsage() const {
+        MemoryUsage memoryUsage = mExpandableLookupTableBuffer.getMemoryUsage();
+        memoryUsage.add(mExpandableAddressTableBuffer.getMemoryUsage());
+        memoryUsage.add(mExpandableContentBuffer.getMemoryUsage());
+        return memoryUsage;
+    }
+
  protected:
     SparseTable *getUpdatableAddressLookupTable() {
         return &mAddressLookupTable;
@@ -66,6 +66,15 @@ namespace latinime {
             formatVersion, buffers));
 }
 
+void Ver4DictBuffers::getMemoryReport(MemoryReport *const outMemoryReport) const {
+    outMemoryReport->addComponent("header", mExpandableHeaderBuffer.getMemoryUsage());
+    outMemoryReport->addComponent("trie", mExpandableTrieBuffer.getMemoryUsage());
+    outMemoryReport->addComponent("terminal_position_lookup_table",
+            mTerminalPositionLookupTable.getMemoryUsage());
+    outMemoryReport->addComponent("language_model", mLanguageModelDictContent.getMemoryUsage());
+    outMemoryReport->addComponent("shortcut", mShortcutDictContent.getMemoryUsage());
+}
+
 bool Ver4DictBuffers::flushHeaderAndDictBuffers(const char *const dictDirPath,
         const BufferWithExtendableBuffer *const headerBuffer) const {
     // Create temporary directory.
@@ -180,7 +189,9 @@ Ver4DictBuffers::Ver4DictBuffers(MmappedBuffer::MmappedBufferPtr &&headerBuffer,
           mTerminalPositionLookupTable(
                   contentBuffers[Ver4DictConstants::TERMINAL_ADDRESS_LOOKUP_TABLE_BUFFER_INDEX]),
           mLanguageModelDictContent(&contentBuffers[Ver4DictConstants::LANGUAGE_MODEL_BUFFER_INDEX],
-                  mHeaderPolicy.hasHistoricalInfoOfWords()),
+                  mHeaderPolicy.hasHistoricalInfoOfWords(),
+                  mHeaderPolicy.usesCompactProbabilityEntries(),
+                  mHeaderPolicy.getLastDecayedTime()),
           mShortcutDictContent(&contentBuffers[Ver4DictConstants::SHORTCUT_BUFFERS_INDEX]),
           mIsUpdatable(mDictBuffer->isUpdatable()) {}
 
@@ -188,7 +199,9 @@ Ver4DictBuffers::Ver4DictBuffers(const HeaderPolicy *const headerPolicy, const i
         : mHeaderBuffer(nullptr), mDictBuffer(nullptr), mHeaderPolicy(headerPolicy),
           mExpandableHeaderBuffer(Ver4DictConstants::MAX_DICTIONARY_SIZE),
           mExpandableTrieBuffer(maxTrieSize), mTerminalPositionLookupTable(),
-          mLanguageModelDictContent(headerPolicy->hasHistoricalInfoOfWords()),
+          mLanguageModelDictContent(headerPolicy->hasHistoricalInfoOfWords(),
+                  headerPolicy->usesCompactProbabilityEntries(),
+                  headerPolicy->getLastDecayedTime()),
           mShortcutDictContent(),  mIsUpdatable(true) {}
 
 } // namespace latinime
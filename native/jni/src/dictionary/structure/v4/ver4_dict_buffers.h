@@ -28,6 +28,7 @@
 #include "dictionary/structure/v4/ver4_dict_constants.h"
 #include "dictionary/utils/buffer_with_extendable_buffer.h"
 #include "dictionary/utils/mmapped_buffer.h"
+#include "utils/memory_report.h"
 
 namespace latinime {
 
@@ -99,6 +100,9 @@ class Ver4DictBuffers {
         return mIsUpdatable;
     }
 
+    // Mapped bytes are reported with the content that is read from them.
+    void getMemoryReport(MemoryReport *const outMemoryReport) const;
+
     bool flush(const char *const dictDirPath) const {
         return flushHeaderAndDictBuffers(dictDirPath, &mExpandableHeaderBuffer);
     }
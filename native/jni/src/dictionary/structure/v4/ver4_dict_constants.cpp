@@ -51,6 +51,17 @@ const int Ver4DictConstants::TERMINAL_ID_FIELD_SIZE = 4;
 const int Ver4DictConstants::TIME_STAMP_FIELD_SIZE = 4;
 const int Ver4DictConstants::WORD_LEVEL_FIELD_SIZE = 0;
 const int Ver4DictConstants::WORD_COUNT_FIELD_SIZE = 2;
+// A compact entry has to fit in the 22-bit value field of a TrieMap terminal entry. The top bit is
+// always 0 so that a compact entry never collides with TrieMap's invalid value.
+// The timestamp is stored as a signed delta from the base timestamp in hours, which covers about
+// 85 days in both directions.
+const int Ver4DictConstants::COMPACT_TIME_STAMP_DELTA_BIT_COUNT = 12;
+const int Ver4DictConstants::COMPACT_WORD_COUNT_BIT_COUNT = 4;
+const int Ver4DictConstants::COMPACT_FLAGS_BIT_COUNT = 5;
+const int Ver4DictConstants::COMPACT_TIME_STAMP_GRANULARITY_IN_SECONDS = 60 * 60;
+// Entries that cannot be encoded compactly use the regular layout with this bit set. The bit is
+// never used by the regular layout because only 5 bits of the flags field are in use.
+const uint64_t Ver4DictConstants::COMPACT_MODE_FULL_ENTRY_MARKER = 1ull << 55;
 
 const uint8_t Ver4DictConstants::FLAG_REPRESENTS_BEGINNING_OF_SENTENCE = 0x1;
 const uint8_t Ver4DictConstants::FLAG_NOT_A_VALID_ENTRY = 0x2;
@@ -50,6 +50,12 @@ class Ver4DictConstants {
     // TODO: Remove
     static const int WORD_LEVEL_FIELD_SIZE;
     static const int WORD_COUNT_FIELD_SIZE;
+    // Bit layout of compact probability entries with historical information.
+    static const int COMPACT_TIME_STAMP_DELTA_BIT_COUNT;
+    static const int COMPACT_WORD_COUNT_BIT_COUNT;
+    static const int COMPACT_FLAGS_BIT_COUNT;
+    static const int COMPACT_TIME_STAMP_GRANULARITY_IN_SECONDS;
+    static const uint64_t COMPACT_MODE_FULL_ENTRY_MARKER;
     // Flags in probability entry.
     static const uint8_t FLAG_REPRESENTS_BEGINNING_OF_SENTENCE;
     static const uint8_t FLAG_NOT_A_VALID_ENTRY;
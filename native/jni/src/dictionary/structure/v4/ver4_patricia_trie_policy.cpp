@@ -31,6 +31,9 @@
 #include "dictionary/utils/forgetting_curve_utils.h"
 #include "dictionary/utils/multi_bigram_map.h"
 #include "dictionary/utils/probability_utils.h"
+#include "dictionary/utils/word_batch.h"
+#include "dictionary/utils/word_property_batch.h"
+#include "utils/memory_report.h"
 #include "utils/ngram_utils.h"
 
 namespace latinime {
@@ -501,6 +504,12 @@ void Ver4PatriciaTriePolicy::getProperty(const char *const query, const int quer
     }
 }
 
+void Ver4PatriciaTriePolicy::getMemoryReport(MemoryReport *const outMemoryReport) const {
+    mBuffers->getMemoryReport(outMemoryReport);
+    outMemoryReport->addComponent("word_iteration",
+            MemoryReport::getVectorMemoryUsage(mTerminalPtNodePositionsForIteratingWords));
+}
+
 const WordProperty Ver4PatriciaTriePolicy::getWordProperty(
         const CodePointArrayView wordCodePoints) const {
     const int wordId = getWordId(wordCodePoints, false /* forceLowerCaseSearch */);
@@ -600,4 +609,62 @@ int Ver4PatriciaTriePolicy::getNextWordAndNextToken(const int token, int *const
     return nextToken;
 }
 
+int Ver4PatriciaTriePolicy::getNextWordsAndNextToken(const int token,
+        WordBatch *const outWordBatch) {
+    if (token == 0) {
+        // Start iterating the dictionary.
+        mWordIterator.init(getRootPosition());
+    } else if (token != mNextWordBatchToken) {
+        AKLOGE("Given token %d is invalid.", token);
+        return 0;
+    }
+    while (mWordIterator.hasWord()) {
+        const PtNodeParams ptNodeParams(mWordIterator.getPtNodeParams());
+        const WordAttributes wordAttributes =
+                mBuffers->getLanguageModelDictContent()->getWordAttributes(WordIdArrayView(),
+                        ptNodeParams.getTerminalId(), true /* mustMatchAllPrevWords */,
+                        mHeaderPolicy);
+        if (!outWordBatch->addWord(mWordIterator.getCodePoints(), wordAttributes)) {
+            // The batch is full. The current word is the first word of the next batch.
+            mNextWordBatchToken = token + 1;
+            return mNextWordBatchToken;
+        }
+        mWordIterator.readNextWord();
+    }
+    if (mWordIterator.isError()) {
+        mIsCorrupted = true;
+        AKLOGE("Dictionary reading error in getNextWordsAndNextToken().");
+    }
+    // All words have been iterated.
+    mNextWordBatchToken = 0;
+    return 0;
+}
+
+int Ver4PatriciaTriePolicy::getNextWordPropertiesAndNextToken(const int token,
+        WordPropertyBatch *const outWordPropertyBatch) {
+    if (token == 0) {
+        // Start iterating the dictionary.
+        mWordIterator.init(getRootPosition());
+    } else if (token != mNextWordBatchToken) {
+        AKLOGE("Given token %d is invalid.", token);
+        return 0;
+    }
+    while (mWordIterator.hasWord()) {
+        if (!outWordPropertyBatch->addWordProperty(
+                getWordProperty(mWordIterator.getCodePoints()))) {
+            // The batch is full. The current word is the first word of the next batch.
+            mNextWordBatchToken = token + 1;
+            return mNextWordBatchToken;
+        }
+        mWordIterator.readNextWord();
+    }
+    if (mWordIterator.isError()) {
+        mIsCorrupted = true;
+        AKLOGE("Dictionary reading error in getNextWordPropertiesAndNextToken().");
+    }
+    // All words have been iterated.
+    mNextWordBatchToken = 0;
+    return 0;
+}
+
 } // namespace latinime
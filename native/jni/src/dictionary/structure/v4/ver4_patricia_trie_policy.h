@@ -23,6 +23,7 @@
 #include "dictionary/header/header_policy.h"
 #include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
 #include "dictionary/structure/pt_common/dynamic_pt_updating_helper.h"
+#include "dictionary/structure/pt_common/dynamic_pt_word_iterator.h"
 #include "dictionary/structure/v4/shortcut/ver4_shortcut_list_policy.h"
 #include "dictionary/structure/v4/ver4_dict_buffers.h"
 #include "dictionary/structure/v4/ver4_patricia_trie_node_reader.h"
@@ -52,7 +53,9 @@ class Ver4PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
               mUpdatingHelper(mDictBuffer, &mNodeReader, &mNodeWriter),
               mWritingHelper(mBuffers.get()),
               mEntryCounters(mHeaderPolicy->getNgramCounts().getCountArray()),
-              mTerminalPtNodePositionsForIteratingWords(), mIsCorrupted(false) {};
+              mTerminalPtNodePositionsForIteratingWords(),
+              mWordIterator(&mNodeReader, &mPtNodeArrayReader), mNextWordBatchToken(0),
+              mIsCorrupted(false) {};
 
     AK_FORCE_INLINE int getRootPosition() const {
         return 0;
@@ -111,9 +114,24 @@ class Ver4PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
 
     const WordProperty getWordProperty(const CodePointArrayView wordCodePoints) const;
 
+    void getMemoryReport(MemoryReport *const outMemoryReport) const;
+
+    const PtNodeReader *getPtNodeReader() const {
+        return &mNodeReader;
+    }
+
+    const PtNodeArrayReader *getPtNodeArrayReader() const {
+        return &mPtNodeArrayReader;
+    }
+
     int getNextWordAndNextToken(const int token, int *const outCodePoints,
             int *const outCodePointCount);
 
+    int getNextWordsAndNextToken(const int token, WordBatch *const outWordBatch);
+
+    int getNextWordPropertiesAndNextToken(const int token,
+            WordPropertyBatch *const outWordPropertyBatch);
+
     bool isCorrupted() const {
         return mIsCorrupted;
     }
@@ -141,6 +159,8 @@ class Ver4PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
     Ver4PatriciaTrieWritingHelper mWritingHelper;
     MutableEntryCounters mEntryCounters;
     std::vector<int> mTerminalPtNodePositionsForIteratingWords;
+    DynamicPtWordIterator mWordIterator;
+    int mNextWordBatchToken;
     mutable bool mIsCorrupted;
 
     int getShortcutPositionOfWord(const int wordId) const;
@@ -51,6 +51,14 @@ void BufferWithExtendableBuffer::readCodePointsAndAdvancePosition(const int maxC
     }
 }
 
+const MemoryUsage BufferWithExtendableBuffer::getMemoryUsage() const {
+    MemoryUsage memoryUsage = MemoryReport::getMappedMemoryUsage(mOriginalBuffer.data(),
+            mOriginalBuffer.size());
+    memoryUsage.add(MemoryUsage::heap(mAdditionalBuffer.capacity(),
+            mAdditionalBuffer.capacity() - mUsedAdditionalBufferSize));
+    return memoryUsage;
+}
+
 bool BufferWithExtendableBuffer::extend(const int size) {
     return checkAndPrepareWriting(getTailPosition(), size);
 }
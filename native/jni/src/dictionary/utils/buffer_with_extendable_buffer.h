@@ -24,6 +24,7 @@
 #include "defines.h"
 #include "dictionary/utils/byte_array_utils.h"
 #include "utils/byte_array_view.h"
+#include "utils/memory_report.h"
 
 namespace latinime {
 
@@ -88,6 +89,9 @@ class BufferWithExtendableBuffer {
 
     bool extend(const int size);
 
+    // The original buffer is reported as mapped and the additional buffer as heap.
+    const MemoryUsage getMemoryUsage() const;
+
     /**
      * For writing.
      *
@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2014, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dictionary/utils/dict_migration_utils.h"
+
+#include <cstdio>
+#include <limits>
+#include <unistd.h>
+
+#include "dictionary/property/word_property.h"
+#include "dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "dictionary/utils/dict_file_writing_utils.h"
+#include "dictionary/utils/file_utils.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+
+const char *const DictMigrationUtils::PROGRESS_FILE_SUFFIX = ".progress";
+const int DictMigrationUtils::MAX_WORD_COUNT_PER_CHECKPOINT = 5000;
+// Marks the start of each journal record, so that other data is not taken for a commit.
+const int DictMigrationUtils::COMMIT_RECORD_MARKER = -1;
+
+/* static */ bool DictMigrationUtils::migrateDictionary(
+        DictionaryStructureWithBufferPolicy *const sourcePolicy, const char *const dictFilePath,
+        const int newFormatVersion) {
+    int addedNgramCount = 0;
+    return migrateDictionaryInner(sourcePolicy, dictFilePath, newFormatVersion,
+            MAX_WORD_COUNT_PER_CHECKPOINT, std::numeric_limits<int>::max(), &addedNgramCount);
+}
+
+/* static */ bool DictMigrationUtils::migrateDictionaryForTesting(
+        DictionaryStructureWithBufferPolicy *const sourcePolicy, const char *const dictFilePath,
+        const int newFormatVersion, const int wordCountPerCheckpoint,
+        const int maxCheckpointCount, int *const outAddedNgramCount) {
+    return migrateDictionaryInner(sourcePolicy, dictFilePath, newFormatVersion,
+            wordCountPerCheckpoint, maxCheckpointCount, outAddedNgramCount);
+}
+
+/* static */ bool DictMigrationUtils::migrateDictionaryInner(
+        DictionaryStructureWithBufferPolicy *const sourcePolicy, const char *const dictFilePath,
+        const int newFormatVersion, const int wordCountPerCheckpoint,
+        const int maxCheckpointCount, int *const outAddedNgramCount) {
+    const int journalFilePathBufSize = FileUtils::getFilePathWithSuffixBufSize(dictFilePath,
+            PROGRESS_FILE_SUFFIX);
+    char journalFilePath[journalFilePathBufSize];
+    FileUtils::getFilePathWithSuffix(dictFilePath, PROGRESS_FILE_SUFFIX, journalFilePathBufSize,
+            journalFilePath);
+
+    *outAddedNgramCount = 0;
+    MigrationPhase phase = PHASE_ADDING_UNIGRAMS;
+    int token = 0;
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr newPolicy;
+    if (readLastCommit(journalFilePath, &phase, &token)) {
+        // The sections up to the last commit have been written to the new dictionary.
+        newPolicy = DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+                dictFilePath, 0 /* offset */, 0 /* size */, true /* isUpdatable */);
+        if (newPolicy) {
+            AKLOGI("Resuming migration to %s.", dictFilePath);
+        }
+    }
+    if (!newPolicy) {
+        // Nothing to resume from.
+        phase = PHASE_ADDING_UNIGRAMS;
+        token = 0;
+        remove(journalFilePath);
+        FileUtils::removeDirAndFiles(dictFilePath);
+        newPolicy = createNewPolicy(sourcePolicy, newFormatVersion);
+        if (!newPolicy) {
+            AKLOGE("Cannot migrate header.");
+            return false;
+        }
+    }
+    FILE *journalFile = fopen(journalFilePath, "ab");
+    if (!journalFile) {
+        // Migration can continue; only resuming is lost.
+        AKLOGE("Cannot open migration journal %s.", journalFilePath);
+    }
+
+    int wordCodePoints[MAX_WORD_LENGTH];
+    int wordCodePointCount = 0;
+    int wordCountSinceCheckpoint = 0;
+    int checkpointCount = 0;
+    int sectionNgramCount = 0;
+    bool succeeded = true;
+    bool interrupted = false;
+    for (; succeeded && phase <= PHASE_ADDING_NGRAMS;
+            phase = static_cast<MigrationPhase>(phase + 1)) {
+        if (token != 0) {
+            // Resuming from a checkpoint; let the source prepare its iteration state first.
+            sourcePolicy->getNextWordAndNextToken(0 /* token */, wordCodePoints,
+                    &wordCodePointCount);
+        }
+        do {
+            const int currentToken = token;
+            token = sourcePolicy->getNextWordAndNextToken(currentToken, wordCodePoints,
+                    &wordCodePointCount);
+            if (wordCodePointCount <= 0) {
+                continue;
+            }
+            if (phase == PHASE_ADDING_UNIGRAMS
+                    && wordCodePoints[0] == CODE_POINT_BEGINNING_OF_SENTENCE) {
+                // Skip beginning-of-sentence unigram.
+                continue;
+            }
+            if (wordCountSinceCheckpoint >= wordCountPerCheckpoint) {
+                if (checkpointCount >= maxCheckpointCount) {
+                    succeeded = false;
+                    interrupted = true;
+                    break;
+                }
+                // Write the section out before committing it, so a commit never refers to
+                // entries that are only in memory. If the process dies between the two, the
+                // section is added again on resume, which only overwrites the same entries.
+                if (!flushAndReopen(dictFilePath, false /* runsGC */, &newPolicy)) {
+                    succeeded = false;
+                    break;
+                }
+                *outAddedNgramCount += sectionNgramCount;
+                sectionNgramCount = 0;
+                if (journalFile && !appendCommit(journalFile, phase, currentToken)) {
+                    // Stop journaling; the commits already written are still valid.
+                    AKLOGE("Cannot append to migration journal %s.", journalFilePath);
+                    fclose(journalFile);
+                    journalFile = nullptr;
+                }
+                ++checkpointCount;
+                wordCountSinceCheckpoint = 0;
+            }
+            const CodePointArrayView wordCodePointArrayView(wordCodePoints, wordCodePointCount);
+            if (!migrateWord(sourcePolicy, wordCodePointArrayView, phase, dictFilePath,
+                    &newPolicy, &sectionNgramCount)) {
+                succeeded = false;
+                break;
+            }
+            wordCountSinceCheckpoint++;
+        } while (token != 0);
+    }
+    if (journalFile) {
+        fclose(journalFile);
+    }
+    if (interrupted) {
+        return false;
+    }
+    if (succeeded && !newPolicy->flushWithGC(dictFilePath)) {
+        AKLOGE("Cannot flush the migrated dictionary.");
+        succeeded = false;
+    }
+    if (succeeded) {
+        *outAddedNgramCount += sectionNgramCount;
+    } else {
+        // The failure would repeat on resume; start over next time.
+        newPolicy.reset();
+        FileUtils::removeDirAndFiles(dictFilePath);
+    }
+    remove(journalFilePath);
+    return succeeded;
+}
+
+/* static */ DictionaryStructureWithBufferPolicy::StructurePolicyPtr
+        DictMigrationUtils::createNewPolicy(
+                const DictionaryStructureWithBufferPolicy *const sourcePolicy,
+                const int newFormatVersion) {
+    const DictionaryHeaderStructurePolicy *const headerPolicy =
+            sourcePolicy->getHeaderStructurePolicy();
+    return DictionaryStructureWithBufferPolicyFactory::newPolicyForOnMemoryDict(
+            newFormatVersion, *headerPolicy->getLocale(), headerPolicy->getAttributeMap());
+}
+
+/* static */ bool DictMigrationUtils::migrateWord(
+        DictionaryStructureWithBufferPolicy *const sourcePolicy,
+        const CodePointArrayView wordCodePoints, const MigrationPhase phase,
+        const char *const dictFilePath,
+        DictionaryStructureWithBufferPolicy::StructurePolicyPtr *const newPolicy,
+        int *const outAddedNgramCount) {
+    if ((*newPolicy)->needsToRunGC(true /* mindsBlockByGC */)
+            && !flushAndReopen(dictFilePath, true /* runsGC */, newPolicy)) {
+        return false;
+    }
+    const WordProperty wordProperty = sourcePolicy->getWordProperty(wordCodePoints);
+    if (phase == PHASE_ADDING_UNIGRAMS) {
+        if (!(*newPolicy)->addUnigramEntry(wordCodePoints, &wordProperty.getUnigramProperty())) {
+            AKLOGE("Cannot add unigram to the new dict.");
+            return false;
+        }
+        return true;
+    }
+    for (const NgramProperty &ngramProperty : wordProperty.getNgramProperties()) {
+        if (!(*newPolicy)->addNgramEntry(&ngramProperty)) {
+            AKLOGE("Cannot add ngram to the new dict.");
+            return false;
+        }
+        ++(*outAddedNgramCount);
+    }
+    return true;
+}
+
+/* static */ bool DictMigrationUtils::flushAndReopen(const char *const dictFilePath,
+        const bool runsGC,
+        DictionaryStructureWithBufferPolicy::StructurePolicyPtr *const newPolicy) {
+    if (runsGC ? !(*newPolicy)->flushWithGC(dictFilePath) : !(*newPolicy)->flush(dictFilePath)) {
+        AKLOGE("Cannot flush the new dict.");
+        return false;
+    }
+    // Release the current buffers before mapping the flushed dictionary.
+    newPolicy->reset();
+    *newPolicy = DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+            dictFilePath, 0 /* offset */, 0 /* size */, true /* isUpdatable */);
+    if (!*newPolicy) {
+        AKLOGE("Cannot open dict after flush.");
+        return false;
+    }
+    return true;
+}
+
+/* static */ bool DictMigrationUtils::readLastCommit(const char *const journalFilePath,
+        MigrationPhase *const outPhase, int *const outToken) {
+    FILE *const file = fopen(journalFilePath, "rb");
+    if (!file) {
+        return false;
+    }
+    // A torn record after the last complete commit is dropped.
+    long committedSize = 0;
+    int record[3];
+    while (fread(record, sizeof(record[0]), NELEMS(record), file) == NELEMS(record)
+            && record[0] == COMMIT_RECORD_MARKER && record[1] >= PHASE_ADDING_UNIGRAMS
+            && record[1] <= PHASE_ADDING_NGRAMS && record[2] >= 0) {
+        *outPhase = static_cast<MigrationPhase>(record[1]);
+        *outToken = record[2];
+        committedSize = ftell(file);
+    }
+    fclose(file);
+    if (committedSize == 0) {
+        return false;
+    }
+    // New commits are appended right after the last complete one.
+    if (truncate(journalFilePath, committedSize) != 0) {
+        AKLOGE("Cannot truncate migration journal %s.", journalFilePath);
+        return false;
+    }
+    return true;
+}
+
+/* static */ bool DictMigrationUtils::appendCommit(FILE *const journalFile,
+        const MigrationPhase phase, const int token) {
+    const int record[] = { COMMIT_RECORD_MARKER, phase, token };
+    if (fwrite(record, sizeof(record[0]), NELEMS(record), journalFile) != NELEMS(record)) {
+        return false;
+    }
+    return fflush(journalFile) == 0 && fsync(fileno(journalFile)) == 0;
+}
+
+} // namespace latinime
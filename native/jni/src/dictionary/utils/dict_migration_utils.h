@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2014, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_DICT_MIGRATION_UTILS_H
+#define LATINIME_DICT_MIGRATION_UTILS_H
+
+#include <cstdio>
+
+#include "defines.h"
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+
+// Copies all entries of a dictionary into a new dictionary file of another format. Entries are
+// streamed in the source's iteration order into the new dictionary, which is written out and
+// remapped in sections of a bounded number of words, so only the current section is held in
+// memory. After each section is written, a commit record with the position to resume from is
+// appended to a journal next to the new dictionary. An interrupted migration reopens the written
+// dictionary and continues from the last commit. On any other failure the partially written
+// dictionary and the journal are removed.
+class DictMigrationUtils {
+ public:
+    static const char *const PROGRESS_FILE_SUFFIX;
+
+    static bool migrateDictionary(DictionaryStructureWithBufferPolicy *const sourcePolicy,
+            const char *const dictFilePath, const int newFormatVersion);
+
+    // Same as above, but stops and returns false after maxCheckpointCount checkpoints as if the
+    // migration were interrupted, leaving the written sections and the journal behind.
+    // outAddedNgramCount receives the number of n-gram entries this call added to the new
+    // dictionary and wrote out. Used for testing.
+    static bool migrateDictionaryForTesting(
+            DictionaryStructureWithBufferPolicy *const sourcePolicy,
+            const char *const dictFilePath, const int newFormatVersion,
+            const int wordCountPerCheckpoint, const int maxCheckpointCount,
+            int *const outAddedNgramCount);
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(DictMigrationUtils);
+
+    enum MigrationPhase {
+        PHASE_ADDING_UNIGRAMS = 0,
+        PHASE_ADDING_NGRAMS = 1,
+    };
+
+    static const int MAX_WORD_COUNT_PER_CHECKPOINT;
+    static const int COMMIT_RECORD_MARKER;
+
+    static bool migrateDictionaryInner(DictionaryStructureWithBufferPolicy *const sourcePolicy,
+            const char *const dictFilePath, const int newFormatVersion,
+            const int wordCountPerCheckpoint, const int maxCheckpointCount,
+            int *const outAddedNgramCount);
+
+    static DictionaryStructureWithBufferPolicy::StructurePolicyPtr createNewPolicy(
+            const DictionaryStructureWithBufferPolicy *const sourcePolicy,
+            const int newFormatVersion);
+
+    static bool migrateWord(DictionaryStructureWithBufferPolicy *const sourcePolicy,
+            const CodePointArrayView wordCodePoints, const MigrationPhase phase,
+            const char *const dictFilePath,
+            DictionaryStructureWithBufferPolicy::StructurePolicyPtr *const newPolicy,
+            int *const outAddedNgramCount);
+
+    static bool flushAndReopen(const char *const dictFilePath, const bool runsGC,
+            DictionaryStructureWithBufferPolicy::StructurePolicyPtr *const newPolicy);
+
+    static bool readLastCommit(const char *const journalFilePath, MigrationPhase *const outPhase,
+            int *const outToken);
+
+    static bool appendCommit(FILE *const journalFile, const MigrationPhase phase,
+            const int token);
+};
+} // namespace latinime
+#endif /* LATINIME_DICT_MIGRATION_UTILS_H */
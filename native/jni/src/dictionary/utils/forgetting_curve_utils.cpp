@@ -17,7 +17,6 @@
 #include "dictionary/utils/forgetting_curve_utils.h"
 
 #include <algorithm>
-#include <cmath>
 #include <stdlib.h>
 
 #include "dictionary/header/header_policy.h"
@@ -40,7 +39,190 @@ const int ForgettingCurveUtils::DURATION_TO_LOWER_THE_LEVEL_IN_SECONDS = 15 * 24
 
 const float ForgettingCurveUtils::ENTRY_COUNT_HARD_LIMIT_WEIGHT = 1.2;
 
-const ForgettingCurveUtils::ProbabilityTable ForgettingCurveUtils::sProbabilityTable;
+const int ForgettingCurveUtils::PROBABILITY_TABLE_COUNT = 4;
+
+/*
+ * Probabilities of visible levels for each forgetting curve table, level and elapsed time step.
+ * The tables are weak, modest, strong and aggressive, in the order of table ids. Levels under
+ * MIN_VISIBLE_LEVEL always have NOT_A_PROBABILITY.
+ *
+ * Generated with:
+ *   base(level) = 127 / (1 << (MAX_LEVEL - level)) for the weak table, and 8 * (level + 1),
+ *   9 * (level + 1) and 10 * (level + 1) for the others.
+ *   probability = base(level) * powf(base(level) / base(level - 1),
+ *           -timeStepCount / (MAX_ELAPSED_TIME_STEP_COUNT + 1))
+ *   clamped to [1, MAX_PROBABILITY] after truncating to int; NaN (0 / 0) is clamped to 1.
+ */
+/* static */ const int ForgettingCurveUtils::PROBABILITY_TABLES[] = {
+    // Weak, level 2
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    // Weak, level 3
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    // Weak, level 4
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    // Weak, level 5
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    // Weak, level 6
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    // Weak, level 7
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    // Weak, level 8
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    // Weak, level 9
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    // Weak, level 10
+    3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    // Weak, level 11
+    7, 6, 6, 6, 6, 6, 5, 5, 5, 5, 5, 5, 5, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    // Weak, level 12
+    15, 14, 14, 13, 13, 13, 13, 12, 12, 12, 11, 11, 11, 11, 10, 10,
+    10, 10, 9, 9, 9, 9, 8, 8, 8, 8, 8, 7, 7, 7, 7, 7,
+    // Weak, level 13
+    31, 30, 29, 28, 28, 27, 27, 26, 25, 25, 24, 24, 23, 23, 22, 22,
+    21, 21, 20, 20, 19, 19, 18, 18, 17, 17, 17, 16, 16, 16, 15, 15,
+    // Weak, level 14
+    63, 61, 60, 58, 57, 56, 55, 53, 52, 51, 50, 49, 48, 47, 46, 45,
+    44, 43, 42, 41, 40, 39, 38, 37, 37, 36, 35, 34, 33, 33, 32, 31,
+    // Weak, level 15
+    127, 124, 121, 118, 116, 113, 111, 108, 106, 104, 102, 99, 97, 95, 93, 91,
+    89, 87, 85, 83, 81, 80, 78, 76, 75, 73, 71, 70, 68, 67, 65, 64,
+    // Modest, level 2
+    24, 23, 23, 23, 22, 22, 22, 21, 21, 21, 21, 20, 20, 20, 20, 19,
+    19, 19, 19, 18, 18, 18, 18, 17, 17, 17, 17, 17, 16, 16, 16, 16,
+    // Modest, level 3
+    32, 31, 31, 31, 30, 30, 30, 30, 29, 29, 29, 28, 28, 28, 28, 27,
+    27, 27, 27, 26, 26, 26, 26, 26, 25, 25, 25, 25, 24, 24, 24, 24,
+    // Modest, level 4
+    40, 39, 39, 39, 38, 38, 38, 38, 37, 37, 37, 37, 36, 36, 36, 36,
+    35, 35, 35, 35, 34, 34, 34, 34, 33, 33, 33, 33, 32, 32, 32, 32,
+    // Modest, level 5
+    48, 47, 47, 47, 46, 46, 46, 46, 45, 45, 45, 45, 44, 44, 44, 44,
+    43, 43, 43, 43, 42, 42, 42, 42, 41, 41, 41, 41, 40, 40, 40, 40,
+    // Modest, level 6
+    56, 55, 55, 55, 54, 54, 54, 54, 53, 53, 53, 53, 52, 52, 52, 52,
+    51, 51, 51, 51, 50, 50, 50, 50, 49, 49, 49, 49, 48, 48, 48, 48,
+    // Modest, level 7
+    64, 63, 63, 63, 62, 62, 62, 62, 61, 61, 61, 61, 60, 60, 60, 60,
+    59, 59, 59, 59, 58, 58, 58, 58, 57, 57, 57, 57, 56, 56, 56, 56,
+    // Modest, level 8
+    72, 71, 71, 71, 70, 70, 70, 70, 69, 69, 69, 69, 68, 68, 68, 68,
+    67, 67, 67, 67, 66, 66, 66, 66, 65, 65, 65, 65, 64, 64, 64, 64,
+    // Modest, level 9
+    80, 79, 79, 79, 78, 78, 78, 78, 77, 77, 77, 77, 76, 76, 76, 76,
+    75, 75, 75, 75, 74, 74, 74, 74, 73, 73, 73, 73, 72, 72, 72, 72,
+    // Modest, level 10
+    88, 87, 87, 87, 86, 86, 86, 86, 85, 85, 85, 85, 84, 84, 84, 84,
+    83, 83, 83, 83, 82, 82, 82, 82, 81, 81, 81, 81, 80, 80, 80, 80,
+    // Modest, level 11
+    96, 95, 95, 95, 94, 94, 94, 94, 93, 93, 93, 93, 92, 92, 92, 92,
+    91, 91, 91, 91, 90, 90, 90, 90, 89, 89, 89, 89, 88, 88, 88, 88,
+    // Modest, level 12
+    104, 103, 103, 103, 102, 102, 102, 102, 101, 101, 101, 101, 100, 100, 100, 100,
+    99, 99, 99, 99, 98, 98, 98, 98, 97, 97, 97, 97, 96, 96, 96, 96,
+    // Modest, level 13
+    112, 111, 111, 111, 110, 110, 110, 110, 109, 109, 109, 109, 108, 108, 108, 108,
+    107, 107, 107, 107, 106, 106, 106, 106, 105, 105, 105, 105, 104, 104, 104, 104,
+    // Modest, level 14
+    120, 119, 119, 119, 118, 118, 118, 118, 117, 117, 117, 117, 116, 116, 116, 116,
+    115, 115, 115, 115, 114, 114, 114, 114, 113, 113, 113, 113, 112, 112, 112, 112,
+    // Modest, level 15
+    128, 127, 127, 127, 126, 126, 126, 126, 125, 125, 125, 125, 124, 124, 124, 124,
+    123, 123, 123, 123, 122, 122, 122, 122, 121, 121, 121, 121, 120, 120, 120, 120,
+    // Strong, level 2
+    27, 26, 26, 25, 25, 25, 25, 24, 24, 24, 23, 23, 23, 22, 22, 22,
+    22, 21, 21, 21, 20, 20, 20, 20, 19, 19, 19, 19, 18, 18, 18, 18,
+    // Strong, level 3
+    36, 35, 35, 35, 34, 34, 34, 33, 33, 33, 32, 32, 32, 32, 31, 31,
+    31, 30, 30, 30, 30, 29, 29, 29, 29, 28, 28, 28, 27, 27, 27, 27,
+    // Strong, level 4
+    45, 44, 44, 44, 43, 43, 43, 42, 42, 42, 41, 41, 41, 41, 40, 40,
+    40, 39, 39, 39, 39, 38, 38, 38, 38, 37, 37, 37, 37, 36, 36, 36,
+    // Strong, level 5
+    54, 53, 53, 53, 52, 52, 52, 51, 51, 51, 51, 50, 50, 50, 49, 49,
+    49, 49, 48, 48, 48, 47, 47, 47, 47, 46, 46, 46, 46, 45, 45, 45,
+    // Strong, level 6
+    63, 62, 62, 62, 61, 61, 61, 60, 60, 60, 60, 59, 59, 59, 58, 58,
+    58, 58, 57, 57, 57, 56, 56, 56, 56, 55, 55, 55, 55, 54, 54, 54,
+    // Strong, level 7
+    72, 71, 71, 71, 70, 70, 70, 69, 69, 69, 69, 68, 68, 68, 67, 67,
+    67, 67, 66, 66, 66, 65, 65, 65, 65, 64, 64, 64, 64, 63, 63, 63,
+    // Strong, level 8
+    81, 80, 80, 80, 79, 79, 79, 78, 78, 78, 78, 77, 77, 77, 76, 76,
+    76, 76, 75, 75, 75, 74, 74, 74, 74, 73, 73, 73, 73, 72, 72, 72,
+    // Strong, level 9
+    90, 89, 89, 89, 88, 88, 88, 87, 87, 87, 87, 86, 86, 86, 85, 85,
+    85, 85, 84, 84, 84, 83, 83, 83, 83, 82, 82, 82, 82, 81, 81, 81,
+    // Strong, level 10
+    99, 98, 98, 98, 97, 97, 97, 96, 96, 96, 96, 95, 95, 95, 94, 94,
+    94, 94, 93, 93, 93, 92, 92, 92, 92, 91, 91, 91, 91, 90, 90, 90,
+    // Strong, level 11
+    108, 107, 107, 107, 106, 106, 106, 105, 105, 105, 105, 104, 104, 104, 103, 103,
+    103, 103, 102, 102, 102, 102, 101, 101, 101, 100, 100, 100, 100, 99, 99, 99,
+    // Strong, level 12
+    117, 116, 116, 116, 115, 115, 115, 114, 114, 114, 114, 113, 113, 113, 112, 112,
+    112, 112, 111, 111, 111, 111, 110, 110, 110, 109, 109, 109, 109, 108, 108, 108,
+    // Strong, level 13
+    126, 125, 125, 125, 124, 124, 124, 123, 123, 123, 123, 122, 122, 122, 121, 121,
+    121, 121, 120, 120, 120, 120, 119, 119, 119, 118, 118, 118, 118, 117, 117, 117,
+    // Strong, level 14
+    135, 134, 134, 134, 133, 133, 133, 132, 132, 132, 132, 131, 131, 131, 130, 130,
+    130, 130, 129, 129, 129, 129, 128, 128, 128, 127, 127, 127, 127, 126, 126, 126,
+    // Strong, level 15
+    144, 143, 143, 143, 142, 142, 142, 141, 141, 141, 141, 140, 140, 140, 139, 139,
+    139, 139, 138, 138, 138, 138, 137, 137, 137, 136, 136, 136, 136, 135, 135, 135,
+    // Aggressive, level 2
+    30, 29, 29, 28, 28, 28, 27, 27, 27, 26, 26, 26, 25, 25, 25, 24,
+    24, 24, 23, 23, 23, 22, 22, 22, 22, 21, 21, 21, 21, 20, 20, 20,
+    // Aggressive, level 3
+    40, 39, 39, 38, 38, 38, 37, 37, 37, 36, 36, 36, 35, 35, 35, 34,
+    34, 34, 34, 33, 33, 33, 32, 32, 32, 31, 31, 31, 31, 30, 30, 30,
+    // Aggressive, level 4
+    50, 49, 49, 48, 48, 48, 47, 47, 47, 46, 46, 46, 45, 45, 45, 45,
+    44, 44, 44, 43, 43, 43, 42, 42, 42, 42, 41, 41, 41, 40, 40, 40,
+    // Aggressive, level 5
+    60, 59, 59, 58, 58, 58, 57, 57, 57, 57, 56, 56, 56, 55, 55, 55,
+    54, 54, 54, 53, 53, 53, 52, 52, 52, 52, 51, 51, 51, 50, 50, 50,
+    // Aggressive, level 6
+    70, 69, 69, 68, 68, 68, 68, 67, 67, 67, 66, 66, 66, 65, 65, 65,
+    64, 64, 64, 63, 63, 63, 62, 62, 62, 62, 61, 61, 61, 60, 60, 60,
+    // Aggressive, level 7
+    80, 79, 79, 79, 78, 78, 78, 77, 77, 77, 76, 76, 76, 75, 75, 75,
+    74, 74, 74, 73, 73, 73, 72, 72, 72, 72, 71, 71, 71, 70, 70, 70,
+    // Aggressive, level 8
+    90, 89, 89, 89, 88, 88, 88, 87, 87, 87, 86, 86, 86, 85, 85, 85,
+    84, 84, 84, 83, 83, 83, 82, 82, 82, 82, 81, 81, 81, 80, 80, 80,
+    // Aggressive, level 9
+    100, 99, 99, 99, 98, 98, 98, 97, 97, 97, 96, 96, 96, 95, 95, 95,
+    94, 94, 94, 93, 93, 93, 93, 92, 92, 92, 91, 91, 91, 90, 90, 90,
+    // Aggressive, level 10
+    110, 109, 109, 109, 108, 108, 108, 107, 107, 107, 106, 106, 106, 105, 105, 105,
+    104, 104, 104, 103, 103, 103, 103, 102, 102, 102, 101, 101, 101, 100, 100, 100,
+    // Aggressive, level 11
+    120, 119, 119, 119, 118, 118, 118, 117, 117, 117, 116, 116, 116, 115, 115, 115,
+    114, 114, 114, 113, 113, 113, 113, 112, 112, 112, 111, 111, 111, 110, 110, 110,
+    // Aggressive, level 12
+    130, 129, 129, 129, 128, 128, 128, 127, 127, 127, 126, 126, 126, 125, 125, 125,
+    124, 124, 124, 123, 123, 123, 123, 122, 122, 122, 121, 121, 121, 120, 120, 120,
+    // Aggressive, level 13
+    140, 139, 139, 139, 138, 138, 138, 137, 137, 137, 136, 136, 136, 135, 135, 135,
+    134, 134, 134, 133, 133, 133, 133, 132, 132, 132, 131, 131, 131, 130, 130, 130,
+    // Aggressive, level 14
+    150, 149, 149, 149, 148, 148, 148, 147, 147, 147, 146, 146, 146, 145, 145, 145,
+    144, 144, 144, 143, 143, 143, 143, 142, 142, 142, 141, 141, 141, 140, 140, 140,
+    // Aggressive, level 15
+    160, 159, 159, 159, 158, 158, 158, 157, 157, 157, 156, 156, 156, 155, 155, 155,
+    154, 154, 154, 153, 153, 153, 153, 152, 152, 152, 151, 151, 151, 150, 150, 150,
+};
 
 // TODO: Revise the logic to decide the initial probability depending on the given probability.
 /* static */ const HistoricalInfo ForgettingCurveUtils::createUpdatedHistoricalInfo(
@@ -87,8 +269,7 @@ const ForgettingCurveUtils::ProbabilityTable ForgettingCurveUtils::sProbabilityT
         const HistoricalInfo *const historicalInfo, const HeaderPolicy *const headerPolicy) {
     const int elapsedTimeStepCount = getElapsedTimeStepCount(historicalInfo->getTimestamp(),
             DURATION_TO_LOWER_THE_LEVEL_IN_SECONDS);
-    return sProbabilityTable.getProbability(
-            headerPolicy->getForgettingCurveProbabilityValuesTableId(),
+    return getProbabilityFromTable(headerPolicy->getForgettingCurveProbabilityValuesTableId(),
             clampToValidLevelRange(historicalInfo->getLevel()),
             clampToValidTimeStepCountRange(elapsedTimeStepCount));
 }
@@ -176,59 +357,17 @@ const ForgettingCurveUtils::ProbabilityTable ForgettingCurveUtils::sProbabilityT
     return std::min(std::max(timeStepCount, 0), MAX_ELAPSED_TIME_STEP_COUNT);
 }
 
-const int ForgettingCurveUtils::ProbabilityTable::PROBABILITY_TABLE_COUNT = 4;
-const int ForgettingCurveUtils::ProbabilityTable::WEAK_PROBABILITY_TABLE_ID = 0;
-const int ForgettingCurveUtils::ProbabilityTable::MODEST_PROBABILITY_TABLE_ID = 1;
-const int ForgettingCurveUtils::ProbabilityTable::STRONG_PROBABILITY_TABLE_ID = 2;
-const int ForgettingCurveUtils::ProbabilityTable::AGGRESSIVE_PROBABILITY_TABLE_ID = 3;
-const int ForgettingCurveUtils::ProbabilityTable::WEAK_MAX_PROBABILITY = 127;
-const int ForgettingCurveUtils::ProbabilityTable::MODEST_BASE_PROBABILITY = 8;
-const int ForgettingCurveUtils::ProbabilityTable::STRONG_BASE_PROBABILITY = 9;
-const int ForgettingCurveUtils::ProbabilityTable::AGGRESSIVE_BASE_PROBABILITY = 10;
-
-
-ForgettingCurveUtils::ProbabilityTable::ProbabilityTable() : mTables() {
-    mTables.resize(PROBABILITY_TABLE_COUNT);
-    for (int tableId = 0; tableId < PROBABILITY_TABLE_COUNT; ++tableId) {
-        mTables[tableId].resize(MAX_LEVEL + 1);
-        for (int level = 0; level <= MAX_LEVEL; ++level) {
-            mTables[tableId][level].resize(MAX_ELAPSED_TIME_STEP_COUNT + 1);
-            const float initialProbability = getBaseProbabilityForLevel(tableId, level);
-            const float endProbability = getBaseProbabilityForLevel(tableId, level - 1);
-            for (int timeStepCount = 0; timeStepCount <= MAX_ELAPSED_TIME_STEP_COUNT;
-                    ++timeStepCount) {
-                if (level < MIN_VISIBLE_LEVEL) {
-                    mTables[tableId][level][timeStepCount] = NOT_A_PROBABILITY;
-                    continue;
-                }
-                const float probability = initialProbability
-                        * powf(initialProbability / endProbability,
-                                -1.0f * static_cast<float>(timeStepCount)
-                                        / static_cast<float>(MAX_ELAPSED_TIME_STEP_COUNT + 1));
-                mTables[tableId][level][timeStepCount] =
-                        std::min(std::max(static_cast<int>(probability), 1), MAX_PROBABILITY);
-            }
-        }
-    }
-}
-
-/* static */ int ForgettingCurveUtils::ProbabilityTable::getBaseProbabilityForLevel(
-        const int tableId, const int level) {
-    if (tableId == WEAK_PROBABILITY_TABLE_ID) {
-        // Max probability is 127.
-        return static_cast<float>(WEAK_MAX_PROBABILITY / (1 << (MAX_LEVEL - level)));
-    } else if (tableId == MODEST_PROBABILITY_TABLE_ID) {
-        // Max probability is 128.
-        return static_cast<float>(MODEST_BASE_PROBABILITY * (level + 1));
-    } else if (tableId == STRONG_PROBABILITY_TABLE_ID) {
-        // Max probability is 140.
-        return static_cast<float>(STRONG_BASE_PROBABILITY * (level + 1));
-    } else if (tableId == AGGRESSIVE_PROBABILITY_TABLE_ID) {
-        // Max probability is 160.
-        return static_cast<float>(AGGRESSIVE_BASE_PROBABILITY * (level + 1));
-    } else {
+/* static */ int ForgettingCurveUtils::getProbabilityFromTable(const int tableId,
+        const int level, const int elapsedTimeStepCount) {
+    const int levelCount = MAX_LEVEL - MIN_VISIBLE_LEVEL + 1;
+    static_assert(NELEMS(PROBABILITY_TABLES)
+            == PROBABILITY_TABLE_COUNT * levelCount * (MAX_ELAPSED_TIME_STEP_COUNT + 1),
+            "PROBABILITY_TABLES must have all tables, levels and time steps.");
+    if (tableId < 0 || tableId >= PROBABILITY_TABLE_COUNT || level < MIN_VISIBLE_LEVEL) {
         return NOT_A_PROBABILITY;
     }
+    return PROBABILITY_TABLES[((tableId * levelCount) + (level - MIN_VISIBLE_LEVEL))
+            * (MAX_ELAPSED_TIME_STEP_COUNT + 1) + elapsedTimeStepCount];
 }
 
 } // namespace latinime
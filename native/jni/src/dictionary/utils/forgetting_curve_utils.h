@@ -17,8 +17,6 @@
 #ifndef LATINIME_FORGETTING_CURVE_UTILS_H
 #define LATINIME_FORGETTING_CURVE_UTILS_H
 
-#include <vector>
-
 #include "defines.h"
 #include "dictionary/property/historical_info.h"
 #include "dictionary/utils/entry_counters.h"
@@ -59,34 +57,6 @@ class ForgettingCurveUtils {
  private:
     DISALLOW_IMPLICIT_CONSTRUCTORS(ForgettingCurveUtils);
 
-    class ProbabilityTable {
-     public:
-        ProbabilityTable();
-
-        int getProbability(const int tableId, const int level,
-                const int elapsedTimeStepCount) const {
-            return mTables[tableId][level][elapsedTimeStepCount];
-        }
-
-     private:
-        DISALLOW_COPY_AND_ASSIGN(ProbabilityTable);
-
-        static const int PROBABILITY_TABLE_COUNT;
-        static const int WEAK_PROBABILITY_TABLE_ID;
-        static const int MODEST_PROBABILITY_TABLE_ID;
-        static const int STRONG_PROBABILITY_TABLE_ID;
-        static const int AGGRESSIVE_PROBABILITY_TABLE_ID;
-
-        static const int WEAK_MAX_PROBABILITY;
-        static const int MODEST_BASE_PROBABILITY;
-        static const int STRONG_BASE_PROBABILITY;
-        static const int AGGRESSIVE_BASE_PROBABILITY;
-
-        std::vector<std::vector<std::vector<int>>> mTables;
-
-        static int getBaseProbabilityForLevel(const int tableId, const int level);
-    };
-
     static const int MULTIPLIER_TWO_IN_PROBABILITY_SCALE;
     static const int DECAY_INTERVAL_SECONDS;
 
@@ -99,7 +69,9 @@ class ForgettingCurveUtils {
 
     static const float ENTRY_COUNT_HARD_LIMIT_WEIGHT;
 
-    static const ProbabilityTable sProbabilityTable;
+    static const int PROBABILITY_TABLE_COUNT;
+    // Flattened [tableId][level - MIN_VISIBLE_LEVEL][elapsedTimeStepCount] table.
+    static const int PROBABILITY_TABLES[];
 
     static int backoff(const int unigramProbability);
     static int getElapsedTimeStepCount(const int timestamp, const int durationToLevelDown);
@@ -107,6 +79,8 @@ class ForgettingCurveUtils {
     static int clampToValidLevelRange(const int level);
     static int clampToValidCountRange(const int count, const HeaderPolicy *const headerPolicy);
     static int clampToValidTimeStepCountRange(const int timeStepCount);
+    static int getProbabilityFromTable(const int tableId, const int level,
+            const int elapsedTimeStepCount);
 };
 } // namespace latinime
 #endif /* LATINIME_FORGETTING_CURVE_UTILS_H */
@@ -22,6 +22,7 @@
 
 #include "defines.h"
 #include "utils/byte_array_view.h"
+#include "utils/memory_report.h"
 
 namespace latinime {
 
@@ -52,6 +53,10 @@ class MmappedBuffer {
         return mIsUpdatable;
     }
 
+    const MemoryUsage getMemoryUsage() const {
+        return MemoryReport::getMappedMemoryUsage(mMmappedBuffer, mAlignedSize);
+    }
+
  private:
     AK_FORCE_INLINE MmappedBuffer(uint8_t *const buffer, const int bufferSize,
             void *const mmappedBuffer, const int alignedSize, const int mmapFd,
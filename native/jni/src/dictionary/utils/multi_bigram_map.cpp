@@ -19,6 +19,8 @@
 #include <cstddef>
 #include <unordered_map>
 
+#include "utils/trace_counters.h"
+
 namespace latinime {
 
 // Max number of bigram maps (previous word contexts) to be cached. Increasing this number
@@ -42,9 +44,11 @@ int MultiBigramMap::getBigramProbability(
     }
     const auto mapPosition = mBigramMaps.find(prevWordIds[0]);
     if (mapPosition != mBigramMaps.end()) {
+        TraceCounters::increment(TraceCounters::BIGRAM_CACHE_HITS);
         return mapPosition->second.getBigramProbability(structurePolicy, nextWordId,
                 unigramProbability);
     }
+    TraceCounters::increment(TraceCounters::BIGRAM_CACHE_MISSES);
     if (mBigramMaps.size() < MAX_CACHED_PREV_WORDS_IN_BIGRAM_MAP) {
         addBigramsForWord(structurePolicy, prevWordIds);
         return mBigramMaps[prevWordIds[0]].getBigramProbability(structurePolicy,
@@ -54,6 +58,14 @@ int MultiBigramMap::getBigramProbability(
             nextWordId, unigramProbability);
 }
 
+const MemoryUsage MultiBigramMap::getMemoryUsage() const {
+    MemoryUsage memoryUsage = MemoryReport::getUnorderedMapMemoryUsage(mBigramMaps);
+    for (const auto &bigramMap : mBigramMaps) {
+        memoryUsage.add(bigramMap.second.getMemoryUsage());
+    }
+    return memoryUsage;
+}
+
 void MultiBigramMap::BigramMap::init(
         const DictionaryStructureWithBufferPolicy *const structurePolicy,
         const WordIdArrayView prevWordIds) {
@@ -73,6 +85,11 @@ int MultiBigramMap::BigramMap::getBigramProbability(
     return structurePolicy->getProbability(unigramProbability, bigramProbability);
 }
 
+const MemoryUsage MultiBigramMap::BigramMap::getMemoryUsage() const {
+    // The bloom filter is a member and counted with the entry of mBigramMaps.
+    return MemoryReport::getUnorderedMapMemoryUsage(mBigramMap);
+}
+
 void MultiBigramMap::BigramMap::onVisitEntry(const int ngramProbability, const int targetWordId) {
     if (targetWordId == NOT_A_WORD_ID) {
         return;
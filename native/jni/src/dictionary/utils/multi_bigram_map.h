@@ -26,6 +26,7 @@
 #include "dictionary/utils/binary_dictionary_bigrams_iterator.h"
 #include "dictionary/utils/bloom_filter.h"
 #include "utils/int_array_view.h"
+#include "utils/memory_report.h"
 
 namespace latinime {
 
@@ -46,6 +47,8 @@ class MultiBigramMap {
         mBigramMaps.clear();
     }
 
+    const MemoryUsage getMemoryUsage() const;
+
  private:
     DISALLOW_COPY_AND_ASSIGN(MultiBigramMap);
 
@@ -57,6 +60,8 @@ class MultiBigramMap {
                 : mBigramMap(bigramMap.mBigramMap), mBloomFilter(bigramMap.mBloomFilter) {}
         virtual ~BigramMap() {}
 
+        const MemoryUsage getMemoryUsage() const;
+
         void init(const DictionaryStructureWithBufferPolicy *const structurePolicy,
                 const WordIdArrayView prevWordIds);
         int getBigramProbability(
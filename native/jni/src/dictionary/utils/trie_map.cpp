@@ -53,15 +53,25 @@ void TrieMap::dump(const int from, const int to) const {
     for (int i = from; i < to; ++i) {
         AKLOGI("Entry[%d]: %x, %x", i, readField0(i), readField1(i));
     }
-    int unusedRegionSize = 0;
+    AKLOGI("Unused Size: %d", getUnusedEntryCount());
+}
+
+const MemoryUsage TrieMap::getMemoryUsage() const {
+    MemoryUsage memoryUsage = mBuffer.getMemoryUsage();
+    memoryUsage.add(MemoryUsage::heap(0 /* heapSize */, getUnusedEntryCount() * ENTRY_SIZE));
+    return memoryUsage;
+}
+
+int TrieMap::getUnusedEntryCount() const {
+    int unusedEntryCount = 0;
     for (int i = 1; i <= MAX_NUM_OF_ENTRIES_IN_ONE_LEVEL; ++i) {
         int index = readEmptyTableLink(i);
         while (index != ROOT_BITMAP_ENTRY_INDEX) {
             index = readField0(index);
-            unusedRegionSize += i;
+            unusedEntryCount += i;
         }
     }
-    AKLOGI("Unused Size: %d", unusedRegionSize);
+    return unusedEntryCount;
 }
 
 int TrieMap::getNextLevelBitmapEntryIndex(const int key, const int bitmapEntryIndex) {
@@ -169,6 +169,9 @@ class TrieMap {
     TrieMap(const ReadWriteByteArrayView buffer);
     void dump(const int from = 0, const int to = 0) const;
 
+    // Entries in the free lists are reported as wasted.
+    const MemoryUsage getMemoryUsage() const;
+
     bool isNearSizeLimit() const {
         return mBuffer.isNearSizeLimit();
     }
@@ -300,6 +303,7 @@ class TrieMap {
     bool updateValue(const Entry &terminalEntry, const uint64_t value,
             const int terminalEntryIndex);
     bool freeTable(const int tableIndex, const int entryCount);
+    int getUnusedEntryCount() const;
     int allocateTable(const int entryCount);
     int getTerminalEntryIndex(const uint32_t key, const uint32_t hashedKey,
             const Entry &bitmapEntry, const int level) const;
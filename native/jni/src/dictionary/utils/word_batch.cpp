@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dictionary/utils/word_batch.h"
+
+namespace latinime {
+
+const int WordBatch::FLAG_IS_NOT_A_WORD = 0x1;
+const int WordBatch::FLAG_IS_POSSIBLY_OFFENSIVE = 0x2;
+const int WordBatch::FLAG_IS_BEGINNING_OF_SENTENCE = 0x4;
+const int WordBatch::WORD_COUNT_INDEX = 0;
+const int WordBatch::RECORD_HEADER_SIZE = 3;
+const int WordBatch::MIN_BUFFER_SIZE = 1 /* word count */ + RECORD_HEADER_SIZE + MAX_WORD_LENGTH;
+
+WordBatch::WordBatch(int *const buffer, const int bufferSize)
+        : mBuffer(buffer), mBufferSize(bufferSize), mUsedSize(WORD_COUNT_INDEX + 1) {
+    ASSERT(bufferSize >= MIN_BUFFER_SIZE);
+    mBuffer[WORD_COUNT_INDEX] = 0;
+}
+
+bool WordBatch::addWord(const CodePointArrayView codePoints,
+        const WordAttributes &wordAttributes) {
+    const bool isBeginningOfSentence =
+            !codePoints.empty() && codePoints[0] == CODE_POINT_BEGINNING_OF_SENTENCE;
+    const CodePointArrayView wordCodePoints =
+            isBeginningOfSentence ? codePoints.skip(1) : codePoints;
+    const int codePointCount = static_cast<int>(wordCodePoints.size());
+    if (mUsedSize + RECORD_HEADER_SIZE + codePointCount > mBufferSize) {
+        return false;
+    }
+    int flags = 0;
+    if (isBeginningOfSentence) {
+        flags |= FLAG_IS_BEGINNING_OF_SENTENCE;
+    }
+    if (wordAttributes.isNotAWord()) {
+        flags |= FLAG_IS_NOT_A_WORD;
+    }
+    if (wordAttributes.isPossiblyOffensive()) {
+        flags |= FLAG_IS_POSSIBLY_OFFENSIVE;
+    }
+    mBuffer[mUsedSize++] = codePointCount;
+    mBuffer[mUsedSize++] = wordAttributes.getProbability();
+    mBuffer[mUsedSize++] = flags;
+    for (int i = 0; i < codePointCount; ++i) {
+        mBuffer[mUsedSize++] = wordCodePoints[i];
+    }
+    ++mBuffer[WORD_COUNT_INDEX];
+    return true;
+}
+
+} // namespace latinime
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_WORD_BATCH_H
+#define LATINIME_WORD_BATCH_H
+
+#include "defines.h"
+#include "dictionary/property/word_attributes.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+
+// Packs words and their unigram attributes into an int buffer to pass many words to Java at
+// once. The buffer starts with the word count, followed by a record for each word:
+// [code point count, probability, flags, code points...]
+// The beginning-of-sentence marker is not written; FLAG_IS_BEGINNING_OF_SENTENCE is set instead.
+class WordBatch {
+ public:
+    static const int FLAG_IS_NOT_A_WORD;
+    static const int FLAG_IS_POSSIBLY_OFFENSIVE;
+    static const int FLAG_IS_BEGINNING_OF_SENTENCE;
+    // Buffers must be at least this large to be able to hold any word.
+    static const int MIN_BUFFER_SIZE;
+
+    WordBatch(int *const buffer, const int bufferSize);
+    ~WordBatch() {}
+
+    // Returns false when the word does not fit in the buffer.
+    bool addWord(const CodePointArrayView codePoints, const WordAttributes &wordAttributes);
+
+    int getWordCount() const {
+        return mBuffer[WORD_COUNT_INDEX];
+    }
+
+    // Returns the number of ints written to the buffer.
+    int getUsedSize() const {
+        return mUsedSize;
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(WordBatch);
+
+    static const int WORD_COUNT_INDEX;
+    static const int RECORD_HEADER_SIZE;
+
+    int *const mBuffer;
+    const int mBufferSize;
+    int mUsedSize;
+};
+} // namespace latinime
+#endif /* LATINIME_WORD_BATCH_H */
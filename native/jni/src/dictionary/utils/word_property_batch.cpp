@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dictionary/utils/word_property_batch.h"
+
+#include "dictionary/property/historical_info.h"
+#include "dictionary/property/ngram_context.h"
+#include "dictionary/property/ngram_property.h"
+#include "dictionary/property/unigram_property.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+
+const int WordPropertyBatch::FLAG_IS_NOT_A_WORD = 0x1;
+const int WordPropertyBatch::FLAG_IS_POSSIBLY_OFFENSIVE = 0x2;
+const int WordPropertyBatch::FLAG_IS_BEGINNING_OF_SENTENCE = 0x4;
+const int WordPropertyBatch::FLAG_HAS_NGRAMS = 0x8;
+const int WordPropertyBatch::FLAG_NGRAMS_NOT_INCLUDED = 0x10;
+const int WordPropertyBatch::WORD_COUNT_INDEX = 0;
+const int WordPropertyBatch::RECORD_HEADER_SIZE = 7;
+const int WordPropertyBatch::NGRAM_RECORD_HEADER_SIZE = 6;
+const int WordPropertyBatch::MIN_BUFFER_SIZE =
+        1 /* word count */ + RECORD_HEADER_SIZE + MAX_WORD_LENGTH;
+
+WordPropertyBatch::WordPropertyBatch(int *const buffer, const int bufferSize)
+        : mBuffer(buffer), mBufferSize(bufferSize), mUsedSize(WORD_COUNT_INDEX + 1) {
+    ASSERT(bufferSize >= MIN_BUFFER_SIZE);
+    mBuffer[WORD_COUNT_INDEX] = 0;
+}
+
+bool WordPropertyBatch::addWordProperty(const WordProperty &wordProperty) {
+    const CodePointArrayView codePoints = wordProperty.getCodePoints();
+    const bool isBeginningOfSentence =
+            !codePoints.empty() && codePoints[0] == CODE_POINT_BEGINNING_OF_SENTENCE;
+    int recordSize = RECORD_HEADER_SIZE + static_cast<int>(codePoints.size())
+            - (isBeginningOfSentence ? 1 : 0);
+    for (const NgramProperty &ngramProperty : wordProperty.getNgramProperties()) {
+        recordSize += getNgramRecordSize(ngramProperty);
+    }
+    if (mUsedSize + recordSize <= mBufferSize) {
+        writeRecord(wordProperty, true /* includesNgrams */);
+        return true;
+    }
+    if (getWordCount() > 0) {
+        return false;
+    }
+    writeRecord(wordProperty, false /* includesNgrams */);
+    return true;
+}
+
+/* static */ int WordPropertyBatch::getNgramRecordSize(const NgramProperty &ngramProperty) {
+    const NgramContext *const ngramContext = ngramProperty.getNgramContext();
+    int size = NGRAM_RECORD_HEADER_SIZE + static_cast<int>(
+            ngramProperty.getTargetCodePoints()->size());
+    for (size_t i = 1; i <= ngramContext->getPrevWordCount(); ++i) {
+        size += 2 /* is beginning of sentence, code point count */
+                + static_cast<int>(ngramContext->getNthPrevWordCodePoints(i).size());
+    }
+    return size;
+}
+
+void WordPropertyBatch::writeRecord(const WordProperty &wordProperty, const bool includesNgrams) {
+    const UnigramProperty &unigramProperty = wordProperty.getUnigramProperty();
+    const std::vector<NgramProperty> &ngrams = wordProperty.getNgramProperties();
+    const CodePointArrayView codePoints = wordProperty.getCodePoints();
+    const bool isBeginningOfSentence =
+            !codePoints.empty() && codePoints[0] == CODE_POINT_BEGINNING_OF_SENTENCE;
+    const CodePointArrayView wordCodePoints =
+            isBeginningOfSentence ? codePoints.skip(1) : codePoints;
+    int flags = 0;
+    if (isBeginningOfSentence) {
+        flags |= FLAG_IS_BEGINNING_OF_SENTENCE;
+    }
+    if (unigramProperty.isNotAWord()) {
+        flags |= FLAG_IS_NOT_A_WORD;
+    }
+    if (unigramProperty.isPossiblyOffensive()) {
+        flags |= FLAG_IS_POSSIBLY_OFFENSIVE;
+    }
+    if (!ngrams.empty()) {
+        flags |= FLAG_HAS_NGRAMS;
+    }
+    if (!includesNgrams) {
+        flags |= FLAG_NGRAMS_NOT_INCLUDED;
+    }
+    const HistoricalInfo &historicalInfo = unigramProperty.getHistoricalInfo();
+    mBuffer[mUsedSize++] = static_cast<int>(wordCodePoints.size());
+    mBuffer[mUsedSize++] = flags;
+    mBuffer[mUsedSize++] = unigramProperty.getProbability();
+    mBuffer[mUsedSize++] = historicalInfo.getTimestamp();
+    mBuffer[mUsedSize++] = historicalInfo.getLevel();
+    mBuffer[mUsedSize++] = historicalInfo.getCount();
+    mBuffer[mUsedSize++] = includesNgrams ? static_cast<int>(ngrams.size()) : 0;
+    for (const int codePoint : wordCodePoints) {
+        mBuffer[mUsedSize++] = codePoint;
+    }
+    ++mBuffer[WORD_COUNT_INDEX];
+    if (!includesNgrams) {
+        return;
+    }
+    for (const NgramProperty &ngramProperty : ngrams) {
+        const NgramContext *const ngramContext = ngramProperty.getNgramContext();
+        mBuffer[mUsedSize++] = static_cast<int>(ngramContext->getPrevWordCount());
+        for (size_t i = 1; i <= ngramContext->getPrevWordCount(); ++i) {
+            const CodePointArrayView prevWordCodePoints =
+                    ngramContext->getNthPrevWordCodePoints(i);
+            mBuffer[mUsedSize++] = ngramContext->isNthPrevWordBeginningOfSentence(i) ? 1 : 0;
+            mBuffer[mUsedSize++] = static_cast<int>(prevWordCodePoints.size());
+            for (const int codePoint : prevWordCodePoints) {
+                mBuffer[mUsedSize++] = codePoint;
+            }
+        }
+        const std::vector<int> *const targetCodePoints = ngramProperty.getTargetCodePoints();
+        const HistoricalInfo ngramHistoricalInfo = ngramProperty.getHistoricalInfo();
+        mBuffer[mUsedSize++] = static_cast<int>(targetCodePoints->size());
+        mBuffer[mUsedSize++] = ngramProperty.getProbability();
+        mBuffer[mUsedSize++] = ngramHistoricalInfo.getTimestamp();
+        mBuffer[mUsedSize++] = ngramHistoricalInfo.getLevel();
+        mBuffer[mUsedSize++] = ngramHistoricalInfo.getCount();
+        for (const int codePoint : *targetCodePoints) {
+            mBuffer[mUsedSize++] = codePoint;
+        }
+    }
+}
+
+} // namespace latinime
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_WORD_PROPERTY_BATCH_H
+#define LATINIME_WORD_PROPERTY_BATCH_H
+
+#include "defines.h"
+#include "dictionary/property/word_property.h"
+
+namespace latinime {
+
+// Packs the properties of words into an int buffer to pass many words to Java at once, like
+// WordBatch but with the historical info and the n-grams. The buffer starts with the word count,
+// followed by a record for each word:
+// [code point count, flags, probability, timestamp, level, count, n-gram count, code points...]
+// Each record is followed by its n-grams:
+// [previous word count, (is beginning of sentence, code point count, code points...) for each
+//  previous word, target code point count, probability, timestamp, level, count,
+//  target code points...]
+// The beginning-of-sentence marker is not written; FLAG_IS_BEGINNING_OF_SENTENCE is set instead.
+// Shortcuts are not written.
+class WordPropertyBatch {
+ public:
+    static const int FLAG_IS_NOT_A_WORD;
+    static const int FLAG_IS_POSSIBLY_OFFENSIVE;
+    static const int FLAG_IS_BEGINNING_OF_SENTENCE;
+    static const int FLAG_HAS_NGRAMS;
+    // The n-grams of the word did not fit in an empty buffer and have been left out.
+    static const int FLAG_NGRAMS_NOT_INCLUDED;
+    // Buffers must be at least this large to be able to hold any word without its n-grams.
+    static const int MIN_BUFFER_SIZE;
+
+    WordPropertyBatch(int *const buffer, const int bufferSize);
+    ~WordPropertyBatch() {}
+
+    // Returns false when the word does not fit in the buffer. When the buffer is empty, the word
+    // is written without its n-grams instead, so that iterating always makes progress.
+    bool addWordProperty(const WordProperty &wordProperty);
+
+    int getWordCount() const {
+        return mBuffer[WORD_COUNT_INDEX];
+    }
+
+    // Returns the number of ints written to the buffer.
+    int getUsedSize() const {
+        return mUsedSize;
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(WordPropertyBatch);
+
+    static const int WORD_COUNT_INDEX;
+    static const int RECORD_HEADER_SIZE;
+    static const int NGRAM_RECORD_HEADER_SIZE;
+
+    int *const mBuffer;
+    const int mBufferSize;
+    int mUsedSize;
+
+    static int getNgramRecordSize(const NgramProperty &ngramProperty);
+
+    void writeRecord(const WordProperty &wordProperty, const bool includesNgrams);
+};
+} // namespace latinime
+#endif /* LATINIME_WORD_PROPERTY_BATCH_H */
@@ -419,13 +419,11 @@ class DicNode {
         if (leftExactMatch != rightExactMatch) {
             return leftExactMatch;
         }
-        const float diff =
-                right->getNormalizedCompoundDistance() - getNormalizedCompoundDistance();
-        static const float MIN_DIFF = 0.000001f;
-        if (diff > MIN_DIFF) {
-            return true;
-        } else if (diff < -MIN_DIFF) {
-            return false;
+        const int distanceComparison =
+                mDicNodeState.mDicNodeStateScoring.compareNormalizedCompoundDistance(
+                        &right->mDicNodeState.mDicNodeStateScoring);
+        if (distanceComparison != 0) {
+            return distanceComparison < 0;
         }
         const int depth = getNodeCodePointCount();
         const int depthDiff = right->getNodeCodePointCount() - depth;
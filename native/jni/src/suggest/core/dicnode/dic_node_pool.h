@@ -23,6 +23,7 @@
 
 #include "defines.h"
 #include "suggest/core/dicnode/dic_node.h"
+#include "utils/memory_report.h"
 
 namespace latinime {
 
@@ -62,6 +63,14 @@ class DicNodePool {
         mPooledDicNodes.emplace_back(dicNode);
     }
 
+    // The deque is estimated to hold a pointer for each node.
+    const MemoryUsage getMemoryUsage() const {
+        MemoryUsage memoryUsage = MemoryReport::getVectorMemoryUsage(mDicNodes);
+        memoryUsage.add(MemoryUsage::heap(mDicNodes.size() * sizeof(DicNode *),
+                0 /* wastedSize */));
+        return memoryUsage;
+    }
+
     void dump() const {
         AKLOGI("\n\n\n\n\n===========================");
         std::unordered_set<const DicNode*> usedDicNodes;
@@ -24,6 +24,7 @@
 #include "defines.h"
 #include "suggest/core/dicnode/dic_node.h"
 #include "suggest/core/dicnode/dic_node_pool.h"
+#include "utils/trace_counters.h"
 
 namespace latinime {
 
@@ -61,22 +62,23 @@ class DicNodePriorityQueue {
         mDicNodePool.reset(mMaxSize + 1);
     }
 
-    AK_FORCE_INLINE void copyPush(const DicNode *const dicNode) {
+    AK_FORCE_INLINE TraceCounters::PushResult copyPush(const DicNode *const dicNode) {
         DicNode *const pooledDicNode = newDicNode(dicNode);
         if (!pooledDicNode) {
-            return;
+            return TraceCounters::DROPPED;
         }
         if (getSize() < mMaxSize) {
             mDicNodesQueue.push(pooledDicNode);
-            return;
+            return TraceCounters::PUSHED;
         }
         if (betterThanWorstDicNode(pooledDicNode)) {
             mDicNodePool.placeBackInstance(mDicNodesQueue.top());
             mDicNodesQueue.pop();
             mDicNodesQueue.push(pooledDicNode);
-            return;
+            return TraceCounters::EVICTED;
         }
         mDicNodePool.placeBackInstance(pooledDicNode);
+        return TraceCounters::DROPPED;
     }
 
     AK_FORCE_INLINE void copyPop(DicNode *const dest) {
@@ -92,6 +94,14 @@ class DicNodePriorityQueue {
         mDicNodesQueue.pop();
     }
 
+    // The queue is estimated to hold a pointer for each pooled node.
+    const MemoryUsage getMemoryUsage() const {
+        MemoryUsage memoryUsage = mDicNodePool.getMemoryUsage();
+        memoryUsage.add(MemoryUsage::heap((mMaxSize + 1) * sizeof(DicNode *),
+                0 /* wastedSize */));
+        return memoryUsage;
+    }
+
     AK_FORCE_INLINE void dump() {
         mDicNodePool.dump();
     }
@@ -19,6 +19,7 @@
 #include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
 #include "suggest/core/dicnode/dic_node.h"
 #include "suggest/core/dicnode/dic_node_vector.h"
+#include "utils/trace_counters.h"
 
 namespace latinime {
 
@@ -56,6 +57,7 @@ namespace latinime {
     if (!dicNode->isLeavingNode()) {
         childDicNodes->pushPassingChild(dicNode);
     } else {
+        TraceCounters::increment(TraceCounters::CHILD_PT_NODE_ARRAY_READS);
         dictionaryStructurePolicy->createAndGetAllChildDicNodes(dicNode, childDicNodes);
     }
 }
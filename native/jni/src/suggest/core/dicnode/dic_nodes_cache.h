@@ -21,6 +21,7 @@
 
 #include "defines.h"
 #include "suggest/core/dicnode/dic_node_priority_queue.h"
+#include "utils/trace_counters.h"
 
 namespace latinime {
 
@@ -86,26 +87,32 @@ class DicNodesCache {
     }
 
     AK_FORCE_INLINE void copyPushTerminal(DicNode *dicNode) {
-        mTerminalDicNodes->copyPush(dicNode);
+        TraceCounters::countPush(TraceCounters::TERMINAL_DIC_NODES_PUSHED,
+                mTerminalDicNodes->copyPush(dicNode));
     }
 
     AK_FORCE_INLINE void copyPushActive(DicNode *dicNode) {
-        mActiveDicNodes->copyPush(dicNode);
+        TraceCounters::countPush(TraceCounters::ACTIVE_DIC_NODES_PUSHED,
+                mActiveDicNodes->copyPush(dicNode));
     }
 
     AK_FORCE_INLINE void copyPushContinue(DicNode *dicNode) {
-        mCachedDicNodesForContinuousSuggestion->copyPush(dicNode);
+        TraceCounters::countPush(TraceCounters::CACHED_DIC_NODES_PUSHED,
+                mCachedDicNodesForContinuousSuggestion->copyPush(dicNode));
     }
 
     AK_FORCE_INLINE void copyPushNextActive(DicNode *dicNode) {
-        mNextActiveDicNodes->copyPush(dicNode);
+        TraceCounters::countPush(TraceCounters::NEXT_ACTIVE_DIC_NODES_PUSHED,
+                mNextActiveDicNodes->copyPush(dicNode));
     }
 
     void popTerminal(DicNode *dest) {
+        TraceCounters::increment(TraceCounters::TERMINAL_DIC_NODES_POPPED);
         mTerminalDicNodes->copyPop(dest);
     }
 
     void popActive(DicNode *dest) {
+        TraceCounters::increment(TraceCounters::ACTIVE_DIC_NODES_POPPED);
         mActiveDicNodes->copyPop(dest);
     }
 
@@ -127,6 +134,14 @@ class DicNodesCache {
         mLastCachedInputIndex = mInputIndex;
     }
 
+    const MemoryUsage getMemoryUsage() const {
+        MemoryUsage memoryUsage = mDicNodePriorityQueue0.getMemoryUsage();
+        memoryUsage.add(mDicNodePriorityQueue1.getMemoryUsage());
+        memoryUsage.add(mDicNodePriorityQueue2.getMemoryUsage());
+        memoryUsage.add(mDicNodePriorityQueueForTerminal.getMemoryUsage());
+        return memoryUsage;
+    }
+
  private:
     DISALLOW_COPY_AND_ASSIGN(DicNodesCache);
 
@@ -18,6 +18,7 @@
 #define LATINIME_DIC_NODE_STATE_SCORING_H
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 
 #include "defines.h"
@@ -26,34 +27,136 @@
 
 namespace latinime {
 
-class DicNodeStateScoring {
+// Accumulates the distances in floats.
+class FloatScoringArithmetic {
  public:
-    AK_FORCE_INLINE DicNodeStateScoring()
+    typedef float Distance;
+
+    static AK_FORCE_INLINE Distance fromFloat(const float value) {
+        return value;
+    }
+
+    static AK_FORCE_INLINE float toFloat(const Distance distance) {
+        return distance;
+    }
+
+    static AK_FORCE_INLINE Distance add(const Distance left, const Distance right) {
+        return left + right;
+    }
+
+    static AK_FORCE_INLINE Distance divide(const Distance distance, const int divisor) {
+        return distance / static_cast<float>(divisor);
+    }
+
+    // Returns a negative value when left is smaller, a positive value when right is smaller and
+    // 0 when they are too close to tell apart.
+    static AK_FORCE_INLINE int compare(const Distance left, const Distance right) {
+        static const float MIN_DIFF = 0.000001f;
+        const float diff = right - left;
+        if (diff > MIN_DIFF) {
+            return -1;
+        } else if (diff < -MIN_DIFF) {
+            return 1;
+        }
+        return 0;
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(FloatScoringArithmetic);
+};
+
+// Accumulates the distances in 32-bit integers with 16 fractional bits. Out of range values
+// saturate, and the saturated maximum reads back as MAX_VALUE_FOR_WEIGHTING so that the pruning
+// checks keep working.
+class FixedPointScoringArithmetic {
+ public:
+    typedef int32_t Distance;
+
+    static AK_FORCE_INLINE Distance fromFloat(const float value) {
+        const float scaledValue = value * getScale();
+        if (scaledValue >= static_cast<float>(S_INT_MAX)) {
+            return S_INT_MAX;
+        } else if (scaledValue <= static_cast<float>(S_INT_MIN)) {
+            return S_INT_MIN;
+        }
+        return static_cast<Distance>(lrintf(scaledValue));
+    }
+
+    static AK_FORCE_INLINE float toFloat(const Distance distance) {
+        if (distance == S_INT_MAX) {
+            return static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+        }
+        return static_cast<float>(distance) / getScale();
+    }
+
+    static AK_FORCE_INLINE Distance add(const Distance left, const Distance right) {
+        if (left == S_INT_MAX || right == S_INT_MAX) {
+            return S_INT_MAX;
+        }
+        const int64_t sum = static_cast<int64_t>(left) + static_cast<int64_t>(right);
+        return static_cast<Distance>(std::min(static_cast<int64_t>(S_INT_MAX),
+                std::max(static_cast<int64_t>(S_INT_MIN), sum)));
+    }
+
+    static AK_FORCE_INLINE Distance divide(const Distance distance, const int divisor) {
+        return distance == S_INT_MAX ? S_INT_MAX : distance / divisor;
+    }
+
+    static AK_FORCE_INLINE int compare(const Distance left, const Distance right) {
+        return (left < right) ? -1 : ((left > right) ? 1 : 0);
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(FixedPointScoringArithmetic);
+
+    static AK_FORCE_INLINE float getScale() {
+        return static_cast<float>(1 << 16);
+    }
+};
+
+// Define FLAG_FIXED_POINT_SCORING to score with integers on CPUs with weak floating point
+// throughput. The costs are still computed in floats by the weighting policies.
+#if defined(FLAG_FIXED_POINT_SCORING)
+typedef FixedPointScoringArithmetic ScoringArithmetic;
+#else
+typedef FloatScoringArithmetic ScoringArithmetic;
+#endif
+
+template<class Arithmetic>
+class DicNodeStateScoringT {
+ public:
+    typedef typename Arithmetic::Distance Distance;
+
+    AK_FORCE_INLINE DicNodeStateScoringT()
             : mDoubleLetterLevel(NOT_A_DOUBLE_LETTER),
               mDigraphIndex(DigraphUtils::NOT_A_DIGRAPH_INDEX),
               mEditCorrectionCount(0), mProximityCorrectionCount(0), mCompletionCount(0),
-              mNormalizedCompoundDistance(0.0f), mSpatialDistance(0.0f), mLanguageDistance(0.0f),
+              mNormalizedCompoundDistance(Arithmetic::fromFloat(0.0f)),
+              mSpatialDistance(Arithmetic::fromFloat(0.0f)),
+              mLanguageDistance(Arithmetic::fromFloat(0.0f)),
               mRawLength(0.0f), mContainedErrorTypes(ErrorTypeUtils::NOT_AN_ERROR),
-              mNormalizedCompoundDistanceAfterFirstWord(MAX_VALUE_FOR_WEIGHTING) {
+              mNormalizedCompoundDistanceAfterFirstWord(
+                      Arithmetic::fromFloat(static_cast<float>(MAX_VALUE_FOR_WEIGHTING))) {
     }
 
-    ~DicNodeStateScoring() {}
+    ~DicNodeStateScoringT() {}
 
     void init() {
         mEditCorrectionCount = 0;
         mProximityCorrectionCount = 0;
         mCompletionCount = 0;
-        mNormalizedCompoundDistance = 0.0f;
-        mSpatialDistance = 0.0f;
-        mLanguageDistance = 0.0f;
+        mNormalizedCompoundDistance = Arithmetic::fromFloat(0.0f);
+        mSpatialDistance = Arithmetic::fromFloat(0.0f);
+        mLanguageDistance = Arithmetic::fromFloat(0.0f);
         mRawLength = 0.0f;
         mDoubleLetterLevel = NOT_A_DOUBLE_LETTER;
         mDigraphIndex = DigraphUtils::NOT_A_DIGRAPH_INDEX;
-        mNormalizedCompoundDistanceAfterFirstWord = MAX_VALUE_FOR_WEIGHTING;
+        mNormalizedCompoundDistanceAfterFirstWord =
+                Arithmetic::fromFloat(static_cast<float>(MAX_VALUE_FOR_WEIGHTING));
         mContainedErrorTypes = ErrorTypeUtils::NOT_AN_ERROR;
     }
 
-    AK_FORCE_INLINE void initByCopy(const DicNodeStateScoring *const scoring) {
+    AK_FORCE_INLINE void initByCopy(const DicNodeStateScoringT *const scoring) {
         mEditCorrectionCount = scoring->mEditCorrectionCount;
         mProximityCorrectionCount = scoring->mProximityCorrectionCount;
         mCompletionCount = scoring->mCompletionCount;
@@ -90,8 +193,8 @@ class DicNodeStateScoring {
         // We get called here after each word. We only want to store the distance after
         // the first word, so if we already have a distance we skip saving -- hence "IfNoneYet"
         // in the method name.
-        if (mNormalizedCompoundDistanceAfterFirstWord >= MAX_VALUE_FOR_WEIGHTING) {
-            mNormalizedCompoundDistanceAfterFirstWord = getNormalizedCompoundDistance();
+        if (getNormalizedCompoundDistanceAfterFirstWord() >= MAX_VALUE_FOR_WEIGHTING) {
+            mNormalizedCompoundDistanceAfterFirstWord = mNormalizedCompoundDistance;
         }
     }
 
@@ -105,27 +208,34 @@ class DicNodeStateScoring {
 
     float getCompoundDistance(
             const float weightOfLangModelVsSpatialModel) const {
-        return mSpatialDistance
-                + mLanguageDistance * weightOfLangModelVsSpatialModel;
+        return Arithmetic::toFloat(mSpatialDistance)
+                + Arithmetic::toFloat(mLanguageDistance) * weightOfLangModelVsSpatialModel;
     }
 
     float getNormalizedCompoundDistance() const {
-        return mNormalizedCompoundDistance;
+        return Arithmetic::toFloat(mNormalizedCompoundDistance);
+    }
+
+    // Compares the normalized compound distances in the arithmetic used for scoring. See
+    // Arithmetic::compare() for the return value.
+    int compareNormalizedCompoundDistance(const DicNodeStateScoringT *const right) const {
+        return Arithmetic::compare(mNormalizedCompoundDistance,
+                right->mNormalizedCompoundDistance);
     }
 
     // For space-aware gestures, we store the normalized distance at the char index
     // that ends the first word of the suggestion. We call this the distance after
     // first word.
     float getNormalizedCompoundDistanceAfterFirstWord() const {
-        return mNormalizedCompoundDistanceAfterFirstWord;
+        return Arithmetic::toFloat(mNormalizedCompoundDistanceAfterFirstWord);
     }
 
     float getSpatialDistance() const {
-        return mSpatialDistance;
+        return Arithmetic::toFloat(mSpatialDistance);
     }
 
     float getLanguageDistance() const {
-        return mLanguageDistance;
+        return Arithmetic::toFloat(mLanguageDistance);
     }
 
     int16_t getEditCorrectionCount() const {
@@ -186,7 +296,7 @@ class DicNodeStateScoring {
     }
 
  private:
-    DISALLOW_COPY_AND_ASSIGN(DicNodeStateScoring);
+    DISALLOW_COPY_AND_ASSIGN(DicNodeStateScoringT);
 
     DoubleLetterLevel mDoubleLetterLevel;
     DigraphUtils::DigraphCodePointIndex mDigraphIndex;
@@ -195,25 +305,30 @@ class DicNodeStateScoring {
     int16_t mProximityCorrectionCount;
     int16_t mCompletionCount;
 
-    float mNormalizedCompoundDistance;
-    float mSpatialDistance;
-    float mLanguageDistance;
+    Distance mNormalizedCompoundDistance;
+    Distance mSpatialDistance;
+    Distance mLanguageDistance;
     float mRawLength;
     // All accumulated error types so far
     ErrorTypeUtils::ErrorType mContainedErrorTypes;
-    float mNormalizedCompoundDistanceAfterFirstWord;
+    Distance mNormalizedCompoundDistanceAfterFirstWord;
 
     AK_FORCE_INLINE void addDistance(float spatialDistance, float languageDistance,
             bool doNormalization, int inputSize, int totalInputIndex) {
-        mSpatialDistance += spatialDistance;
-        mLanguageDistance += languageDistance;
+        mSpatialDistance = Arithmetic::add(mSpatialDistance,
+                Arithmetic::fromFloat(spatialDistance));
+        mLanguageDistance = Arithmetic::add(mLanguageDistance,
+                Arithmetic::fromFloat(languageDistance));
+        const Distance compoundDistance = Arithmetic::add(mSpatialDistance, mLanguageDistance);
         if (!doNormalization) {
-            mNormalizedCompoundDistance = mSpatialDistance + mLanguageDistance;
+            mNormalizedCompoundDistance = compoundDistance;
         } else {
-            mNormalizedCompoundDistance = (mSpatialDistance + mLanguageDistance)
-                    / static_cast<float>(std::max(1, totalInputIndex));
+            mNormalizedCompoundDistance =
+                    Arithmetic::divide(compoundDistance, std::max(1, totalInputIndex));
         }
     }
 };
+
+typedef DicNodeStateScoringT<ScoringArithmetic> DicNodeStateScoring;
 } // namespace latinime
 #endif // LATINIME_DIC_NODE_STATE_SCORING_H
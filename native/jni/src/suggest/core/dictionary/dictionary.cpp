@@ -18,10 +18,14 @@
 
 #include "suggest/core/dictionary/dictionary.h"
 
+#include <cstring>
+
 #include "defines.h"
 #include "dictionary/interface/dictionary_header_structure_policy.h"
 #include "dictionary/property/ngram_context.h"
+#include "dictionary/utils/dict_migration_utils.h"
 #include "suggest/core/dictionary/dictionary_utils.h"
+#include "suggest/core/layout/proximity_info_cache.h"
 #include "suggest/core/result/suggestion_results.h"
 #include "suggest/core/session/dic_traverse_session.h"
 #include "suggest/core/suggest.h"
@@ -30,20 +34,29 @@
 #include "suggest/policyimpl/typing/typing_suggest_policy_factory.h"
 #include "utils/int_array_view.h"
 #include "utils/log_utils.h"
+#include "utils/memory_report.h"
 #include "utils/time_keeper.h"
+#include "utils/trace_counters.h"
 
 namespace latinime {
 
 const int Dictionary::HEADER_ATTRIBUTE_BUFFER_SIZE = 32;
+const char *const Dictionary::MEMORY_REPORT_QUERY = "MEMORY_REPORT";
+std::atomic<int> Dictionary::sNextContentVersion(0);
 
 Dictionary::Dictionary(JNIEnv *env, DictionaryStructureWithBufferPolicy::StructurePolicyPtr
         dictionaryStructureWithBufferPolicy)
-        : mDictionaryStructureWithBufferPolicy(std::move(dictionaryStructureWithBufferPolicy)),
-          mGestureSuggest(new Suggest(GestureSuggestPolicyFactory::getGestureSuggestPolicy())),
-          mTypingSuggest(new Suggest(TypingSuggestPolicyFactory::getTypingSuggestPolicy())) {
+        : Dictionary(std::move(dictionaryStructureWithBufferPolicy)) {
     logDictionaryInfo(env);
 }
 
+Dictionary::Dictionary(DictionaryStructureWithBufferPolicy::StructurePolicyPtr
+        dictionaryStructureWithBufferPolicy)
+        : mDictionaryStructureWithBufferPolicy(std::move(dictionaryStructureWithBufferPolicy)),
+          mGestureSuggest(new Suggest(GestureSuggestPolicyFactory::getGestureSuggestPolicy())),
+          mTypingSuggest(new Suggest(TypingSuggestPolicyFactory::getTypingSuggestPolicy())),
+          mContentVersion(sNextContentVersion++) {}
+
 void Dictionary::getSuggestions(ProximityInfo *proximityInfo, DicTraverseSession *traverseSession,
         int *xcoordinates, int *ycoordinates, int *times, int *pointerIds, int *inputCodePoints,
         int inputSize, const NgramContext *const ngramContext,
@@ -57,6 +70,33 @@ void Dictionary::getSuggestions(ProximityInfo *proximityInfo, DicTraverseSession
             weightOfLangModelVsSpatialModel, outSuggestionResults);
 }
 
+/* static */ void Dictionary::getSuggestionsFromDictionaries(
+        const Dictionary *const *const dictionaries,
+        DicTraverseSession *const *const traverseSessions,
+        const SuggestOptions *const *const suggestOptions, const float *const dictionaryWeights,
+        const int dictionaryCount, ProximityInfo *proximityInfo, int *xcoordinates,
+        int *ycoordinates, int *times, int *pointerIds, int *inputCodePoints, int inputSize,
+        const NgramContext *const ngramContext, const float weightOfLangModelVsSpatialModel,
+        SuggestionResults *const outSuggestionResults) {
+    SuggestionResults allSuggestionResults(MAX_RESULTS * dictionaryCount);
+    // The weight computed for the first dictionary is used for the others, as when they are
+    // searched one after another with the same in-out weight.
+    float weight = weightOfLangModelVsSpatialModel;
+    for (int i = 0; i < dictionaryCount; ++i) {
+        // The first session computes the input states for the others.
+        traverseSessions[i]->setSharedInputSession(i == 0 ? nullptr : traverseSessions[0]);
+        SuggestionResults suggestionResults(MAX_RESULTS);
+        dictionaries[i]->getSuggestions(proximityInfo, traverseSessions[i], xcoordinates,
+                ycoordinates, times, pointerIds, inputCodePoints, inputSize, ngramContext,
+                suggestOptions[i], weight, &suggestionResults);
+        weight = suggestionResults.getWeightOfLangModelVsSpatialModel();
+        allSuggestionResults.addSuggestionsFrom(&suggestionResults, dictionaryWeights[i],
+                i /* sourceDictionaryIndex */);
+    }
+    // A word suggested by several dictionaries takes only one of the MAX_RESULTS slots.
+    outSuggestionResults->addUniqueSuggestionsFrom(&allSuggestionResults);
+}
+
 Dictionary::NgramListenerForPrediction::NgramListenerForPrediction(
         const NgramContext *const ngramContext, const WordIdArrayView prevWordIds,
         SuggestionResults *const suggestionResults,
@@ -135,41 +175,58 @@ bool Dictionary::addUnigramEntry(const CodePointArrayView codePoints,
         return false;
     }
     TimeKeeper::setCurrentTime();
-    return mDictionaryStructureWithBufferPolicy->addUnigramEntry(codePoints, unigramProperty);
+    const bool result = mDictionaryStructureWithBufferPolicy->addUnigramEntry(codePoints,
+            unigramProperty);
+    onContentChanged();
+    return result;
 }
 
 bool Dictionary::removeUnigramEntry(const CodePointArrayView codePoints) {
     TimeKeeper::setCurrentTime();
-    return mDictionaryStructureWithBufferPolicy->removeUnigramEntry(codePoints);
+    const bool result = mDictionaryStructureWithBufferPolicy->removeUnigramEntry(codePoints);
+    onContentChanged();
+    return result;
 }
 
 bool Dictionary::addNgramEntry(const NgramProperty *const ngramProperty) {
     TimeKeeper::setCurrentTime();
-    return mDictionaryStructureWithBufferPolicy->addNgramEntry(ngramProperty);
+    const bool result = mDictionaryStructureWithBufferPolicy->addNgramEntry(ngramProperty);
+    onContentChanged();
+    return result;
 }
 
 bool Dictionary::removeNgramEntry(const NgramContext *const ngramContext,
         const CodePointArrayView codePoints) {
     TimeKeeper::setCurrentTime();
-    return mDictionaryStructureWithBufferPolicy->removeNgramEntry(ngramContext, codePoints);
+    const bool result = mDictionaryStructureWithBufferPolicy->removeNgramEntry(ngramContext,
+            codePoints);
+    onContentChanged();
+    return result;
 }
 
 bool Dictionary::updateEntriesForWordWithNgramContext(const NgramContext *const ngramContext,
         const CodePointArrayView codePoints, const bool isValidWord,
         const HistoricalInfo historicalInfo) {
     TimeKeeper::setCurrentTime();
-    return mDictionaryStructureWithBufferPolicy->updateEntriesForWordWithNgramContext(ngramContext,
-            codePoints, isValidWord, historicalInfo);
+    const bool result = mDictionaryStructureWithBufferPolicy->updateEntriesForWordWithNgramContext(
+            ngramContext, codePoints, isValidWord, historicalInfo);
+    onContentChanged();
+    return result;
 }
 
 bool Dictionary::flush(const char *const filePath) {
     TimeKeeper::setCurrentTime();
+    const TraceCounters::ScopedTimer timer(TraceCounters::FLUSH_TIME);
     return mDictionaryStructureWithBufferPolicy->flush(filePath);
 }
 
 bool Dictionary::flushWithGC(const char *const filePath) {
     TimeKeeper::setCurrentTime();
-    return mDictionaryStructureWithBufferPolicy->flushWithGC(filePath);
+    const TraceCounters::ScopedTimer timer(TraceCounters::FLUSH_WITH_GC_TIME);
+    // GC may decay or drop entries.
+    const bool result = mDictionaryStructureWithBufferPolicy->flushWithGC(filePath);
+    onContentChanged();
+    return result;
 }
 
 bool Dictionary::needsToRunGC(const bool mindsBlockByGC) {
@@ -177,13 +234,30 @@ bool Dictionary::needsToRunGC(const bool mindsBlockByGC) {
     return mDictionaryStructureWithBufferPolicy->needsToRunGC(mindsBlockByGC);
 }
 
+bool Dictionary::migrateTo(const char *const dictFilePath, const int newFormatVersion) {
+    TimeKeeper::setCurrentTime();
+    return DictMigrationUtils::migrateDictionary(mDictionaryStructureWithBufferPolicy.get(),
+            dictFilePath, newFormatVersion);
+}
+
 void Dictionary::getProperty(const char *const query, const int queryLength, char *const outResult,
         const int maxResultLength) {
     TimeKeeper::setCurrentTime();
+    if (strncmp(query, MEMORY_REPORT_QUERY, queryLength + 1 /* terminator */) == 0) {
+        MemoryReport memoryReport;
+        getMemoryReport(&memoryReport);
+        ProximityInfoCache::getInstance()->getMemoryReport(&memoryReport);
+        memoryReport.dump(outResult, maxResultLength);
+        return;
+    }
     return mDictionaryStructureWithBufferPolicy->getProperty(query, queryLength, outResult,
             maxResultLength);
 }
 
+void Dictionary::getMemoryReport(MemoryReport *const outMemoryReport) const {
+    mDictionaryStructureWithBufferPolicy->getMemoryReport(outMemoryReport);
+}
+
 const WordProperty Dictionary::getWordProperty(const CodePointArrayView codePoints) {
     TimeKeeper::setCurrentTime();
     return mDictionaryStructureWithBufferPolicy->getWordProperty(codePoints);
@@ -196,6 +270,18 @@ int Dictionary::getNextWordAndNextToken(const int token, int *const outCodePoint
             token, outCodePoints, outCodePointCount);
 }
 
+int Dictionary::getNextWordsAndNextToken(const int token, WordBatch *const outWordBatch) {
+    TimeKeeper::setCurrentTime();
+    return mDictionaryStructureWithBufferPolicy->getNextWordsAndNextToken(token, outWordBatch);
+}
+
+int Dictionary::getNextWordPropertiesAndNextToken(const int token,
+        WordPropertyBatch *const outWordPropertyBatch) {
+    TimeKeeper::setCurrentTime();
+    return mDictionaryStructureWithBufferPolicy->getNextWordPropertiesAndNextToken(token,
+            outWordPropertyBatch);
+}
+
 void Dictionary::logDictionaryInfo(JNIEnv *const env) const {
     int dictionaryIdCodePointBuffer[HEADER_ATTRIBUTE_BUFFER_SIZE];
     int versionStringCodePointBuffer[HEADER_ATTRIBUTE_BUFFER_SIZE];
@@ -17,6 +17,7 @@
 #ifndef LATINIME_DICTIONARY_H
 #define LATINIME_DICTIONARY_H
 
+#include <atomic>
 #include <memory>
 
 #include "defines.h"
@@ -33,10 +34,13 @@ namespace latinime {
 
 class DictionaryStructureWithBufferPolicy;
 class DicTraverseSession;
+class MemoryReport;
 class NgramContext;
 class ProximityInfo;
 class SuggestionResults;
 class SuggestOptions;
+class WordBatch;
+class WordPropertyBatch;
 
 class Dictionary {
  public:
@@ -64,6 +68,9 @@ class Dictionary {
 
     Dictionary(JNIEnv *env, DictionaryStructureWithBufferPolicy::StructurePolicyPtr
             dictionaryStructureWithBufferPolicy);
+    // For use without a Java VM, e.g. in native tests and benchmarks.
+    explicit Dictionary(DictionaryStructureWithBufferPolicy::StructurePolicyPtr
+            dictionaryStructureWithBufferPolicy);
 
     void getSuggestions(ProximityInfo *proximityInfo, DicTraverseSession *traverseSession,
             int *xcoordinates, int *ycoordinates, int *times, int *pointerIds, int *inputCodePoints,
@@ -71,6 +78,21 @@ class Dictionary {
             const SuggestOptions *const suggestOptions, const float weightOfLangModelVsSpatialModel,
             SuggestionResults *const outSuggestionResults) const;
 
+    // Searches several dictionaries for the same input, each with its own options. The spatial
+    // input states are computed once with the first session and shared by the others, and the
+    // weight of the language model computed for the first dictionary is used for the others.
+    // Suggestions are merged into outSuggestionResults with scores multiplied by the
+    // per-dictionary weight; a word suggested by several dictionaries is kept once, with its best
+    // score.
+    static void getSuggestionsFromDictionaries(const Dictionary *const *const dictionaries,
+            DicTraverseSession *const *const traverseSessions,
+            const SuggestOptions *const *const suggestOptions,
+            const float *const dictionaryWeights, const int dictionaryCount,
+            ProximityInfo *proximityInfo, int *xcoordinates, int *ycoordinates, int *times,
+            int *pointerIds, int *inputCodePoints, int inputSize,
+            const NgramContext *const ngramContext, const float weightOfLangModelVsSpatialModel,
+            SuggestionResults *const outSuggestionResults);
+
     void getPredictions(const NgramContext *const ngramContext,
             SuggestionResults *const outSuggestionResults) const;
 
@@ -101,9 +123,17 @@ class Dictionary {
 
     bool needsToRunGC(const bool mindsBlockByGC);
 
+    // Writes all entries into a new dictionary file of the given format. A previously interrupted
+    // migration to the same file is resumed from its last committed section.
+    bool migrateTo(const char *const dictFilePath, const int newFormatVersion);
+
+    // In addition to the queries of the structure policy, the "MEMORY_REPORT" query returns the
+    // dump of getMemoryReport() followed by the keyboard layouts of ProximityInfoCache.
     void getProperty(const char *const query, const int queryLength, char *const outResult,
             const int maxResultLength);
 
+    void getMemoryReport(MemoryReport *const outMemoryReport) const;
+
     const WordProperty getWordProperty(const CodePointArrayView codePoints);
 
     // Method to iterate all words in the dictionary.
@@ -112,10 +142,25 @@ class Dictionary {
     int getNextWordAndNextToken(const int token, int *const outCodePoints,
             int *const outCodePointCount);
 
+    // Method to iterate all words in the dictionary in batches. See
+    // DictionaryStructureWithBufferPolicy::getNextWordsAndNextToken().
+    int getNextWordsAndNextToken(const int token, WordBatch *const outWordBatch);
+
+    // Method to iterate the properties of all words in the dictionary in batches. See
+    // DictionaryStructureWithBufferPolicy::getNextWordPropertiesAndNextToken().
+    int getNextWordPropertiesAndNextToken(const int token,
+            WordPropertyBatch *const outWordPropertyBatch);
+
     const DictionaryStructureWithBufferPolicy *getDictionaryStructurePolicy() const {
         return mDictionaryStructureWithBufferPolicy.get();
     }
 
+    // Changes whenever entries may have been modified. Versions are unique in the process, so
+    // results cached for one dictionary never match another one allocated at the same address.
+    int getContentVersion() const {
+        return mContentVersion;
+    }
+
  private:
     DISALLOW_IMPLICIT_CONSTRUCTORS(Dictionary);
 
@@ -138,13 +183,22 @@ class Dictionary {
     };
 
     static const int HEADER_ATTRIBUTE_BUFFER_SIZE;
+    static const char *const MEMORY_REPORT_QUERY;
+
+    static std::atomic<int> sNextContentVersion;
 
     const DictionaryStructureWithBufferPolicy::StructurePolicyPtr
             mDictionaryStructureWithBufferPolicy;
     const SuggestInterfacePtr mGestureSuggest;
     const SuggestInterfacePtr mTypingSuggest;
+    std::atomic<int> mContentVersion;
 
     void logDictionaryInfo(JNIEnv *const env) const;
+
+    // Called after a modification so that results computed during it are invalidated too.
+    void onContentChanged() {
+        mContentVersion = sNextContentVersion++;
+    }
 };
 } // namespace latinime
 #endif // LATINIME_DICTIONARY_H
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/key_distance_kernels.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define LATINIME_KEY_DISTANCE_KERNELS_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+// ARMv7 NEON has no exact float division.
+#include <arm_neon.h>
+#define LATINIME_KEY_DISTANCE_KERNELS_NEON
+#endif
+
+// Multiply-adds must not be fused: an FMA skips the rounding of the product, so the results would
+// depend on which of the scalar and vector paths the compiler happens to fuse. The distances are
+// also compared bit for bit with ProximityInfo::getNormalizedSquaredDistanceFromCenterFloatG().
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace latinime {
+
+/* static */ AK_FORCE_INLINE float KeyDistanceKernels::getNormalizedSquaredDistance(
+        const KeyCenters *const keyCenters, const int keyId, const float touchX,
+        const float touchY, const float normalizer) {
+    const float centerX = std::min(std::max(touchX, keyCenters->mMinCenterXs[keyId]),
+            keyCenters->mMaxCenterXs[keyId]);
+    const float centerY = std::max(keyCenters->mCenterYs[keyId],
+            std::min(touchY, keyCenters->mMaxCenterYs[keyId]));
+    const float dx = centerX - touchX;
+    const float dy = centerY - touchY;
+    const float squaredDx = dx * dx;
+    const float squaredDy = dy * dy;
+    return (squaredDx + squaredDy) / normalizer;
+}
+
+/* static */ void KeyDistanceKernels::getNormalizedSquaredDistancesScalar(
+        const KeyCenters *const keyCenters, const int keyCount, const int x, const int y,
+        const float normalizer, float *const outDistances) {
+    const float touchX = static_cast<float>(x);
+    const float touchY = static_cast<float>(y);
+    for (int i = 0; i < keyCount; ++i) {
+        outDistances[i] = getNormalizedSquaredDistance(keyCenters, i, touchX, touchY, normalizer);
+    }
+}
+
+/* static */ void KeyDistanceKernels::getNormalizedSquaredDistances(
+        const KeyCenters *const keyCenters, const int keyCount, const int x, const int y,
+        const float normalizer, float *const outDistances) {
+    const float touchX = static_cast<float>(x);
+    const float touchY = static_cast<float>(y);
+    int i = 0;
+#if defined(LATINIME_KEY_DISTANCE_KERNELS_SSE2)
+    const __m128 touchXs = _mm_set1_ps(touchX);
+    const __m128 touchYs = _mm_set1_ps(touchY);
+    const __m128 normalizers = _mm_set1_ps(normalizer);
+    for (; i + 4 <= keyCount; i += 4) {
+        const __m128 centerXs = _mm_min_ps(
+                _mm_max_ps(touchXs, _mm_load_ps(keyCenters->mMinCenterXs + i)),
+                _mm_load_ps(keyCenters->mMaxCenterXs + i));
+        const __m128 centerYs = _mm_max_ps(_mm_load_ps(keyCenters->mCenterYs + i),
+                _mm_min_ps(touchYs, _mm_load_ps(keyCenters->mMaxCenterYs + i)));
+        const __m128 dxs = _mm_sub_ps(centerXs, touchXs);
+        const __m128 dys = _mm_sub_ps(centerYs, touchYs);
+        _mm_storeu_ps(outDistances + i, _mm_div_ps(
+                _mm_add_ps(_mm_mul_ps(dxs, dxs), _mm_mul_ps(dys, dys)), normalizers));
+    }
+#elif defined(LATINIME_KEY_DISTANCE_KERNELS_NEON)
+    const float32x4_t touchXs = vdupq_n_f32(touchX);
+    const float32x4_t touchYs = vdupq_n_f32(touchY);
+    const float32x4_t normalizers = vdupq_n_f32(normalizer);
+    for (; i + 4 <= keyCount; i += 4) {
+        const float32x4_t centerXs = vminq_f32(
+                vmaxq_f32(touchXs, vld1q_f32(keyCenters->mMinCenterXs + i)),
+                vld1q_f32(keyCenters->mMaxCenterXs + i));
+        const float32x4_t centerYs = vmaxq_f32(vld1q_f32(keyCenters->mCenterYs + i),
+                vminq_f32(touchYs, vld1q_f32(keyCenters->mMaxCenterYs + i)));
+        const float32x4_t dxs = vsubq_f32(centerXs, touchXs);
+        const float32x4_t dys = vsubq_f32(centerYs, touchYs);
+        vst1q_f32(outDistances + i, vdivq_f32(
+                vaddq_f32(vmulq_f32(dxs, dxs), vmulq_f32(dys, dys)), normalizers));
+    }
+#endif
+    for (; i < keyCount; ++i) {
+        outDistances[i] = getNormalizedSquaredDistance(keyCenters, i, touchX, touchY, normalizer);
+    }
+}
+
+/* static */ bool KeyDistanceKernels::hasVectorKernel() {
+#if defined(LATINIME_KEY_DISTANCE_KERNELS_SSE2) || defined(LATINIME_KEY_DISTANCE_KERNELS_NEON)
+    return true;
+#else
+    return false;
+#endif
+}
+} // namespace latinime
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_KEY_DISTANCE_KERNELS_H
+#define LATINIME_KEY_DISTANCE_KERNELS_H
+
+#include "defines.h"
+
+namespace latinime {
+
+// Computes the normalized squared distances from a point to the centers of all keys at once.
+// Uses SSE2 or AArch64 NEON when available. All kernels give bit-exact results of
+// ProximityInfo::getNormalizedSquaredDistanceFromCenterFloatG().
+class KeyDistanceKernels {
+ public:
+    // Structure of arrays of the key centers. The X center of a key wider than the most common
+    // key slides in [mMinCenterXs, mMaxCenterXs] to the X of the point. The Y center of a key at
+    // the bottom of the keyboard extends to the Y of the point up to mMaxCenterYs.
+    struct KeyCenters {
+        alignas(16) float mMinCenterXs[MAX_KEY_COUNT_IN_A_KEYBOARD];
+        alignas(16) float mMaxCenterXs[MAX_KEY_COUNT_IN_A_KEYBOARD];
+        alignas(16) float mCenterYs[MAX_KEY_COUNT_IN_A_KEYBOARD];
+        alignas(16) float mMaxCenterYs[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    };
+
+    // Writes the squared distances from (x, y) to the first keyCount key centers divided by
+    // normalizer to outDistances.
+    static void getNormalizedSquaredDistances(const KeyCenters *const keyCenters,
+            const int keyCount, const int x, const int y, const float normalizer,
+            float *const outDistances);
+    // Same as above without vector instructions.
+    static void getNormalizedSquaredDistancesScalar(const KeyCenters *const keyCenters,
+            const int keyCount, const int x, const int y, const float normalizer,
+            float *const outDistances);
+    static bool hasVectorKernel();
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(KeyDistanceKernels);
+
+    static AK_FORCE_INLINE float getNormalizedSquaredDistance(const KeyCenters *const keyCenters,
+            const int keyId, const float touchX, const float touchY, const float normalizer);
+};
+} // namespace latinime
+#endif // LATINIME_KEY_DISTANCE_KERNELS_H
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/key_probability_kernels.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define LATINIME_KEY_PROBABILITY_KERNELS_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+// ARMv7 NEON has no exact float division.
+#include <arm_neon.h>
+#define LATINIME_KEY_PROBABILITY_KERNELS_NEON
+#endif
+
+namespace latinime {
+
+/* static */ void KeyProbabilityKernels::normalizeProbabilitiesScalar(const int keyCount,
+        const float inputCharProbability, const float sumOfProbabilityDensities,
+        float *const keyProbabilities) {
+    for (int i = 0; i < keyCount; ++i) {
+        keyProbabilities[i] = getNormalizedProbability(keyProbabilities[i], inputCharProbability,
+                sumOfProbabilityDensities);
+    }
+}
+
+/* static */ void KeyProbabilityKernels::normalizeProbabilities(const int keyCount,
+        const float inputCharProbability, const float sumOfProbabilityDensities,
+        float *const keyProbabilities) {
+    int i = 0;
+#if defined(LATINIME_KEY_PROBABILITY_KERNELS_SSE2)
+    const __m128 inputCharProbabilities = _mm_set1_ps(inputCharProbability);
+    const __m128 sumsOfProbabilityDensities = _mm_set1_ps(sumOfProbabilityDensities);
+    for (; i + 4 <= keyCount; i += 4) {
+        _mm_storeu_ps(keyProbabilities + i, _mm_div_ps(
+                _mm_mul_ps(inputCharProbabilities, _mm_loadu_ps(keyProbabilities + i)),
+                sumsOfProbabilityDensities));
+    }
+#elif defined(LATINIME_KEY_PROBABILITY_KERNELS_NEON)
+    const float32x4_t inputCharProbabilities = vdupq_n_f32(inputCharProbability);
+    const float32x4_t sumsOfProbabilityDensities = vdupq_n_f32(sumOfProbabilityDensities);
+    for (; i + 4 <= keyCount; i += 4) {
+        vst1q_f32(keyProbabilities + i, vdivq_f32(
+                vmulq_f32(inputCharProbabilities, vld1q_f32(keyProbabilities + i)),
+                sumsOfProbabilityDensities));
+    }
+#endif
+    for (; i < keyCount; ++i) {
+        keyProbabilities[i] = getNormalizedProbability(keyProbabilities[i], inputCharProbability,
+                sumOfProbabilityDensities);
+    }
+}
+
+/* static */ void KeyProbabilityKernels::suppressProbabilitiesScalar(const int keyCount,
+        const float suppressionRate, const float *const keyProbabilities1,
+        float *const keyProbabilities0, float *const outSuppressions) {
+    for (int i = 0; i < keyCount; ++i) {
+        const float probability0 = keyProbabilities0[i];
+        const float newProbability = getSuppressedProbability(probability0,
+                keyProbabilities1[i], suppressionRate);
+        outSuppressions[i] = probability0 - newProbability;
+        keyProbabilities0[i] = newProbability;
+    }
+}
+
+/* static */ void KeyProbabilityKernels::suppressProbabilities(const int keyCount,
+        const float suppressionRate, const float *const keyProbabilities1,
+        float *const keyProbabilities0, float *const outSuppressions) {
+    int i = 0;
+#if defined(LATINIME_KEY_PROBABILITY_KERNELS_SSE2)
+    const __m128 suppressionRates = _mm_set1_ps(suppressionRate);
+    for (; i + 4 <= keyCount; i += 4) {
+        const __m128 probabilities0 = _mm_loadu_ps(keyProbabilities0 + i);
+        // All bits are set in the lanes to suppress. False for NaNs, as the scalar comparison.
+        const __m128 isSuppressed =
+                _mm_cmplt_ps(probabilities0, _mm_loadu_ps(keyProbabilities1 + i));
+        const __m128 newProbabilities = _mm_or_ps(
+                _mm_and_ps(isSuppressed, _mm_mul_ps(probabilities0, suppressionRates)),
+                _mm_andnot_ps(isSuppressed, probabilities0));
+        _mm_storeu_ps(outSuppressions + i, _mm_sub_ps(probabilities0, newProbabilities));
+        _mm_storeu_ps(keyProbabilities0 + i, newProbabilities);
+    }
+#elif defined(LATINIME_KEY_PROBABILITY_KERNELS_NEON)
+    const float32x4_t suppressionRates = vdupq_n_f32(suppressionRate);
+    for (; i + 4 <= keyCount; i += 4) {
+        const float32x4_t probabilities0 = vld1q_f32(keyProbabilities0 + i);
+        // All bits are set in the lanes to suppress. False for NaNs, as the scalar comparison.
+        const uint32x4_t isSuppressed = vcltq_f32(probabilities0, vld1q_f32(keyProbabilities1 + i));
+        const float32x4_t newProbabilities = vbslq_f32(isSuppressed,
+                vmulq_f32(probabilities0, suppressionRates), probabilities0);
+        vst1q_f32(outSuppressions + i, vsubq_f32(probabilities0, newProbabilities));
+        vst1q_f32(keyProbabilities0 + i, newProbabilities);
+    }
+#endif
+    for (; i < keyCount; ++i) {
+        const float probability0 = keyProbabilities0[i];
+        const float newProbability = getSuppressedProbability(probability0,
+                keyProbabilities1[i], suppressionRate);
+        outSuppressions[i] = probability0 - newProbability;
+        keyProbabilities0[i] = newProbability;
+    }
+}
+
+/* static */ bool KeyProbabilityKernels::hasVectorKernel() {
+#if defined(LATINIME_KEY_PROBABILITY_KERNELS_SSE2) \
+        || defined(LATINIME_KEY_PROBABILITY_KERNELS_NEON)
+    return true;
+#else
+    return false;
+#endif
+}
+} // namespace latinime
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_KEY_PROBABILITY_KERNELS_H
+#define LATINIME_KEY_PROBABILITY_KERNELS_H
+
+#include "defines.h"
+
+namespace latinime {
+
+// Updates the probabilities of all keys of an input point at once. Uses SSE2 or AArch64 NEON when
+// available. All kernels give bit-exact results of the scalar ones.
+class KeyProbabilityKernels {
+ public:
+    // Replaces each of the first keyCount probabilities p with
+    // inputCharProbability * p / sumOfProbabilityDensities.
+    static void normalizeProbabilities(const int keyCount, const float inputCharProbability,
+            const float sumOfProbabilityDensities, float *const keyProbabilities);
+    // Same as above without vector instructions.
+    static void normalizeProbabilitiesScalar(const int keyCount, const float inputCharProbability,
+            const float sumOfProbabilityDensities, float *const keyProbabilities);
+
+    // Multiplies each of the first keyCount probabilities of keyProbabilities0 that is less than
+    // the probability of the same key in keyProbabilities1 by suppressionRate, and writes how much
+    // each probability decreased to outSuppressions.
+    static void suppressProbabilities(const int keyCount, const float suppressionRate,
+            const float *const keyProbabilities1, float *const keyProbabilities0,
+            float *const outSuppressions);
+    // Same as above without vector instructions.
+    static void suppressProbabilitiesScalar(const int keyCount, const float suppressionRate,
+            const float *const keyProbabilities1, float *const keyProbabilities0,
+            float *const outSuppressions);
+
+    static bool hasVectorKernel();
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(KeyProbabilityKernels);
+
+    static AK_FORCE_INLINE float getNormalizedProbability(const float probability,
+            const float inputCharProbability, const float sumOfProbabilityDensities) {
+        return inputCharProbability * probability / sumOfProbabilityDensities;
+    }
+
+    static AK_FORCE_INLINE float getSuppressedProbability(const float probability0,
+            const float probability1, const float suppressionRate) {
+        return (probability0 < probability1) ? probability0 * suppressionRate : probability0;
+    }
+};
+} // namespace latinime
+#endif // LATINIME_KEY_PROBABILITY_KERNELS_H
@@ -19,6 +19,7 @@
 #include "suggest/core/layout/proximity_info.h"
 
 #include <algorithm>
+#include <cfloat>
 #include <cstring>
 #include <cmath>
 
@@ -29,26 +30,46 @@
 #include "suggest/core/layout/proximity_info_params.h"
 #include "utils/char_utils.h"
 
+// Same as key_distance_kernels.cpp, whose distances must match the ones computed here bit for bit.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
 namespace latinime {
 
-static AK_FORCE_INLINE void safeGetOrFillZeroIntArrayRegion(JNIEnv *env, jintArray jArray,
-        jsize len, jint *buffer) {
-    if (jArray && buffer) {
-        env->GetIntArrayRegion(jArray, 0, len, buffer);
-    } else if (buffer) {
-        memset(buffer, 0, len * sizeof(buffer[0]));
+// Copies a Java array. Returns an empty vector for a null array.
+template<typename JArrayType, typename T>
+static std::vector<T> copyJavaArray(JNIEnv *env, const JArrayType jArray, const jsize len,
+        void (JNIEnv::*getArrayRegion)(JArrayType, jsize, jsize, T *)) {
+    std::vector<T> array;
+    if (jArray) {
+        array.resize(std::max(len, 0));
+        (env->*getArrayRegion)(jArray, 0, len, array.data());
     }
+    return array;
+}
+
+static AK_FORCE_INLINE int getKeyCountToCopy(const int keyCount) {
+    return std::min(keyCount, MAX_KEY_COUNT_IN_A_KEYBOARD);
+}
+
+template<typename T>
+static AK_FORCE_INLINE const T *getDataOrNull(const std::vector<T> &array) {
+    return array.empty() ? nullptr : array.data();
 }
 
-static AK_FORCE_INLINE void safeGetOrFillZeroFloatArrayRegion(JNIEnv *env, jfloatArray jArray,
-        jsize len, jfloat *buffer) {
-    if (jArray && buffer) {
-        env->GetFloatArrayRegion(jArray, 0, len, buffer);
-    } else if (buffer) {
+template<typename T>
+static AK_FORCE_INLINE void safeCopyOrFillZero(const T *const src, const int len, T *buffer) {
+    if (src) {
+        memmove(buffer, src, len * sizeof(buffer[0]));
+    } else {
         memset(buffer, 0, len * sizeof(buffer[0]));
     }
 }
 
+// The Java arrays are copied into temporaries that live until the delegated constructor returns.
 ProximityInfo::ProximityInfo(JNIEnv *env, const int keyboardWidth, const int keyboardHeight,
         const int gridWidth, const int gridHeight, const int mostCommonKeyWidth,
         const int mostCommonKeyHeight, const jintArray proximityChars, const int keyCount,
@@ -56,6 +77,37 @@ ProximityInfo::ProximityInfo(JNIEnv *env, const int keyboardWidth, const int key
         const jintArray keyWidths, const jintArray keyHeights, const jintArray keyCharCodes,
         const jfloatArray sweetSpotCenterXs, const jfloatArray sweetSpotCenterYs,
         const jfloatArray sweetSpotRadii)
+        : ProximityInfo(keyboardWidth, keyboardHeight, gridWidth, gridHeight,
+                  mostCommonKeyWidth, mostCommonKeyHeight,
+                  getDataOrNull(copyJavaArray(env, proximityChars,
+                          proximityChars ? env->GetArrayLength(proximityChars) : 0,
+                          &JNIEnv::GetIntArrayRegion)),
+                  proximityChars ? env->GetArrayLength(proximityChars) : 0, keyCount,
+                  getDataOrNull(copyJavaArray(env, keyXCoordinates, getKeyCountToCopy(keyCount),
+                          &JNIEnv::GetIntArrayRegion)),
+                  getDataOrNull(copyJavaArray(env, keyYCoordinates, getKeyCountToCopy(keyCount),
+                          &JNIEnv::GetIntArrayRegion)),
+                  getDataOrNull(copyJavaArray(env, keyWidths, getKeyCountToCopy(keyCount),
+                          &JNIEnv::GetIntArrayRegion)),
+                  getDataOrNull(copyJavaArray(env, keyHeights, getKeyCountToCopy(keyCount),
+                          &JNIEnv::GetIntArrayRegion)),
+                  getDataOrNull(copyJavaArray(env, keyCharCodes, getKeyCountToCopy(keyCount),
+                          &JNIEnv::GetIntArrayRegion)),
+                  getDataOrNull(copyJavaArray(env, sweetSpotCenterXs,
+                          getKeyCountToCopy(keyCount), &JNIEnv::GetFloatArrayRegion)),
+                  getDataOrNull(copyJavaArray(env, sweetSpotCenterYs,
+                          getKeyCountToCopy(keyCount), &JNIEnv::GetFloatArrayRegion)),
+                  getDataOrNull(copyJavaArray(env, sweetSpotRadii,
+                          getKeyCountToCopy(keyCount), &JNIEnv::GetFloatArrayRegion))) {}
+
+ProximityInfo::ProximityInfo(const int keyboardWidth, const int keyboardHeight,
+        const int gridWidth, const int gridHeight, const int mostCommonKeyWidth,
+        const int mostCommonKeyHeight, const int *const proximityChars,
+        const int proximityCharsLength, const int keyCount, const int *const keyXCoordinates,
+        const int *const keyYCoordinates, const int *const keyWidths,
+        const int *const keyHeights, const int *const keyCharCodes,
+        const float *const sweetSpotCenterXs, const float *const sweetSpotCenterYs,
+        const float *const sweetSpotRadii)
         : GRID_WIDTH(gridWidth), GRID_HEIGHT(gridHeight), MOST_COMMON_KEY_WIDTH(mostCommonKeyWidth),
           MOST_COMMON_KEY_WIDTH_SQUARE(mostCommonKeyWidth * mostCommonKeyWidth),
           NORMALIZED_SQUARED_MOST_COMMON_KEY_HYPOTENUSE(1.0f +
@@ -71,9 +123,9 @@ ProximityInfo::ProximityInfo(JNIEnv *env, const int keyboardWidth, const int key
                   && sweetSpotCenterYs && sweetSpotRadii),
           mProximityCharsArray(new int[GRID_WIDTH * GRID_HEIGHT * MAX_PROXIMITY_CHARS_SIZE
                   /* proximityCharsLength */]),
-          mLowerCodePointToKeyMap() {
+          mLowerCodePointToKeyMap(), mKeyCenters(), mKeyCentersG(),
+          mCellKeys(GRID_WIDTH * GRID_HEIGHT * MAX_PROXIMITY_CHARS_SIZE) {
     /* Let's check the input array length here to make sure */
-    const jsize proximityCharsLength = env->GetArrayLength(proximityChars);
     if (proximityCharsLength != GRID_WIDTH * GRID_HEIGHT * MAX_PROXIMITY_CHARS_SIZE) {
         AKLOGE("Invalid proximityCharsLength: %d", proximityCharsLength);
         ASSERT(false);
@@ -82,23 +134,35 @@ ProximityInfo::ProximityInfo(JNIEnv *env, const int keyboardWidth, const int key
     if (DEBUG_PROXIMITY_INFO) {
         AKLOGI("Create proximity info array %d", proximityCharsLength);
     }
-    safeGetOrFillZeroIntArrayRegion(env, proximityChars, proximityCharsLength,
-            mProximityCharsArray);
-    safeGetOrFillZeroIntArrayRegion(env, keyXCoordinates, KEY_COUNT, mKeyXCoordinates);
-    safeGetOrFillZeroIntArrayRegion(env, keyYCoordinates, KEY_COUNT, mKeyYCoordinates);
-    safeGetOrFillZeroIntArrayRegion(env, keyWidths, KEY_COUNT, mKeyWidths);
-    safeGetOrFillZeroIntArrayRegion(env, keyHeights, KEY_COUNT, mKeyHeights);
-    safeGetOrFillZeroIntArrayRegion(env, keyCharCodes, KEY_COUNT, mKeyCodePoints);
-    safeGetOrFillZeroFloatArrayRegion(env, sweetSpotCenterXs, KEY_COUNT, mSweetSpotCenterXs);
-    safeGetOrFillZeroFloatArrayRegion(env, sweetSpotCenterYs, KEY_COUNT, mSweetSpotCenterYs);
-    safeGetOrFillZeroFloatArrayRegion(env, sweetSpotRadii, KEY_COUNT, mSweetSpotRadii);
+    safeCopyOrFillZero(proximityChars, proximityCharsLength, mProximityCharsArray);
+    safeCopyOrFillZero(keyXCoordinates, KEY_COUNT, mKeyXCoordinates);
+    safeCopyOrFillZero(keyYCoordinates, KEY_COUNT, mKeyYCoordinates);
+    safeCopyOrFillZero(keyWidths, KEY_COUNT, mKeyWidths);
+    safeCopyOrFillZero(keyHeights, KEY_COUNT, mKeyHeights);
+    safeCopyOrFillZero(keyCharCodes, KEY_COUNT, mKeyCodePoints);
+    safeCopyOrFillZero(sweetSpotCenterXs, KEY_COUNT, mSweetSpotCenterXs);
+    safeCopyOrFillZero(sweetSpotCenterYs, KEY_COUNT, mSweetSpotCenterYs);
+    safeCopyOrFillZero(sweetSpotRadii, KEY_COUNT, mSweetSpotRadii);
     initializeG();
+    ProximityInfoUtils::initializeCellKeys(mKeyXCoordinates, mKeyYCoordinates, mKeyWidths,
+            mKeyHeights, mProximityCharsArray, CELL_HEIGHT, CELL_WIDTH, GRID_WIDTH, GRID_HEIGHT,
+            KEY_COUNT, &mLowerCodePointToKeyMap, mCellKeys.data());
 }
 
 ProximityInfo::~ProximityInfo() {
     delete[] mProximityCharsArray;
 }
 
+const MemoryUsage ProximityInfo::getMemoryUsage() const {
+    // The per key tables are members.
+    MemoryUsage memoryUsage = MemoryUsage::heap(sizeof(ProximityInfo)
+            + GRID_WIDTH * GRID_HEIGHT * MAX_PROXIMITY_CHARS_SIZE * sizeof(int),
+            0 /* wastedSize */);
+    memoryUsage.add(MemoryReport::getVectorMemoryUsage(mCellKeys));
+    memoryUsage.add(MemoryReport::getUnorderedMapMemoryUsage(mLowerCodePointToKeyMap));
+    return memoryUsage;
+}
+
 bool ProximityInfo::hasSpaceProximity(const int x, const int y) const {
     if (x < 0 || y < 0) {
         if (DEBUG_DICT) {
@@ -136,6 +200,21 @@ float ProximityInfo::getNormalizedSquaredDistanceFromCenterFloatG(
             / GeometryUtils::SQUARE_FLOAT(static_cast<float>(getMostCommonKeyWidth()));
 }
 
+void ProximityInfo::getNormalizedSquaredDistancesFromCentersG(const int x, const int y,
+        const bool isGeometric, float *const outDistances) const {
+    if (x == NOT_A_COORDINATE || y == NOT_A_COORDINATE) {
+        // The key centers don't slide to the point in this case.
+        for (int i = 0; i < KEY_COUNT; ++i) {
+            outDistances[i] = getNormalizedSquaredDistanceFromCenterFloatG(i, x, y, isGeometric);
+        }
+        return;
+    }
+    KeyDistanceKernels::getNormalizedSquaredDistances(
+            isGeometric ? &mKeyCentersG : &mKeyCenters, KEY_COUNT, x, y,
+            GeometryUtils::SQUARE_FLOAT(static_cast<float>(getMostCommonKeyWidth())),
+            outDistances);
+}
+
 int ProximityInfo::getCodePointOf(const int keyIndex) const {
     if (keyIndex < 0 || keyIndex >= KEY_COUNT) {
         return NOT_A_CODE_POINT;
@@ -168,6 +247,10 @@ void ProximityInfo::initializeG() {
         mKeyIndexToOriginalCodePoint[i] = code;
         mKeyIndexToLowerCodePointG[i] = lowerCode;
     }
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        initializeKeyCenters(i, false /* isGeometric */, &mKeyCenters);
+        initializeKeyCenters(i, true /* isGeometric */, &mKeyCentersG);
+    }
     for (int i = 0; i < KEY_COUNT; i++) {
         mKeyKeyDistancesG[i][i] = 0;
         for (int j = i + 1; j < KEY_COUNT; j++) {
@@ -188,6 +271,22 @@ void ProximityInfo::initializeG() {
     }
 }
 
+// Mirrors the adjustments of getKeyCenterXOfKeyIdG() and getKeyCenterYOfKeyIdG() for the distance
+// kernels.
+void ProximityInfo::initializeKeyCenters(const int keyId, const bool isGeometric,
+        KeyDistanceKernels::KeyCenters *const outKeyCenters) const {
+    const int centerX = getKeyCenterXOfKeyIdG(keyId, NOT_A_COORDINATE, isGeometric);
+    const int keyWidth = mKeyWidths[keyId];
+    const int keyWidthHalfDiff = (keyWidth > getMostCommonKeyWidth())
+            ? (keyWidth - getMostCommonKeyWidth()) / 2 : 0;
+    outKeyCenters->mMinCenterXs[keyId] = static_cast<float>(centerX - keyWidthHalfDiff);
+    outKeyCenters->mMaxCenterXs[keyId] = static_cast<float>(centerX + keyWidthHalfDiff);
+    const int centerY = getKeyCenterYOfKeyIdG(keyId, NOT_A_COORDINATE, isGeometric);
+    outKeyCenters->mCenterYs[keyId] = static_cast<float>(centerY);
+    outKeyCenters->mMaxCenterYs[keyId] = (centerY + mKeyHeights[keyId] > KEYBOARD_HEIGHT)
+            ? FLT_MAX : static_cast<float>(centerY);
+}
+
 // referencePointX is used only for keys wider than most common key width. When the referencePointX
 // is NOT_A_COORDINATE, this method calculates the return value without using the line segment.
 // isGeometric is currently not used because we don't have extra X coordinates sweet spots for
@@ -22,7 +22,9 @@
 
 #include "defines.h"
 #include "jni.h"
+#include "suggest/core/layout/key_distance_kernels.h"
 #include "suggest/core/layout/proximity_info_utils.h"
+#include "utils/memory_report.h"
 
 namespace latinime {
 
@@ -35,10 +37,23 @@ class ProximityInfo {
             const jintArray keyYCoordinates, const jintArray keyWidths, const jintArray keyHeights,
             const jintArray keyCharCodes, const jfloatArray sweetSpotCenterXs,
             const jfloatArray sweetSpotCenterYs, const jfloatArray sweetSpotRadii);
+    // For use without a Java VM. proximityChars has to have gridWidth * gridHeight *
+    // MAX_PROXIMITY_CHARS_SIZE elements and the key arrays keyCount elements. The key arrays and
+    // the sweet spot arrays can be null.
+    ProximityInfo(const int keyboardWidth, const int keyboardHeight, const int gridWidth,
+            const int gridHeight, const int mostCommonKeyWidth, const int mostCommonKeyHeight,
+            const int *const proximityChars, const int proximityCharsLength, const int keyCount,
+            const int *const keyXCoordinates, const int *const keyYCoordinates,
+            const int *const keyWidths, const int *const keyHeights,
+            const int *const keyCharCodes, const float *const sweetSpotCenterXs,
+            const float *const sweetSpotCenterYs, const float *const sweetSpotRadii);
     ~ProximityInfo();
     bool hasSpaceProximity(const int x, const int y) const;
     float getNormalizedSquaredDistanceFromCenterFloatG(
             const int keyId, const int x, const int y, const bool isGeometric) const;
+    // Writes getNormalizedSquaredDistanceFromCenterFloatG() of all keys to outDistances.
+    void getNormalizedSquaredDistancesFromCentersG(const int x, const int y,
+            const bool isGeometric, float *const outDistances) const;
     int getCodePointOf(const int keyIndex) const;
     int getOriginalCodePointOf(const int keyIndex) const;
     bool hasSweetSpotData(const int keyIndex) const {
@@ -75,8 +90,9 @@ class ProximityInfo {
             const int inputSize, int *allInputCodes, const std::vector<int> *locale) const {
         ProximityInfoUtils::initializeProximities(inputCodes, inputXCoordinates, inputYCoordinates,
                 inputSize, mKeyXCoordinates, mKeyYCoordinates, mKeyWidths, mKeyHeights,
-                mProximityCharsArray, CELL_HEIGHT, CELL_WIDTH, GRID_WIDTH, MOST_COMMON_KEY_WIDTH,
-                KEY_COUNT, locale, &mLowerCodePointToKeyMap, allInputCodes);
+                mProximityCharsArray, mCellKeys.data(), CELL_HEIGHT, CELL_WIDTH, GRID_WIDTH,
+                GRID_HEIGHT, MOST_COMMON_KEY_WIDTH, KEY_COUNT, locale, &mLowerCodePointToKeyMap,
+                allInputCodes);
     }
 
     AK_FORCE_INLINE int getKeyIndexOf(const int c) const {
@@ -87,10 +103,14 @@ class ProximityInfo {
         return getKeyIndexOf(codePoint) != NOT_AN_INDEX;
     }
 
+    const MemoryUsage getMemoryUsage() const;
+
  private:
     DISALLOW_IMPLICIT_CONSTRUCTORS(ProximityInfo);
 
     void initializeG();
+    void initializeKeyCenters(const int keyId, const bool isGeometric,
+            KeyDistanceKernels::KeyCenters *const outKeyCenters) const;
 
     const int GRID_WIDTH;
     const int GRID_HEIGHT;
@@ -121,6 +141,10 @@ class ProximityInfo {
     int mCenterXsG[MAX_KEY_COUNT_IN_A_KEYBOARD];
     int mCenterYsG[MAX_KEY_COUNT_IN_A_KEYBOARD];
     int mKeyKeyDistancesG[MAX_KEY_COUNT_IN_A_KEYBOARD][MAX_KEY_COUNT_IN_A_KEYBOARD];
+    KeyDistanceKernels::KeyCenters mKeyCenters;
+    KeyDistanceKernels::KeyCenters mKeyCentersG;
+    // The keys of each grid cell in the same layout as mProximityCharsArray.
+    std::vector<ProximityInfoUtils::CellKey> mCellKeys;
 };
 } // namespace latinime
 #endif // LATINIME_PROXIMITY_INFO_H
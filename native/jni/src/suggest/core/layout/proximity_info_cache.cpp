@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/proximity_info_cache.h"
+
+namespace latinime {
+
+const int64_t ProximityInfoCache::NO_FINGERPRINT = 0;
+// Covers the alphabet, shifted and symbol layouts of two languages.
+const int ProximityInfoCache::DEFAULT_MAX_CACHED_LAYOUT_COUNT = 8;
+
+/* static */ ProximityInfoCache *ProximityInfoCache::getInstance() {
+    static ProximityInfoCache *const sInstance =
+            new ProximityInfoCache(DEFAULT_MAX_CACHED_LAYOUT_COUNT);
+    return sInstance;
+}
+
+ProximityInfo *ProximityInfoCache::acquire(const int64_t fingerprint) {
+    if (fingerprint == NO_FINGERPRINT) {
+        return nullptr;
+    }
+    const auto it = mCachedLayouts.find(fingerprint);
+    if (it == mCachedLayouts.end()) {
+        return nullptr;
+    }
+    Layout *const layout = it->second;
+    mLruFingerprints.splice(mLruFingerprints.begin(), mLruFingerprints, layout->mLruPosition);
+    ++layout->mRefCount;
+    return layout->mProximityInfo.get();
+}
+
+ProximityInfo *ProximityInfoCache::add(const int64_t fingerprint,
+        ProximityInfo *const proximityInfo) {
+    Layout *const layout = new Layout(proximityInfo, fingerprint);
+    mLayouts[proximityInfo].reset(layout);
+    layout->mRefCount = 1;
+    if (fingerprint == NO_FINGERPRINT || MAX_CACHED_LAYOUT_COUNT <= 0) {
+        return proximityInfo;
+    }
+    const auto it = mCachedLayouts.find(fingerprint);
+    if (it != mCachedLayouts.end()) {
+        evict(it->second);
+    }
+    while (getCachedLayoutCount() >= MAX_CACHED_LAYOUT_COUNT) {
+        evict(mCachedLayouts[mLruFingerprints.back()]);
+    }
+    mLruFingerprints.push_front(fingerprint);
+    layout->mLruPosition = mLruFingerprints.begin();
+    layout->mIsCached = true;
+    mCachedLayouts[fingerprint] = layout;
+    return proximityInfo;
+}
+
+bool ProximityInfoCache::release(const ProximityInfo *const proximityInfo) {
+    const auto it = mLayouts.find(proximityInfo);
+    if (it == mLayouts.end() || it->second->mRefCount <= 0) {
+        AKLOGE("Releasing an unknown ProximityInfo %p", proximityInfo);
+        return false;
+    }
+    Layout *const layout = it->second.get();
+    --layout->mRefCount;
+    if (layout->mRefCount == 0 && !layout->mIsCached) {
+        mLayouts.erase(it);
+    }
+    return true;
+}
+
+void ProximityInfoCache::getMemoryReport(MemoryReport *const outMemoryReport) const {
+    MemoryUsage memoryUsage = MemoryReport::getUnorderedMapMemoryUsage(mLayouts);
+    memoryUsage.add(MemoryReport::getUnorderedMapMemoryUsage(mCachedLayouts));
+    // A list node holds a fingerprint and two links.
+    memoryUsage.add(MemoryUsage::heap(mLruFingerprints.size()
+            * (sizeof(int64_t) + 2 * sizeof(void *)), 0 /* wastedSize */));
+    for (const auto &entry : mLayouts) {
+        memoryUsage.add(MemoryUsage::heap(sizeof(Layout), 0 /* wastedSize */));
+        memoryUsage.add(entry.second->mProximityInfo->getMemoryUsage());
+    }
+    outMemoryReport->addComponent("proximity_info", memoryUsage);
+}
+
+void ProximityInfoCache::evict(Layout *const layout) {
+    mCachedLayouts.erase(layout->mFingerprint);
+    mLruFingerprints.erase(layout->mLruPosition);
+    layout->mIsCached = false;
+    if (layout->mRefCount == 0) {
+        mLayouts.erase(layout->mProximityInfo.get());
+    }
+}
+} // namespace latinime
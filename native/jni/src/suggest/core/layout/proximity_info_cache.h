@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_PROXIMITY_INFO_CACHE_H
+#define LATINIME_PROXIMITY_INFO_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include "defines.h"
+#include "suggest/core/layout/proximity_info.h"
+#include "utils/memory_report.h"
+
+namespace latinime {
+
+// LRU of initialized keyboard layouts keyed by a fingerprint of the layout inputs, so that
+// switching back to a recent layout does not rebuild it. Layouts are reference counted by
+// acquire(), add() and release(); an evicted layout lives until it is released. Not thread safe.
+class ProximityInfoCache {
+ public:
+    static const int64_t NO_FINGERPRINT;
+    static const int DEFAULT_MAX_CACHED_LAYOUT_COUNT;
+
+    explicit ProximityInfoCache(const int maxCachedLayoutCount)
+            : MAX_CACHED_LAYOUT_COUNT(maxCachedLayoutCount), mLayouts(), mCachedLayouts(),
+              mLruFingerprints() {}
+
+    // The cache used by the JNI methods. Java serializes the calls.
+    static ProximityInfoCache *getInstance();
+
+    // Returns the layout of the fingerprint after acquiring it, or nullptr when it isn't cached.
+    ProximityInfo *acquire(const int64_t fingerprint);
+    // Takes the ownership of proximityInfo, caches it unless the fingerprint is NO_FINGERPRINT,
+    // and returns it acquired.
+    ProximityInfo *add(const int64_t fingerprint, ProximityInfo *const proximityInfo);
+    // Releases a layout returned by acquire() or add(). Returns false for an unknown layout.
+    bool release(const ProximityInfo *const proximityInfo);
+
+    int getCachedLayoutCount() const {
+        return static_cast<int>(mCachedLayouts.size());
+    }
+
+    // Number of the cached or acquired layouts.
+    int getLayoutCount() const {
+        return static_cast<int>(mLayouts.size());
+    }
+
+    // Adds the tables of the cached or acquired layouts and the cache bookkeeping to
+    // outMemoryReport as the "proximity_info" component.
+    void getMemoryReport(MemoryReport *const outMemoryReport) const;
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(ProximityInfoCache);
+
+    struct Layout {
+        Layout(ProximityInfo *const proximityInfo, const int64_t fingerprint)
+                : mProximityInfo(proximityInfo), mFingerprint(fingerprint), mRefCount(0),
+                  mIsCached(false), mLruPosition() {}
+
+        std::unique_ptr<ProximityInfo> mProximityInfo;
+        const int64_t mFingerprint;
+        int mRefCount;
+        bool mIsCached;
+        std::list<int64_t>::iterator mLruPosition;
+    };
+
+    void evict(Layout *const layout);
+
+    const int MAX_CACHED_LAYOUT_COUNT;
+    std::unordered_map<const ProximityInfo *, std::unique_ptr<Layout>> mLayouts;
+    std::unordered_map<int64_t, Layout *> mCachedLayouts;
+    // The fingerprints of the cached layouts from the most recently used one.
+    std::list<int64_t> mLruFingerprints;
+};
+} // namespace latinime
+#endif // LATINIME_PROXIMITY_INFO_CACHE_H
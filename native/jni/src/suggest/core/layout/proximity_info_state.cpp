@@ -21,13 +21,13 @@
 #include <algorithm>
 #include <cstring> // for memset() and memmove()
 #include <sstream> // for debug prints
-#include <unordered_map>
 #include <vector>
 
 #include "defines.h"
 #include "suggest/core/layout/geometry_utils.h"
 #include "suggest/core/layout/proximity_info.h"
 #include "suggest/core/layout/proximity_info_state_utils.h"
+#include "suggest/core/layout/touch_position_correction_utils.h"
 #include "utils/char_utils.h"
 
 namespace latinime {
@@ -97,6 +97,8 @@ void ProximityInfoState::initInputParams(const int pointerId, const float maxPoi
         mBeelineSpeedPercentiles.clear();
         mCharProbabilities.clear();
         mDirections.clear();
+        mMostProbableStringPrefixLengths.clear();
+        mMostProbableStringPrefixLogProbabilities.clear();
     }
 
     if (DEBUG_GEO_FULL) {
@@ -104,6 +106,101 @@ void ProximityInfoState::initInputParams(const int pointerId, const float maxPoi
                 pushTouchPointStartIndex, lastSavedInputSize);
     }
 
+    const int prevInputSize = static_cast<int>(mInputXs.size());
+    saveInput(isGeometric, inputSize, xCoordinates, yCoordinates, times, pointerIds);
+    updateSampledInput(pointerId, isGeometric, inputSize, xCoordinates, yCoordinates, times,
+            pointerIds, pushTouchPointStartIndex, lastSavedInputSize, prevInputSize);
+    if (!isGeometric && pointerId == 0) {
+        ProximityInfoStateUtils::initPrimaryInputWord(
+                inputSize, mInputProximities, mPrimaryInputWord);
+    }
+    if (DEBUG_GEO_FULL) {
+        AKLOGI("ProximityState init finished: %d points out of %d", mSampledInputSize, inputSize);
+    }
+    mHasBeenUpdatedByGeometricInput = isGeometric;
+}
+
+bool ProximityInfoState::appendTouchPoints(const int pointerId, const int *const xCoordinates,
+        const int *const yCoordinates, const int *const times, const int count) {
+    if (!mHasBeenUpdatedByGeometricInput || mSampledInputIndice.size() <= 1
+            || mInputXs.empty() || (times == nullptr) != mInputTimes.empty()) {
+        return false;
+    }
+    mIsContinuousSuggestionPossible = true;
+    if (count <= 0) {
+        return true;
+    }
+    const int prevInputSize = static_cast<int>(mInputXs.size());
+    mInputXs.insert(mInputXs.end(), xCoordinates, xCoordinates + count);
+    mInputYs.insert(mInputYs.end(), yCoordinates, yCoordinates + count);
+    if (times) {
+        mInputTimes.insert(mInputTimes.end(), times, times + count);
+    }
+    if (mInputPointerIds.empty() && pointerId != 0) {
+        // The saved points without pointer ids belong to the pointer 0.
+        mInputPointerIds.resize(prevInputSize, 0);
+    }
+    if (!mInputPointerIds.empty()) {
+        mInputPointerIds.resize(prevInputSize + count, pointerId);
+    }
+    // Previous two points are never skipped. Thus, we pop 2 input point data here.
+    const int pushTouchPointStartIndex = ProximityInfoStateUtils::trimLastTwoTouchPoints(
+            &mSampledInputXs, &mSampledInputYs, &mSampledTimes, &mSampledLengthCache,
+            &mSampledInputIndice);
+    const int lastSavedInputSize = static_cast<int>(mSampledInputXs.size());
+    updateSampledInput(pointerId, true /* isGeometric */, static_cast<int>(mInputXs.size()),
+            mInputXs.data(), mInputYs.data(), times ? mInputTimes.data() : nullptr,
+            mInputPointerIds.empty() ? nullptr : mInputPointerIds.data(),
+            pushTouchPointStartIndex, lastSavedInputSize, prevInputSize);
+    return true;
+}
+
+bool ProximityInfoState::isSavedInputPrefixOf(const ProximityInfo *const proximityInfo,
+        const int inputSize, const int *const xCoordinates, const int *const yCoordinates,
+        const int *const times) const {
+    const int savedInputSize = getSavedInputSize();
+    if (!mHasBeenUpdatedByGeometricInput || proximityInfo != mProximityInfo
+            || savedInputSize == 0 || savedInputSize > inputSize || !xCoordinates
+            || !yCoordinates || (times == nullptr) != mInputTimes.empty()) {
+        return false;
+    }
+    const int lastIndex = savedInputSize - 1;
+    if (xCoordinates[0] != mInputXs[0] || yCoordinates[0] != mInputYs[0]
+            || xCoordinates[lastIndex] != mInputXs[lastIndex]
+            || yCoordinates[lastIndex] != mInputYs[lastIndex]) {
+        return false;
+    }
+    return !times || (times[0] == mInputTimes[0] && times[lastIndex] == mInputTimes[lastIndex]);
+}
+
+void ProximityInfoState::saveInput(const bool isGeometric, const int inputSize,
+        const int *const xCoordinates, const int *const yCoordinates, const int *const times,
+        const int *const pointerIds) {
+    mInputXs.clear();
+    mInputYs.clear();
+    mInputTimes.clear();
+    mInputPointerIds.clear();
+    if (!isGeometric || !xCoordinates || !yCoordinates) {
+        return;
+    }
+    mInputXs.assign(xCoordinates, xCoordinates + inputSize);
+    mInputYs.assign(yCoordinates, yCoordinates + inputSize);
+    if (times) {
+        mInputTimes.assign(times, times + inputSize);
+    }
+    if (pointerIds) {
+        mInputPointerIds.assign(pointerIds, pointerIds + inputSize);
+    }
+}
+
+// Samples the input from pushTouchPointStartIndex and refreshes the states of the sampled points
+// from lastSavedInputSize. prevInputSize is the raw input size of the previous update.
+void ProximityInfoState::updateSampledInput(const int pointerId, const bool isGeometric,
+        const int inputSize, const int *const xCoordinates, const int *const yCoordinates,
+        const int *const times, const int *const pointerIds, const int pushTouchPointStartIndex,
+        const int lastSavedInputSize, const int prevInputSize) {
+    mSampledInputSize = 0;
+    mMostProbableStringProbability = 0.0f;
     if (xCoordinates && yCoordinates) {
         mSampledInputSize = ProximityInfoStateUtils::updateTouchPoints(mProximityInfo,
                 mMaxPointToKeyLength, mInputProximities, xCoordinates, yCoordinates, times,
@@ -118,9 +215,9 @@ void ProximityInfoState::initInputParams(const int pointerId, const float maxPoi
                 &mSampledInputYs, &mSampledTimes, &mSampledLengthCache, &mSampledInputIndice,
                 &mSpeedRates, &mDirections);
         ProximityInfoStateUtils::refreshBeelineSpeedRates(mProximityInfo->getMostCommonKeyWidth(),
-                mAverageSpeed, inputSize, xCoordinates, yCoordinates, times, mSampledInputSize,
-                &mSampledInputXs, &mSampledInputYs, &mSampledInputIndice,
-                &mBeelineSpeedPercentiles);
+                mAverageSpeed, inputSize, xCoordinates, yCoordinates, times, prevInputSize,
+                lastSavedInputSize, mSampledInputSize, &mSampledInputXs, &mSampledInputYs,
+                &mSampledInputIndice, &mBeelineSpeedPercentiles);
     }
 
     if (mSampledInputSize > 0) {
@@ -138,9 +235,10 @@ void ProximityInfoState::initInputParams(const int pointerId, const float maxPoi
                     mSampledInputSize, lastSavedInputSize, &mSampledLengthCache,
                     &mCharProbabilities, &mSampledSearchKeySets,
                     &mSampledSearchKeyVectors);
-            mMostProbableStringProbability = ProximityInfoStateUtils::getMostProbableString(
-                    mProximityInfo, mSampledInputSize, &mCharProbabilities, mMostProbableString);
-
+            mMostProbableStringProbability = ProximityInfoStateUtils::updateMostProbableString(
+                    mProximityInfo, mSampledInputSize, lastSavedInputSize, &mCharProbabilities,
+                    &mMostProbableStringPrefixLengths, &mMostProbableStringPrefixLogProbabilities,
+                    mMostProbableString);
         }
     }
 
@@ -154,14 +252,13 @@ void ProximityInfoState::initInputParams(const int pointerId, const float maxPoi
 
     mTouchPositionCorrectionEnabled = mSampledInputSize > 0 && mHasTouchPositionCorrectionData
             && xCoordinates && yCoordinates;
-    if (!isGeometric && pointerId == 0) {
-        ProximityInfoStateUtils::initPrimaryInputWord(
-                inputSize, mInputProximities, mPrimaryInputWord);
-    }
-    if (DEBUG_GEO_FULL) {
-        AKLOGI("ProximityState init finished: %d points out of %d", mSampledInputSize, inputSize);
+    if (isGeometric) {
+        mSampledSweetSpotFactorCache.clear();
+    } else {
+        ProximityInfoStateUtils::initSweetSpotFactors(mMaxPointToKeyLength,
+                mTouchPositionCorrectionEnabled, mProximityInfo->getKeyCount(), mSampledInputSize,
+                &mSampledNormalizedSquaredLengthCache, &mSampledSweetSpotFactorCache);
     }
-    mHasBeenUpdatedByGeometricInput = isGeometric;
 }
 
 // This function basically converts from a length to an edit distance. Accordingly, it's obviously
@@ -180,6 +277,17 @@ float ProximityInfoState::getPointToKeyLength(
     return static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
 }
 
+float ProximityInfoState::getPointToKeySweetSpotFactor(
+        const int inputIndex, const int codePoint) const {
+    const int keyId = mProximityInfo->getKeyIndexOf(codePoint);
+    if (keyId != NOT_AN_INDEX) {
+        ASSERT(!mSampledSweetSpotFactorCache.empty());
+        return mSampledSweetSpotFactorCache[inputIndex * mProximityInfo->getKeyCount() + keyId];
+    }
+    return TouchPositionCorrectionUtils::getSweetSpotFactor(mTouchPositionCorrectionEnabled,
+            getPointToKeyLength(inputIndex, codePoint));
+}
+
 float ProximityInfoState::getPointToKeyByIdLength(
         const int inputIndex, const int keyId) const {
     return ProximityInfoStateUtils::getPointToKeyByIdLength(mMaxPointToKeyLength,
@@ -297,10 +405,15 @@ bool ProximityInfoState::hasSpaceProximity(const int index) const {
 // Returns a probability of mapping index to keyIndex.
 float ProximityInfoState::getProbability(const int index, const int keyIndex) const {
     ASSERT(0 <= index && index < mSampledInputSize);
-    std::unordered_map<int, float>::const_iterator it = mCharProbabilities[index].find(keyIndex);
-    if (it != mCharProbabilities[index].end()) {
-        return it->second;
+    const ProximityInfoStateUtils::CharProbabilities &charProbabilities =
+            mCharProbabilities[index];
+    if (keyIndex == NOT_AN_INDEX) {
+        return charProbabilities.mSkipProbability;
     }
-    return static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    if (keyIndex < 0 || keyIndex >= MAX_KEY_COUNT_IN_A_KEYBOARD
+            || !charProbabilities.mNearKeys.test(keyIndex)) {
+        return static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    }
+    return charProbabilities.mKeyProbabilities[keyIndex];
 }
 } // namespace latinime
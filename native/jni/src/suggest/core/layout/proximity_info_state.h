@@ -18,7 +18,6 @@
 #define LATINIME_PROXIMITY_INFO_STATE_H
 
 #include <cstring> // for memset()
-#include <unordered_map>
 #include <vector>
 
 #include "defines.h"
@@ -39,6 +38,16 @@ class ProximityInfoState {
             const int inputSize, const int *xCoordinates, const int *yCoordinates,
             const int *const times, const int *const pointerIds, const bool isGeometric,
             const std::vector<int> *locale);
+    // Appends touch points of pointerId to the gesture input of the last update and only
+    // processes the new points. Returns false when there is no gesture input to continue; then
+    // initInputParams() has to be called with the whole input.
+    bool appendTouchPoints(const int pointerId, const int *const xCoordinates,
+            const int *const yCoordinates, const int *const times, const int count);
+    // Returns whether the gesture input of the last update is a prefix of the given input. Only
+    // the first and the last saved points are compared.
+    bool isSavedInputPrefixOf(const ProximityInfo *const proximityInfo, const int inputSize,
+            const int *const xCoordinates, const int *const yCoordinates,
+            const int *const times) const;
 
     /////////////////////////////////////////
     // Defined here                        //
@@ -50,8 +59,11 @@ class ProximityInfoState {
               mIsContinuousSuggestionPossible(false), mHasBeenUpdatedByGeometricInput(false),
               mSampledInputXs(), mSampledInputYs(), mSampledTimes(), mSampledInputIndice(),
               mSampledLengthCache(), mBeelineSpeedPercentiles(),
-              mSampledNormalizedSquaredLengthCache(), mSpeedRates(), mDirections(),
+              mSampledNormalizedSquaredLengthCache(), mSampledSweetSpotFactorCache(),
+              mSpeedRates(), mDirections(),
               mCharProbabilities(), mSampledSearchKeySets(), mSampledSearchKeyVectors(),
+              mInputXs(), mInputYs(), mInputTimes(), mInputPointerIds(),
+              mMostProbableStringPrefixLengths(), mMostProbableStringPrefixLogProbabilities(),
               mTouchPositionCorrectionEnabled(false), mSampledInputSize(0),
               mMostProbableStringProbability(0.0f) {
         memset(mInputProximities, 0, sizeof(mInputProximities));
@@ -121,6 +133,10 @@ class ProximityInfoState {
         return mSampledInputSize;
     }
 
+    int getSavedInputSize() const {
+        return static_cast<int>(mInputXs.size());
+    }
+
     int getInputX(const int index) const {
         return mSampledInputXs[index];
     }
@@ -147,6 +163,8 @@ class ProximityInfoState {
     float getPointToKeyByIdLength(const int inputIndex, const int keyId) const;
     // TODO: Rename s/Length/NormalizedSquaredLength/
     float getPointToKeyLength(const int inputIndex, const int codePoint) const;
+    // Returns the sweet spot factor of getPointToKeyLength(). Only available for typing input.
+    float getPointToKeySweetSpotFactor(const int inputIndex, const int codePoint) const;
 
     ProximityType getProximityType(const int index, const int codePoint,
             const bool checkProximityChars, int *proximityIndex = 0) const;
@@ -192,6 +210,14 @@ class ProximityInfoState {
         return ProximityInfoStateUtils::getProximityCodePointsAt(mInputProximities, index);
     }
 
+    void saveInput(const bool isGeometric, const int inputSize, const int *const xCoordinates,
+            const int *const yCoordinates, const int *const times, const int *const pointerIds);
+    void updateSampledInput(const int pointerId, const bool isGeometric, const int inputSize,
+            const int *const xCoordinates, const int *const yCoordinates,
+            const int *const times, const int *const pointerIds,
+            const int pushTouchPointStartIndex, const int lastSavedInputSize,
+            const int prevInputSize);
+
     // const
     const ProximityInfo *mProximityInfo;
     float mMaxPointToKeyLength;
@@ -213,16 +239,25 @@ class ProximityInfoState {
     std::vector<int> mSampledLengthCache;
     std::vector<int> mBeelineSpeedPercentiles;
     std::vector<float> mSampledNormalizedSquaredLengthCache;
+    std::vector<float> mSampledSweetSpotFactorCache;
     std::vector<float> mSpeedRates;
     std::vector<float> mDirections;
     // probabilities of skipping or mapping to a key for each point.
-    std::vector<std::unordered_map<int, float>> mCharProbabilities;
+    std::vector<ProximityInfoStateUtils::CharProbabilities> mCharProbabilities;
     // The vector for the key code set which holds nearby keys of some trailing sampled input points
     // for each sampled input point. These nearby keys contain the next characters which can be in
     // the dictionary. Specifically, currently we are looking for keys nearby trailing sampled
     // inputs including the current input point.
     std::vector<ProximityInfoStateUtils::NearKeycodesSet> mSampledSearchKeySets;
     std::vector<std::vector<int>> mSampledSearchKeyVectors;
+    // The raw gesture input of the last update. Kept for appendTouchPoints().
+    std::vector<int> mInputXs;
+    std::vector<int> mInputYs;
+    std::vector<int> mInputTimes;
+    std::vector<int> mInputPointerIds;
+    // The length and the log probability of the most probable string after each sampled point.
+    std::vector<int> mMostProbableStringPrefixLengths;
+    std::vector<float> mMostProbableStringPrefixLogProbabilities;
     bool mTouchPositionCorrectionEnabled;
     int mInputProximities[MAX_PROXIMITY_CHARS_SIZE * MAX_WORD_LENGTH];
     int mSampledInputSize;
@@ -25,9 +25,11 @@
 
 #include "defines.h"
 #include "suggest/core/layout/geometry_utils.h"
+#include "suggest/core/layout/key_probability_kernels.h"
 #include "suggest/core/layout/normal_distribution_2d.h"
 #include "suggest/core/layout/proximity_info.h"
 #include "suggest/core/layout/proximity_info_params.h"
+#include "suggest/core/layout/touch_position_correction_utils.h"
 
 namespace latinime {
 
@@ -192,16 +194,30 @@ namespace latinime {
         std::vector<float> *sampledNormalizedSquaredLengthCache) {
     const int keyCount = proximityInfo->getKeyCount();
     sampledNormalizedSquaredLengthCache->resize(sampledInputSize * keyCount);
+    if (keyCount <= 0) {
+        return;
+    }
     for (int i = lastSavedInputSize; i < sampledInputSize; ++i) {
-        for (int k = 0; k < keyCount; ++k) {
-            const int index = i * keyCount + k;
-            const int x = (*sampledInputXs)[i];
-            const int y = (*sampledInputYs)[i];
-            const float normalizedSquaredDistance =
-                    proximityInfo->getNormalizedSquaredDistanceFromCenterFloatG(
-                            k, x, y, isGeometric);
-            (*sampledNormalizedSquaredLengthCache)[index] = normalizedSquaredDistance;
-        }
+        proximityInfo->getNormalizedSquaredDistancesFromCentersG((*sampledInputXs)[i],
+                (*sampledInputYs)[i], isGeometric,
+                &(*sampledNormalizedSquaredLengthCache)[i * keyCount]);
+    }
+}
+
+// Fills the sweet spot factors of all the point to key lengths. They depend on whether touch
+// position correction is enabled, which is only known after sampling, so the whole table is
+// refreshed.
+/* static */ void ProximityInfoStateUtils::initSweetSpotFactors(const float maxPointToKeyLength,
+        const bool isTouchPositionCorrectionEnabled, const int keyCount,
+        const int sampledInputSize,
+        const std::vector<float> *const sampledNormalizedSquaredLengthCache,
+        std::vector<float> *sampledSweetSpotFactorCache) {
+    const int cacheSize = sampledInputSize * keyCount;
+    sampledSweetSpotFactorCache->resize(cacheSize);
+    for (int i = 0; i < cacheSize; ++i) {
+        (*sampledSweetSpotFactorCache)[i] = TouchPositionCorrectionUtils::getSweetSpotFactor(
+                isTouchPositionCorrectionEnabled,
+                std::min((*sampledNormalizedSquaredLengthCache)[i], maxPointToKeyLength));
     }
 }
 
@@ -276,15 +292,34 @@ namespace latinime {
 
 /* static */ void ProximityInfoStateUtils::refreshBeelineSpeedRates(const int mostCommonKeyWidth,
         const float averageSpeed, const int inputSize, const int *const xCoordinates,
-        const int *const yCoordinates, const int *times, const int sampledInputSize,
+        const int *const yCoordinates, const int *times, const int prevInputSize,
+        const int lastSavedInputSize, const int sampledInputSize,
         const std::vector<int> *const sampledInputXs,
         const std::vector<int> *const sampledInputYs, const std::vector<int> *const inputIndice,
         std::vector<int> *beelineSpeedPercentiles) {
     if (DEBUG_SAMPLING_POINTS) {
         AKLOGI("--- refresh beeline speed rates");
     }
+    // The rate of a saved point depends on the new points only when its forward lookup reached
+    // the last point of the previous input. Such points are at the end of the saved points.
+    const int lookupRadius = mostCommonKeyWidth
+            * ProximityInfoParams::LOOKUP_RADIUS_PERCENTILE / MAX_PERCENTILE;
+    int start = std::min(lastSavedInputSize, static_cast<int>(beelineSpeedPercentiles->size()));
+    while (start > 0 && prevInputSize > 0) {
+        const int x0 = (*sampledInputXs)[start - 1];
+        const int y0 = (*sampledInputYs)[start - 1];
+        int end = (*inputIndice)[start - 1];
+        while (end < prevInputSize - 1 && GeometryUtils::getDistanceInt(x0, y0,
+                xCoordinates[end], yCoordinates[end]) < lookupRadius) {
+            ++end;
+        }
+        if (end < prevInputSize - 1) {
+            break;
+        }
+        --start;
+    }
     beelineSpeedPercentiles->resize(sampledInputSize);
-    for (int i = 0; i < sampledInputSize; ++i) {
+    for (int i = start; i < sampledInputSize; ++i) {
         (*beelineSpeedPercentiles)[i] = static_cast<int>(calculateBeelineSpeedRate(
                 mostCommonKeyWidth, averageSpeed, i, inputSize, xCoordinates, yCoordinates, times,
                 sampledInputSize, sampledInputXs, sampledInputYs, inputIndice) * MAX_PERCENTILE);
@@ -317,9 +352,10 @@ namespace latinime {
     currentNearKeysDistances->clear();
     const int keyCount = proximityInfo->getKeyCount();
     float nearestKeyDistance = maxPointToKeyLength;
+    float distances[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    proximityInfo->getNormalizedSquaredDistancesFromCentersG(x, y, isGeometric, distances);
     for (int k = 0; k < keyCount; ++k) {
-        const float dist = proximityInfo->getNormalizedSquaredDistanceFromCenterFloatG(k, x, y,
-                isGeometric);
+        const float dist = distances[k];
         if (dist < ProximityInfoParams::NEAR_KEY_THRESHOLD_FOR_DISTANCE) {
             currentNearKeysDistances->insert(std::pair<int, float>(k, dist));
         }
@@ -621,12 +657,25 @@ namespace latinime {
         const std::vector<int> *const sampledLengthCache,
         const std::vector<float> *const sampledNormalizedSquaredLengthCache,
         const ProximityInfo *const proximityInfo,
-        std::vector<std::unordered_map<int, float>> *charProbabilities) {
+        std::vector<CharProbabilities> *charProbabilities) {
     charProbabilities->resize(sampledInputSize);
+    // The key centers do not depend on the point.
+    float keyCenterXs[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    float keyCenterYs[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    for (int j = 0; j < keyCount; ++j) {
+        keyCenterXs[j] = proximityInfo->getKeyCenterXOfKeyIdG(j,
+                NOT_A_COORDINATE /* referencePointX */, true /* isGeometric */);
+        keyCenterYs[j] = proximityInfo->getKeyCenterYOfKeyIdG(j,
+                NOT_A_COORDINATE /* referencePointY */, true /* isGeometric */);
+    }
+    NearKeycodesSet allKeys;
+    for (int j = 0; j < keyCount; ++j) {
+        allKeys.set(j);
+    }
     // Calculates probabilities of using a point as a correlated point with the character
     // for each point.
     for (int i = start; i < sampledInputSize; ++i) {
-        (*charProbabilities)[i].clear();
+        CharProbabilities *const pointCharProbabilities = &(*charProbabilities)[i];
         // First, calculates skip probability. Starts from MAX_SKIP_PROBABILITY.
         // Note that all values that are multiplied to this probability should be in [0.0, 1.0];
         float skipProbability = ProximityInfoParams::MAX_SKIP_PROBABILITY;
@@ -695,7 +744,7 @@ namespace latinime {
         // probabilities must be in [0.0, ProximityInfoParams::MAX_SKIP_PROBABILITY];
         ASSERT(skipProbability >= 0.0f);
         ASSERT(skipProbability <= ProximityInfoParams::MAX_SKIP_PROBABILITY);
-        (*charProbabilities)[i][NOT_AN_INDEX] = skipProbability;
+        pointCharProbabilities->mSkipProbability = skipProbability;
 
         // Second, calculates key probabilities by dividing the rest probability
         // (1.0f - skipProbability).
@@ -733,26 +782,18 @@ namespace latinime {
         NormalDistribution2D distribution((*sampledInputXs)[i], sigmaX, (*sampledInputYs)[i],
                 sigmaY, theta);
         // Summing up probability densities of all near keys.
+        float *const keyProbabilities = pointCharProbabilities->mKeyProbabilities;
         float sumOfProbabilityDensities = 0.0f;
         for (int j = 0; j < keyCount; ++j) {
-            sumOfProbabilityDensities += distribution.getProbabilityDensity(
-                    proximityInfo->getKeyCenterXOfKeyIdG(j,
-                            NOT_A_COORDINATE /* referencePointX */, true /* isGeometric */),
-                    proximityInfo->getKeyCenterYOfKeyIdG(j,
-                            NOT_A_COORDINATE /* referencePointY */, true /* isGeometric */));
+            keyProbabilities[j] = distribution.getProbabilityDensity(keyCenterXs[j],
+                    keyCenterYs[j]);
+            sumOfProbabilityDensities += keyProbabilities[j];
         }
 
         // Split the probability of an input point to keys that are close to the input point.
-        for (int j = 0; j < keyCount; ++j) {
-            const float probabilityDensity = distribution.getProbabilityDensity(
-                    proximityInfo->getKeyCenterXOfKeyIdG(j,
-                            NOT_A_COORDINATE /* referencePointX */, true /* isGeometric */),
-                    proximityInfo->getKeyCenterYOfKeyIdG(j,
-                            NOT_A_COORDINATE /* referencePointY */, true /* isGeometric */));
-            const float probability = inputCharProbability * probabilityDensity
-                    / sumOfProbabilityDensities;
-            (*charProbabilities)[i][j] = probability;
-        }
+        KeyProbabilityKernels::normalizeProbabilities(keyCount, inputCharProbability,
+                sumOfProbabilityDensities, keyProbabilities);
+        pointCharProbabilities->mNearKeys = allKeys;
     }
 
     if (DEBUG_POINTS_PROBABILITY) {
@@ -763,20 +804,12 @@ namespace latinime {
             sstream << "Speed: "<< (*sampledSpeedRates)[i] << ", ";
             sstream << "Angle: "<< getPointAngle(sampledInputXs, sampledInputYs, i) << ", \n";
 
-            for (std::unordered_map<int, float>::iterator it = (*charProbabilities)[i].begin();
-                    it != (*charProbabilities)[i].end(); ++it) {
-                if (it->first == NOT_AN_INDEX) {
-                    sstream << it->first
-                            << "(skip):"
-                            << it->second
-                            << "\n";
-                } else {
-                    sstream << it->first
-                            << "("
-                            //<< static_cast<char>(mProximityInfo->getCodePointOf(it->first))
-                            << "):"
-                            << it->second
-                            << "\n";
+            const CharProbabilities &pointCharProbabilities = (*charProbabilities)[i];
+            sstream << NOT_AN_INDEX << "(skip):" << pointCharProbabilities.mSkipProbability
+                    << "\n";
+            for (int j = 0; j < keyCount; ++j) {
+                if (pointCharProbabilities.mNearKeys.test(j)) {
+                    sstream << j << "():" << pointCharProbabilities.mKeyProbabilities[j] << "\n";
                 }
             }
             AKLOGI("%s", sstream.str().c_str());
@@ -788,14 +821,14 @@ namespace latinime {
     for (int i = std::max(start, 1); i < sampledInputSize; ++i) {
         for (int j = i + 1; j < sampledInputSize; ++j) {
             if (!suppressCharProbabilities(
-                    mostCommonKeyWidth, sampledInputSize, sampledLengthCache, i, j,
+                    mostCommonKeyWidth, keyCount, sampledInputSize, sampledLengthCache, i, j,
                     charProbabilities)) {
                 break;
             }
         }
         for (int j = i - 1; j >= std::max(start, 0); --j) {
             if (!suppressCharProbabilities(
-                    mostCommonKeyWidth, sampledInputSize, sampledLengthCache, i, j,
+                    mostCommonKeyWidth, keyCount, sampledInputSize, sampledLengthCache, i, j,
                     charProbabilities)) {
                 break;
             }
@@ -804,25 +837,28 @@ namespace latinime {
 
     // Converting from raw probabilities to log probabilities to calculate spatial distance.
     for (int i = start; i < sampledInputSize; ++i) {
+        CharProbabilities *const pointCharProbabilities = &(*charProbabilities)[i];
         for (int j = 0; j < keyCount; ++j) {
-            std::unordered_map<int, float>::iterator it = (*charProbabilities)[i].find(j);
-            if (it == (*charProbabilities)[i].end()){
+            if (!pointCharProbabilities->mNearKeys.test(j)) {
                 continue;
-            } else if(it->second < ProximityInfoParams::MIN_PROBABILITY) {
-                // Erases from near keys vector because it has very low probability.
-                (*charProbabilities)[i].erase(j);
+            } else if (pointCharProbabilities->mKeyProbabilities[j]
+                    < ProximityInfoParams::MIN_PROBABILITY) {
+                // Removes from near keys because it has very low probability.
+                pointCharProbabilities->mNearKeys.reset(j);
             } else {
-                it->second = -logf(it->second);
+                pointCharProbabilities->mKeyProbabilities[j] =
+                        -logf(pointCharProbabilities->mKeyProbabilities[j]);
             }
         }
-        (*charProbabilities)[i][NOT_AN_INDEX] = -logf((*charProbabilities)[i][NOT_AN_INDEX]);
+        pointCharProbabilities->mSkipProbability =
+                -logf(pointCharProbabilities->mSkipProbability);
     }
 }
 
 /* static */ void ProximityInfoStateUtils::updateSampledSearchKeySets(
         const ProximityInfo *const proximityInfo, const int sampledInputSize,
         const int lastSavedInputSize, const std::vector<int> *const sampledLengthCache,
-        const std::vector<std::unordered_map<int, float>> *const charProbabilities,
+        const std::vector<CharProbabilities> *const charProbabilities,
         std::vector<NearKeycodesSet> *sampledSearchKeySets,
         std::vector<std::vector<int>> *sampledSearchKeyVectors) {
     sampledSearchKeySets->resize(sampledInputSize);
@@ -830,7 +866,16 @@ namespace latinime {
     const int readForwordLength = static_cast<int>(
             hypotf(proximityInfo->getKeyboardWidth(), proximityInfo->getKeyboardHeight())
                     * ProximityInfoParams::SEARCH_KEY_RADIUS_RATIO);
-    for (int i = 0; i < sampledInputSize; ++i) {
+    // The keys of the new points are only added to the points within readForwordLength before
+    // them. The length cache is monotonically increasing.
+    int start = sampledInputSize;
+    if (lastSavedInputSize < sampledInputSize) {
+        start = static_cast<int>(std::upper_bound(sampledLengthCache->begin(),
+                sampledLengthCache->begin() + lastSavedInputSize,
+                (*sampledLengthCache)[lastSavedInputSize] - readForwordLength)
+                        - sampledLengthCache->begin());
+    }
+    for (int i = start; i < sampledInputSize; ++i) {
         if (i >= lastSavedInputSize) {
             (*sampledSearchKeySets)[i].reset();
         }
@@ -839,16 +884,11 @@ namespace latinime {
             if ((*sampledLengthCache)[j] - (*sampledLengthCache)[i] >= readForwordLength) {
                 break;
             }
-            for(const auto& charProbability : charProbabilities->at(j)) {
-                if (charProbability.first == NOT_AN_INDEX) {
-                    continue;
-                }
-                (*sampledSearchKeySets)[i].set(charProbability.first);
-            }
+            (*sampledSearchKeySets)[i] |= (*charProbabilities)[j].mNearKeys;
         }
     }
     const int keyCount = proximityInfo->getKeyCount();
-    for (int i = 0; i < sampledInputSize; ++i) {
+    for (int i = start; i < sampledInputSize; ++i) {
         std::vector<int> *searchKeyVector = &(*sampledSearchKeyVectors)[i];
         searchKeyVector->clear();
         for (int j = 0; j < keyCount; ++j) {
@@ -866,9 +906,9 @@ namespace latinime {
 // Decreases char probabilities of index0 by checking probabilities of a near point (index1) and
 // increases char probabilities of index1 by checking probabilities of index0.
 /* static */ bool ProximityInfoStateUtils::suppressCharProbabilities(const int mostCommonKeyWidth,
-        const int sampledInputSize, const std::vector<int> *const lengthCache,
+        const int keyCount, const int sampledInputSize, const std::vector<int> *const lengthCache,
         const int index0, const int index1,
-        std::vector<std::unordered_map<int, float>> *charProbabilities) {
+        std::vector<CharProbabilities> *charProbabilities) {
     ASSERT(0 <= index0 && index0 < sampledInputSize);
     ASSERT(0 <= index1 && index1 < sampledInputSize);
     const float keyWidthFloat = static_cast<float>(mostCommonKeyWidth);
@@ -879,24 +919,31 @@ namespace latinime {
     const float suppressionRate = ProximityInfoParams::MIN_SUPPRESSION_RATE
             + diff / keyWidthFloat / ProximityInfoParams::SUPPRESSION_LENGTH_WEIGHT
                     * ProximityInfoParams::SUPPRESSION_WEIGHT;
-    for (std::unordered_map<int, float>::iterator it = (*charProbabilities)[index0].begin();
-            it != (*charProbabilities)[index0].end(); ++it) {
-        std::unordered_map<int, float>::iterator it2 = (*charProbabilities)[index1].find(it->first);
-        if (it2 != (*charProbabilities)[index1].end() && it->second < it2->second) {
-            const float newProbability = it->second * suppressionRate;
-            const float suppression = it->second - newProbability;
-            it->second = newProbability;
-            // mCharProbabilities[index0][NOT_AN_INDEX] is the probability of skipping this point.
-            (*charProbabilities)[index0][NOT_AN_INDEX] += suppression;
-
-            // Add the probability of the same key nearby index1
-            const float probabilityGain = std::min(suppression
-                    * ProximityInfoParams::SUPPRESSION_WEIGHT_FOR_PROBABILITY_GAIN,
-                    (*charProbabilities)[index1][NOT_AN_INDEX]
-                            * ProximityInfoParams::SKIP_PROBABALITY_WEIGHT_FOR_PROBABILITY_GAIN);
-            it2->second += probabilityGain;
-            (*charProbabilities)[index1][NOT_AN_INDEX] -= probabilityGain;
+    CharProbabilities *const charProbabilities0 = &(*charProbabilities)[index0];
+    CharProbabilities *const charProbabilities1 = &(*charProbabilities)[index1];
+    // Both points still have the raw probabilities of all keys here. The skip probabilities are
+    // not suppressed against each other as the suppression and the gain would cancel out.
+    float *const keyProbabilities0 = charProbabilities0->mKeyProbabilities;
+    const float *const keyProbabilities1 = charProbabilities1->mKeyProbabilities;
+    float suppressions[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    KeyProbabilityKernels::suppressProbabilities(keyCount, suppressionRate, keyProbabilities1,
+            keyProbabilities0, suppressions);
+    // The gain of each key is bounded by the remaining skip probability of index1, so this loop
+    // is sequential.
+    for (int j = 0; j < keyCount; ++j) {
+        if (suppressions[j] <= 0.0f) {
+            continue;
         }
+        // mSkipProbability is the probability of skipping this point.
+        charProbabilities0->mSkipProbability += suppressions[j];
+
+        // Add the probability of the same key nearby index1
+        const float probabilityGain = std::min(suppressions[j]
+                * ProximityInfoParams::SUPPRESSION_WEIGHT_FOR_PROBABILITY_GAIN,
+                charProbabilities1->mSkipProbability
+                        * ProximityInfoParams::SKIP_PROBABALITY_WEIGHT_FOR_PROBABILITY_GAIN);
+        charProbabilities1->mKeyProbabilities[j] += probabilityGain;
+        charProbabilities1->mSkipProbability -= probabilityGain;
     }
     return true;
 }
@@ -931,25 +978,35 @@ namespace latinime {
 
 // Get a word that is detected by tracing the most probable string into codePointBuf and
 // returns probability of generating the word.
-/* static */ float ProximityInfoStateUtils::getMostProbableString(
+/* static */ float ProximityInfoStateUtils::updateMostProbableString(
         const ProximityInfo *const proximityInfo, const int sampledInputSize,
-        const std::vector<std::unordered_map<int, float>> *const charProbabilities,
+        const int lastSavedInputSize,
+        const std::vector<CharProbabilities> *const charProbabilities,
+        std::vector<int> *const prefixLengths, std::vector<float> *const prefixLogProbabilities,
         int *const codePointBuf) {
     ASSERT(sampledInputSize >= 0);
-    memset(codePointBuf, 0, sizeof(codePointBuf[0]) * MAX_WORD_LENGTH);
-    int index = 0;
-    float sumLogProbability = 0.0f;
+    const int keyCount = proximityInfo->getKeyCount();
+    const int start = std::min(lastSavedInputSize, static_cast<int>(prefixLengths->size()));
+    prefixLengths->resize(start);
+    prefixLogProbabilities->resize(start);
+    int index = (start > 0) ? prefixLengths->back() : 0;
+    float sumLogProbability = (start > 0) ? prefixLogProbabilities->back() : 0.0f;
+    memset(codePointBuf + index, 0, sizeof(codePointBuf[0]) * (MAX_WORD_LENGTH - index));
     // TODO: Current implementation is greedy algorithm. DP would be efficient for many cases.
-    for (int i = 0; i < sampledInputSize && index < MAX_WORD_LENGTH - 1; ++i) {
-        float minLogProbability = static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    for (int i = start; i < sampledInputSize && index < MAX_WORD_LENGTH - 1; ++i) {
+        const CharProbabilities &pointCharProbabilities = (*charProbabilities)[i];
+        float minLogProbability = std::min(static_cast<float>(MAX_VALUE_FOR_WEIGHTING),
+                pointCharProbabilities.mSkipProbability);
         int character = NOT_AN_INDEX;
-        for (std::unordered_map<int, float>::const_iterator it = (*charProbabilities)[i].begin();
-                it != (*charProbabilities)[i].end(); ++it) {
-            const float logProbability = (it->first != NOT_AN_INDEX)
-                    ? it->second + ProximityInfoParams::DEMOTION_LOG_PROBABILITY : it->second;
+        for (int j = 0; j < keyCount; ++j) {
+            if (!pointCharProbabilities.mNearKeys.test(j)) {
+                continue;
+            }
+            const float logProbability = pointCharProbabilities.mKeyProbabilities[j]
+                    + ProximityInfoParams::DEMOTION_LOG_PROBABILITY;
             if (logProbability < minLogProbability) {
                 minLogProbability = logProbability;
-                character = it->first;
+                character = j;
             }
         }
         if (character != NOT_AN_INDEX) {
@@ -960,12 +1017,17 @@ namespace latinime {
                 ASSERT(false);
                 // Make the length zero, which means most probable string won't be used.
                 index = 0;
+                // Nothing can be resumed.
+                prefixLengths->clear();
+                prefixLogProbabilities->clear();
                 break;
             }
             codePointBuf[index] = codePoint;
             index++;
         }
         sumLogProbability += minLogProbability;
+        prefixLengths->push_back(index);
+        prefixLogProbabilities->push_back(sumLogProbability);
     }
     codePointBuf[index] = '\0';
     return sumLogProbability;
@@ -32,6 +32,15 @@ class ProximityInfoStateUtils {
     typedef std::unordered_map<int, float> NearKeysDistanceMap;
     typedef std::bitset<MAX_KEY_COUNT_IN_A_KEYBOARD> NearKeycodesSet;
 
+    // Probabilities of aligning a sampled point to each key and of skipping the point. They are
+    // log probabilities once updateAlignPointProbabilities() returns. Only the keys in mNearKeys
+    // have a probability.
+    struct CharProbabilities {
+        alignas(16) float mKeyProbabilities[MAX_KEY_COUNT_IN_A_KEYBOARD];
+        float mSkipProbability;
+        NearKeycodesSet mNearKeys;
+    };
+
     static int trimLastTwoTouchPoints(std::vector<int> *sampledInputXs,
             std::vector<int> *sampledInputYs, std::vector<int> *sampledInputTimes,
             std::vector<int> *sampledLengthCache, std::vector<int> *sampledInputIndice);
@@ -56,10 +65,12 @@ class ProximityInfoStateUtils {
             const std::vector<int> *const sampledLengthCache,
             const std::vector<int> *const sampledInputIndice,
             std::vector<float> *sampledSpeedRates, std::vector<float> *sampledDirections);
+    // Only refreshes the points from lastSavedInputSize and the saved points whose lookup reached
+    // the end of the previous input of prevInputSize points.
     static void refreshBeelineSpeedRates(const int mostCommonKeyWidth, const float averageSpeed,
             const int inputSize, const int *const xCoordinates, const int *const yCoordinates,
-            const int *times, const int sampledInputSize,
-            const std::vector<int> *const sampledInputXs,
+            const int *times, const int prevInputSize, const int lastSavedInputSize,
+            const int sampledInputSize, const std::vector<int> *const sampledInputXs,
             const std::vector<int> *const sampledInputYs, const std::vector<int> *const inputIndice,
             std::vector<int> *beelineSpeedPercentiles);
     static float getDirection(const std::vector<int> *const sampledInputXs,
@@ -72,11 +83,11 @@ class ProximityInfoStateUtils {
             const std::vector<int> *const sampledLengthCache,
             const std::vector<float> *const sampledNormalizedSquaredLengthCache,
             const ProximityInfo *const proximityInfo,
-            std::vector<std::unordered_map<int, float>> *charProbabilities);
+            std::vector<CharProbabilities> *charProbabilities);
     static void updateSampledSearchKeySets(const ProximityInfo *const proximityInfo,
             const int sampledInputSize, const int lastSavedInputSize,
             const std::vector<int> *const sampledLengthCache,
-            const std::vector<std::unordered_map<int, float>> *const charProbabilities,
+            const std::vector<CharProbabilities> *const charProbabilities,
             std::vector<NearKeycodesSet> *sampledSearchKeySets,
             std::vector<std::vector<int>> *sampledSearchKeyVectors);
     static float getPointToKeyByIdLength(const float maxPointToKeyLength,
@@ -87,6 +98,11 @@ class ProximityInfoStateUtils {
             const std::vector<int> *const sampledInputXs,
             const std::vector<int> *const sampledInputYs,
             std::vector<float> *sampledNormalizedSquaredLengthCache);
+    static void initSweetSpotFactors(const float maxPointToKeyLength,
+            const bool isTouchPositionCorrectionEnabled, const int keyCount,
+            const int sampledInputSize,
+            const std::vector<float> *const sampledNormalizedSquaredLengthCache,
+            std::vector<float> *sampledSweetSpotFactorCache);
     static void initPrimaryInputWord(const int inputSize, const int *const inputProximities,
             int *primaryInputWord);
     static void dump(const bool isGeometric, const int inputSize,
@@ -103,9 +119,12 @@ class ProximityInfoStateUtils {
             const std::vector<int> *const sampledTimes,
             const std::vector<int> *const sampledInputIndices);
     // TODO: Move to most_probable_string_utils.h
-    static float getMostProbableString(const ProximityInfo *const proximityInfo,
-            const int sampledInputSize,
-            const std::vector<std::unordered_map<int, float>> *const charProbabilities,
+    // Resumes from the state after the first lastSavedInputSize points, which is kept in
+    // prefixLengths and prefixLogProbabilities, and in codePointBuf for the code points.
+    static float updateMostProbableString(const ProximityInfo *const proximityInfo,
+            const int sampledInputSize, const int lastSavedInputSize,
+            const std::vector<CharProbabilities> *const charProbabilities,
+            std::vector<int> *const prefixLengths, std::vector<float> *const prefixLogProbabilities,
             int *const codePointBuf);
 
  private:
@@ -145,9 +164,9 @@ class ProximityInfoStateUtils {
     static float getPointsAngle(const std::vector<int> *const sampledInputXs,
             const std::vector<int> *const sampledInputYs, const int index0, const int index1,
             const int index2);
-    static bool suppressCharProbabilities(const int mostCommonKeyWidth,
+    static bool suppressCharProbabilities(const int mostCommonKeyWidth, const int keyCount,
             const int sampledInputSize, const std::vector<int> *const lengthCache, const int index0,
-            const int index1, std::vector<std::unordered_map<int, float>> *charProbabilities);
+            const int index1, std::vector<CharProbabilities> *charProbabilities);
     static float calculateSquaredDistanceFromSweetSpotCenter(
             const ProximityInfo *const proximityInfo, const std::vector<int> *const sampledInputXs,
             const std::vector<int> *const sampledInputYs, const int keyIndex,
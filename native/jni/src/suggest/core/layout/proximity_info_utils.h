@@ -17,6 +17,7 @@
 #ifndef LATINIME_PROXIMITY_INFO_UTILS_H
 #define LATINIME_PROXIMITY_INFO_UTILS_H
 
+#include <algorithm>
 #include <cmath>
 #include <unordered_map>
 #include <vector>
@@ -29,6 +30,41 @@
 namespace latinime {
 class ProximityInfoUtils {
  public:
+    // A key listed in a grid cell with the bounds of the squared length to its edge from the
+    // points in the cell. Computed once per layout so that typing only measures the keys whose
+    // bounds don't decide whether they are near.
+    struct CellKey {
+        int mCodePoint;
+        int mKeyIndex;
+        int mMinSquaredLengthToEdge;
+        int mMaxSquaredLengthToEdge;
+        bool mMayBeOnKey;
+    };
+
+    // outCellKeys has the same layout as proximityCharsArray.
+    static void initializeCellKeys(const int *const keyXCoordinates,
+            const int *const keyYCoordinates, const int *const keyWidths, const int *keyHeights,
+            const int *const proximityCharsArray, const int cellHeight, const int cellWidth,
+            const int gridWidth, const int gridHeight, const int keyCount,
+            const std::unordered_map<int, int> *const codeToKeyMap, CellKey *const outCellKeys) {
+        for (int cellY = 0; cellY < gridHeight; ++cellY) {
+            for (int cellX = 0; cellX < gridWidth; ++cellX) {
+                const int left = cellX * cellWidth;
+                const int top = cellY * cellHeight;
+                const int startIndex = getStartIndexFromCoordinates(left, top, cellHeight,
+                        cellWidth, gridWidth);
+                for (int i = 0; i < MAX_PROXIMITY_CHARS_SIZE; ++i) {
+                    const int c = proximityCharsArray[startIndex + i];
+                    initializeCellKey(keyXCoordinates, keyYCoordinates, keyWidths, keyHeights,
+                            c, (c < KEYCODE_SPACE) ? NOT_AN_INDEX
+                                    : getKeyIndexOf(keyCount, c, codeToKeyMap),
+                            left, top, left + cellWidth - 1, top + cellHeight - 1,
+                            &outCellKeys[startIndex + i]);
+                }
+            }
+        }
+    }
+
     static AK_FORCE_INLINE int getKeyIndexOf(const int keyCount, const int c,
             const std::unordered_map<int, int> *const codeToKeyMap) {
         if (keyCount == 0) {
@@ -50,9 +86,9 @@ class ProximityInfoUtils {
             const int *const inputXCoordinates, const int *const inputYCoordinates,
             const int inputSize, const int *const keyXCoordinates,
             const int *const keyYCoordinates, const int *const keyWidths, const int *keyHeights,
-            const int *const proximityCharsArray, const int cellHeight, const int cellWidth,
-            const int gridWidth, const int mostCommonKeyWidth, const int keyCount,
-            const std::vector<int> *locale,
+            const int *const proximityCharsArray, const CellKey *const cellKeys,
+            const int cellHeight, const int cellWidth, const int gridWidth, const int gridHeight,
+            const int mostCommonKeyWidth, const int keyCount, const std::vector<int> *locale,
             const std::unordered_map<int, int> *const codeToKeyMap, int *inputProximities) {
         // Initialize
         // - mInputCodes
@@ -64,8 +100,9 @@ class ProximityInfoUtils {
             const int y = inputYCoordinates[i];
             int *proximities = &inputProximities[i * MAX_PROXIMITY_CHARS_SIZE];
             calculateProximities(keyXCoordinates, keyYCoordinates, keyWidths, keyHeights,
-                    proximityCharsArray, cellHeight, cellWidth, gridWidth, mostCommonKeyWidth,
-                    keyCount, x, y, primaryKey, locale, codeToKeyMap, proximities);
+                    proximityCharsArray, cellKeys, cellHeight, cellWidth, gridWidth, gridHeight,
+                    mostCommonKeyWidth, keyCount, x, y, primaryKey, locale, codeToKeyMap,
+                    proximities);
         }
 
         if (DEBUG_PROXIMITY_CHARS) {
@@ -140,11 +177,79 @@ class ProximityInfoUtils {
         return left < right && top < bottom && x >= left && x < right && y >= top && y < bottom;
     }
 
+    static void initializeCellKey(const int *const keyXCoordinates,
+            const int *const keyYCoordinates, const int *const keyWidths, const int *keyHeights,
+            const int codePoint, const int keyId, const int cellLeft, const int cellTop,
+            const int cellRight, const int cellBottom, CellKey *const outCellKey) {
+        outCellKey->mCodePoint = codePoint;
+        outCellKey->mKeyIndex = keyId;
+        if (keyId < 0) {
+            // isOnKey() is true for the keys that are not on the keyboard.
+            outCellKey->mMinSquaredLengthToEdge = 0;
+            outCellKey->mMaxSquaredLengthToEdge = 0;
+            outCellKey->mMayBeOnKey = true;
+            return;
+        }
+        const int left = keyXCoordinates[keyId];
+        const int top = keyYCoordinates[keyId];
+        const int right = left + keyWidths[keyId];
+        const int bottom = top + keyHeights[keyId];
+        // The length to the edge is separable in x and y, and the length on each axis is convex.
+        const int minDx = getLengthToRange(cellLeft, cellRight, left, right);
+        const int minDy = getLengthToRange(cellTop, cellBottom, top, bottom);
+        const int maxDx = std::max(getLengthToRange(cellLeft, cellLeft, left, right),
+                getLengthToRange(cellRight, cellRight, left, right));
+        const int maxDy = std::max(getLengthToRange(cellTop, cellTop, top, bottom),
+                getLengthToRange(cellBottom, cellBottom, top, bottom));
+        outCellKey->mMinSquaredLengthToEdge = minDx * minDx + minDy * minDy;
+        outCellKey->mMaxSquaredLengthToEdge = maxDx * maxDx + maxDy * maxDy;
+        // Same bounds as isOnKey().
+        const int onKeyRight = right + 1;
+        outCellKey->mMayBeOnKey = left < onKeyRight && top < bottom && cellRight >= left
+                && cellLeft < onKeyRight && cellBottom >= top && cellTop < bottom;
+    }
+
+    // Returns the length between the ranges [begin0, end0] and [begin1, end1].
+    static int getLengthToRange(const int begin0, const int end0, const int begin1,
+            const int end1) {
+        if (end0 < begin1) {
+            return begin1 - end0;
+        }
+        if (begin0 > end1) {
+            return begin0 - end1;
+        }
+        return 0;
+    }
+
+    static AK_FORCE_INLINE bool isNearKey(const int *const keyXCoordinates,
+            const int *const keyYCoordinates, const int *const keyWidths, const int *keyHeights,
+            const int mostCommonKeyWidthSquare, const int keyIndex, const int x, const int y) {
+        return isOnKey(keyXCoordinates, keyYCoordinates, keyWidths, keyHeights, keyIndex, x, y)
+                || squaredLengthToEdge(keyXCoordinates, keyYCoordinates, keyWidths, keyHeights,
+                        keyIndex, x, y) < mostCommonKeyWidthSquare;
+    }
+
+    static AK_FORCE_INLINE bool isNearCellKey(const int *const keyXCoordinates,
+            const int *const keyYCoordinates, const int *const keyWidths, const int *keyHeights,
+            const int mostCommonKeyWidthSquare, const CellKey *const cellKey, const int x,
+            const int y) {
+        if (cellKey->mMaxSquaredLengthToEdge < mostCommonKeyWidthSquare) {
+            return true;
+        }
+        if (cellKey->mMinSquaredLengthToEdge >= mostCommonKeyWidthSquare
+                && !cellKey->mMayBeOnKey) {
+            return false;
+        }
+        return isNearKey(keyXCoordinates, keyYCoordinates, keyWidths, keyHeights,
+                mostCommonKeyWidthSquare, cellKey->mKeyIndex, x, y);
+    }
+
     static AK_FORCE_INLINE void calculateProximities(const int *const keyXCoordinates,
             const int *const keyYCoordinates, const int *const keyWidths, const int *keyHeights,
-            const int *const proximityCharsArray, const int cellHeight, const int cellWidth,
-            const int gridWidth, const int mostCommonKeyWidth, const int keyCount,
-            const int x, const int y, const int primaryKey, const std::vector<int> *locale,
+            const int *const proximityCharsArray, const CellKey *const cellKeys,
+            const int cellHeight, const int cellWidth, const int gridWidth, const int gridHeight,
+            const int mostCommonKeyWidth, const int keyCount, const int x, const int y,
+            const int primaryKey, const std::vector<int> *locale,
             const std::unordered_map<int, int> *const codeToKeyMap, int *proximities) {
         const int mostCommonKeyWidthSquare = mostCommonKeyWidth * mostCommonKeyWidth;
         int insertPos = 0;
@@ -156,18 +261,22 @@ class ProximityInfoUtils {
             return;
         }
         const int startIndex = getStartIndexFromCoordinates(x, y, cellHeight, cellWidth, gridWidth);
+        // The bounds of the cell keys are only valid for the points in the cell.
+        const bool isInGrid = x >= 0 && y >= 0 && x < gridWidth * cellWidth
+                && y < gridHeight * cellHeight;
         if (startIndex >= 0) {
             for (int i = 0; i < MAX_PROXIMITY_CHARS_SIZE; ++i) {
                 const int c = proximityCharsArray[startIndex + i];
                 if (c < KEYCODE_SPACE || c == primaryKey) {
                     continue;
                 }
-                const int keyIndex = getKeyIndexOf(keyCount, c, codeToKeyMap);
-                const bool onKey = isOnKey(keyXCoordinates, keyYCoordinates, keyWidths, keyHeights,
-                        keyIndex, x, y);
-                const int distance = squaredLengthToEdge(keyXCoordinates, keyYCoordinates,
-                        keyWidths, keyHeights, keyIndex, x, y);
-                if (onKey || distance < mostCommonKeyWidthSquare) {
+                const bool isNear = isInGrid
+                        ? isNearCellKey(keyXCoordinates, keyYCoordinates, keyWidths, keyHeights,
+                                mostCommonKeyWidthSquare, &cellKeys[startIndex + i], x, y)
+                        : isNearKey(keyXCoordinates, keyYCoordinates, keyWidths, keyHeights,
+                                mostCommonKeyWidthSquare, getKeyIndexOf(keyCount, c, codeToKeyMap),
+                                x, y);
+                if (isNear) {
                     proximities[insertPos++] = c;
                     if (insertPos >= MAX_PROXIMITY_CHARS_SIZE) {
                         if (DEBUG_DICT) {
@@ -44,7 +44,15 @@ class SuggestedWord {
             const int autoCommitFirstWordConfidence)
             : mCodePoints(codePoints, codePoints + codePointCount), mScore(score),
               mType(type), mIndexToPartialCommit(indexToPartialCommit),
-              mAutoCommitFirstWordConfidence(autoCommitFirstWordConfidence) {}
+              mAutoCommitFirstWordConfidence(autoCommitFirstWordConfidence),
+              mSourceDictionaryIndex(0) {}
+
+    SuggestedWord(const SuggestedWord &suggestedWord, const int score,
+            const int sourceDictionaryIndex)
+            : mCodePoints(suggestedWord.mCodePoints), mScore(score), mType(suggestedWord.mType),
+              mIndexToPartialCommit(suggestedWord.mIndexToPartialCommit),
+              mAutoCommitFirstWordConfidence(suggestedWord.mAutoCommitFirstWordConfidence),
+              mSourceDictionaryIndex(sourceDictionaryIndex) {}
 
     const int *getCodePoint() const {
         return &mCodePoints.at(0);
@@ -70,6 +78,11 @@ class SuggestedWord {
         return mAutoCommitFirstWordConfidence;
     }
 
+    // Index of the dictionary in a federated search; 0 for single dictionary searches.
+    int getSourceDictionaryIndex() const {
+        return mSourceDictionaryIndex;
+    }
+
  private:
     DISALLOW_DEFAULT_CONSTRUCTOR(SuggestedWord);
 
@@ -78,6 +91,7 @@ class SuggestedWord {
     int mType;
     int mIndexToPartialCommit;
     int mAutoCommitFirstWordConfidence;
+    int mSourceDictionaryIndex;
 };
 } // namespace latinime
 #endif /* LATINIME_SUGGESTED_WORD_H */
@@ -16,6 +16,11 @@
 
 #include "suggest/core/result/suggestion_results.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "suggest/core/session/suggestion_buffer.h"
 #include "utils/jni_data_utils.h"
 
 namespace latinime {
@@ -23,7 +28,8 @@ namespace latinime {
 void SuggestionResults::outputSuggestions(JNIEnv *env, jintArray outSuggestionCount,
         jintArray outputCodePointsArray, jintArray outScoresArray, jintArray outSpaceIndicesArray,
         jintArray outTypesArray, jintArray outAutoCommitFirstWordConfidenceArray,
-        jfloatArray outWeightOfLangModelVsSpatialModel) {
+        jfloatArray outWeightOfLangModelVsSpatialModel,
+        jintArray outSourceDictionaryIndicesArray) {
     int outputIndex = 0;
     while (!mSuggestedWords.empty()) {
         const SuggestedWord &suggestedWord = mSuggestedWords.top();
@@ -36,6 +42,10 @@ void SuggestionResults::outputSuggestions(JNIEnv *env, jintArray outSuggestionCo
         JniDataUtils::putIntToArray(env, outSpaceIndicesArray, outputIndex,
                 suggestedWord.getIndexToPartialCommit());
         JniDataUtils::putIntToArray(env, outTypesArray, outputIndex, suggestedWord.getType());
+        if (outSourceDictionaryIndicesArray) {
+            JniDataUtils::putIntToArray(env, outSourceDictionaryIndicesArray, outputIndex,
+                    suggestedWord.getSourceDictionaryIndex());
+        }
         if (mSuggestedWords.size() == 1) {
             JniDataUtils::putIntToArray(env, outAutoCommitFirstWordConfidenceArray, 0 /* index */,
                     suggestedWord.getAutoCommitFirstWordConfidence());
@@ -48,6 +58,31 @@ void SuggestionResults::outputSuggestions(JNIEnv *env, jintArray outSuggestionCo
             mWeightOfLangModelVsSpatialModel);
 }
 
+void SuggestionResults::outputSuggestions(const SuggestionBuffer *const suggestionBuffer) {
+    int *const outCodePoints = suggestionBuffer->getOutCodePoints();
+    int *const outScores = suggestionBuffer->getOutScores();
+    int *const outSpaceIndices = suggestionBuffer->getOutSpaceIndices();
+    int *const outTypes = suggestionBuffer->getOutTypes();
+    int outputIndex = 0;
+    while (!mSuggestedWords.empty()) {
+        const SuggestedWord &suggestedWord = mSuggestedWords.top();
+        JniDataUtils::outputCodePoints(outCodePoints + outputIndex * MAX_WORD_LENGTH,
+                MAX_WORD_LENGTH /* maxLength */, suggestedWord.getCodePoint(),
+                suggestedWord.getCodePointCount(), true /* needsNullTermination */);
+        outScores[outputIndex] = suggestedWord.getScore();
+        outSpaceIndices[outputIndex] = suggestedWord.getIndexToPartialCommit();
+        outTypes[outputIndex] = suggestedWord.getType();
+        if (mSuggestedWords.size() == 1) {
+            *suggestionBuffer->getOutAutoCommitFirstWordConfidence() =
+                    suggestedWord.getAutoCommitFirstWordConfidence();
+        }
+        ++outputIndex;
+        mSuggestedWords.pop();
+    }
+    *suggestionBuffer->getOutSuggestionCount() = outputIndex;
+    suggestionBuffer->setWeightOfLangModelVsSpatialModel(mWeightOfLangModelVsSpatialModel);
+}
+
 void SuggestionResults::addPrediction(const int *const codePoints, const int codePointCount,
         const int probability) {
     if (probability == NOT_A_PROBABILITY) {
@@ -67,17 +102,73 @@ void SuggestionResults::addSuggestion(const int *const codePoints, const int cod
                 codePointCount);
         return;
     }
+    addSuggestedWord(SuggestedWord(codePoints, codePointCount, score, type,
+            indexToPartialCommit, autocimmitFirstWordConfindence));
+}
+
+void SuggestionResults::addSuggestionsFrom(SuggestionResults *const suggestionResults,
+        const float scoreWeight, const int sourceDictionaryIndex) {
+    if (sourceDictionaryIndex == 0) {
+        // The weight of the primary dictionary is reported.
+        mWeightOfLangModelVsSpatialModel = suggestionResults->mWeightOfLangModelVsSpatialModel;
+    }
+    while (!suggestionResults->mSuggestedWords.empty()) {
+        const SuggestedWord &suggestedWord = suggestionResults->mSuggestedWords.top();
+        const int score = static_cast<int>(static_cast<float>(suggestedWord.getScore())
+                * scoreWeight);
+        addSuggestedWord(SuggestedWord(suggestedWord, score, sourceDictionaryIndex));
+        suggestionResults->mSuggestedWords.pop();
+    }
+}
+
+void SuggestionResults::addUniqueSuggestionsFrom(SuggestionResults *const suggestionResults) {
+    mWeightOfLangModelVsSpatialModel = suggestionResults->mWeightOfLangModelVsSpatialModel;
+    // Suggestions are popped from the worst one.
+    std::vector<SuggestedWord> suggestedWords;
+    suggestedWords.reserve(suggestionResults->getSuggestionCount());
+    while (!suggestionResults->mSuggestedWords.empty()) {
+        suggestedWords.push_back(suggestionResults->mSuggestedWords.top());
+        suggestionResults->mSuggestedWords.pop();
+    }
+    std::vector<const SuggestedWord *> addedWords;
+    for (auto it = suggestedWords.rbegin(); it != suggestedWords.rend(); ++it) {
+        if (getSuggestionCount() >= mMaxSuggestionCount) {
+            // The remaining suggestions are not better than the ones already added.
+            break;
+        }
+        const SuggestedWord &suggestedWord = *it;
+        bool isDuplicate = false;
+        for (const SuggestedWord *const addedWord : addedWords) {
+            if (addedWord->getCodePointCount() == suggestedWord.getCodePointCount()
+                    && std::equal(suggestedWord.getCodePoint(),
+                            suggestedWord.getCodePoint() + suggestedWord.getCodePointCount(),
+                            addedWord->getCodePoint())) {
+                isDuplicate = true;
+                break;
+            }
+        }
+        if (isDuplicate) {
+            continue;
+        }
+        addedWords.push_back(&suggestedWord);
+        addSuggestedWord(SuggestedWord(suggestedWord, suggestedWord.getScore(),
+                suggestedWord.getSourceDictionaryIndex()));
+    }
+}
+
+void SuggestionResults::addSuggestedWord(SuggestedWord &&suggestedWord) {
     if (getSuggestionCount() >= mMaxSuggestionCount) {
         const SuggestedWord &mWorstSuggestion = mSuggestedWords.top();
-        if (score > mWorstSuggestion.getScore() || (score == mWorstSuggestion.getScore()
-                && codePointCount < mWorstSuggestion.getCodePointCount())) {
+        if (suggestedWord.getScore() > mWorstSuggestion.getScore()
+                || (suggestedWord.getScore() == mWorstSuggestion.getScore()
+                        && suggestedWord.getCodePointCount()
+                                < mWorstSuggestion.getCodePointCount())) {
             mSuggestedWords.pop();
         } else {
             return;
         }
     }
-    mSuggestedWords.push(SuggestedWord(codePoints, codePointCount, score, type,
-            indexToPartialCommit, autocimmitFirstWordConfindence));
+    mSuggestedWords.push(std::move(suggestedWord));
 }
 
 void SuggestionResults::getSortedScores(int *const outScores) const {
@@ -26,6 +26,8 @@
 
 namespace latinime {
 
+class SuggestionBuffer;
+
 class SuggestionResults {
  public:
     explicit SuggestionResults(const int maxSuggestionCount)
@@ -37,11 +39,22 @@ class SuggestionResults {
     void outputSuggestions(JNIEnv *env, jintArray outSuggestionCount, jintArray outCodePointsArray,
             jintArray outScoresArray, jintArray outSpaceIndicesArray, jintArray outTypesArray,
             jintArray outAutoCommitFirstWordConfidenceArray,
-            jfloatArray outWeightOfLangModelVsSpatialModel);
+            jfloatArray outWeightOfLangModelVsSpatialModel,
+            jintArray outSourceDictionaryIndicesArray);
+    // Outputs into the output sections of a buffer shared with Java.
+    void outputSuggestions(const SuggestionBuffer *const suggestionBuffer);
     void addPrediction(const int *const codePoints, const int codePointCount, const int score);
     void addSuggestion(const int *const codePoints, const int codePointCount,
             const int score, const int type, const int indexToPartialCommit,
             const int autocimmitFirstWordConfindence);
+    // Moves all suggestions of the given results into this one, multiplying their scores by
+    // scoreWeight and marking them with sourceDictionaryIndex.
+    void addSuggestionsFrom(SuggestionResults *const suggestionResults, const float scoreWeight,
+            const int sourceDictionaryIndex);
+    // Moves all suggestions of the given results into this one, from the best one, keeping only
+    // the best of the suggestions with the same code points. The weight of the language model is
+    // taken over as well.
+    void addUniqueSuggestionsFrom(SuggestionResults *const suggestionResults);
     void getSortedScores(int *const outScores) const;
     void dumpSuggestions() const;
 
@@ -49,6 +62,10 @@ class SuggestionResults {
         mWeightOfLangModelVsSpatialModel = weightOfLangModelVsSpatialModel;
     }
 
+    float getWeightOfLangModelVsSpatialModel() const {
+        return mWeightOfLangModelVsSpatialModel;
+    }
+
     int getSuggestionCount() const {
         return mSuggestedWords.size();
     }
@@ -56,6 +73,8 @@ class SuggestionResults {
  private:
     DISALLOW_IMPLICIT_CONSTRUCTORS(SuggestionResults);
 
+    void addSuggestedWord(SuggestedWord &&suggestedWord);
+
     const int mMaxSuggestionCount;
     float mWeightOfLangModelVsSpatialModel;
     std::priority_queue<
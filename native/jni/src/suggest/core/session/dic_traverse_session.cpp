@@ -21,6 +21,7 @@
 #include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
 #include "dictionary/property/ngram_context.h"
 #include "suggest/core/dictionary/dictionary.h"
+#include "utils/memory_report.h"
 
 namespace latinime {
 
@@ -29,6 +30,16 @@ namespace latinime {
 const int DicTraverseSession::DICTIONARY_SIZE_THRESHOLD_TO_USE_LARGE_CACHE_FOR_SUGGESTION =
         256 * 1024;
 
+void DicTraverseSession::getMemoryReport(MemoryReport *const outMemoryReport) const {
+    // The proximity info states and the queues are members.
+    outMemoryReport->addComponent("session",
+            MemoryUsage::heap(sizeof(DicTraverseSession), 0 /* wastedSize */));
+    outMemoryReport->addComponent("dic_nodes_cache", mDicNodesCache.getMemoryUsage());
+    outMemoryReport->addComponent("multi_bigram_map", mMultiBigramMap.getMemoryUsage());
+    // mProximityInfo is not reported: it is owned by Java and may have been freed since the last
+    // search.
+}
+
 void DicTraverseSession::init(const Dictionary *const dictionary,
         const NgramContext *const ngramContext, const SuggestOptions *const suggestOptions) {
     mDictionary = dictionary;
@@ -45,15 +56,72 @@ void DicTraverseSession::setupForGetSuggestions(const ProximityInfo *pInfo,
         const float maxSpatialDistance, const int maxPointerCount) {
     mProximityInfo = pInfo;
     mMaxPointerCount = maxPointerCount;
+    mExpandedDicNodeCount = 0;
+    if (mSharedInputSession) {
+        if (mSharedInputSession->mInputGeneration != mLastSharedInputGeneration + 1) {
+            // The cached dic nodes were not created for the previous input of the shared states.
+            resetCache(0 /* thresholdForNextActiveDicNodes */, 0 /* maxWords */);
+        }
+        mLastSharedInputGeneration = mSharedInputSession->mInputGeneration;
+        mInputSize = mSharedInputSession->mInputSize;
+        return;
+    }
     initializeProximityInfoStates(inputCodePoints, inputXs, inputYs, times, pointerIds, inputSize,
             maxSpatialDistance, maxPointerCount);
 }
 
+void DicTraverseSession::setSharedInputSession(const DicTraverseSession *const inputSession) {
+    const DicTraverseSession *const sharedInputSession =
+            (inputSession == this) ? nullptr : inputSession;
+    if (sharedInputSession == mSharedInputSession) {
+        return;
+    }
+    mSharedInputSession = sharedInputSession;
+    mProximityInfoStatesInUse = sharedInputSession ?
+            sharedInputSession->mProximityInfoStates : mProximityInfoStates;
+    mLastSharedInputGeneration = sharedInputSession ? sharedInputSession->mInputGeneration : 0;
+    // The cached dic nodes were created for other input states.
+    resetCache(0 /* thresholdForNextActiveDicNodes */, 0 /* maxWords */);
+}
+
 const DictionaryStructureWithBufferPolicy *DicTraverseSession::getDictionaryStructurePolicy()
         const {
     return mDictionary->getDictionaryStructurePolicy();
 }
 
+bool DicTraverseSession::prefetchPredictions(const Dictionary *const dictionary,
+        const int ngramContextId) {
+    const NgramContext *const ngramContext = getCachedNgramContext(ngramContextId);
+    if (!ngramContext) {
+        return false;
+    }
+    // Read before computing so that a concurrent modification invalidates the results.
+    const int contentVersion = dictionary->getContentVersion();
+    mPrefetchedPredictions.reset(new SuggestionResults(MAX_RESULTS));
+    dictionary->getPredictions(ngramContext, mPrefetchedPredictions.get());
+    mPrefetchedPredictionsContentVersion = contentVersion;
+    mPrefetchedPredictionsNgramContextId = ngramContextId;
+    return true;
+}
+
+bool DicTraverseSession::consumePrefetchedPredictions(const Dictionary *const dictionary,
+        const int ngramContextId, SuggestionResults *const outSuggestionResults) {
+    if (!mPrefetchedPredictions) {
+        return false;
+    }
+    const bool isValid = dictionary->getContentVersion() == mPrefetchedPredictionsContentVersion
+            && ngramContextId == mPrefetchedPredictionsNgramContextId;
+    if (isValid) {
+        outSuggestionResults->addSuggestionsFrom(mPrefetchedPredictions.get(),
+                1.0f /* scoreWeight */, 0 /* sourceDictionaryIndex */);
+    }
+    // Stale predictions are dropped as well.
+    mPrefetchedPredictions.reset();
+    mPrefetchedPredictionsContentVersion = NOT_A_CONTENT_VERSION;
+    mPrefetchedPredictionsNgramContextId = NOT_AN_INDEX;
+    return isValid;
+}
+
 void DicTraverseSession::resetCache(const int thresholdForNextActiveDicNodes, const int maxWords) {
     mDicNodesCache.reset(thresholdForNextActiveDicNodes /* nextActiveSize */,
             maxWords /* terminalSize */);
@@ -65,8 +133,15 @@ void DicTraverseSession::initializeProximityInfoStates(const int *const inputCod
         const int *const pointerIds, const int inputSize, const float maxSpatialDistance,
         const int maxPointerCount) {
     ASSERT(1 <= maxPointerCount && maxPointerCount <= MAX_POINTER_COUNT_G);
+    ++mInputGeneration;
     mInputSize = 0;
+    const bool isGeometric = maxPointerCount == MAX_POINTER_COUNT_G;
     for (int i = 0; i < maxPointerCount; ++i) {
+        if (isGeometric && appendTouchPointsToSavedInput(i, inputXs, inputYs, times, pointerIds,
+                inputSize)) {
+            mInputSize += mProximityInfoStates[i].size();
+            continue;
+        }
         mProximityInfoStates[i].initInputParams(i, maxSpatialDistance, getProximityInfo(),
                 inputCodePoints, inputSize, inputXs, inputYs, times, pointerIds,
                 // Right now the line below is trying to figure out whether this is a gesture by
@@ -78,4 +153,25 @@ void DicTraverseSession::initializeProximityInfoStates(const int *const inputCod
         mInputSize += mProximityInfoStates[i].size();
     }
 }
+
+// Feeds only the new touch points to the proximity info state when the gesture input it has seen
+// is a prefix of the given input and all the new points belong to the pointer of the state.
+bool DicTraverseSession::appendTouchPointsToSavedInput(const int pointerId,
+        const int *const inputXs, const int *const inputYs, const int *const times,
+        const int *const pointerIds, const int inputSize) {
+    ProximityInfoState *const proximityInfoState = &mProximityInfoStates[pointerId];
+    if (!proximityInfoState->isSavedInputPrefixOf(getProximityInfo(), inputSize, inputXs, inputYs,
+            times)) {
+        return false;
+    }
+    const int savedInputSize = proximityInfoState->getSavedInputSize();
+    for (int i = savedInputSize; i < inputSize; ++i) {
+        if ((pointerIds ? pointerIds[i] : 0) != pointerId) {
+            return false;
+        }
+    }
+    return proximityInfoState->appendTouchPoints(pointerId, inputXs + savedInputSize,
+            inputYs + savedInputSize, times ? times + savedInputSize : nullptr,
+            inputSize - savedInputSize);
+}
 } // namespace latinime
@@ -17,20 +17,24 @@
 #ifndef LATINIME_DIC_TRAVERSE_SESSION_H
 #define LATINIME_DIC_TRAVERSE_SESSION_H
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "defines.h"
+#include "dictionary/property/ngram_context.h"
 #include "dictionary/utils/multi_bigram_map.h"
 #include "jni.h"
 #include "suggest/core/dicnode/dic_nodes_cache.h"
 #include "suggest/core/layout/proximity_info_state.h"
+#include "suggest/core/result/suggestion_results.h"
 #include "utils/int_array_view.h"
 
 namespace latinime {
 
 class Dictionary;
 class DictionaryStructureWithBufferPolicy;
-class NgramContext;
+class MemoryReport;
 class ProximityInfo;
 class SuggestOptions;
 
@@ -46,14 +50,29 @@ class DicTraverseSession {
                 dictSize >= DICTIONARY_SIZE_THRESHOLD_TO_USE_LARGE_CACHE_FOR_SUGGESTION);
     }
 
+    // A factory method for use without a Java VM.
+    static AK_FORCE_INLINE DicTraverseSession *getSessionInstance(const int64_t dictSize) {
+        return new DicTraverseSession(
+                dictSize >= DICTIONARY_SIZE_THRESHOLD_TO_USE_LARGE_CACHE_FOR_SUGGESTION);
+    }
+
     static AK_FORCE_INLINE void releaseSessionInstance(DicTraverseSession *traverseSession) {
         delete traverseSession;
     }
 
     AK_FORCE_INLINE DicTraverseSession(JNIEnv *env, jstring localeStr, bool usesLargeCache)
+            : DicTraverseSession(usesLargeCache) {}
+
+    AK_FORCE_INLINE explicit DicTraverseSession(const bool usesLargeCache)
             : mPrevWordIdCount(0), mProximityInfo(nullptr), mDictionary(nullptr),
               mSuggestOptions(nullptr), mDicNodesCache(usesLargeCache), mMultiBigramMap(),
-              mInputSize(0), mMaxPointerCount(1), mMultiWordCostMultiplier(1.0f) {
+              mProximityInfoStatesInUse(mProximityInfoStates), mSharedInputSession(nullptr),
+              mInputGeneration(0), mLastSharedInputGeneration(0), mInputSize(0),
+              mExpandedDicNodeCount(0),
+              mMaxPointerCount(1), mMultiWordCostMultiplier(1.0f),
+              mCachedNgramContextId(NOT_AN_INDEX), mCachedNgramContext(),
+              mPrefetchedPredictionsContentVersion(NOT_A_CONTENT_VERSION),
+              mPrefetchedPredictionsNgramContextId(NOT_AN_INDEX), mPrefetchedPredictions() {
         // NOTE: mProximityInfoStates is an array of instances.
         // No need to initialize it explicitly here.
     }
@@ -61,6 +80,10 @@ class DicTraverseSession {
     // Non virtual inline destructor -- never inherit this class
     AK_FORCE_INLINE ~DicTraverseSession() {}
 
+    // Adds the memory used by the session to outMemoryReport. The dictionary and the layout are
+    // not included; their owners report them.
+    void getMemoryReport(MemoryReport *const outMemoryReport) const;
+
     void init(const Dictionary *dictionary, const NgramContext *const ngramContext,
             const SuggestOptions *const suggestOptions);
     // TODO: Remove and merge into init
@@ -69,6 +92,30 @@ class DicTraverseSession {
             const int *const times, const int *const pointerIds, const float maxSpatialDistance,
             const int maxPointerCount);
     void resetCache(const int thresholdForNextActiveDicNodes, const int maxWords);
+    // Makes the following searches read the input states of inputSession instead of computing
+    // their own. inputSession has to be set up for the same input before each search. Passing
+    // nullptr restores the session's own input states.
+    void setSharedInputSession(const DicTraverseSession *const inputSession);
+
+    // Keeps a copy of the n-gram context so that later calls can refer to it by its id instead of
+    // passing the previous words again.
+    void cacheNgramContext(const int ngramContextId, const NgramContext *const ngramContext) {
+        mCachedNgramContextId = ngramContextId;
+        mCachedNgramContext.reset(new NgramContext(*ngramContext));
+    }
+
+    // Returns nullptr when the context of the id is not cached.
+    const NgramContext *getCachedNgramContext(const int ngramContextId) const {
+        return (ngramContextId == mCachedNgramContextId) ? mCachedNgramContext.get() : nullptr;
+    }
+
+    // Computes the predictions for the cached n-gram context ahead of the request for them.
+    bool prefetchPredictions(const Dictionary *const dictionary, const int ngramContextId);
+    // Moves the prefetched predictions into outSuggestionResults when they were computed for the
+    // same context and the dictionary has not changed since, according to its content version.
+    // Prefetched predictions are used only once.
+    bool consumePrefetchedPredictions(const Dictionary *const dictionary,
+            const int ngramContextId, SuggestionResults *const outSuggestionResults);
 
     const DictionaryStructureWithBufferPolicy *getDictionaryStructurePolicy() const;
 
@@ -83,16 +130,19 @@ class DicTraverseSession {
     DicNodesCache *getDicTraverseCache() { return &mDicNodesCache; }
     MultiBigramMap *getMultiBigramMap() { return &mMultiBigramMap; }
     const ProximityInfoState *getProximityInfoState(int id) const {
-        return &mProximityInfoStates[id];
+        return &mProximityInfoStatesInUse[id];
     }
     int getInputSize() const { return mInputSize; }
+    // The number of dic nodes expanded by the last search.
+    int getExpandedDicNodeCount() const { return mExpandedDicNodeCount; }
+    void incrementExpandedDicNodeCount() { ++mExpandedDicNodeCount; }
 
     bool isOnlyOnePointerUsed(int *pointerId) const {
         // Not in the dictionary word
         int usedPointerCount = 0;
         int usedPointerId = 0;
         for (int i = 0; i < mMaxPointerCount; ++i) {
-            if (mProximityInfoStates[i].isUsed()) {
+            if (mProximityInfoStatesInUse[i].isUsed()) {
                 ++usedPointerCount;
                 usedPointerId = i;
             }
@@ -109,11 +159,12 @@ class DicTraverseSession {
     ProximityType getProximityTypeG(const DicNode *const dicNode, const int childCodePoint) const {
         ProximityType proximityType = UNRELATED_CHAR;
         for (int i = 0; i < MAX_POINTER_COUNT_G; ++i) {
-            if (!mProximityInfoStates[i].isUsed()) {
+            if (!mProximityInfoStatesInUse[i].isUsed()) {
                 continue;
             }
             const int pointerId = dicNode->getInputIndex(i);
-            proximityType = mProximityInfoStates[i].getProximityTypeG(pointerId, childCodePoint);
+            proximityType = mProximityInfoStatesInUse[i].getProximityTypeG(pointerId,
+                    childCodePoint);
             ASSERT(proximityType == UNRELATED_CHAR || proximityType == MATCH_CHAR);
             // TODO: Make this more generic
             // Currently we assume there are only two types here -- UNRELATED_CHAR
@@ -150,7 +201,7 @@ class DicTraverseSession {
     }
 
     bool isTouchPositionCorrectionEnabled() const {
-        return mProximityInfoStates[0].touchPositionCorrectionEnabled();
+        return mProximityInfoStatesInUse[0].touchPositionCorrectionEnabled();
     }
 
     float getMultiWordCostMultiplier() const {
@@ -165,6 +216,9 @@ class DicTraverseSession {
     void initializeProximityInfoStates(const int *const inputCodePoints, const int *const inputXs,
             const int *const inputYs, const int *const times, const int *const pointerIds,
             const int inputSize, const float maxSpatialDistance, const int maxPointerCount);
+    bool appendTouchPointsToSavedInput(const int pointerId, const int *const inputXs,
+            const int *const inputYs, const int *const times, const int *const pointerIds,
+            const int inputSize);
 
     WordIdArray<MAX_PREV_WORD_COUNT_FOR_N_GRAM> mPrevWordIdArray;
     size_t mPrevWordIdCount;
@@ -176,14 +230,28 @@ class DicTraverseSession {
     // Temporary cache for bigram frequencies
     MultiBigramMap mMultiBigramMap;
     ProximityInfoState mProximityInfoStates[MAX_POINTER_COUNT_G];
+    // Points to mProximityInfoStates or to the states of mSharedInputSession.
+    const ProximityInfoState *mProximityInfoStatesInUse;
+    const DicTraverseSession *mSharedInputSession;
+    // Incremented every time the input states are computed; lets sessions sharing the states
+    // detect that they missed an input and cannot continue their previous search.
+    int mInputGeneration;
+    int mLastSharedInputGeneration;
 
     int mInputSize;
+    int mExpandedDicNodeCount;
     int mMaxPointerCount;
 
     /////////////////////////////////
     // Configuration per dictionary
     float mMultiWordCostMultiplier;
 
+    int mCachedNgramContextId;
+    std::unique_ptr<NgramContext> mCachedNgramContext;
+    int mPrefetchedPredictionsContentVersion;
+    int mPrefetchedPredictionsNgramContextId;
+    std::unique_ptr<SuggestionResults> mPrefetchedPredictions;
+
 };
 } // namespace latinime
 #endif // LATINIME_DIC_TRAVERSE_SESSION_H
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/session/suggestion_buffer.h"
+
+#include <cstring>
+
+namespace latinime {
+
+const int SuggestionBuffer::CURRENT_LAYOUT_VERSION = 1;
+const int SuggestionBuffer::MAX_OPTION_COUNT = 32;
+
+/* static */ size_t SuggestionBuffer::getRequiredBufferSize(const int inputCapacity) {
+    const size_t fieldCount = HEADER_FIELD_COUNT + 4 * inputCapacity + MAX_WORD_LENGTH
+            + MAX_OPTION_COUNT + MAX_RESULTS * MAX_WORD_LENGTH + 3 * MAX_RESULTS;
+    return fieldCount * sizeof(int32_t);
+}
+
+bool SuggestionBuffer::isValid() const {
+    if (!mBuffer || mBufferSize < HEADER_FIELD_COUNT * sizeof(int32_t)) {
+        AKLOGE("Suggestion buffer is too small: %zd", mBufferSize);
+        return false;
+    }
+    if (mBuffer[LAYOUT_VERSION] != CURRENT_LAYOUT_VERSION) {
+        AKLOGE("Unsupported suggestion buffer layout version: %d", mBuffer[LAYOUT_VERSION]);
+        return false;
+    }
+    const int inputCapacity = getInputCapacity();
+    if (inputCapacity < 0 || mBufferSize < getRequiredBufferSize(inputCapacity)) {
+        AKLOGE("Invalid input capacity: %d, buffer size: %zd", inputCapacity, mBufferSize);
+        return false;
+    }
+    if (getInputSize() < 0 || getInputSize() > inputCapacity) {
+        AKLOGE("Invalid input size: %d", getInputSize());
+        return false;
+    }
+    if (getOptionCount() < 0 || getOptionCount() > MAX_OPTION_COUNT) {
+        AKLOGE("Invalid option count: %d", getOptionCount());
+        return false;
+    }
+    return true;
+}
+
+float SuggestionBuffer::getWeightOfLangModelVsSpatialModel() const {
+    float weight;
+    memcpy(&weight, &mBuffer[WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL], sizeof(weight));
+    return weight;
+}
+
+void SuggestionBuffer::setWeightOfLangModelVsSpatialModel(const float weight) const {
+    memcpy(&mBuffer[WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL], &weight, sizeof(weight));
+}
+
+} // namespace latinime
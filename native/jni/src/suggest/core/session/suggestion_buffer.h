@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_SUGGESTION_BUFFER_H
+#define LATINIME_SUGGESTION_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "defines.h"
+
+namespace latinime {
+
+/*
+ * View of a block of memory shared with Java that carries the input and the output of one
+ * getSuggestions call. All fields are 32-bit values in native byte order.
+ *
+ * Layout (version 1):
+ *   header      : HEADER_FIELD_COUNT ints, see HeaderField
+ *   xs, ys, times, pointerIds : inputCapacity ints each
+ *   inputCodePoints           : MAX_WORD_LENGTH ints
+ *   options                   : MAX_OPTION_COUNT ints
+ *   outCodePoints             : MAX_RESULTS * MAX_WORD_LENGTH ints
+ *   outScores, outSpaceIndices, outTypes : MAX_RESULTS ints each
+ *
+ * com.android.inputmethod.latin.DicTraverseSession has to be updated when this layout changes.
+ */
+class SuggestionBuffer {
+ public:
+    enum HeaderField {
+        LAYOUT_VERSION = 0,
+        INPUT_CAPACITY = 1,
+        INPUT_SIZE = 2,
+        OPTION_COUNT = 3,
+        NGRAM_CONTEXT_ID = 4,
+        // Float bits. Input and output.
+        WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL = 5,
+        OUT_SUGGESTION_COUNT = 6,
+        OUT_AUTO_COMMIT_FIRST_WORD_CONFIDENCE = 7,
+        HEADER_FIELD_COUNT = 8,
+    };
+
+    static const int CURRENT_LAYOUT_VERSION;
+    static const int MAX_OPTION_COUNT;
+
+    // Returns the size in bytes of a buffer that can hold inputCapacity touch points.
+    static size_t getRequiredBufferSize(const int inputCapacity);
+
+    SuggestionBuffer(int32_t *const buffer, const size_t bufferSize)
+            : mBuffer(buffer), mBufferSize(bufferSize) {}
+
+    // Checks the version and that every section and count fits in the buffer.
+    bool isValid() const;
+
+    int getInputSize() const { return mBuffer[INPUT_SIZE]; }
+    int getOptionCount() const { return mBuffer[OPTION_COUNT]; }
+    int getNgramContextId() const { return mBuffer[NGRAM_CONTEXT_ID]; }
+    float getWeightOfLangModelVsSpatialModel() const;
+
+    int *getXCoordinates() const { return mBuffer + HEADER_FIELD_COUNT; }
+    int *getYCoordinates() const { return getXCoordinates() + getInputCapacity(); }
+    int *getTimes() const { return getYCoordinates() + getInputCapacity(); }
+    int *getPointerIds() const { return getTimes() + getInputCapacity(); }
+    int *getInputCodePoints() const { return getPointerIds() + getInputCapacity(); }
+    int *getOptions() const { return getInputCodePoints() + MAX_WORD_LENGTH; }
+    int *getOutCodePoints() const { return getOptions() + MAX_OPTION_COUNT; }
+    int *getOutScores() const { return getOutCodePoints() + MAX_RESULTS * MAX_WORD_LENGTH; }
+    int *getOutSpaceIndices() const { return getOutScores() + MAX_RESULTS; }
+    int *getOutTypes() const { return getOutSpaceIndices() + MAX_RESULTS; }
+
+    int *getOutSuggestionCount() const { return &mBuffer[OUT_SUGGESTION_COUNT]; }
+    int *getOutAutoCommitFirstWordConfidence() const {
+        return &mBuffer[OUT_AUTO_COMMIT_FIRST_WORD_CONFIDENCE];
+    }
+    void setWeightOfLangModelVsSpatialModel(const float weight) const;
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(SuggestionBuffer);
+
+    int getInputCapacity() const { return mBuffer[INPUT_CAPACITY]; }
+
+    int32_t *const mBuffer;
+    const size_t mBufferSize;
+};
+} // namespace latinime
+#endif // LATINIME_SUGGESTION_BUFFER_H
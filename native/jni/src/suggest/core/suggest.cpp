@@ -30,6 +30,7 @@
 #include "suggest/core/session/dic_traverse_session.h"
 #include "suggest/core/suggest_options.h"
 #include "utils/profiler.h"
+#include "utils/trace_counters.h"
 
 namespace latinime {
 
@@ -51,6 +52,8 @@ void Suggest::getSuggestions(ProximityInfo *pInfo, void *traverseSession,
         SuggestionResults *const outSuggestionResults) const {
     PROF_INIT;
     PROF_TIMER_START(0);
+    TraceCounters::increment(TraceCounters::SUGGESTION_CALLS);
+    TraceCounters::ScopedTimer setupTimer(TraceCounters::SUGGESTION_SETUP_TIME);
     const float maxSpatialDistance = TRAVERSAL->getMaxSpatialDistance();
     DicTraverseSession *tSession = static_cast<DicTraverseSession *>(traverseSession);
     tSession->setupForGetSuggestions(pInfo, inputCodePoints, inputSize, inputXs, inputYs, times,
@@ -58,17 +61,20 @@ void Suggest::getSuggestions(ProximityInfo *pInfo, void *traverseSession,
     // TODO: Add the way to evaluate cache
 
     initializeSearch(tSession);
+    setupTimer.stop();
     PROF_TIMER_END(0);
     PROF_TIMER_START(1);
 
     // keep expanding search dicNodes until all have terminated.
     while (tSession->getDicTraverseCache()->activeSize() > 0) {
+        TraceCounters::ScopedTimer stepTimer(TraceCounters::SUGGESTION_EXPANSION_STEP_TIME);
         expandCurrentDicNodes(tSession);
         tSession->getDicTraverseCache()->advanceActiveDicNodes();
         tSession->getDicTraverseCache()->advanceInputIndex(inputSize);
     }
     PROF_TIMER_END(1);
     PROF_TIMER_START(2);
+    TraceCounters::ScopedTimer outputTimer(TraceCounters::SUGGESTION_OUTPUT_TIME);
     SuggestionsOutputUtils::outputSuggestions(
             SCORING, tSession, weightOfLangModelVsSpatialModel, outSuggestionResults);
     PROF_TIMER_END(2);
@@ -124,6 +130,8 @@ void Suggest::expandCurrentDicNodes(DicTraverseSession *traverseSession) const {
         if (dicNode.isTotalInputSizeExceedingLimit()) {
             return;
         }
+        traverseSession->incrementExpandedDicNodeCount();
+        TraceCounters::increment(TraceCounters::EXPANDED_DIC_NODES);
         childDicNodes.clear();
         const int point0Index = dicNode.getInputIndex(0);
         const bool canDoLookAheadCorrection =
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_GESTURE_SCORING_H
+#define LATINIME_GESTURE_SCORING_H
+
+#include "defines.h"
+#include "suggest/core/dictionary/error_type_utils.h"
+#include "suggest/core/policy/scoring.h"
+#include "suggest/policyimpl/gesture/gesture_scoring_params.h"
+
+namespace latinime {
+
+class DicNode;
+class DicTraverseSession;
+
+class GestureScoring : public Scoring {
+ public:
+    static const GestureScoring *getInstance() { return &sInstance; }
+
+    AK_FORCE_INLINE void getMostProbableString(const DicTraverseSession *const traverseSession,
+            const float weightOfLangModelVsSpatialModel,
+            SuggestionResults *const outSuggestionResults) const {}
+
+    AK_FORCE_INLINE float getAdjustedWeightOfLangModelVsSpatialModel(
+            DicTraverseSession *const traverseSession, DicNode *const terminals,
+            const int size) const {
+        return 1.0f;
+    }
+
+    // Gestures never produce exact matches, so there is nothing to boost.
+    AK_FORCE_INLINE int calculateFinalScore(const float compoundDistance, const int inputSize,
+            const ErrorTypeUtils::ErrorType containedErrorTypes, const bool forceCommit,
+            const bool boostExactMatches, const bool hasProbabilityZero) const {
+        const float maxDistance = GestureScoringParams::DISTANCE_WEIGHT_LANGUAGE
+                + static_cast<float>(inputSize)
+                        * GestureScoringParams::GESTURE_MAX_OUTPUT_SCORE_PER_INPUT;
+        float score = GestureScoringParams::GESTURE_BASE_OUTPUT_SCORE
+                - compoundDistance / maxDistance;
+        if (forceCommit) {
+            score += GestureScoringParams::AUTOCORRECT_OUTPUT_THRESHOLD;
+        }
+        return static_cast<int>(score * SUGGEST_INTERFACE_OUTPUT_SCALE);
+    }
+
+    AK_FORCE_INLINE float getDoubleLetterDemotionDistanceCost(
+            const DicNode *const terminalDicNode) const {
+        return 0.0f;
+    }
+
+    AK_FORCE_INLINE bool autoCorrectsToMultiWordSuggestionIfTop() const {
+        return false;
+    }
+
+    AK_FORCE_INLINE bool sameAsTyped(const DicTraverseSession *const traverseSession,
+            const DicNode *const dicNode) const {
+        return false;
+    }
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(GestureScoring);
+    static const GestureScoring sInstance;
+
+    GestureScoring() {}
+    ~GestureScoring() {}
+};
+} // namespace latinime
+#endif // LATINIME_GESTURE_SCORING_H
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/gesture/gesture_scoring_params.h"
+
+namespace latinime {
+const float GestureScoringParams::MAX_SPATIAL_DISTANCE = 1.0f;
+const int GestureScoringParams::THRESHOLD_NEXT_WORD_PROBABILITY = 40;
+const float GestureScoringParams::AUTOCORRECT_OUTPUT_THRESHOLD = 1.0f;
+const int GestureScoringParams::MAX_CACHE_DIC_NODE_SIZE = 120;
+const int GestureScoringParams::MAX_CACHE_DIC_NODE_SIZE_FOR_LOW_PROBABILITY_LOCALE = 40;
+const float GestureScoringParams::LOCALE_WEIGHT_THRESHOLD_FOR_SMALL_CACHE_SIZE = 0.99f;
+const float GestureScoringParams::LOCALE_WEIGHT_THRESHOLD_FOR_SPACE_OMISSION = 0.99f;
+
+const float GestureScoringParams::DISTANCE_WEIGHT_LANGUAGE = 2.0f;
+const float GestureScoringParams::INTENTIONAL_OMISSION_COST = 0.1f;
+const float GestureScoringParams::DOUBLE_LETTER_COST = 0.3f;
+const float GestureScoringParams::SPACE_OMISSION_COST = 0.5f;
+const float GestureScoringParams::COST_FIRST_COMPLETION = 1.0f;
+const float GestureScoringParams::COST_COMPLETION = 0.1f;
+const float GestureScoringParams::HAS_MULTI_WORD_TERMINAL_COST = 0.5f;
+const float GestureScoringParams::GESTURE_BASE_OUTPUT_SCORE = 1.0f;
+const float GestureScoringParams::GESTURE_MAX_OUTPUT_SCORE_PER_INPUT = 1.0f;
+} // namespace latinime
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_GESTURE_TRAVERSAL_H
+#define LATINIME_GESTURE_TRAVERSAL_H
+
+#include <cstdint>
+
+#include "defines.h"
+#include "suggest/core/dicnode/dic_node.h"
+#include "suggest/core/dicnode/dic_node_vector.h"
+#include "suggest/core/layout/proximity_info_state.h"
+#include "suggest/core/layout/proximity_info_utils.h"
+#include "suggest/core/policy/traversal.h"
+#include "suggest/core/session/dic_traverse_session.h"
+#include "suggest/core/suggest_options.h"
+#include "suggest/policyimpl/gesture/gesture_scoring_params.h"
+
+namespace latinime {
+
+// Traversal for gesture input. A dictionary letter is expanded only when its key is near the
+// sampled points that follow the current input index, and the search keeps a fixed size beam
+// instead of doing typing error corrections.
+class GestureTraversal : public Traversal {
+ public:
+    static const GestureTraversal *getInstance() { return &sInstance; }
+
+    AK_FORCE_INLINE int getMaxPointerCount() const {
+        return MAX_POINTER_COUNT_G;
+    }
+
+    AK_FORCE_INLINE bool allowsErrorCorrections(const DicNode *const dicNode) const {
+        return false;
+    }
+
+    AK_FORCE_INLINE bool isOmission(const DicTraverseSession *const traverseSession,
+            const DicNode *const dicNode, const DicNode *const childDicNode,
+            const bool allowsErrorCorrections) const {
+        // Only letters that are not on the keyboard, like apostrophes, can be omitted.
+        if (!childDicNode->canBeIntentionalOmission()) {
+            return false;
+        }
+        return !dicNode->isCompletion(traverseSession->getInputSize());
+    }
+
+    AK_FORCE_INLINE bool isSpaceSubstitutionTerminal(
+            const DicTraverseSession *const traverseSession, const DicNode *const dicNode) const {
+        return false;
+    }
+
+    AK_FORCE_INLINE bool isSpaceOmissionTerminal(
+            const DicTraverseSession *const traverseSession, const DicNode *const dicNode) const {
+        if (!traverseSession->getSuggestOptions()->enableSpaceAwareGesture()) {
+            return false;
+        }
+        if (traverseSession->getSuggestOptions()->weightForLocale()
+                < GestureScoringParams::LOCALE_WEIGHT_THRESHOLD_FOR_SPACE_OMISSION) {
+            return false;
+        }
+        if (dicNode->isCompletion(traverseSession->getInputSize())) {
+            return false;
+        }
+        return dicNode->isTerminalDicNode() && !dicNode->isTotalInputSizeExceedingLimit()
+                && !dicNode->shouldBeFilteredBySafetyNetForBigram();
+    }
+
+    AK_FORCE_INLINE bool shouldDepthLevelCache(
+            const DicTraverseSession *const traverseSession) const {
+        return false;
+    }
+
+    AK_FORCE_INLINE bool shouldNodeLevelCache(
+            const DicTraverseSession *const traverseSession, const DicNode *const dicNode) const {
+        return false;
+    }
+
+    AK_FORCE_INLINE bool canDoLookAheadCorrection(
+            const DicTraverseSession *const traverseSession, const DicNode *const dicNode) const {
+        return false;
+    }
+
+    AK_FORCE_INLINE ProximityType getProximityType(
+            const DicTraverseSession *const traverseSession, const DicNode *const dicNode,
+            const DicNode *const childDicNode) const {
+        const ProximityInfoState *const pInfoState = traverseSession->getProximityInfoState(0);
+        const int pointIndex = dicNode->getInputIndex(0);
+        if (pointIndex >= pInfoState->size()) {
+            return UNRELATED_CHAR;
+        }
+        return pInfoState->getProximityTypeG(pointIndex, childDicNode->getNodeCodePoint());
+    }
+
+    AK_FORCE_INLINE bool needsToTraverseAllUserInput() const {
+        return true;
+    }
+
+    AK_FORCE_INLINE float getMaxSpatialDistance() const {
+        return GestureScoringParams::MAX_SPATIAL_DISTANCE;
+    }
+
+    AK_FORCE_INLINE int getDefaultExpandDicNodeSize() const {
+        return DicNodeVector::DEFAULT_NODES_SIZE_FOR_OPTIMIZATION;
+    }
+
+    AK_FORCE_INLINE int getMaxCacheSize(const int inputSize, const float weightForLocale) const {
+        if (weightForLocale < GestureScoringParams::LOCALE_WEIGHT_THRESHOLD_FOR_SMALL_CACHE_SIZE) {
+            return GestureScoringParams::MAX_CACHE_DIC_NODE_SIZE_FOR_LOW_PROBABILITY_LOCALE;
+        }
+        return GestureScoringParams::MAX_CACHE_DIC_NODE_SIZE;
+    }
+
+    AK_FORCE_INLINE int getTerminalCacheSize() const {
+        return MAX_RESULTS;
+    }
+
+    AK_FORCE_INLINE bool isPossibleOmissionChildNode(
+            const DicTraverseSession *const traverseSession, const DicNode *const parentDicNode,
+            const DicNode *const dicNode) const {
+        return ProximityInfoUtils::isMatchOrProximityChar(
+                getProximityType(traverseSession, parentDicNode, dicNode));
+    }
+
+    AK_FORCE_INLINE bool isGoodToTraverseNextWord(const DicNode *const dicNode,
+            const int probability) const {
+        return probability >= GestureScoringParams::THRESHOLD_NEXT_WORD_PROBABILITY;
+    }
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(GestureTraversal);
+    static const GestureTraversal sInstance;
+
+    GestureTraversal() {}
+    ~GestureTraversal() {}
+};
+} // namespace latinime
+#endif // LATINIME_GESTURE_TRAVERSAL_H
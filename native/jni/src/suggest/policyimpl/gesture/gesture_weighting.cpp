@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/gesture/gesture_weighting.h"
+
+#include "suggest/core/dicnode/dic_node.h"
+#include "suggest/core/layout/proximity_info.h"
+#include "suggest/core/layout/proximity_info_state.h"
+#include "utils/char_utils.h"
+
+namespace latinime {
+
+const GestureWeighting GestureWeighting::sInstance;
+
+float GestureWeighting::getMatchedCost(const DicTraverseSession *const traverseSession,
+        const DicNode *const dicNode, DicNode_InputStateG *inputStateG) const {
+    const ProximityInfoState *const pInfoState = traverseSession->getProximityInfoState(0);
+    const int sampledInputSize = pInfoState->size();
+    const int startIndex = dicNode->getInputIndex(0);
+    const int codePoint = CharUtils::toBaseLowerCase(dicNode->getNodeCodePoint());
+    const int keyId = traverseSession->getProximityInfo()->getKeyIndexOf(codePoint);
+    inputStateG->mNeedsToUpdateInputStateG = true;
+    inputStateG->mPointerId = 0;
+    inputStateG->mInputIndex = startIndex;
+    inputStateG->mPrevCodePoint = codePoint;
+    if (keyId == NOT_AN_INDEX || startIndex >= sampledInputSize) {
+        return static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    }
+    float minCost = static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    int alignedIndex = NOT_AN_INDEX;
+    // The second letter of a double letter can be aligned to the point of the first one.
+    if (startIndex > 0 && dicNode->getNodeCodePointCount() > 1
+            && dicNode->getPrevCodePointG(0) == codePoint) {
+        minCost = pInfoState->getProbability(startIndex - 1, keyId)
+                + GestureScoringParams::DOUBLE_LETTER_COST;
+        alignedIndex = startIndex - 1;
+    }
+    // Searches the following points for the cheapest alignment. Skip costs only grow, so the
+    // search stops once they exceed the best cost or the key is out of reach.
+    float skipCost = 0.0f;
+    for (int i = startIndex; i < sampledInputSize && skipCost < minCost; ++i) {
+        const float cost = skipCost + pInfoState->getProbability(i, keyId);
+        if (cost < minCost) {
+            minCost = cost;
+            alignedIndex = i;
+        }
+        if (!pInfoState->isKeyInSerchKeysAfterIndex(i, keyId)) {
+            break;
+        }
+        skipCost += pInfoState->getProbability(i, NOT_AN_INDEX);
+    }
+    if (alignedIndex == NOT_AN_INDEX) {
+        return static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    }
+    inputStateG->mInputIndex = alignedIndex + 1;
+    return minCost;
+}
+
+float GestureWeighting::getTerminalInsertionCost(const DicTraverseSession *const traverseSession,
+        const DicNode *const dicNode) const {
+    // The points after the last letter have to be skipped.
+    const ProximityInfoState *const pInfoState = traverseSession->getProximityInfoState(0);
+    float cost = 0.0f;
+    for (int i = dicNode->getInputIndex(0); i < pInfoState->size(); ++i) {
+        cost += pInfoState->getProbability(i, NOT_AN_INDEX);
+    }
+    return cost;
+}
+
+ErrorTypeUtils::ErrorType GestureWeighting::getErrorType(const CorrectionType correctionType,
+        const DicTraverseSession *const traverseSession, const DicNode *const parentDicNode,
+        const DicNode *const dicNode) const {
+    switch (correctionType) {
+        case CT_MATCH:
+        case CT_TERMINAL_INSERTION:
+            // A gesture never hits a key exactly.
+            return ErrorTypeUtils::PROXIMITY_CORRECTION;
+        case CT_OMISSION:
+            return ErrorTypeUtils::INTENTIONAL_OMISSION;
+        case CT_NEW_WORD_SPACE_OMISSION:
+        case CT_NEW_WORD_SPACE_SUBSTITUTION:
+            return ErrorTypeUtils::NEW_WORD;
+        case CT_TERMINAL:
+            return ErrorTypeUtils::NOT_AN_ERROR;
+        case CT_COMPLETION:
+            return ErrorTypeUtils::COMPLETION;
+        default:
+            return ErrorTypeUtils::EDIT_CORRECTION;
+    }
+}
+}  // namespace latinime
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_GESTURE_WEIGHTING_H
+#define LATINIME_GESTURE_WEIGHTING_H
+
+#include "defines.h"
+#include "suggest/core/dicnode/dic_node_utils.h"
+#include "suggest/core/dictionary/error_type_utils.h"
+#include "suggest/core/policy/weighting.h"
+#include "suggest/core/session/dic_traverse_session.h"
+#include "suggest/policyimpl/gesture/gesture_scoring_params.h"
+#include "utils/char_utils.h"
+
+namespace latinime {
+
+class DicNode;
+struct DicNode_InputStateG;
+class MultiBigramMap;
+
+// Weighting for gesture input. Each letter is aligned to one of the following sampled points and
+// costs the -log probability of that point being the letter's key plus the -log probabilities of
+// skipping the points in between.
+class GestureWeighting : public Weighting {
+ public:
+    static const GestureWeighting *getInstance() { return &sInstance; }
+
+ protected:
+    float getTerminalSpatialCost(const DicTraverseSession *const traverseSession,
+            const DicNode *const dicNode) const {
+        return dicNode->hasMultipleWords() ? GestureScoringParams::HAS_MULTI_WORD_TERMINAL_COST
+                : 0.0f;
+    }
+
+    float getOmissionCost(const DicNode *const parentDicNode, const DicNode *const dicNode) const {
+        return parentDicNode->canBeIntentionalOmission()
+                ? GestureScoringParams::INTENTIONAL_OMISSION_COST
+                : static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    }
+
+    float getMatchedCost(const DicTraverseSession *const traverseSession,
+            const DicNode *const dicNode, DicNode_InputStateG *inputStateG) const;
+
+    bool isProximityDicNode(const DicTraverseSession *const traverseSession,
+            const DicNode *const dicNode) const {
+        return false;
+    }
+
+    float getTranspositionCost(const DicTraverseSession *const traverseSession,
+            const DicNode *const parentDicNode, const DicNode *const dicNode) const {
+        return static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    }
+
+    float getInsertionCost(const DicTraverseSession *const traverseSession,
+            const DicNode *const parentDicNode, const DicNode *const dicNode) const {
+        return static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    }
+
+    float getSpaceOmissionCost(const DicTraverseSession *const traverseSession,
+            const DicNode *const dicNode, DicNode_InputStateG *inputStateG) const {
+        return GestureScoringParams::SPACE_OMISSION_COST
+                * traverseSession->getMultiWordCostMultiplier();
+    }
+
+    float getNewWordBigramLanguageCost(const DicTraverseSession *const traverseSession,
+            const DicNode *const dicNode,
+            MultiBigramMap *const multiBigramMap) const {
+        return DicNodeUtils::getBigramNodeImprobability(
+                traverseSession->getDictionaryStructurePolicy(),
+                dicNode, multiBigramMap) * GestureScoringParams::DISTANCE_WEIGHT_LANGUAGE;
+    }
+
+    float getCompletionCost(const DicTraverseSession *const traverseSession,
+            const DicNode *const dicNode) const {
+        const bool firstCompletion = dicNode->getInputIndex(0)
+                == traverseSession->getInputSize();
+        // A word ending with a double letter aligns both letters to the last point.
+        if (firstCompletion && dicNode->getNodeCodePointCount() > 1
+                && dicNode->getPrevCodePointG(0)
+                        == CharUtils::toBaseLowerCase(dicNode->getNodeCodePoint())) {
+            return GestureScoringParams::DOUBLE_LETTER_COST;
+        }
+        return firstCompletion ? GestureScoringParams::COST_FIRST_COMPLETION
+                : GestureScoringParams::COST_COMPLETION;
+    }
+
+    float getTerminalLanguageCost(const DicTraverseSession *const traverseSession,
+            const DicNode *const dicNode, const float dicNodeLanguageImprobability) const {
+        return dicNodeLanguageImprobability * GestureScoringParams::DISTANCE_WEIGHT_LANGUAGE;
+    }
+
+    float getTerminalInsertionCost(const DicTraverseSession *const traverseSession,
+            const DicNode *const dicNode) const;
+
+    // Nodes at different input indices are compared by their average cost per sampled point.
+    AK_FORCE_INLINE bool needsToNormalizeCompoundDistance() const {
+        return true;
+    }
+
+    AK_FORCE_INLINE float getAdditionalProximityCost() const {
+        return static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    }
+
+    AK_FORCE_INLINE float getSubstitutionCost() const {
+        return static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    }
+
+    AK_FORCE_INLINE float getSpaceSubstitutionCost(const DicTraverseSession *const traverseSession,
+            const DicNode *const dicNode) const {
+        return static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    }
+
+    ErrorTypeUtils::ErrorType getErrorType(const CorrectionType correctionType,
+            const DicTraverseSession *const traverseSession,
+            const DicNode *const parentDicNode, const DicNode *const dicNode) const;
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(GestureWeighting);
+    static const GestureWeighting sInstance;
+
+    GestureWeighting() {}
+    ~GestureWeighting() {}
+};
+} // namespace latinime
+#endif // LATINIME_GESTURE_WEIGHTING_H
@@ -20,7 +20,6 @@
 #include "defines.h"
 #include "suggest/core/dicnode/dic_node_utils.h"
 #include "suggest/core/dictionary/error_type_utils.h"
-#include "suggest/core/layout/touch_position_correction_utils.h"
 #include "suggest/core/policy/weighting.h"
 #include "suggest/core/session/dic_traverse_session.h"
 #include "suggest/policyimpl/typing/scoring_params.h"
@@ -75,11 +74,9 @@ class TypingWeighting : public Weighting {
     float getMatchedCost(const DicTraverseSession *const traverseSession,
             const DicNode *const dicNode, DicNode_InputStateG *inputStateG) const {
         const int pointIndex = dicNode->getInputIndex(0);
-        const float normalizedSquaredLength = traverseSession->getProximityInfoState(0)
-                ->getPointToKeyLength(pointIndex,
+        const float normalizedDistance = traverseSession->getProximityInfoState(0)
+                ->getPointToKeySweetSpotFactor(pointIndex,
                         CharUtils::toBaseLowerCase(dicNode->getNodeCodePoint()));
-        const float normalizedDistance = TouchPositionCorrectionUtils::getSweetSpotFactor(
-                traverseSession->isTouchPositionCorrectionEnabled(), normalizedSquaredLength);
         const float weightedDistance = ScoringParams::DISTANCE_WEIGHT_LENGTH * normalizedDistance;
 
         const bool isFirstChar = pointIndex == 0;
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/utils/bit_parallel_edit_distance.h"
+
+#include "utils/char_utils.h"
+
+namespace latinime {
+
+const int BitParallelEditDistance::MAX_QUERY_LENGTH = 64;
+
+BitParallelEditDistance::BitParallelEditDistance(const CodePointArrayView query)
+        : mQueryLength(static_cast<int>(query.size())) {
+    ASSERT(mQueryLength <= MAX_QUERY_LENGTH);
+    for (int i = 0; i < MATCH_MASK_TABLE_SIZE; ++i) {
+        mCodePoints[i] = NOT_A_CODE_POINT;
+        mMatchMasks[i] = 0;
+    }
+    int baseLowerQuery[MAX_QUERY_LENGTH];
+    CharUtils::toBaseLowerCaseCodePoints(query.data(), mQueryLength, baseLowerQuery);
+    for (int i = 0; i < mQueryLength; ++i) {
+        const int codePoint = baseLowerQuery[i];
+        int index = getHashIndex(codePoint);
+        while (mCodePoints[index] != NOT_A_CODE_POINT && mCodePoints[index] != codePoint) {
+            index = (index + 1) & (MATCH_MASK_TABLE_SIZE - 1);
+        }
+        mCodePoints[index] = codePoint;
+        mMatchMasks[index] |= static_cast<uint64_t>(1) << i;
+    }
+}
+
+uint64_t BitParallelEditDistance::getMatchMask(const int codePoint) const {
+    int index = getHashIndex(codePoint);
+    while (mCodePoints[index] != NOT_A_CODE_POINT) {
+        if (mCodePoints[index] == codePoint) {
+            return mMatchMasks[index];
+        }
+        index = (index + 1) & (MATCH_MASK_TABLE_SIZE - 1);
+    }
+    return 0;
+}
+
+// The bit i of the vertical deltas tells whether D[i + 1][j] differs from D[i][j] by +1 or -1,
+// where D is the dynamic programming table of EditDistance::getEditDistance() for the query and
+// the first j code points of the candidate.
+int BitParallelEditDistance::getEditDistance(const CodePointArrayView candidate) const {
+    const int candidateLength = static_cast<int>(candidate.size());
+    if (mQueryLength == 0) {
+        return candidateLength;
+    }
+    const uint64_t lastBit = static_cast<uint64_t>(1) << (mQueryLength - 1);
+    uint64_t positiveVerticalDeltas = ~static_cast<uint64_t>(0);
+    uint64_t negativeVerticalDeltas = 0;
+    uint64_t zeroDiagonalDeltas = 0;
+    uint64_t prevMatchMask = 0;
+    int distance = mQueryLength;
+    for (int j = 0; j < candidateLength; ++j) {
+        const uint64_t matchMask = getMatchMask(CharUtils::toBaseLowerCase(candidate[j]));
+        const uint64_t transpositions =
+                (((~zeroDiagonalDeltas) & matchMask) << 1) & prevMatchMask;
+        zeroDiagonalDeltas = (((matchMask & positiveVerticalDeltas) + positiveVerticalDeltas)
+                ^ positiveVerticalDeltas) | matchMask | negativeVerticalDeltas | transpositions;
+        uint64_t positiveHorizontalDeltas =
+                negativeVerticalDeltas | ~(zeroDiagonalDeltas | positiveVerticalDeltas);
+        uint64_t negativeHorizontalDeltas = zeroDiagonalDeltas & positiveVerticalDeltas;
+        if (positiveHorizontalDeltas & lastBit) {
+            ++distance;
+        } else if (negativeHorizontalDeltas & lastBit) {
+            --distance;
+        }
+        // The first row of the table increases by 1 for each code point of the candidate.
+        positiveHorizontalDeltas = (positiveHorizontalDeltas << 1) | 1;
+        negativeHorizontalDeltas <<= 1;
+        positiveVerticalDeltas =
+                negativeHorizontalDeltas | ~(zeroDiagonalDeltas | positiveHorizontalDeltas);
+        negativeVerticalDeltas = positiveHorizontalDeltas & zeroDiagonalDeltas;
+        prevMatchMask = matchMask;
+    }
+    return distance;
+}
+
+void BitParallelEditDistance::getEditDistances(const CodePointArrayView *const candidates,
+        const int candidateCount, int *const outDistances) const {
+    for (int i = 0; i < candidateCount; ++i) {
+        outDistances[i] = getEditDistance(candidates[i]);
+    }
+}
+
+} // namespace latinime
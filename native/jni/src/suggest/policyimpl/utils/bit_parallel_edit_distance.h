@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_BIT_PARALLEL_EDIT_DISTANCE_H
+#define LATINIME_BIT_PARALLEL_EDIT_DISTANCE_H
+
+#include <cstdint>
+
+#include "defines.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+
+// Computes the same case and accent insensitive Damerau-Levenshtein distance (with adjacent
+// transpositions and unit costs) as DamerauLevenshteinEditDistancePolicy with Hyyro's bit-vector
+// algorithm. The query is preprocessed once so that it can be compared against many candidates
+// in O(candidate length) each. The query must not be longer than MAX_QUERY_LENGTH.
+class BitParallelEditDistance {
+ public:
+    static const int MAX_QUERY_LENGTH;
+
+    BitParallelEditDistance(const CodePointArrayView query);
+    ~BitParallelEditDistance() {}
+
+    int getEditDistance(const CodePointArrayView candidate) const;
+
+    // Writes the distance to each of the candidateCount candidates to outDistances.
+    void getEditDistances(const CodePointArrayView *const candidates, const int candidateCount,
+            int *const outDistances) const;
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(BitParallelEditDistance);
+
+    // Must be a power of 2 larger than MAX_QUERY_LENGTH to keep the probe sequences short.
+    static const int MATCH_MASK_TABLE_SIZE = 128;
+
+    const int mQueryLength;
+    // Open addressing table from the base lower case code points of the query to the bit masks
+    // of their positions.
+    int mCodePoints[MATCH_MASK_TABLE_SIZE];
+    uint64_t mMatchMasks[MATCH_MASK_TABLE_SIZE];
+
+    static AK_FORCE_INLINE int getHashIndex(const int codePoint) {
+        return static_cast<int>((static_cast<uint32_t>(codePoint) * 2654435761u) >> 25);
+    }
+
+    uint64_t getMatchMask(const int codePoint) const;
+};
+} // namespace latinime
+#endif // LATINIME_BIT_PARALLEL_EDIT_DISTANCE_H
@@ -20,8 +20,10 @@
 #include <cmath>
 
 #include "defines.h"
+#include "suggest/policyimpl/utils/bit_parallel_edit_distance.h"
 #include "suggest/policyimpl/utils/edit_distance.h"
 #include "suggest/policyimpl/utils/damerau_levenshtein_edit_distance_policy.h"
+#include "utils/int_array_view.h"
 
 namespace latinime {
 
@@ -31,6 +33,11 @@ const int AutocorrectionThresholdUtils::FULL_WORD_MULTIPLIER = 2;
 
 /* static */ int AutocorrectionThresholdUtils::editDistance(const int *before,
         const int beforeLength, const int *after, const int afterLength) {
+    if (beforeLength <= BitParallelEditDistance::MAX_QUERY_LENGTH) {
+        const BitParallelEditDistance bitParallelEditDistance(
+                CodePointArrayView(before, beforeLength));
+        return bitParallelEditDistance.getEditDistance(CodePointArrayView(after, afterLength));
+    }
     const DamerauLevenshteinEditDistancePolicy daemaruLevenshtein(
             before, beforeLength, after, afterLength);
     return static_cast<int>(EditDistance::getEditDistance(&daemaruLevenshtein));
@@ -17,7 +17,7 @@
 #ifndef LATINIME_CHAR_UTILS_H
 #define LATINIME_CHAR_UTILS_H
 
-#include <cctype>
+#include <algorithm>
 #include <cstring>
 #include <vector>
 
@@ -30,19 +30,12 @@ class CharUtils {
     static const std::vector<int> EMPTY_STRING;
 
     static AK_FORCE_INLINE bool isAsciiUpper(int c) {
-        // Note: isupper(...) reports false positives for some Cyrillic characters, causing them to
-        // be incorrectly lower-cased using toAsciiLower(...) rather than latin_tolower(...).
+        // Note: isupper(...) reports false positives for some Cyrillic characters.
         return (c >= 'A' && c <= 'Z');
     }
 
     static AK_FORCE_INLINE int toLowerCase(const int c) {
-        if (isAsciiUpper(c)) {
-            return toAsciiLower(c);
-        }
-        if (isAscii(c)) {
-            return c;
-        }
-        return latin_tolower(c);
+        return mapBmpCodePoint(LOWER_CASE_PAGE_BLOCKS, LOWER_CASE_DELTAS, c);
     }
 
     static AK_FORCE_INLINE int toBaseLowerCase(const int c) {
@@ -64,12 +57,16 @@ class CharUtils {
     }
 
     static AK_FORCE_INLINE int toBaseCodePoint(int c) {
-        if (c < BASE_CHARS_SIZE) {
-            return static_cast<int>(BASE_CHARS[c]);
-        }
-        return c;
+        return mapBmpCodePoint(BASE_PAGE_BLOCKS, BASE_DELTAS, c);
     }
 
+    // Same as toLowerCase() and toBaseLowerCase() for whole words. outCodePoints can be
+    // codePoints.
+    static void toLowerCaseCodePoints(const int *const codePoints, const int codePointCount,
+            int *const outCodePoints);
+    static void toBaseLowerCaseCodePoints(const int *const codePoints, const int codePointCount,
+            int *const outCodePoints);
+
     static AK_FORCE_INLINE int getSpaceCount(const int *const codePointBuffer, const int length) {
         int spaceCount = 0;
         for (int i = 0; i < length; ++i) {
@@ -119,23 +116,29 @@ class CharUtils {
     static const int MAX_UNICODE_CODE_POINT;
 
     /**
-     * Table mapping most combined Latin, Greek, and Cyrillic characters
-     * to their base characters.  If c is in range, BASE_CHARS[c] == c
-     * if c is not a combined character, or the base character if it
-     * is combined.
+     * Two-level tables mapping code points to their lower case and to their base characters.
+     * The BMP is divided into pages of BMP_PAGE_SIZE code points, and pages that map the same
+     * way share a block of deltas. A code point c in the BMP maps to
+     * c + DELTAS[PAGE_BLOCKS[c / BMP_PAGE_SIZE] * BMP_PAGE_SIZE + c % BMP_PAGE_SIZE] modulo
+     * 0x10000. The extra last page maps any other code point to itself.
      */
-    static const int BASE_CHARS_SIZE = 0x0500;
-    static const unsigned short BASE_CHARS[BASE_CHARS_SIZE];
-
-    static AK_FORCE_INLINE bool isAscii(int c) {
-        return isascii(c) != 0;
-    }
-
-    static AK_FORCE_INLINE int toAsciiLower(int c) {
-        return c - 'A' + 'a';
+    static const int BMP_PAGE_SHIFT = 8;
+    static const int BMP_PAGE_SIZE = 1 << BMP_PAGE_SHIFT;
+    static const int BMP_PAGE_COUNT = 0x10000 >> BMP_PAGE_SHIFT;
+    static const unsigned char LOWER_CASE_PAGE_BLOCKS[BMP_PAGE_COUNT + 1];
+    static const unsigned short LOWER_CASE_DELTAS[];
+    static const unsigned char BASE_PAGE_BLOCKS[BMP_PAGE_COUNT + 1];
+    static const unsigned short BASE_DELTAS[];
+
+    static AK_FORCE_INLINE int mapBmpCodePoint(const unsigned char *const pageBlocks,
+            const unsigned short *const deltas, const int c) {
+        // Negative code points and code points out of the BMP fall in the extra last page.
+        const unsigned int index = std::min(static_cast<unsigned int>(c),
+                static_cast<unsigned int>(BMP_PAGE_COUNT << BMP_PAGE_SHIFT));
+        const int delta = deltas[(pageBlocks[index >> BMP_PAGE_SHIFT] << BMP_PAGE_SHIFT)
+                | (index & (BMP_PAGE_SIZE - 1))];
+        return (c & ~0xFFFF) | ((c + delta) & 0xFFFF);
     }
-
-    static int latin_tolower(const int c);
 };
 } // namespace latinime
 #endif // LATINIME_CHAR_UTILS_H
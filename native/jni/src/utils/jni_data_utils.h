@@ -75,22 +75,8 @@ class JniDataUtils {
             const bool needsNullTermination) {
         const int codePointBufSize = std::min(maxLength, codePointCount);
         int outputCodePonts[codePointBufSize];
-        int outputCodePointCount = 0;
-        for (int i = 0; i < codePointBufSize; ++i) {
-            const int codePoint = codePoints[i];
-            int codePointToOutput = codePoint;
-            if (!CharUtils::isInUnicodeSpace(codePoint)) {
-                if (codePoint == CODE_POINT_BEGINNING_OF_SENTENCE) {
-                    // Just skip Beginning-of-Sentence marker.
-                    continue;
-                }
-                codePointToOutput = CODE_POINT_REPLACEMENT_CHARACTER;
-            } else if (codePoint >= 0x01 && codePoint <= 0x1F) {
-                // Control code.
-                codePointToOutput = CODE_POINT_REPLACEMENT_CHARACTER;
-            }
-            outputCodePonts[outputCodePointCount++] = codePointToOutput;
-        }
+        const int outputCodePointCount = getCodePointsForOutput(codePoints, codePointBufSize,
+                outputCodePonts);
         env->SetIntArrayRegion(intArrayToOutputCodePoints, start, outputCodePointCount,
                 outputCodePonts);
         if (needsNullTermination && outputCodePointCount < maxLength) {
@@ -99,6 +85,17 @@ class JniDataUtils {
         }
     }
 
+    // Same as above for a native buffer shared with Java.
+    static void outputCodePoints(int *const outCodePoints, const int maxLength,
+            const int *const codePoints, const int codePointCount,
+            const bool needsNullTermination) {
+        const int outputCodePointCount = getCodePointsForOutput(codePoints,
+                std::min(maxLength, codePointCount), outCodePoints);
+        if (needsNullTermination && outputCodePointCount < maxLength) {
+            outCodePoints[outputCodePointCount] = CODE_POINT_NULL;
+        }
+    }
+
     static NgramContext constructNgramContext(JNIEnv *env, jobjectArray prevWordCodePointArrays,
             jbooleanArray isBeginningOfSentenceArray, const size_t prevWordCount) {
         int prevWordCodePoints[MAX_PREV_WORD_COUNT_FOR_N_GRAM][MAX_WORD_LENGTH];
@@ -152,6 +149,29 @@ class JniDataUtils {
 
     static const int CODE_POINT_REPLACEMENT_CHARACTER;
     static const int CODE_POINT_NULL;
+
+    // Skips beginning-of-sentence markers and replaces invalid and control code points. Returns
+    // the number of code points written to outCodePoints.
+    static int getCodePointsForOutput(const int *const codePoints, const int codePointCount,
+            int *const outCodePoints) {
+        int outputCodePointCount = 0;
+        for (int i = 0; i < codePointCount; ++i) {
+            const int codePoint = codePoints[i];
+            int codePointToOutput = codePoint;
+            if (!CharUtils::isInUnicodeSpace(codePoint)) {
+                if (codePoint == CODE_POINT_BEGINNING_OF_SENTENCE) {
+                    // Just skip Beginning-of-Sentence marker.
+                    continue;
+                }
+                codePointToOutput = CODE_POINT_REPLACEMENT_CHARACTER;
+            } else if (codePoint >= 0x01 && codePoint <= 0x1F) {
+                // Control code.
+                codePointToOutput = CODE_POINT_REPLACEMENT_CHARACTER;
+            }
+            outCodePoints[outputCodePointCount++] = codePointToOutput;
+        }
+        return outputCodePointCount;
+    }
 };
 } // namespace latinime
 #endif // LATINIME_JNI_DATA_UTILS_H
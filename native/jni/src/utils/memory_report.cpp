@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/memory_report.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace latinime {
+
+const char *const MemoryReport::TOTAL_COMPONENT_NAME = "total";
+
+void MemoryReport::addComponent(const char *const name, const MemoryUsage &memoryUsage) {
+    for (auto &component : mComponents) {
+        if (component.mName == name) {
+            component.mMemoryUsage.add(memoryUsage);
+            return;
+        }
+    }
+    mComponents.emplace_back(name, memoryUsage);
+}
+
+const MemoryUsage MemoryReport::getTotal() const {
+    MemoryUsage total;
+    for (const auto &component : mComponents) {
+        total.add(component.getMemoryUsage());
+    }
+    return total;
+}
+
+int MemoryReport::dump(char *const outResult, const int maxResultLength) const {
+    if (maxResultLength <= 0) {
+        return 0;
+    }
+    outResult[0] = '\0';
+    int length = 0;
+    for (size_t i = 0; i <= mComponents.size() && length < maxResultLength; ++i) {
+        const bool isTotal = i == mComponents.size();
+        const char *const name = isTotal ? TOTAL_COMPONENT_NAME : mComponents[i].mName.c_str();
+        const MemoryUsage memoryUsage = isTotal ? getTotal() : mComponents[i].mMemoryUsage;
+        length += snprintf(outResult + length, maxResultLength - length,
+                "%s=%lld,%lld,%lld,%lld\n", name,
+                static_cast<long long>(memoryUsage.getMappedSize()),
+                static_cast<long long>(memoryUsage.getResidentSize()),
+                static_cast<long long>(memoryUsage.getHeapSize()),
+                static_cast<long long>(memoryUsage.getWastedSize()));
+    }
+    return std::min(length, maxResultLength - 1);
+}
+
+/* static */ int64_t MemoryReport::getResidentSize(const void *const data, const size_t size) {
+    if (!data || size == 0) {
+        return 0;
+    }
+    const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t start = reinterpret_cast<uintptr_t>(data);
+    const uintptr_t end = start + size;
+    const uintptr_t alignedStart = start & ~(pageSize - 1);
+    const size_t pageCount = (end - alignedStart + pageSize - 1) / pageSize;
+    std::vector<unsigned char> residency(pageCount);
+    if (mincore(reinterpret_cast<void *>(alignedStart), end - alignedStart,
+            residency.data()) != 0) {
+        // The range is not mapped.
+        return 0;
+    }
+    int64_t residentSize = 0;
+    for (size_t i = 0; i < pageCount; ++i) {
+        if ((residency[i] & 1) == 0) {
+            continue;
+        }
+        const uintptr_t pageStart = alignedStart + i * pageSize;
+        residentSize += std::min(pageStart + pageSize, end) - std::max(pageStart, start);
+    }
+    return residentSize;
+}
+
+} // namespace latinime
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_MEMORY_REPORT_H
+#define LATINIME_MEMORY_REPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "defines.h"
+
+namespace latinime {
+
+// Bytes used by a component. Mapped bytes are file backed and resident bytes are the mapped bytes
+// that are currently in memory. Wasted bytes are the mapped or heap bytes that hold no data, e.g.
+// free lists and reserved capacity.
+class MemoryUsage {
+ public:
+    MemoryUsage() : mMappedSize(0), mResidentSize(0), mHeapSize(0), mWastedSize(0) {}
+
+    static MemoryUsage mapped(const int64_t mappedSize, const int64_t residentSize) {
+        return MemoryUsage(mappedSize, residentSize, 0 /* heapSize */, 0 /* wastedSize */);
+    }
+
+    static MemoryUsage heap(const int64_t heapSize, const int64_t wastedSize) {
+        return MemoryUsage(0 /* mappedSize */, 0 /* residentSize */, heapSize, wastedSize);
+    }
+
+    int64_t getMappedSize() const { return mMappedSize; }
+    int64_t getResidentSize() const { return mResidentSize; }
+    int64_t getHeapSize() const { return mHeapSize; }
+    int64_t getWastedSize() const { return mWastedSize; }
+
+    void add(const MemoryUsage &memoryUsage) {
+        mMappedSize += memoryUsage.mMappedSize;
+        mResidentSize += memoryUsage.mResidentSize;
+        mHeapSize += memoryUsage.mHeapSize;
+        mWastedSize += memoryUsage.mWastedSize;
+    }
+
+ private:
+    MemoryUsage(const int64_t mappedSize, const int64_t residentSize, const int64_t heapSize,
+            const int64_t wastedSize)
+            : mMappedSize(mappedSize), mResidentSize(residentSize), mHeapSize(heapSize),
+              mWastedSize(wastedSize) {}
+
+    int64_t mMappedSize;
+    int64_t mResidentSize;
+    int64_t mHeapSize;
+    int64_t mWastedSize;
+};
+
+// Memory usage of an object broken down by named component.
+class MemoryReport {
+ public:
+    class Component {
+     public:
+        Component(const char *const name, const MemoryUsage &memoryUsage)
+                : mName(name), mMemoryUsage(memoryUsage) {}
+
+        const std::string &getName() const { return mName; }
+        const MemoryUsage &getMemoryUsage() const { return mMemoryUsage; }
+
+     private:
+        friend class MemoryReport;
+
+        std::string mName;
+        MemoryUsage mMemoryUsage;
+    };
+
+    MemoryReport() : mComponents() {}
+
+    // Usages of the same component are summed up.
+    void addComponent(const char *const name, const MemoryUsage &memoryUsage);
+
+    const std::vector<Component> &getComponents() const {
+        return mComponents;
+    }
+
+    const MemoryUsage getTotal() const;
+
+    // Writes "name=mapped,resident,heap,wasted" lines for all components followed by the total.
+    // Returns the written length.
+    int dump(char *const outResult, const int maxResultLength) const;
+
+    // Returns the number of bytes in [data, data + size) that are in resident pages.
+    static int64_t getResidentSize(const void *const data, const size_t size);
+
+    // Returns the memory usage of the mapped region [data, data + size).
+    static MemoryUsage getMappedMemoryUsage(const void *const data, const size_t size) {
+        return MemoryUsage::mapped(size, getResidentSize(data, size));
+    }
+
+    template<class T>
+    static MemoryUsage getVectorMemoryUsage(const std::vector<T> &vector) {
+        return MemoryUsage::heap(vector.capacity() * sizeof(T),
+                (vector.capacity() - vector.size()) * sizeof(T));
+    }
+
+    // Estimated from the bucket array and a node holding an entry and a link for each entry.
+    template<class K, class V>
+    static MemoryUsage getUnorderedMapMemoryUsage(const std::unordered_map<K, V> &map) {
+        return MemoryUsage::heap(map.bucket_count() * sizeof(void *) + map.size()
+                * (sizeof(typename std::unordered_map<K, V>::value_type) + sizeof(void *)),
+                0 /* wastedSize */);
+    }
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(MemoryReport);
+
+    static const char *const TOTAL_COMPONENT_NAME;
+
+    std::vector<Component> mComponents;
+};
+} // namespace latinime
+#endif /* LATINIME_MEMORY_REPORT_H */
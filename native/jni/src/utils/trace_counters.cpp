@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/trace_counters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace latinime {
+
+const int TraceCounters::HISTOGRAM_BUCKET_COUNT;
+
+const char *const TraceCounters::COUNTER_NAMES[] = {
+    "SUGGESTION_CALLS",
+    "EXPANDED_DIC_NODES",
+    "ACTIVE_DIC_NODES_POPPED",
+    "ACTIVE_DIC_NODES_PUSHED",
+    "ACTIVE_DIC_NODES_EVICTED",
+    "ACTIVE_DIC_NODES_DROPPED",
+    "NEXT_ACTIVE_DIC_NODES_PUSHED",
+    "NEXT_ACTIVE_DIC_NODES_EVICTED",
+    "NEXT_ACTIVE_DIC_NODES_DROPPED",
+    "TERMINAL_DIC_NODES_POPPED",
+    "TERMINAL_DIC_NODES_PUSHED",
+    "TERMINAL_DIC_NODES_EVICTED",
+    "TERMINAL_DIC_NODES_DROPPED",
+    "CACHED_DIC_NODES_PUSHED",
+    "CACHED_DIC_NODES_EVICTED",
+    "CACHED_DIC_NODES_DROPPED",
+    "CHILD_PT_NODE_ARRAY_READS",
+    "BIGRAM_CACHE_HITS",
+    "BIGRAM_CACHE_MISSES",
+};
+
+const char *const TraceCounters::HISTOGRAM_NAMES[] = {
+    "SUGGESTION_SETUP_TIME",
+    "SUGGESTION_EXPANSION_STEP_TIME",
+    "SUGGESTION_OUTPUT_TIME",
+    "FLUSH_TIME",
+    "FLUSH_WITH_GC_TIME",
+};
+
+std::atomic<bool> TraceCounters::sIsEnabled(false);
+std::atomic<int64_t> TraceCounters::sCounters[COUNTER_COUNT];
+std::atomic<int64_t> TraceCounters::sSampleCounts[HISTOGRAM_COUNT];
+std::atomic<int64_t> TraceCounters::sSampleSums[HISTOGRAM_COUNT];
+std::atomic<int64_t> TraceCounters::sBuckets[HISTOGRAM_COUNT][HISTOGRAM_BUCKET_COUNT];
+
+/* static */ void TraceCounters::setEnabled(const bool enabled) {
+    if (enabled && !isEnabled()) {
+        reset();
+    }
+    sIsEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+/* static */ void TraceCounters::record(const Histogram histogram, const int64_t value) {
+    if (!isEnabled()) {
+        return;
+    }
+    int bucketIndex = 0;
+    while (bucketIndex < HISTOGRAM_BUCKET_COUNT - 1 && (value >> bucketIndex) > 0) {
+        ++bucketIndex;
+    }
+    sSampleCounts[histogram].fetch_add(1, std::memory_order_relaxed);
+    sSampleSums[histogram].fetch_add(value, std::memory_order_relaxed);
+    sBuckets[histogram][bucketIndex].fetch_add(1, std::memory_order_relaxed);
+}
+
+/* static */ void TraceCounters::reset() {
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        sCounters[i].store(0, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < HISTOGRAM_COUNT; ++i) {
+        sSampleCounts[i].store(0, std::memory_order_relaxed);
+        sSampleSums[i].store(0, std::memory_order_relaxed);
+        for (int j = 0; j < HISTOGRAM_BUCKET_COUNT; ++j) {
+            sBuckets[i][j].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+/* static */ int64_t TraceCounters::getCount(const Counter counter) {
+    return sCounters[counter].load(std::memory_order_relaxed);
+}
+
+/* static */ int64_t TraceCounters::getSampleCount(const Histogram histogram) {
+    return sSampleCounts[histogram].load(std::memory_order_relaxed);
+}
+
+/* static */ int64_t TraceCounters::getSampleSum(const Histogram histogram) {
+    return sSampleSums[histogram].load(std::memory_order_relaxed);
+}
+
+/* static */ int64_t TraceCounters::getBucketCount(const Histogram histogram,
+        const int bucketIndex) {
+    if (bucketIndex < 0 || bucketIndex >= HISTOGRAM_BUCKET_COUNT) {
+        return 0;
+    }
+    return sBuckets[histogram][bucketIndex].load(std::memory_order_relaxed);
+}
+
+/* static */ int TraceCounters::dump(char *const outResult, const int maxResultLength) {
+    static_assert(NELEMS(COUNTER_NAMES) == COUNTER_COUNT,
+            "COUNTER_NAMES must have a name for each counter.");
+    static_assert(NELEMS(HISTOGRAM_NAMES) == HISTOGRAM_COUNT,
+            "HISTOGRAM_NAMES must have a name for each histogram.");
+    if (maxResultLength <= 0) {
+        return 0;
+    }
+    outResult[0] = '\0';
+    int length = 0;
+    for (int i = 0; i < COUNTER_COUNT && length < maxResultLength; ++i) {
+        length += snprintf(outResult + length, maxResultLength - length, "%s=%lld\n",
+                COUNTER_NAMES[i], static_cast<long long>(getCount(static_cast<Counter>(i))));
+    }
+    for (int i = 0; i < HISTOGRAM_COUNT && length < maxResultLength; ++i) {
+        const Histogram histogram = static_cast<Histogram>(i);
+        length += snprintf(outResult + length, maxResultLength - length, "%s=%lld,%lld",
+                HISTOGRAM_NAMES[i], static_cast<long long>(getSampleCount(histogram)),
+                static_cast<long long>(getSampleSum(histogram)));
+        for (int j = 0; j < HISTOGRAM_BUCKET_COUNT && length < maxResultLength; ++j) {
+            length += snprintf(outResult + length, maxResultLength - length, ",%lld",
+                    static_cast<long long>(getBucketCount(histogram, j)));
+        }
+        if (length < maxResultLength) {
+            length += snprintf(outResult + length, maxResultLength - length, "\n");
+        }
+    }
+    return std::min(length, maxResultLength - 1);
+}
+
+/* static */ int64_t TraceCounters::getTimeInMicroseconds() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace latinime
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_TRACE_COUNTERS_H
+#define LATINIME_TRACE_COUNTERS_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "defines.h"
+
+namespace latinime {
+
+/*
+ * Counters and latency histograms of the suggestion pipeline and the dictionary maintenance that
+ * are compiled in all builds. They are disabled by default; when disabled, recording costs a
+ * relaxed atomic load and a branch. Unlike Profiler, all slots are fixed and the counters are
+ * shared by all dictionaries and sessions of the process.
+ */
+class TraceCounters {
+ public:
+    // The PUSHED, EVICTED and DROPPED counters of each queue must be consecutive. See
+    // countPush().
+    enum Counter {
+        SUGGESTION_CALLS = 0,
+        EXPANDED_DIC_NODES,
+        ACTIVE_DIC_NODES_POPPED,
+        ACTIVE_DIC_NODES_PUSHED,
+        ACTIVE_DIC_NODES_EVICTED,
+        ACTIVE_DIC_NODES_DROPPED,
+        NEXT_ACTIVE_DIC_NODES_PUSHED,
+        NEXT_ACTIVE_DIC_NODES_EVICTED,
+        NEXT_ACTIVE_DIC_NODES_DROPPED,
+        TERMINAL_DIC_NODES_POPPED,
+        TERMINAL_DIC_NODES_PUSHED,
+        TERMINAL_DIC_NODES_EVICTED,
+        TERMINAL_DIC_NODES_DROPPED,
+        CACHED_DIC_NODES_PUSHED,
+        CACHED_DIC_NODES_EVICTED,
+        CACHED_DIC_NODES_DROPPED,
+        CHILD_PT_NODE_ARRAY_READS,
+        BIGRAM_CACHE_HITS,
+        BIGRAM_CACHE_MISSES,
+        COUNTER_COUNT,
+    };
+
+    // Durations in microseconds.
+    enum Histogram {
+        SUGGESTION_SETUP_TIME = 0,
+        // One sample for each input index.
+        SUGGESTION_EXPANSION_STEP_TIME,
+        SUGGESTION_OUTPUT_TIME,
+        FLUSH_TIME,
+        FLUSH_WITH_GC_TIME,
+        HISTOGRAM_COUNT,
+    };
+
+    // Outcome of pushing a node to a bounded queue.
+    enum PushResult {
+        PUSHED = 0,
+        // Pushed after removing the worst node of the full queue.
+        EVICTED = 1,
+        // Not pushed because the queue was full of better nodes.
+        DROPPED = 2,
+    };
+
+    // Bucket 0 holds 0 and bucket i holds [2^(i-1), 2^i). The last bucket also holds all larger
+    // values.
+    static const int HISTOGRAM_BUCKET_COUNT = 24;
+
+    // Records the time from its construction to its destruction or stop() to a histogram.
+    class ScopedTimer {
+     public:
+        explicit ScopedTimer(const Histogram histogram)
+                : mHistogram(histogram),
+                  mStartTimeInMicroseconds(isEnabled() ? getTimeInMicroseconds() : -1) {}
+
+        ~ScopedTimer() {
+            stop();
+        }
+
+        void stop() {
+            if (mStartTimeInMicroseconds >= 0) {
+                record(mHistogram, getTimeInMicroseconds() - mStartTimeInMicroseconds);
+                mStartTimeInMicroseconds = -1;
+            }
+        }
+
+     private:
+        DISALLOW_IMPLICIT_CONSTRUCTORS(ScopedTimer);
+
+        const Histogram mHistogram;
+        int64_t mStartTimeInMicroseconds;
+    };
+
+    static AK_FORCE_INLINE bool isEnabled() {
+        return sIsEnabled.load(std::memory_order_relaxed);
+    }
+
+    // Clears all counters and histograms when enabling.
+    static void setEnabled(const bool enabled);
+
+    static AK_FORCE_INLINE void increment(const Counter counter) {
+        if (isEnabled()) {
+            sCounters[counter].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // pushedCounter is the PUSHED counter of the queue.
+    static AK_FORCE_INLINE void countPush(const Counter pushedCounter,
+            const PushResult pushResult) {
+        if (isEnabled()) {
+            sCounters[pushedCounter + pushResult].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    static void record(const Histogram histogram, const int64_t value);
+
+    static void reset();
+
+    static int64_t getCount(const Counter counter);
+
+    static int64_t getSampleCount(const Histogram histogram);
+
+    static int64_t getSampleSum(const Histogram histogram);
+
+    static int64_t getBucketCount(const Histogram histogram, const int bucketIndex);
+
+    // Writes all counters as "name=count" lines and all histograms as
+    // "name=sampleCount,sampleSum,bucket0,bucket1,..." lines. Returns the written length.
+    static int dump(char *const outResult, const int maxResultLength);
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(TraceCounters);
+
+    static const char *const COUNTER_NAMES[];
+    static const char *const HISTOGRAM_NAMES[];
+
+    static std::atomic<bool> sIsEnabled;
+    static std::atomic<int64_t> sCounters[COUNTER_COUNT];
+    static std::atomic<int64_t> sSampleCounts[HISTOGRAM_COUNT];
+    static std::atomic<int64_t> sSampleSums[HISTOGRAM_COUNT];
+    static std::atomic<int64_t> sBuckets[HISTOGRAM_COUNT][HISTOGRAM_BUCKET_COUNT];
+
+    static int64_t getTimeInMicroseconds();
+};
+} // namespace latinime
+#endif /* LATINIME_TRACE_COUNTERS_H */
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dictionary/structure/v2/patricia_trie_policy.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "defines.h"
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "dictionary/utils/word_batch.h"
+#include "dictionary/utils/word_property_batch.h"
+
+namespace latinime {
+namespace {
+
+// A version 202 dictionary of "hello" (200), "help" (150), "word" (180), "world" (200) and
+// "yellow" (120) written by dicttoolkit makedict. The last PtNode array ends at the end of the
+// buffer.
+const uint8_t DICT[] = {
+    0x9B, 0xC1, 0x3A, 0xFE, 0x00, 0xCA, 0x00, 0x00, 0x00, 0x00, 0x00, 0x33, 0x64, 0x69, 0x63,
+    0x74, 0x69, 0x6F, 0x6E, 0x61, 0x72, 0x79, 0x1F, 0x6D, 0x61, 0x69, 0x6E, 0x3A, 0x65, 0x6E,
+    0x1F, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 0x65, 0x1F, 0x65, 0x6E, 0x1F, 0x76, 0x65, 0x72, 0x73,
+    0x69, 0x6F, 0x6E, 0x1F, 0x31, 0x1F, 0x03, 0x60, 0x68, 0x65, 0x6C, 0x1F, 0x10, 0x60, 0x77,
+    0x6F, 0x72, 0x1F, 0x13, 0x30, 0x79, 0x65, 0x6C, 0x6C, 0x6F, 0x77, 0x1F, 0x78, 0x02, 0x30,
+    0x6C, 0x6F, 0x1F, 0xC8, 0x10, 0x70, 0x96, 0x02, 0x10, 0x64, 0xB4, 0x30, 0x6C, 0x64, 0x1F,
+    0xC8,
+};
+
+class PatriciaTriePolicyTest : public ::testing::Test {
+ protected:
+    virtual void SetUp() {
+        char path[] = "/tmp/patricia_trie_policy_test_XXXXXX";
+        const int fd = mkstemp(path);
+        ASSERT_NE(-1, fd);
+        ASSERT_EQ(static_cast<ssize_t>(sizeof(DICT)), write(fd, DICT, sizeof(DICT)));
+        close(fd);
+        mPath = path;
+        mPolicy = DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+                path, 0 /* bufOffset */, sizeof(DICT), false /* isUpdatable */);
+        ASSERT_NE(nullptr, mPolicy.get());
+    }
+
+    virtual void TearDown() {
+        mPolicy.reset();
+        unlink(mPath.c_str());
+    }
+
+    // Returns the words with their probabilities and flags as "word:probability:flags".
+    std::vector<std::string> getWordsInBatches(const int bufferSize) {
+        std::vector<std::string> words;
+        std::vector<int> buffer(bufferSize);
+        int token = 0;
+        do {
+            WordBatch wordBatch(buffer.data(), bufferSize);
+            token = mPolicy->getNextWordsAndNextToken(token, &wordBatch);
+            int pos = 1;
+            for (int i = 0; i < wordBatch.getWordCount(); ++i) {
+                const int codePointCount = buffer[pos];
+                std::string word;
+                for (int j = 0; j < codePointCount; ++j) {
+                    word.push_back(static_cast<char>(buffer[pos + 3 + j]));
+                }
+                words.push_back(word + ":" + std::to_string(buffer[pos + 1]) + ":"
+                        + std::to_string(buffer[pos + 2]));
+                pos += 3 + codePointCount;
+            }
+            EXPECT_EQ(pos, wordBatch.getUsedSize());
+        } while (token != 0);
+        return words;
+    }
+
+    std::string mPath;
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr mPolicy;
+};
+
+TEST_F(PatriciaTriePolicyTest, TestGetNextWordsAndNextToken) {
+    const std::vector<std::string> allWords = getWordsInBatches(1024);
+    // Reaching the end of the last PtNode array is not an error.
+    EXPECT_FALSE(mPolicy->isCorrupted());
+    std::vector<std::string> sortedWords(allWords.begin(), allWords.end());
+    std::sort(sortedWords.begin(), sortedWords.end());
+    const std::vector<std::string> expectedWords = { "hello:200:0", "help:150:0",
+            "word:180:0", "world:200:0", "yellow:120:0" };
+    EXPECT_EQ(expectedWords, sortedWords);
+
+    // Small batches return the same words in the same order.
+    EXPECT_EQ(allWords, getWordsInBatches(WordBatch::MIN_BUFFER_SIZE));
+    EXPECT_FALSE(mPolicy->isCorrupted());
+
+    // Same words in the same order as with the per word iteration.
+    std::vector<std::string> words;
+    int token = 0;
+    do {
+        int codePoints[MAX_WORD_LENGTH];
+        int codePointCount = 0;
+        token = mPolicy->getNextWordAndNextToken(token, codePoints, &codePointCount);
+        words.push_back(std::string(codePoints, codePoints + codePointCount));
+    } while (token != 0);
+    ASSERT_EQ(allWords.size(), words.size());
+    for (size_t i = 0; i < words.size(); ++i) {
+        EXPECT_EQ(words[i], allWords[i].substr(0, allWords[i].find(':')));
+    }
+    EXPECT_FALSE(mPolicy->isCorrupted());
+}
+
+TEST_F(PatriciaTriePolicyTest, TestGetNextWordPropertiesAndNextToken) {
+    const std::vector<std::string> allWords = getWordsInBatches(1024);
+    std::vector<std::string> words;
+    std::vector<int> buffer(WordPropertyBatch::MIN_BUFFER_SIZE);
+    int token = 0;
+    do {
+        WordPropertyBatch wordPropertyBatch(buffer.data(), buffer.size());
+        token = mPolicy->getNextWordPropertiesAndNextToken(token, &wordPropertyBatch);
+        int pos = 1;
+        for (int i = 0; i < wordPropertyBatch.getWordCount(); ++i) {
+            const int codePointCount = buffer[pos];
+            EXPECT_EQ(0, buffer[pos + 6] /* n-gram count */);
+            words.push_back(std::string(buffer.begin() + pos + 7,
+                    buffer.begin() + pos + 7 + codePointCount) + ":"
+                    + std::to_string(buffer[pos + 2]) + ":" + std::to_string(buffer[pos + 1]));
+            pos += 7 + codePointCount;
+        }
+        EXPECT_EQ(pos, wordPropertyBatch.getUsedSize());
+    } while (token != 0);
+    EXPECT_EQ(allWords, words);
+    EXPECT_FALSE(mPolicy->isCorrupted());
+}
+
+TEST_F(PatriciaTriePolicyTest, TestGetNextWordsWithInvalidToken) {
+    std::vector<int> buffer(WordBatch::MIN_BUFFER_SIZE);
+    WordBatch wordBatch(buffer.data(), buffer.size());
+    EXPECT_EQ(0, mPolicy->getNextWordsAndNextToken(5 /* token */, &wordBatch));
+    EXPECT_EQ(0, wordBatch.getWordCount());
+}
+
+} // namespace
+} // namespace latinime
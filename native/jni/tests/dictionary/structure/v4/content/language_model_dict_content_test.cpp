@@ -70,6 +70,28 @@ TEST(LanguageModelDictContentTest, TestUnigramProbabilityWithHistoricalInfo) {
     EXPECT_TRUE(languageModelDictContent.removeProbabilityEntry(wordId));
 }
 
+TEST(LanguageModelDictContentTest, TestUnigramProbabilityWithCompactHistoricalInfo) {
+    const int baseTimestamp = 1000000000;
+    LanguageModelDictContent languageModelDictContent(true /* useHistoricalInfo */,
+            true /* usesCompactProbabilityEntries */, baseTimestamp);
+
+    const int flag = 0x10;
+    const int timestamp = baseTimestamp + 2 * 60 * 60;
+    const int wordIds[] = { 100, 200 };
+    const int counts[] = { 10, 1000 };
+    for (size_t i = 0; i < NELEMS(wordIds); ++i) {
+        const HistoricalInfo historicalInfo(timestamp, 0 /* level */, counts[i]);
+        const ProbabilityEntry probabilityEntry(flag, &historicalInfo);
+        EXPECT_TRUE(languageModelDictContent.setProbabilityEntry(wordIds[i], &probabilityEntry));
+    }
+    for (size_t i = 0; i < NELEMS(wordIds); ++i) {
+        const ProbabilityEntry entry = languageModelDictContent.getProbabilityEntry(wordIds[i]);
+        EXPECT_EQ(flag, entry.getFlags());
+        EXPECT_EQ(timestamp, entry.getHistoricalInfo()->getTimestamp());
+        EXPECT_EQ(counts[i], entry.getHistoricalInfo()->getCount());
+    }
+}
+
 TEST(LanguageModelDictContentTest, TestIterateProbabilityEntry) {
     LanguageModelDictContent languageModelDictContent(false /* useHistoricalInfo */);
 
@@ -116,5 +138,46 @@ TEST(LanguageModelDictContentTest, TestGetWordProbability) {
             false /* mustMatchAllPrevWords */, nullptr /* headerPolicy */).getProbability());
 }
 
+TEST(LanguageModelDictContentTest, TestTruncateEntries) {
+    LanguageModelDictContent languageModelDictContent(false /* useHistoricalInfo */);
+
+    const int flag = 0;
+    // Word 1 has the highest unigram probability; words 2, 3 and 4 have the lowest ones.
+    for (int wordId = 1; wordId <= 10; ++wordId) {
+        const ProbabilityEntry entry(flag, wordId == 1 ? 200 : wordId * 10);
+        EXPECT_TRUE(languageModelDictContent.setProbabilityEntry(wordId, &entry));
+    }
+    const std::array<int, 1> prevWordIdArray1 = {{ 1 }};
+    const WordIdArrayView prevWordIds1 = WordIdArrayView::fromArray(prevWordIdArray1);
+    for (int wordId = 5; wordId <= 9; ++wordId) {
+        const ProbabilityEntry entry(flag, wordId * 10);
+        EXPECT_TRUE(languageModelDictContent.setNgramProbabilityEntry(prevWordIds1, wordId,
+                &entry));
+    }
+    // This bigram is removed together with word 2.
+    const std::array<int, 1> prevWordIdArray2 = {{ 2 }};
+    const ProbabilityEntry bigramEntry(flag, 100);
+    EXPECT_TRUE(languageModelDictContent.setNgramProbabilityEntry(
+            WordIdArrayView::fromArray(prevWordIdArray2), 5, &bigramEntry));
+
+    const EntryCounts currentEntryCounts(
+            std::array<int, MAX_PREV_WORD_COUNT_FOR_N_GRAM + 1>({{ 10, 6, 0, 0 }}));
+    const EntryCounts maxEntryCounts(
+            std::array<int, MAX_PREV_WORD_COUNT_FOR_N_GRAM + 1>({{ 7, 2, 0, 0 }}));
+    MutableEntryCounters entryCounters;
+    EXPECT_TRUE(languageModelDictContent.truncateEntries(currentEntryCounts, maxEntryCounts,
+            nullptr /* headerPolicy */, &entryCounters));
+    EXPECT_EQ(7, entryCounters.getNgramCount(NgramType::Unigram));
+    EXPECT_EQ(2, entryCounters.getNgramCount(NgramType::Bigram));
+    for (int wordId = 1; wordId <= 10; ++wordId) {
+        EXPECT_EQ(wordId < 2 || wordId > 4,
+                languageModelDictContent.getProbabilityEntry(wordId).isValid()) << wordId;
+    }
+    for (int wordId = 5; wordId <= 9; ++wordId) {
+        EXPECT_EQ(wordId >= 8, languageModelDictContent.getNgramProbabilityEntry(
+                prevWordIds1, wordId).isValid()) << wordId;
+    }
+}
+
 }  // namespace
 }  // namespace latinime
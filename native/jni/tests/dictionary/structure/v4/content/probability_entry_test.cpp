@@ -54,5 +54,63 @@ TEST(ProbabilityEntryTest, TestEncodeDecodeWithHistoricalInfo) {
     EXPECT_EQ(count, decodedEntry.getHistoricalInfo()->getCount());
 }
 
+TEST(ProbabilityEntryTest, TestEncodeDecodeCompact) {
+    const int flag = 0x05;
+    const int probability = 10;
+
+    const ProbabilityEntry entry(flag, probability);
+    const uint64_t encodedEntry = entry.encodeCompact(false /* hasHistoricalInfo */,
+            0 /* baseTimestamp */);
+    EXPECT_EQ(entry.encode(false /* hasHistoricalInfo */), encodedEntry);
+    const ProbabilityEntry decodedEntry = ProbabilityEntry::decodeCompact(encodedEntry,
+            false /* hasHistoricalInfo */, 0 /* baseTimestamp */);
+    EXPECT_EQ(flag, decodedEntry.getFlags());
+    EXPECT_EQ(probability, decodedEntry.getProbability());
+}
+
+TEST(ProbabilityEntryTest, TestEncodeDecodeCompactWithHistoricalInfo) {
+    const int flag = 0x11;
+    const int baseTimestamp = 1000000000;
+    const int timestamp = baseTimestamp - 3 * 60 * 60 - 1;
+    const int count = 7;
+
+    const HistoricalInfo historicalInfo(timestamp, 0 /* level */, count);
+    const ProbabilityEntry entry(flag, &historicalInfo);
+    const uint64_t encodedEntry = entry.encodeCompact(true /* hasHistoricalInfo */,
+            baseTimestamp);
+    // Fits in the value field of a TrieMap terminal entry.
+    EXPECT_GT(1ull << 21, encodedEntry);
+    const ProbabilityEntry decodedEntry = ProbabilityEntry::decodeCompact(encodedEntry,
+            true /* hasHistoricalInfo */, baseTimestamp);
+    EXPECT_EQ(flag, decodedEntry.getFlags());
+    EXPECT_EQ(count, decodedEntry.getHistoricalInfo()->getCount());
+    // The timestamp is rounded down to hours.
+    EXPECT_EQ(baseTimestamp - 4 * 60 * 60, decodedEntry.getHistoricalInfo()->getTimestamp());
+}
+
+TEST(ProbabilityEntryTest, TestEncodeDecodeCompactFallback) {
+    const int flag = 0x08;
+    const int baseTimestamp = 1000000000;
+    const int count = 0xABCD;
+    const int timestamp = baseTimestamp + 10;
+
+    // The count is too large for the compact layout.
+    const HistoricalInfo historicalInfo(timestamp, 0 /* level */, count);
+    const ProbabilityEntry entry(flag, &historicalInfo);
+    const uint64_t encodedEntry = entry.encodeCompact(true /* hasHistoricalInfo */,
+            baseTimestamp);
+    const ProbabilityEntry decodedEntry = ProbabilityEntry::decodeCompact(encodedEntry,
+            true /* hasHistoricalInfo */, baseTimestamp);
+    EXPECT_EQ(flag, decodedEntry.getFlags());
+    EXPECT_EQ(timestamp, decodedEntry.getHistoricalInfo()->getTimestamp());
+    EXPECT_EQ(count, decodedEntry.getHistoricalInfo()->getCount());
+
+    // Dummy entries don't have a valid timestamp.
+    const uint64_t encodedDummyEntry = ProbabilityEntry().encodeCompact(
+            true /* hasHistoricalInfo */, baseTimestamp);
+    EXPECT_FALSE(ProbabilityEntry::decodeCompact(encodedDummyEntry,
+            true /* hasHistoricalInfo */, baseTimestamp).isValid());
+}
+
 }  // namespace
 }  // namespace latinime
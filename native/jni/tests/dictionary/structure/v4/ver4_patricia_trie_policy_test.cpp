@@ -0,0 +1,307 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dictionary/structure/v4/ver4_patricia_trie_policy.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "defines.h"
+#include "dictionary/header/header_policy.h"
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "dictionary/property/historical_info.h"
+#include "dictionary/property/ngram_context.h"
+#include "dictionary/property/ngram_property.h"
+#include "dictionary/property/unigram_property.h"
+#include "dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "dictionary/utils/file_utils.h"
+#include "dictionary/utils/format_utils.h"
+#include "dictionary/utils/word_batch.h"
+#include "dictionary/utils/word_property_batch.h"
+#include "utils/int_array_view.h"
+#include "utils/memory_report.h"
+
+namespace latinime {
+namespace {
+
+std::vector<int> toCodePoints(const std::string &word) {
+    return std::vector<int>(word.begin(), word.end());
+}
+
+DictionaryStructureWithBufferPolicy::StructurePolicyPtr createPolicy() {
+    DictionaryHeaderStructurePolicy::AttributeMap attributeMap;
+    return DictionaryStructureWithBufferPolicyFactory::newPolicyForOnMemoryDict(
+            FormatUtils::VERSION_403, toCodePoints("en"), &attributeMap);
+}
+
+bool addUnigramEntry(DictionaryStructureWithBufferPolicy *const policy, const std::string &word,
+        const int probability, const bool isNotAWord) {
+    const std::vector<int> codePoints = toCodePoints(word);
+    const UnigramProperty unigramProperty(false /* representsBeginningOfSentence */, isNotAWord,
+            false /* isPossiblyOffensive */, probability, HistoricalInfo());
+    return policy->addUnigramEntry(CodePointArrayView(codePoints), &unigramProperty);
+}
+
+// Returns the words with their probabilities and flags as "word:probability:flags".
+std::vector<std::string> getWordsInBatches(DictionaryStructureWithBufferPolicy *const policy,
+        const int bufferSize) {
+    std::vector<std::string> words;
+    std::vector<int> buffer(bufferSize);
+    int token = 0;
+    do {
+        WordBatch wordBatch(buffer.data(), bufferSize);
+        token = policy->getNextWordsAndNextToken(token, &wordBatch);
+        int pos = 1;
+        for (int i = 0; i < wordBatch.getWordCount(); ++i) {
+            const int codePointCount = buffer[pos];
+            std::string word;
+            for (int j = 0; j < codePointCount; ++j) {
+                word.push_back(static_cast<char>(buffer[pos + 3 + j]));
+            }
+            words.push_back(word + ":" + std::to_string(buffer[pos + 1]) + ":"
+                    + std::to_string(buffer[pos + 2]));
+            pos += 3 + codePointCount;
+        }
+        EXPECT_EQ(pos, wordBatch.getUsedSize());
+    } while (token != 0);
+    return words;
+}
+
+// Returns the word properties as "word:probability:flags" followed by " prev>target:probability"
+// for each n-gram in sorted order.
+std::vector<std::string> getWordPropertiesInBatches(
+        DictionaryStructureWithBufferPolicy *const policy, const int bufferSize) {
+    std::vector<std::string> wordProperties;
+    std::vector<int> buffer(bufferSize);
+    int token = 0;
+    do {
+        WordPropertyBatch wordPropertyBatch(buffer.data(), bufferSize);
+        token = policy->getNextWordPropertiesAndNextToken(token, &wordPropertyBatch);
+        int pos = 1;
+        for (int i = 0; i < wordPropertyBatch.getWordCount(); ++i) {
+            const int codePointCount = buffer[pos];
+            const int ngramCount = buffer[pos + 6];
+            std::string wordProperty(buffer.begin() + pos + 7,
+                    buffer.begin() + pos + 7 + codePointCount);
+            wordProperty += ":" + std::to_string(buffer[pos + 2]) + ":"
+                    + std::to_string(buffer[pos + 1]);
+            pos += 7 + codePointCount;
+            std::vector<std::string> ngrams;
+            for (int j = 0; j < ngramCount; ++j) {
+                const int prevWordCount = buffer[pos++];
+                std::string ngram;
+                for (int k = 0; k < prevWordCount; ++k) {
+                    const int prevWordCodePointCount = buffer[pos + 1];
+                    ngram += std::string(buffer.begin() + pos + 2,
+                            buffer.begin() + pos + 2 + prevWordCodePointCount) + ">";
+                    pos += 2 + prevWordCodePointCount;
+                }
+                const int targetCodePointCount = buffer[pos];
+                ngram += std::string(buffer.begin() + pos + 5,
+                        buffer.begin() + pos + 5 + targetCodePointCount) + ":"
+                        + std::to_string(buffer[pos + 1]);
+                pos += 5 + targetCodePointCount;
+                ngrams.push_back(ngram);
+            }
+            std::sort(ngrams.begin(), ngrams.end());
+            for (const std::string &ngram : ngrams) {
+                wordProperty += " " + ngram;
+            }
+            wordProperties.push_back(wordProperty);
+        }
+        EXPECT_EQ(pos, wordPropertyBatch.getUsedSize());
+    } while (token != 0);
+    return wordProperties;
+}
+
+TEST(Ver4PatriciaTriePolicyTest, TestGetNextWordsAndNextToken) {
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy = createPolicy();
+    ASSERT_NE(nullptr, policy.get());
+    const std::vector<std::string> words = { "a", "ab", "abc", "b", "hello", "help", "helper",
+            "world", "worlds", "x" };
+    for (size_t i = 0; i < words.size(); ++i) {
+        ASSERT_TRUE(addUnigramEntry(policy.get(), words[i], 100 + static_cast<int>(i),
+                words[i] == "x" /* isNotAWord */));
+    }
+    const UnigramProperty beginningOfSentence(true /* representsBeginningOfSentence */,
+            true /* isNotAWord */, false /* isPossiblyOffensive */, NOT_A_PROBABILITY,
+            HistoricalInfo());
+    ASSERT_TRUE(policy->addUnigramEntry(CodePointArrayView(), &beginningOfSentence));
+    const std::vector<int> removedWord = toCodePoints("help");
+    ASSERT_TRUE(policy->removeUnigramEntry(CodePointArrayView(removedWord)));
+
+    std::vector<std::string> expectedWords;
+    for (size_t i = 0; i < words.size(); ++i) {
+        if (words[i] != "help") {
+            const int flags = words[i] == "x" ? WordBatch::FLAG_IS_NOT_A_WORD : 0;
+            expectedWords.push_back(words[i] + ":" + std::to_string(100 + i) + ":"
+                    + std::to_string(flags));
+        }
+    }
+    const std::vector<std::string> allWords = getWordsInBatches(policy.get(), 1024);
+    ASSERT_EQ(expectedWords.size() + 1, allWords.size());
+    const auto beginningOfSentenceIt = std::find_if(allWords.begin(), allWords.end(),
+            [](const std::string &word) { return word[0] == ':'; });
+    ASSERT_NE(allWords.end(), beginningOfSentenceIt);
+    EXPECT_NE(0, std::stoi(beginningOfSentenceIt->substr(
+            beginningOfSentenceIt->rfind(':') + 1)) & WordBatch::FLAG_IS_BEGINNING_OF_SENTENCE);
+    std::vector<std::string> sortedWords(allWords.begin(), allWords.end());
+    sortedWords.erase(sortedWords.begin() + (beginningOfSentenceIt - allWords.begin()));
+    std::sort(sortedWords.begin(), sortedWords.end());
+    EXPECT_EQ(expectedWords, sortedWords);
+
+    // Small batches return the same words in the same order.
+    EXPECT_EQ(allWords, getWordsInBatches(policy.get(), WordBatch::MIN_BUFFER_SIZE));
+
+    // Same words as with the per word iteration.
+    int wordCount = 0;
+    int token = 0;
+    do {
+        int codePoints[MAX_WORD_LENGTH];
+        int codePointCount = 0;
+        token = policy->getNextWordAndNextToken(token, codePoints, &codePointCount);
+        ++wordCount;
+    } while (token != 0);
+    EXPECT_EQ(static_cast<int>(allWords.size()), wordCount);
+}
+
+TEST(Ver4PatriciaTriePolicyTest, TestGetNextWordsWithInvalidToken) {
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy = createPolicy();
+    ASSERT_NE(nullptr, policy.get());
+    ASSERT_TRUE(addUnigramEntry(policy.get(), "hello", 100, false /* isNotAWord */));
+    std::vector<int> buffer(WordBatch::MIN_BUFFER_SIZE);
+    WordBatch wordBatch(buffer.data(), buffer.size());
+    EXPECT_EQ(0, policy->getNextWordsAndNextToken(5 /* token */, &wordBatch));
+    EXPECT_EQ(0, wordBatch.getWordCount());
+}
+
+TEST(Ver4PatriciaTriePolicyTest, TestGetNextWordPropertiesAndNextToken) {
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy = createPolicy();
+    ASSERT_NE(nullptr, policy.get());
+    ASSERT_TRUE(addUnigramEntry(policy.get(), "hello", 100, false /* isNotAWord */));
+    ASSERT_TRUE(addUnigramEntry(policy.get(), "world", 110, false /* isNotAWord */));
+    // Long enough for the n-grams of "hello" not to fit in the minimum buffer.
+    const std::string longWord(MAX_WORD_LENGTH / 2, 'x');
+    ASSERT_TRUE(addUnigramEntry(policy.get(), longWord, 120, true /* isNotAWord */));
+    const std::vector<int> hello = toCodePoints("hello");
+    for (const std::string &target : std::vector<std::string>({ "world", longWord })) {
+        const NgramProperty ngramProperty(NgramContext(hello.data(), hello.size(),
+                false /* isBeginningOfSentence */), toCodePoints(target), 130, HistoricalInfo());
+        ASSERT_TRUE(policy->addNgramEntry(&ngramProperty));
+    }
+
+    const std::vector<std::string> wordProperties = getWordPropertiesInBatches(policy.get(), 1024);
+    std::vector<std::string> sortedWordProperties(wordProperties);
+    std::sort(sortedWordProperties.begin(), sortedWordProperties.end());
+    const int helloFlags = WordPropertyBatch::FLAG_HAS_NGRAMS;
+    const int longWordFlags = WordPropertyBatch::FLAG_IS_NOT_A_WORD;
+    const std::vector<std::string> expectedWordProperties = {
+            "hello:100:" + std::to_string(helloFlags) + " hello>world:130 hello>" + longWord
+                    + ":130",
+            "world:110:0", longWord + ":120:" + std::to_string(longWordFlags) };
+    EXPECT_EQ(expectedWordProperties, sortedWordProperties);
+
+    // Same properties as getWordProperty().
+    for (const std::string &word : std::vector<std::string>({ "hello", "world", longWord })) {
+        const std::vector<int> codePoints = toCodePoints(word);
+        const WordProperty wordProperty = policy->getWordProperty(CodePointArrayView(codePoints));
+        EXPECT_EQ(codePoints, wordProperty.getCodePoints().toVector());
+        const std::string prefix = word + ":"
+                + std::to_string(wordProperty.getUnigramProperty().getProbability()) + ":";
+        const auto it = std::find_if(wordProperties.begin(), wordProperties.end(),
+                [&prefix](const std::string &property) {
+                    return property.compare(0, prefix.size(), prefix) == 0; });
+        ASSERT_NE(wordProperties.end(), it);
+        EXPECT_EQ(wordProperty.getNgramProperties().size(),
+                static_cast<size_t>(std::count(it->begin(), it->end(), '>')));
+    }
+
+    // The n-grams of a word are left out when they do not fit even in an empty batch.
+    const std::vector<std::string> smallBatchWordProperties =
+            getWordPropertiesInBatches(policy.get(), WordPropertyBatch::MIN_BUFFER_SIZE);
+    ASSERT_EQ(wordProperties.size(), smallBatchWordProperties.size());
+    for (size_t i = 0; i < wordProperties.size(); ++i) {
+        if (wordProperties[i].find('>') == std::string::npos) {
+            EXPECT_EQ(wordProperties[i], smallBatchWordProperties[i]);
+        } else {
+            EXPECT_EQ("hello:100:" + std::to_string(helloFlags
+                    | WordPropertyBatch::FLAG_NGRAMS_NOT_INCLUDED), smallBatchWordProperties[i]);
+        }
+    }
+}
+
+TEST(Ver4PatriciaTriePolicyTest, TestGetNextWordPropertiesAfterGetNextWords) {
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy = createPolicy();
+    ASSERT_NE(nullptr, policy.get());
+    // Two of these words do not fit in the minimum buffer.
+    for (const char c : std::string("abc")) {
+        ASSERT_TRUE(addUnigramEntry(policy.get(), std::string(MAX_WORD_LENGTH - 8, c), 100,
+                false /* isNotAWord */));
+    }
+    std::vector<int> buffer(WordPropertyBatch::MIN_BUFFER_SIZE);
+    WordPropertyBatch wordPropertyBatch(buffer.data(), buffer.size());
+    const int token = policy->getNextWordPropertiesAndNextToken(0 /* token */,
+            &wordPropertyBatch);
+    EXPECT_NE(0, token);
+    EXPECT_EQ(1, wordPropertyBatch.getWordCount());
+    // Both iterations share the state; iterating the words invalidates the token.
+    EXPECT_EQ(3u, getWordsInBatches(policy.get(), 1024).size());
+    WordPropertyBatch staleWordPropertyBatch(buffer.data(), buffer.size());
+    EXPECT_EQ(0, policy->getNextWordPropertiesAndNextToken(token, &staleWordPropertyBatch));
+    EXPECT_EQ(0, staleWordPropertyBatch.getWordCount());
+}
+
+TEST(Ver4PatriciaTriePolicyTest, TestMemoryReport) {
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy = createPolicy();
+    ASSERT_TRUE(addUnigramEntry(policy.get(), "hello", 100, false /* isNotAWord */));
+    ASSERT_TRUE(addUnigramEntry(policy.get(), "world", 100, false /* isNotAWord */));
+    char tmpDirPath[] = "/tmp/ver4_patricia_trie_policy_test_XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(tmpDirPath));
+    const std::string dictDirPath = std::string(tmpDirPath) + "/dict";
+    ASSERT_TRUE(policy->flushWithGC(dictDirPath.c_str()));
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr mappedPolicy =
+            DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+                    dictDirPath.c_str(), 0 /* bufOffset */, 0 /* size */,
+                    true /* isUpdatable */);
+    ASSERT_NE(nullptr, mappedPolicy.get());
+
+    MemoryReport memoryReport;
+    mappedPolicy->getMemoryReport(&memoryReport);
+    std::vector<std::string> names;
+    for (const auto &component : memoryReport.getComponents()) {
+        names.push_back(component.getName());
+        const MemoryUsage &memoryUsage = component.getMemoryUsage();
+        EXPECT_LE(memoryUsage.getResidentSize(), memoryUsage.getMappedSize());
+        EXPECT_LE(memoryUsage.getWastedSize(), memoryUsage.getMappedSize()
+                + memoryUsage.getHeapSize());
+    }
+    const std::vector<std::string> expectedNames = { "header", "trie",
+            "terminal_position_lookup_table", "language_model", "shortcut", "word_iteration" };
+    EXPECT_EQ(expectedNames, names);
+    EXPECT_GT(memoryReport.getComponents()[1].getMemoryUsage().getMappedSize(), 0);
+    EXPECT_EQ(0, memoryReport.getComponents()[1].getMemoryUsage().getHeapSize());
+    EXPECT_GT(memoryReport.getTotal().getResidentSize(), 0);
+
+    mappedPolicy.reset();
+    FileUtils::removeDirAndFiles(tmpDirPath);
+}
+
+}  // namespace
+}  // namespace latinime
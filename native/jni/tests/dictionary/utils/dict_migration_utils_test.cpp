@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dictionary/utils/dict_migration_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "defines.h"
+#include "dictionary/interface/dictionary_structure_with_buffer_policy.h"
+#include "dictionary/property/historical_info.h"
+#include "dictionary/property/ngram_context.h"
+#include "dictionary/property/ngram_property.h"
+#include "dictionary/property/unigram_property.h"
+#include "dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "dictionary/utils/file_utils.h"
+#include "dictionary/utils/format_utils.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+namespace {
+
+const int WORD_COUNT = 30;
+const int BIGRAM_COUNT = 20;
+const int WORD_COUNT_PER_CHECKPOINT = 4;
+
+std::vector<int> getWord(const int index) {
+    const std::string word = std::string("word") + static_cast<char>('a' + index / 26)
+            + static_cast<char>('a' + index % 26);
+    return std::vector<int>(word.begin(), word.end());
+}
+
+DictionaryStructureWithBufferPolicy::StructurePolicyPtr createSourcePolicy() {
+    DictionaryHeaderStructurePolicy::AttributeMap attributeMap;
+    const std::vector<int> locale = { 'e', 'n' };
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+            DictionaryStructureWithBufferPolicyFactory::newPolicyForOnMemoryDict(
+                    FormatUtils::VERSION_403, locale, &attributeMap);
+    for (int i = 0; i < WORD_COUNT; ++i) {
+        const std::vector<int> word = getWord(i);
+        const UnigramProperty unigramProperty(false /* representsBeginningOfSentence */,
+                false /* isNotAWord */, false /* isPossiblyOffensive */, 100 + i,
+                HistoricalInfo());
+        EXPECT_TRUE(policy->addUnigramEntry(CodePointArrayView(word), &unigramProperty));
+    }
+    for (int i = 0; i < BIGRAM_COUNT; ++i) {
+        const std::vector<int> prevWord = getWord(i);
+        const NgramContext ngramContext(prevWord.data(), prevWord.size(),
+                false /* isBeginningOfSentence */);
+        const NgramProperty ngramProperty(ngramContext, getWord(i + 1), 150 /* probability */,
+                HistoricalInfo());
+        EXPECT_TRUE(policy->addNgramEntry(&ngramProperty));
+    }
+    return policy;
+}
+
+int getCount(DictionaryStructureWithBufferPolicy *const policy, const char *const query) {
+    char result[16];
+    policy->getProperty(query, strlen(query), result, NELEMS(result));
+    return atoi(result);
+}
+
+class DictMigrationUtilsTest : public ::testing::Test {
+ protected:
+    virtual void SetUp() {
+        strcpy(mTmpDirPath, "/tmp/dict_migration_utils_test_XXXXXX");
+        ASSERT_NE(nullptr, mkdtemp(mTmpDirPath));
+        mDictDirPath = std::string(mTmpDirPath) + "/dict";
+        mJournalFilePath = mDictDirPath + DictMigrationUtils::PROGRESS_FILE_SUFFIX;
+        mSourcePolicy = createSourcePolicy();
+        ASSERT_EQ(WORD_COUNT, getCount(mSourcePolicy.get(), "UNIGRAM_COUNT"));
+        ASSERT_EQ(BIGRAM_COUNT, getCount(mSourcePolicy.get(), "BIGRAM_COUNT"));
+    }
+
+    virtual void TearDown() {
+        FileUtils::removeDirAndFiles(mDictDirPath.c_str());
+        FileUtils::removeDirAndFiles(mTmpDirPath);
+    }
+
+    bool migrate(const int maxCheckpointCount, int *const outAddedNgramCount) {
+        return DictMigrationUtils::migrateDictionaryForTesting(mSourcePolicy.get(),
+                mDictDirPath.c_str(), FormatUtils::VERSION_403, WORD_COUNT_PER_CHECKPOINT,
+                maxCheckpointCount, outAddedNgramCount);
+    }
+
+    void expectMigratedDictionary() {
+        DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+                DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+                        mDictDirPath.c_str(), 0 /* bufOffset */, 0 /* size */,
+                        false /* isUpdatable */);
+        ASSERT_NE(nullptr, policy.get());
+        EXPECT_EQ(WORD_COUNT, getCount(policy.get(), "UNIGRAM_COUNT"));
+        EXPECT_EQ(BIGRAM_COUNT, getCount(policy.get(), "BIGRAM_COUNT"));
+        for (int i = 0; i < WORD_COUNT; ++i) {
+            const std::vector<int> word = getWord(i);
+            EXPECT_NE(NOT_A_WORD_ID, policy->getWordId(CodePointArrayView(word),
+                    false /* forceLowerCaseSearch */));
+        }
+        // The journal is removed once the migration completes.
+        EXPECT_NE(0, access(mJournalFilePath.c_str(), F_OK));
+    }
+
+    char mTmpDirPath[64];
+    std::string mDictDirPath;
+    std::string mJournalFilePath;
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr mSourcePolicy;
+};
+
+TEST_F(DictMigrationUtilsTest, TestMigrateWithoutInterruption) {
+    int addedNgramCount = 0;
+    ASSERT_TRUE(migrate(S_INT_MAX, &addedNgramCount));
+    EXPECT_EQ(BIGRAM_COUNT, addedNgramCount);
+    expectMigratedDictionary();
+}
+
+TEST_F(DictMigrationUtilsTest, TestResumeDuringUnigrams) {
+    int addedNgramCount = 0;
+    ASSERT_FALSE(migrate(2 /* maxCheckpointCount */, &addedNgramCount));
+    EXPECT_EQ(0, addedNgramCount);
+    // The committed sections have been written to the new dictionary.
+    EXPECT_EQ(0, access(mJournalFilePath.c_str(), F_OK));
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+            DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+                    mDictDirPath.c_str(), 0 /* bufOffset */, 0 /* size */,
+                    false /* isUpdatable */);
+    ASSERT_NE(nullptr, policy.get());
+    EXPECT_EQ(2 * WORD_COUNT_PER_CHECKPOINT, getCount(policy.get(), "UNIGRAM_COUNT"));
+    policy.reset();
+    ASSERT_TRUE(migrate(S_INT_MAX, &addedNgramCount));
+    EXPECT_EQ(BIGRAM_COUNT, addedNgramCount);
+    expectMigratedDictionary();
+}
+
+TEST_F(DictMigrationUtilsTest, TestResumeDuringNgrams) {
+    // All unigrams take (WORD_COUNT / WORD_COUNT_PER_CHECKPOINT) checkpoints.
+    const int maxCheckpointCount = WORD_COUNT / WORD_COUNT_PER_CHECKPOINT + 2;
+    int committedNgramCount = 0;
+    ASSERT_FALSE(migrate(maxCheckpointCount, &committedNgramCount));
+    EXPECT_GT(committedNgramCount, 0);
+    EXPECT_LT(committedNgramCount, BIGRAM_COUNT);
+    // Interrupt the resumed migration again before it commits anything.
+    int addedNgramCount = 0;
+    ASSERT_FALSE(migrate(0 /* maxCheckpointCount */, &addedNgramCount));
+    EXPECT_EQ(0, addedNgramCount);
+    // The run that completes adds only the n-grams that were not committed, each exactly once.
+    ASSERT_TRUE(migrate(S_INT_MAX, &addedNgramCount));
+    EXPECT_EQ(BIGRAM_COUNT - committedNgramCount, addedNgramCount);
+    expectMigratedDictionary();
+}
+
+TEST_F(DictMigrationUtilsTest, TestResumeWithTornJournal) {
+    int committedNgramCount = 0;
+    ASSERT_FALSE(migrate(WORD_COUNT / WORD_COUNT_PER_CHECKPOINT + 2, &committedNgramCount));
+    // Simulate a crash in the middle of appending a commit.
+    FILE *const file = fopen(mJournalFilePath.c_str(), "ab");
+    ASSERT_NE(nullptr, file);
+    const int tornRecord[] = { -1 /* marker */, 1 /* phase */ };
+    ASSERT_EQ(NELEMS(tornRecord), fwrite(tornRecord, sizeof(tornRecord[0]),
+            NELEMS(tornRecord), file));
+    fclose(file);
+    int addedNgramCount = 0;
+    ASSERT_TRUE(migrate(S_INT_MAX, &addedNgramCount));
+    EXPECT_EQ(BIGRAM_COUNT - committedNgramCount, addedNgramCount);
+    expectMigratedDictionary();
+}
+
+TEST_F(DictMigrationUtilsTest, TestRestartWithoutWrittenDictionary) {
+    int addedNgramCount = 0;
+    ASSERT_FALSE(migrate(WORD_COUNT / WORD_COUNT_PER_CHECKPOINT + 2, &addedNgramCount));
+    // A commit without the dictionary it refers to cannot be resumed from.
+    ASSERT_TRUE(FileUtils::removeDirAndFiles(mDictDirPath.c_str()));
+    ASSERT_TRUE(migrate(S_INT_MAX, &addedNgramCount));
+    EXPECT_EQ(BIGRAM_COUNT, addedNgramCount);
+    expectMigratedDictionary();
+}
+
+TEST_F(DictMigrationUtilsTest, TestRestartWithInvalidJournal) {
+    FILE *const file = fopen(mJournalFilePath.c_str(), "wb");
+    ASSERT_NE(nullptr, file);
+    const int invalidRecord[] = { 7 /* phase */, -1, 0 };
+    ASSERT_EQ(NELEMS(invalidRecord), fwrite(invalidRecord, sizeof(invalidRecord[0]),
+            NELEMS(invalidRecord), file));
+    fclose(file);
+    int addedNgramCount = 0;
+    ASSERT_TRUE(migrate(S_INT_MAX, &addedNgramCount));
+    EXPECT_EQ(BIGRAM_COUNT, addedNgramCount);
+    expectMigratedDictionary();
+}
+
+} // namespace
+} // namespace latinime
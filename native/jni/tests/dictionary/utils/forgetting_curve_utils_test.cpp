@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dictionary/utils/forgetting_curve_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "defines.h"
+#include "dictionary/header/header_policy.h"
+#include "dictionary/header/header_read_write_utils.h"
+#include "dictionary/interface/dictionary_header_structure_policy.h"
+#include "dictionary/property/historical_info.h"
+#include "dictionary/utils/format_utils.h"
+#include "utils/time_keeper.h"
+
+namespace latinime {
+namespace {
+
+// 15 days are divided into 32 time steps.
+const int TIME_STEP_DURATION_IN_SECONDS = 15 * 24 * 60 * 60 / 32;
+
+int decodeProbability(const int tableId, const int level, const int elapsedTimeStepCount) {
+    DictionaryHeaderStructurePolicy::AttributeMap attributeMap;
+    HeaderReadWriteUtils::setIntAttribute(&attributeMap,
+            "FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID", tableId);
+    const HeaderPolicy headerPolicy(FormatUtils::VERSION_403, std::vector<int>(), &attributeMap);
+    const HistoricalInfo historicalInfo(TimeKeeper::peekCurrentTime()
+            - elapsedTimeStepCount * TIME_STEP_DURATION_IN_SECONDS, level, 0 /* count */);
+    return ForgettingCurveUtils::decodeProbability(&historicalInfo, &headerPolicy);
+}
+
+TEST(ForgettingCurveUtilsTest, TestDecodeProbability) {
+    TimeKeeper::setCurrentTime();
+    // Weak, modest, strong and aggressive tables.
+    EXPECT_EQ(127, decodeProbability(0, 15 /* level */, 0 /* elapsedTimeStepCount */));
+    EXPECT_EQ(128, decodeProbability(1, 15 /* level */, 0 /* elapsedTimeStepCount */));
+    EXPECT_EQ(144, decodeProbability(2, 15 /* level */, 0 /* elapsedTimeStepCount */));
+    EXPECT_EQ(160, decodeProbability(3, 15 /* level */, 0 /* elapsedTimeStepCount */));
+
+    EXPECT_EQ(24, decodeProbability(1, 2 /* level */, 0 /* elapsedTimeStepCount */));
+    EXPECT_EQ(16, decodeProbability(1, 2 /* level */, 31 /* elapsedTimeStepCount */));
+    EXPECT_EQ(64, decodeProbability(0, 15 /* level */, 31 /* elapsedTimeStepCount */));
+    EXPECT_EQ(150, decodeProbability(3, 15 /* level */, 31 /* elapsedTimeStepCount */));
+    // The elapsed time step count is clamped.
+    EXPECT_EQ(150, decodeProbability(3, 15 /* level */, 100 /* elapsedTimeStepCount */));
+    EXPECT_EQ(150, decodeProbability(3, 20 /* level */, 31 /* elapsedTimeStepCount */));
+
+    // Entries under the visible level don't have probabilities.
+    EXPECT_EQ(NOT_A_PROBABILITY,
+            decodeProbability(3, 0 /* level */, 0 /* elapsedTimeStepCount */));
+    EXPECT_EQ(NOT_A_PROBABILITY,
+            decodeProbability(3, 1 /* level */, 0 /* elapsedTimeStepCount */));
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/dicnode/internal/dic_node_state_scoring.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "defines.h"
+#include "suggest/core/dictionary/dictionary.h"
+#include "suggest/core/dictionary/error_type_utils.h"
+#include "suggest/core/layout/proximity_info.h"
+#include "suggest/core/result/suggestion_results.h"
+#include "suggest/core/session/dic_traverse_session.h"
+#include "test_utils/suggest_test_utils.h"
+
+namespace latinime {
+namespace {
+
+using tests::SuggestTestUtils;
+
+typedef DicNodeStateScoringT<FloatScoringArithmetic> FloatScoring;
+typedef DicNodeStateScoringT<FixedPointScoringArithmetic> FixedPointScoring;
+
+// Largest difference allowed between the fixed point and the float distances.
+const float TOLERANCE = 0.001f;
+const int CORPUS_SIZE = 2000;
+const int MAX_STEP_COUNT = 48;
+
+// Costs in the range of the ones produced by the typing and gesture weightings.
+const float SPATIAL_COSTS[] = { 0.0f, 0.04f, 0.1f, 0.2f, 0.3f, 0.5f, 0.54f, 0.9f, 1.0f, 1.52f };
+const float LANGUAGE_COSTS[] = { 0.0f, 0.0f, 0.0f, 0.25f, 0.8f, 1.47f, 2.1f, 3.3f };
+
+const size_t TOP_WORD_COUNT = 4;
+
+struct SearchExpectation {
+    std::string mInput;
+    bool mIsGesture;
+    std::vector<std::string> mTopWords;
+};
+
+struct Step {
+    float mSpatialCost;
+    float mLanguageCost;
+};
+
+class Corpus {
+ public:
+    Corpus() : mSeed(1) {}
+
+    std::vector<Step> createSteps() {
+        std::vector<Step> steps(1 + next() % MAX_STEP_COUNT);
+        for (Step &step : steps) {
+            step.mSpatialCost = SPATIAL_COSTS[next() % NELEMS(SPATIAL_COSTS)]
+                    + static_cast<float>(next() % 1000) / 10000.0f;
+            step.mLanguageCost = LANGUAGE_COSTS[next() % NELEMS(LANGUAGE_COSTS)];
+        }
+        return steps;
+    }
+
+ private:
+    uint32_t mSeed;
+
+    uint32_t next() {
+        mSeed = mSeed * 1103515245u + 12345u;
+        return mSeed >> 16;
+    }
+};
+
+template<class Scoring>
+void addSteps(const std::vector<Step> &steps, const bool doNormalization,
+        Scoring *const scoring) {
+    scoring->init();
+    for (size_t i = 0; i < steps.size(); ++i) {
+        scoring->addCost(steps[i].mSpatialCost, steps[i].mLanguageCost, doNormalization,
+                static_cast<int>(steps.size()), static_cast<int>(i + 1),
+                ErrorTypeUtils::NOT_AN_ERROR);
+    }
+}
+
+int getSign(const float value) {
+    return (value > 0.0f) ? 1 : ((value < 0.0f) ? -1 : 0);
+}
+
+void testRankingConformance(const bool doNormalization) {
+    Corpus corpus;
+    std::vector<std::unique_ptr<FloatScoring>> floatScorings;
+    std::vector<std::unique_ptr<FixedPointScoring>> fixedPointScorings;
+    for (int i = 0; i < CORPUS_SIZE; ++i) {
+        const std::vector<Step> steps = corpus.createSteps();
+        floatScorings.emplace_back(new FloatScoring());
+        fixedPointScorings.emplace_back(new FixedPointScoring());
+        addSteps(steps, doNormalization, floatScorings.back().get());
+        addSteps(steps, doNormalization, fixedPointScorings.back().get());
+        EXPECT_NEAR(floatScorings.back()->getNormalizedCompoundDistance(),
+                fixedPointScorings.back()->getNormalizedCompoundDistance(), TOLERANCE);
+        EXPECT_NEAR(floatScorings.back()->getSpatialDistance(),
+                fixedPointScorings.back()->getSpatialDistance(), TOLERANCE);
+        EXPECT_NEAR(floatScorings.back()->getLanguageDistance(),
+                fixedPointScorings.back()->getLanguageDistance(), TOLERANCE);
+    }
+    for (int i = 1; i < CORPUS_SIZE; ++i) {
+        const float diff = floatScorings[i]->getNormalizedCompoundDistance()
+                - floatScorings[i - 1]->getNormalizedCompoundDistance();
+        if (std::fabs(diff) <= TOLERANCE) {
+            continue;
+        }
+        EXPECT_EQ(getSign(diff), floatScorings[i]->compareNormalizedCompoundDistance(
+                floatScorings[i - 1].get()));
+        EXPECT_EQ(getSign(diff), fixedPointScorings[i]->compareNormalizedCompoundDistance(
+                fixedPointScorings[i - 1].get()));
+    }
+}
+
+TEST(DicNodeStateScoringTest, TestRankingConformance) {
+    testRankingConformance(false /* doNormalization */);
+}
+
+TEST(DicNodeStateScoringTest, TestRankingConformanceWithNormalization) {
+    testRankingConformance(true /* doNormalization */);
+}
+
+// Returns the first words of the ranking without the duplicated suggestions.
+std::vector<std::string> getTopWords(const Dictionary *const dictionary,
+        ProximityInfo *const proximityInfo, SuggestTestUtils::InputTrace trace,
+        const bool isGesture) {
+    const std::unique_ptr<DicTraverseSession> session(
+            DicTraverseSession::getSessionInstance(0 /* dictSize */));
+    SuggestionResults suggestionResults(MAX_RESULTS);
+    SuggestTestUtils::getSuggestions(dictionary, session.get(), proximityInfo, &trace, isGesture,
+            &suggestionResults);
+    std::vector<std::string> topWords;
+    for (const std::string &word : SuggestTestUtils::getSortedWords(&suggestionResults)) {
+        if (std::find(topWords.begin(), topWords.end(), word) != topWords.end()) {
+            continue;
+        }
+        topWords.push_back(word);
+        if (topWords.size() == TOP_WORD_COUNT) {
+            break;
+        }
+    }
+    return topWords;
+}
+
+// The rankings are the same with and without FLAG_FIXED_POINT_SCORING. This test is also built
+// into liblatinime_fixed_point_scoring_unittests, which checks the same expectations with the
+// fixed point scoring.
+TEST(DicNodeStateScoringTest, TestSearchRanking) {
+    const std::unique_ptr<Dictionary> dictionary = SuggestTestUtils::createDictionary(
+            { "hello", "help", "held", "hell", "jello", "yellow", "world", "word", "would",
+              "wild", "worlds", "the", "they", "then", "there", "their", "this", "that",
+              "keyboard", "key", "kept", "question", "quest", "quiet" },
+            { 200, 150, 140, 120, 90, 120, 200, 180, 160, 110, 100, 250, 200, 190, 210, 200,
+              230, 240, 130, 160, 100, 140, 90, 120 });
+    ASSERT_NE(nullptr, dictionary.get());
+    const std::unique_ptr<ProximityInfo> proximityInfo =
+            SuggestTestUtils::createQwertyProximityInfo();
+    const SearchExpectation expectations[] = {
+        { "hello", false, { "hello", "jello", "help", "hell" } },
+        { "helo", false, { "hello", "help", "hell", "held" } },
+        { "wprld", false, { "world", "word", "worlds", "kept" } },
+        { "wuld", false, { "would", "wild", "held", "question" } },
+        { "thw", false, { "the", "there", "they", "their" } },
+        { "thete", false, { "there", "the the", "their", "they" } },
+        { "keybord", false, { "keyboard", "key word", "key held", "key this" } },
+        { "quet", false, { "quiet", "quest", "they", "question" } },
+        { "hello", true, { "hello", "help", "hell", "jello" } },
+        { "world", true, { "world", "word", "would", "worlds" } },
+        { "their", true, { "their", "the", "there", "they" } },
+        { "keyboard", true, { "keyboard", "key", "kept", "that" } },
+        { "question", true, { "question", "quest", "then", "the" } },
+    };
+    for (const SearchExpectation &expectation : expectations) {
+        const SuggestTestUtils::InputTrace trace = expectation.mIsGesture
+                ? SuggestTestUtils::createGestureTrace(expectation.mInput)
+                : SuggestTestUtils::createTypingTrace(expectation.mInput);
+        EXPECT_EQ(expectation.mTopWords, getTopWords(dictionary.get(), proximityInfo.get(),
+                trace, expectation.mIsGesture)) << expectation.mInput;
+    }
+}
+
+TEST(DicNodeStateScoringTest, TestFixedPointSaturation) {
+    const float maxValue = static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    FixedPointScoring scoring;
+    EXPECT_FLOAT_EQ(maxValue, scoring.getNormalizedCompoundDistanceAfterFirstWord());
+    scoring.addCost(maxValue, 1.0f, false /* doNormalization */, 1 /* inputSize */,
+            1 /* totalInputIndex */, ErrorTypeUtils::NOT_AN_ERROR);
+    EXPECT_FLOAT_EQ(maxValue, scoring.getSpatialDistance());
+    EXPECT_FLOAT_EQ(maxValue, scoring.getNormalizedCompoundDistance());
+    // Saturated distances stay saturated.
+    scoring.addCost(-1.0f, 0.0f, true /* doNormalization */, 2 /* inputSize */,
+            2 /* totalInputIndex */, ErrorTypeUtils::NOT_AN_ERROR);
+    EXPECT_FLOAT_EQ(maxValue, scoring.getNormalizedCompoundDistance());
+
+    FixedPointScoring otherScoring;
+    otherScoring.addCost(1000.0f, 0.0f, false /* doNormalization */, 1 /* inputSize */,
+            1 /* totalInputIndex */, ErrorTypeUtils::NOT_AN_ERROR);
+    EXPECT_EQ(1, scoring.compareNormalizedCompoundDistance(&otherScoring));
+    EXPECT_EQ(-1, otherScoring.compareNormalizedCompoundDistance(&scoring));
+}
+
+TEST(DicNodeStateScoringTest, TestSaveDistanceAfterFirstWord) {
+    FixedPointScoring scoring;
+    scoring.addCost(0.5f, 0.25f, false /* doNormalization */, 1 /* inputSize */,
+            1 /* totalInputIndex */, ErrorTypeUtils::NOT_AN_ERROR);
+    scoring.saveNormalizedCompoundDistanceAfterFirstWordIfNoneYet();
+    EXPECT_FLOAT_EQ(0.75f, scoring.getNormalizedCompoundDistanceAfterFirstWord());
+    scoring.addCost(0.5f, 0.0f, false /* doNormalization */, 1 /* inputSize */,
+            1 /* totalInputIndex */, ErrorTypeUtils::NOT_AN_ERROR);
+    scoring.saveNormalizedCompoundDistanceAfterFirstWordIfNoneYet();
+    EXPECT_FLOAT_EQ(0.75f, scoring.getNormalizedCompoundDistanceAfterFirstWord());
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,429 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/dictionary/dictionary.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dictionary/property/historical_info.h"
+#include "dictionary/property/ngram_context.h"
+#include "dictionary/property/ngram_property.h"
+#include "suggest/core/layout/proximity_info.h"
+#include "suggest/core/result/suggestion_results.h"
+#include "suggest/core/session/dic_traverse_session.h"
+#include "suggest/core/suggest_options.h"
+#include "test_utils/suggest_test_utils.h"
+#include "utils/int_array_view.h"
+#include "utils/memory_report.h"
+
+namespace latinime {
+namespace {
+
+using tests::SuggestTestUtils;
+
+class DictionaryTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        mDictionary = SuggestTestUtils::createDictionary(
+                { "hello", "help", "world", "word", "would", "yellow" },
+                { 200, 150, 200, 180, 160, 120 });
+        ASSERT_NE(nullptr, mDictionary.get());
+        mProximityInfo = SuggestTestUtils::createQwertyProximityInfo();
+        mSession.reset(DicTraverseSession::getSessionInstance(0 /* dictSize */));
+    }
+
+    std::vector<std::string> getSuggestions(SuggestTestUtils::InputTrace trace,
+            const bool isGesture) {
+        SuggestionResults suggestionResults(MAX_RESULTS);
+        SuggestTestUtils::getSuggestions(mDictionary.get(), mSession.get(),
+                mProximityInfo.get(), &trace, isGesture, &suggestionResults);
+        return SuggestTestUtils::getSortedWords(&suggestionResults);
+    }
+
+    static NgramContext createNgramContext(const std::string &prevWord) {
+        const std::vector<int> codePoints = SuggestTestUtils::toCodePoints(prevWord);
+        return NgramContext(codePoints.data(), codePoints.size(),
+                false /* isBeginningOfSentence */);
+    }
+
+    static bool addNgramEntry(Dictionary *const dictionary, const std::string &prevWord,
+            const std::string &word) {
+        const NgramProperty ngramProperty(createNgramContext(prevWord),
+                SuggestTestUtils::toCodePoints(word), 200 /* probability */, HistoricalInfo());
+        return dictionary->addNgramEntry(&ngramProperty);
+    }
+
+    // Returns the consumed predictions, or nothing when they could not be consumed.
+    std::vector<std::string> consumePrefetchedPredictions(const Dictionary *const dictionary,
+            const int ngramContextId) {
+        SuggestionResults suggestionResults(MAX_RESULTS);
+        if (!mSession->consumePrefetchedPredictions(dictionary, ngramContextId,
+                &suggestionResults)) {
+            return std::vector<std::string>();
+        }
+        return SuggestTestUtils::getSortedWords(&suggestionResults);
+    }
+
+    // Searches the dictionaries one after another with sessions of their own, as
+    // DictionaryFacilitatorImpl did: the in-out weight of the language model is shared by the
+    // searches, and duplicated words are removed afterwards keeping the best score. Returns the
+    // words with their scores in the order of sortByScore(), and the weight left by the last
+    // search.
+    std::vector<std::string> getSuggestionsOneByOne(
+            const std::vector<const Dictionary *> &dictionaries,
+            const std::vector<float> &dictionaryWeights,
+            SuggestTestUtils::InputTrace *const trace, const bool isGesture,
+            float *const outWeightOfLangModelVsSpatialModel) {
+        float weightOfLangModelVsSpatialModel = NOT_A_WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL;
+        std::map<std::string, int> bestScores;
+        for (size_t i = 0; i < dictionaries.size(); ++i) {
+            std::unique_ptr<DicTraverseSession> session(
+                    DicTraverseSession::getSessionInstance(0 /* dictSize */));
+            SuggestionResults suggestionResults(MAX_RESULTS);
+            SuggestTestUtils::getSuggestionsWithWeight(dictionaries[i], session.get(),
+                    mProximityInfo.get(), trace, isGesture, weightOfLangModelVsSpatialModel,
+                    &suggestionResults);
+            EXPECT_NE(mSession->getProximityInfoState(0), session->getProximityInfoState(0));
+            weightOfLangModelVsSpatialModel =
+                    suggestionResults.getWeightOfLangModelVsSpatialModel();
+            for (const std::string &wordWithScore :
+                    SuggestTestUtils::getSortedWordsWithScores(&suggestionResults)) {
+                const size_t separator = wordWithScore.rfind(':');
+                const std::string word = wordWithScore.substr(0, separator);
+                const int score = static_cast<int>(static_cast<float>(
+                        atoi(wordWithScore.c_str() + separator + 1)) * dictionaryWeights[i]);
+                if (bestScores.find(word) == bestScores.end() || bestScores[word] < score) {
+                    bestScores[word] = score;
+                }
+            }
+        }
+        *outWeightOfLangModelVsSpatialModel = weightOfLangModelVsSpatialModel;
+        std::vector<std::string> wordsWithScores;
+        for (const auto &bestScore : bestScores) {
+            wordsWithScores.push_back(bestScore.first + ":" + std::to_string(bestScore.second));
+        }
+        wordsWithScores = sortByScore(wordsWithScores);
+        if (wordsWithScores.size() > static_cast<size_t>(MAX_RESULTS)) {
+            wordsWithScores.resize(MAX_RESULTS);
+        }
+        return wordsWithScores;
+    }
+
+    // Sorts "word:score" strings from the best score. Ties are broken as in SuggestionResults,
+    // by preferring the shorter word, and then alphabetically.
+    static std::vector<std::string> sortByScore(std::vector<std::string> wordsWithScores) {
+        const auto getScore = [](const std::string &wordWithScore) {
+            return atoi(wordWithScore.c_str() + wordWithScore.rfind(':') + 1);
+        };
+        std::sort(wordsWithScores.begin(), wordsWithScores.end(),
+                [&getScore](const std::string &left, const std::string &right) {
+                    if (getScore(left) != getScore(right)) {
+                        return getScore(left) > getScore(right);
+                    }
+                    if (left.size() != right.size()) {
+                        return left.size() < right.size();
+                    }
+                    return left < right;
+                });
+        return wordsWithScores;
+    }
+
+    std::unique_ptr<Dictionary> mDictionary;
+    std::unique_ptr<ProximityInfo> mProximityInfo;
+    std::unique_ptr<DicTraverseSession> mSession;
+};
+
+TEST_F(DictionaryTest, TestTypingSuggestions) {
+    const std::vector<std::string> words =
+            getSuggestions(SuggestTestUtils::createTypingTrace("hello"), false /* isGesture */);
+    ASSERT_FALSE(words.empty());
+    EXPECT_EQ("hello", words[0]);
+}
+
+TEST_F(DictionaryTest, TestTypingCorrection) {
+    // 'p' is next to 'o'.
+    const std::vector<std::string> words =
+            getSuggestions(SuggestTestUtils::createTypingTrace("wprld"), false /* isGesture */);
+    ASSERT_FALSE(words.empty());
+    EXPECT_EQ("world", words[0]);
+}
+
+TEST_F(DictionaryTest, TestGestureSuggestions) {
+    for (const std::string word : { "hello", "help", "world", "word", "yellow" }) {
+        const std::vector<std::string> words =
+                getSuggestions(SuggestTestUtils::createGestureTrace(word), true /* isGesture */);
+        ASSERT_FALSE(words.empty()) << word;
+        EXPECT_EQ(word, words[0]);
+    }
+}
+
+TEST_F(DictionaryTest, TestContinuedGestureSuggestions) {
+    // The session is reused for the same gesture as when the keyboard updates the suggestions.
+    const SuggestTestUtils::InputTrace trace = SuggestTestUtils::createGestureTrace("world");
+    for (int i = 0; i < 3; ++i) {
+        const std::vector<std::string> words = getSuggestions(trace, true /* isGesture */);
+        ASSERT_FALSE(words.empty());
+        EXPECT_EQ("world", words[0]);
+    }
+}
+
+TEST_F(DictionaryTest, TestMemoryReport) {
+    MemoryReport memoryReport;
+    mDictionary->getMemoryReport(&memoryReport);
+    bool hasTrie = false;
+    for (const auto &component : memoryReport.getComponents()) {
+        if (component.getName() == "trie") {
+            hasTrie = true;
+            // The on-memory dictionary has no mapped buffer.
+            EXPECT_EQ(0, component.getMemoryUsage().getMappedSize());
+            EXPECT_GT(component.getMemoryUsage().getHeapSize(), 0);
+        }
+    }
+    EXPECT_TRUE(hasTrie);
+
+    const std::string query = "MEMORY_REPORT";
+    char result[1024];
+    mDictionary->getProperty(query.c_str(), query.size(), result, NELEMS(result));
+    const std::string dump(result);
+    EXPECT_NE(std::string::npos, dump.find("\ntrie=0,0,"));
+    // The keyboard layouts are reported after the dictionary.
+    EXPECT_NE(std::string::npos, dump.find("\nproximity_info=0,0,"));
+    EXPECT_NE(std::string::npos, dump.find("\ntotal=0,0,"));
+}
+
+TEST_F(DictionaryTest, TestSessionMemoryReport) {
+    getSuggestions(SuggestTestUtils::createTypingTrace("hello"), false /* isGesture */);
+    MemoryReport memoryReport;
+    mSession->getMemoryReport(&memoryReport);
+    std::vector<std::string> names;
+    for (const auto &component : memoryReport.getComponents()) {
+        names.push_back(component.getName());
+        EXPECT_EQ(0, component.getMemoryUsage().getMappedSize());
+    }
+    // The layout is owned by Java and may be freed after the search, so it is not included.
+    const std::vector<std::string> expectedNames =
+            { "session", "dic_nodes_cache", "multi_bigram_map" };
+    EXPECT_EQ(expectedNames, names);
+    EXPECT_GT(memoryReport.getComponents()[1].getMemoryUsage().getHeapSize(),
+            static_cast<int64_t>(sizeof(DicNode)));
+    // The session must not touch the layout it was last set up with.
+    mProximityInfo.reset();
+    MemoryReport memoryReportAfterLayoutChange;
+    mSession->getMemoryReport(&memoryReportAfterLayoutChange);
+    EXPECT_EQ(memoryReport.getTotal().getHeapSize(),
+            memoryReportAfterLayoutChange.getTotal().getHeapSize());
+}
+
+TEST_F(DictionaryTest, TestProximityInfoMemoryUsage) {
+    const MemoryUsage memoryUsage = mProximityInfo->getMemoryUsage();
+    EXPECT_EQ(0, memoryUsage.getMappedSize());
+    EXPECT_GT(memoryUsage.getHeapSize(), static_cast<int64_t>(sizeof(ProximityInfo)));
+}
+
+TEST_F(DictionaryTest, TestGetSuggestionsFromDictionaries) {
+    std::unique_ptr<Dictionary> secondDictionary = SuggestTestUtils::createDictionary(
+            { "hellp", "yellow", "wold", "would" }, { 180, 170, 150, 140 });
+    ASSERT_NE(nullptr, secondDictionary.get());
+    std::unique_ptr<DicTraverseSession> secondSession(
+            DicTraverseSession::getSessionInstance(0 /* dictSize */));
+    const std::vector<const Dictionary *> dictionaries =
+            { mDictionary.get(), secondDictionary.get() };
+    const std::vector<DicTraverseSession *> sessions = { mSession.get(), secondSession.get() };
+    const std::vector<float> dictionaryWeights = { 1.0f, 1.0f };
+
+    for (const bool isGesture : { false, true }) {
+        for (const std::string word : { "hello", "wprld", "yellow" }) {
+            SuggestTestUtils::InputTrace trace = isGesture
+                    ? SuggestTestUtils::createGestureTrace(word)
+                    : SuggestTestUtils::createTypingTrace(word);
+            SuggestionResults mergedResults(MAX_RESULTS);
+            SuggestTestUtils::getSuggestionsFromDictionaries(dictionaries, sessions,
+                    dictionaryWeights, mProximityInfo.get(), &trace, isGesture, &mergedResults);
+            // The second session searched with the input states of the first one.
+            for (int i = 0; i < MAX_POINTER_COUNT_G; ++i) {
+                EXPECT_EQ(mSession->getProximityInfoState(i),
+                        secondSession->getProximityInfoState(i));
+            }
+            const std::vector<std::string> mergedWords =
+                    sortByScore(SuggestTestUtils::getSortedWordsWithScores(&mergedResults));
+            ASSERT_FALSE(mergedWords.empty()) << word;
+            float weightOfLangModelVsSpatialModel = NOT_A_WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL;
+            EXPECT_EQ(getSuggestionsOneByOne(dictionaries, dictionaryWeights, &trace, isGesture,
+                    &weightOfLangModelVsSpatialModel), mergedWords)
+                    << word << (isGesture ? " gesture" : " typing");
+            EXPECT_NE(NOT_A_WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL,
+                    mergedResults.getWeightOfLangModelVsSpatialModel());
+            EXPECT_EQ(weightOfLangModelVsSpatialModel,
+                    mergedResults.getWeightOfLangModelVsSpatialModel());
+        }
+    }
+    // Searching the second dictionary alone restores its own input states.
+    SuggestTestUtils::InputTrace trace = SuggestTestUtils::createTypingTrace("yellow");
+    SuggestionResults suggestionResults(MAX_RESULTS);
+    secondSession->setSharedInputSession(nullptr);
+    SuggestTestUtils::getSuggestions(secondDictionary.get(), secondSession.get(),
+            mProximityInfo.get(), &trace, false /* isGesture */, &suggestionResults);
+    EXPECT_NE(mSession->getProximityInfoState(0), secondSession->getProximityInfoState(0));
+}
+
+TEST_F(DictionaryTest, TestGetSuggestionsFromDictionariesWithoutDuplicates) {
+    // Both dictionaries have the same words close to "hello", more than MAX_RESULTS of them.
+    std::vector<std::string> words;
+    std::vector<int> probabilities;
+    std::vector<int> otherProbabilities;
+    const std::string word = "hello";
+    const std::string replacements = "gjwrkpi";
+    for (size_t i = 0; i < word.size(); ++i) {
+        for (const char replacement : replacements) {
+            std::string replacedWord = word;
+            replacedWord[i] = replacement;
+            words.push_back(replacedWord);
+            probabilities.push_back(100 + static_cast<int>(words.size()) * 3);
+            otherProbabilities.push_back(200 - static_cast<int>(words.size()) * 3);
+        }
+    }
+    ASSERT_GT(words.size(), static_cast<size_t>(MAX_RESULTS));
+    std::unique_ptr<Dictionary> firstDictionary =
+            SuggestTestUtils::createDictionary(words, probabilities);
+    std::unique_ptr<Dictionary> secondDictionary =
+            SuggestTestUtils::createDictionary(words, otherProbabilities);
+    ASSERT_NE(nullptr, firstDictionary.get());
+    ASSERT_NE(nullptr, secondDictionary.get());
+    std::unique_ptr<DicTraverseSession> secondSession(
+            DicTraverseSession::getSessionInstance(0 /* dictSize */));
+    const std::vector<const Dictionary *> dictionaries =
+            { firstDictionary.get(), secondDictionary.get() };
+    const std::vector<DicTraverseSession *> sessions = { mSession.get(), secondSession.get() };
+    const std::vector<float> dictionaryWeights = { 1.0f, 0.9f };
+
+    SuggestTestUtils::InputTrace trace = SuggestTestUtils::createTypingTrace(word);
+    SuggestionResults mergedResults(MAX_RESULTS);
+    SuggestTestUtils::getSuggestionsFromDictionaries(dictionaries, sessions, dictionaryWeights,
+            mProximityInfo.get(), &trace, false /* isGesture */, &mergedResults);
+    const std::vector<std::string> mergedWords =
+            sortByScore(SuggestTestUtils::getSortedWordsWithScores(&mergedResults));
+    // Every slot holds a different word.
+    ASSERT_EQ(static_cast<size_t>(MAX_RESULTS), mergedWords.size());
+    std::vector<std::string> uniqueWords;
+    for (const std::string &wordWithScore : mergedWords) {
+        uniqueWords.push_back(wordWithScore.substr(0, wordWithScore.rfind(':')));
+    }
+    std::sort(uniqueWords.begin(), uniqueWords.end());
+    EXPECT_EQ(uniqueWords.end(), std::unique(uniqueWords.begin(), uniqueWords.end()));
+    float weightOfLangModelVsSpatialModel = NOT_A_WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL;
+    EXPECT_EQ(getSuggestionsOneByOne(dictionaries, dictionaryWeights, &trace,
+            false /* isGesture */, &weightOfLangModelVsSpatialModel), mergedWords);
+}
+
+TEST_F(DictionaryTest, TestGetSuggestionsFromDictionariesWithOwnOptions) {
+    std::unique_ptr<Dictionary> secondDictionary =
+            SuggestTestUtils::createDictionary({ "hello" }, { 200 });
+    ASSERT_NE(nullptr, secondDictionary.get());
+    std::unique_ptr<DicTraverseSession> secondSession(
+            DicTraverseSession::getSessionInstance(0 /* dictSize */));
+    const std::vector<const Dictionary *> dictionaries =
+            { mDictionary.get(), secondDictionary.get() };
+    const std::vector<DicTraverseSession *> sessions = { mSession.get(), secondSession.get() };
+    const std::vector<float> dictionaryWeights = { 1.0f, 1.0f };
+    // The main dictionary does not use the full edit distance, unlike the other dictionaries.
+    const std::vector<int> options =
+            SuggestTestUtils::createOptions(false /* isGesture */, false /* useFullEditDistance */);
+    const std::vector<int> otherOptions =
+            SuggestTestUtils::createOptions(false /* isGesture */, true /* useFullEditDistance */);
+    const SuggestOptions suggestOptions(options.data(), options.size());
+    const SuggestOptions otherSuggestOptions(otherOptions.data(), otherOptions.size());
+    const std::vector<const SuggestOptions *> suggestOptionsList =
+            { &suggestOptions, &otherSuggestOptions };
+
+    SuggestTestUtils::InputTrace trace = SuggestTestUtils::createTypingTrace("hello");
+    const NgramContext emptyNgramContext;
+    SuggestionResults suggestionResults(MAX_RESULTS);
+    Dictionary::getSuggestionsFromDictionaries(dictionaries.data(), sessions.data(),
+            suggestOptionsList.data(), dictionaryWeights.data(),
+            static_cast<int>(dictionaries.size()), mProximityInfo.get(),
+            trace.mXCoordinates.data(), trace.mYCoordinates.data(), trace.mTimes.data(),
+            trace.mPointerIds.data(), trace.mCodePoints.data(), trace.size(), &emptyNgramContext,
+            NOT_A_WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL, &suggestionResults);
+    EXPECT_FALSE(mSession->getSuggestOptions()->useFullEditDistance());
+    EXPECT_TRUE(secondSession->getSuggestOptions()->useFullEditDistance());
+}
+
+TEST_F(DictionaryTest, TestConsumePrefetchedPredictions) {
+    ASSERT_TRUE(addNgramEntry(mDictionary.get(), "hello", "world"));
+    const NgramContext ngramContext = createNgramContext("hello");
+    mSession->cacheNgramContext(1 /* ngramContextId */, &ngramContext);
+    ASSERT_TRUE(mSession->prefetchPredictions(mDictionary.get(), 1 /* ngramContextId */));
+
+    SuggestionResults expectedResults(MAX_RESULTS);
+    mDictionary->getPredictions(&ngramContext, &expectedResults);
+    const std::vector<std::string> expectedWords =
+            SuggestTestUtils::getSortedWords(&expectedResults);
+    ASSERT_FALSE(expectedWords.empty());
+    EXPECT_EQ("world", expectedWords[0]);
+    EXPECT_EQ(expectedWords, consumePrefetchedPredictions(mDictionary.get(), 1));
+    // Prefetched predictions are used only once.
+    EXPECT_TRUE(consumePrefetchedPredictions(mDictionary.get(), 1).empty());
+}
+
+TEST_F(DictionaryTest, TestPrefetchPredictionsWithoutCachedContext) {
+    EXPECT_FALSE(mSession->prefetchPredictions(mDictionary.get(), 1 /* ngramContextId */));
+    EXPECT_TRUE(consumePrefetchedPredictions(mDictionary.get(), 1).empty());
+}
+
+TEST_F(DictionaryTest, TestPrefetchedPredictionsForOtherContext) {
+    ASSERT_TRUE(addNgramEntry(mDictionary.get(), "hello", "world"));
+    const NgramContext ngramContext = createNgramContext("hello");
+    mSession->cacheNgramContext(1 /* ngramContextId */, &ngramContext);
+    ASSERT_TRUE(mSession->prefetchPredictions(mDictionary.get(), 1 /* ngramContextId */));
+    EXPECT_TRUE(consumePrefetchedPredictions(mDictionary.get(), 2).empty());
+}
+
+TEST_F(DictionaryTest, TestPrefetchedPredictionsAfterUpdate) {
+    ASSERT_TRUE(addNgramEntry(mDictionary.get(), "hello", "world"));
+    const NgramContext ngramContext = createNgramContext("hello");
+    mSession->cacheNgramContext(1 /* ngramContextId */, &ngramContext);
+    ASSERT_TRUE(mSession->prefetchPredictions(mDictionary.get(), 1 /* ngramContextId */));
+    ASSERT_TRUE(addNgramEntry(mDictionary.get(), "hello", "yellow"));
+    // The predictions were computed before "yellow" was added.
+    EXPECT_TRUE(consumePrefetchedPredictions(mDictionary.get(), 1).empty());
+
+    ASSERT_TRUE(mSession->prefetchPredictions(mDictionary.get(), 1 /* ngramContextId */));
+    const std::vector<int> removedWord = SuggestTestUtils::toCodePoints("yellow");
+    ASSERT_TRUE(mDictionary->removeNgramEntry(&ngramContext, CodePointArrayView(removedWord)));
+    EXPECT_TRUE(consumePrefetchedPredictions(mDictionary.get(), 1).empty());
+}
+
+TEST_F(DictionaryTest, TestPrefetchedPredictionsForOtherDictionary) {
+    ASSERT_TRUE(addNgramEntry(mDictionary.get(), "hello", "world"));
+    const NgramContext ngramContext = createNgramContext("hello");
+    mSession->cacheNgramContext(1 /* ngramContextId */, &ngramContext);
+    ASSERT_TRUE(mSession->prefetchPredictions(mDictionary.get(), 1 /* ngramContextId */));
+    // Same as a dictionary reloaded with the same contents, possibly at the same address.
+    mDictionary = SuggestTestUtils::createDictionary({ "hello", "world" }, { 200, 200 });
+    ASSERT_NE(nullptr, mDictionary.get());
+    ASSERT_TRUE(addNgramEntry(mDictionary.get(), "hello", "world"));
+    EXPECT_TRUE(consumePrefetchedPredictions(mDictionary.get(), 1).empty());
+}
+
+}  // namespace
+}  // namespace latinime
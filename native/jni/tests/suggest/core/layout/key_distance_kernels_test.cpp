@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/key_distance_kernels.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "defines.h"
+#include "suggest/core/layout/proximity_info.h"
+
+namespace latinime {
+namespace {
+
+const int KEYBOARD_WIDTH = 400;
+const int KEYBOARD_HEIGHT = 300;
+const int GRID_WIDTH = 8;
+const int GRID_HEIGHT = 6;
+const int KEY_WIDTH = 40;
+const int KEY_HEIGHT = 100;
+
+uint32_t toBits(const float value) {
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Two rows of normal keys and a wide space key at the bottom, with or without sweet spots.
+std::unique_ptr<ProximityInfo> createProximityInfo(const bool hasSweetSpots) {
+    std::vector<int> keyXs, keyYs, keyWidths, keyHeights, codePoints;
+    std::vector<float> sweetSpotXs, sweetSpotYs, sweetSpotRadii;
+    for (int i = 0; i < 18; ++i) {
+        keyXs.push_back((i % 9) * KEY_WIDTH + (i / 9) * KEY_WIDTH / 2);
+        keyYs.push_back((i / 9) * KEY_HEIGHT);
+        keyWidths.push_back(KEY_WIDTH);
+        keyHeights.push_back(KEY_HEIGHT);
+        codePoints.push_back('a' + i);
+    }
+    keyXs.push_back(KEY_WIDTH);
+    keyYs.push_back(2 * KEY_HEIGHT);
+    keyWidths.push_back(5 * KEY_WIDTH + 1);
+    keyHeights.push_back(KEY_HEIGHT);
+    codePoints.push_back(KEYCODE_SPACE);
+    for (size_t i = 0; i < keyXs.size(); ++i) {
+        sweetSpotXs.push_back(static_cast<float>(keyXs[i] + keyWidths[i] / 2) + 1.5f);
+        sweetSpotYs.push_back(static_cast<float>(keyYs[i] + keyHeights[i] / 2) + 7.25f);
+        sweetSpotRadii.push_back(20.0f);
+    }
+    const std::vector<int> proximityChars(GRID_WIDTH * GRID_HEIGHT * MAX_PROXIMITY_CHARS_SIZE,
+            NOT_A_CODE_POINT);
+    return std::unique_ptr<ProximityInfo>(new ProximityInfo(KEYBOARD_WIDTH, KEYBOARD_HEIGHT,
+            GRID_WIDTH, GRID_HEIGHT, KEY_WIDTH, KEY_HEIGHT, proximityChars.data(),
+            static_cast<int>(proximityChars.size()), static_cast<int>(keyXs.size()),
+            keyXs.data(), keyYs.data(), keyWidths.data(), keyHeights.data(), codePoints.data(),
+            hasSweetSpots ? sweetSpotXs.data() : nullptr,
+            hasSweetSpots ? sweetSpotYs.data() : nullptr,
+            hasSweetSpots ? sweetSpotRadii.data() : nullptr));
+}
+
+void expectSameAsSingleKeyDistances(const ProximityInfo *const proximityInfo,
+        const bool isGeometric) {
+    float distances[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    for (int y = -1; y <= KEYBOARD_HEIGHT + 20; y += 7) {
+        for (int x = -1; x <= KEYBOARD_WIDTH + 20; x += 5) {
+            proximityInfo->getNormalizedSquaredDistancesFromCentersG(x, y, isGeometric,
+                    distances);
+            for (int keyId = 0; keyId < proximityInfo->getKeyCount(); ++keyId) {
+                ASSERT_EQ(toBits(proximityInfo->getNormalizedSquaredDistanceFromCenterFloatG(
+                        keyId, x, y, isGeometric)), toBits(distances[keyId]))
+                        << "key " << keyId << " at (" << x << ", " << y << ")";
+            }
+        }
+    }
+}
+
+TEST(KeyDistanceKernelsTest, TestSameAsSingleKeyDistances) {
+    for (const bool hasSweetSpots : { false, true }) {
+        const std::unique_ptr<ProximityInfo> proximityInfo = createProximityInfo(hasSweetSpots);
+        expectSameAsSingleKeyDistances(proximityInfo.get(), false /* isGeometric */);
+        expectSameAsSingleKeyDistances(proximityInfo.get(), true /* isGeometric */);
+    }
+}
+
+TEST(KeyDistanceKernelsTest, TestVectorKernelIsBitExact) {
+    KeyDistanceKernels::KeyCenters keyCenters;
+    uint32_t seed = 7;
+    for (int i = 0; i < MAX_KEY_COUNT_IN_A_KEYBOARD; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        const float centerX = static_cast<float>((seed >> 8) % 2000) - 500.0f;
+        const float centerY = static_cast<float>((seed >> 4) % 1500) - 300.0f;
+        keyCenters.mMinCenterXs[i] = centerX - static_cast<float>(i % 3) * 17.0f;
+        keyCenters.mMaxCenterXs[i] = centerX + static_cast<float>(i % 3) * 17.0f;
+        keyCenters.mCenterYs[i] = centerY;
+        keyCenters.mMaxCenterYs[i] = (i % 5 == 0) ? 1e30f : centerY;
+    }
+    float distances[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    float scalarDistances[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    // Odd key counts exercise the scalar tail of the vector kernels.
+    for (const int keyCount : { 1, 3, 4, 27, MAX_KEY_COUNT_IN_A_KEYBOARD }) {
+        for (int j = 0; j < 200; ++j) {
+            seed = seed * 1103515245u + 12345u;
+            const int x = static_cast<int>((seed >> 8) % 3000) - 1000;
+            const int y = static_cast<int>((seed >> 4) % 3000) - 1000;
+            const float normalizer = 1.0f + static_cast<float>(j % 97) * 31.3f;
+            KeyDistanceKernels::getNormalizedSquaredDistances(&keyCenters, keyCount, x, y,
+                    normalizer, distances);
+            KeyDistanceKernels::getNormalizedSquaredDistancesScalar(&keyCenters, keyCount, x, y,
+                    normalizer, scalarDistances);
+            for (int i = 0; i < keyCount; ++i) {
+                ASSERT_EQ(toBits(scalarDistances[i]), toBits(distances[i]));
+            }
+        }
+    }
+}
+
+}  // namespace
+}  // namespace latinime
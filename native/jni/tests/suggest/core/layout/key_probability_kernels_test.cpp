@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/key_probability_kernels.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "defines.h"
+
+namespace latinime {
+namespace {
+
+uint32_t toBits(const float value) {
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Probabilities in [0, 1) with some zeros, ties and other special values.
+void fillProbabilities(const int offset, uint32_t *const seed, float *const outProbabilities) {
+    for (int i = 0; i < MAX_KEY_COUNT_IN_A_KEYBOARD; ++i) {
+        *seed = *seed * 1103515245u + 12345u;
+        const int index = i + offset;
+        if (index % 11 == 0) {
+            outProbabilities[i] = 0.0f;
+        } else if (index % 13 == 0) {
+            outProbabilities[i] = 0.25f;
+        } else if (index % 29 == 0) {
+            outProbabilities[i] = std::numeric_limits<float>::denorm_min();
+        } else if (index % 31 == 0) {
+            outProbabilities[i] = std::numeric_limits<float>::quiet_NaN();
+        } else {
+            outProbabilities[i] = static_cast<float>((*seed >> 8) % 100000) / 100000.0f;
+        }
+    }
+}
+
+TEST(KeyProbabilityKernelsTest, TestNormalizeProbabilitiesIsBitExact) {
+    float probabilities[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    float scalarProbabilities[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    uint32_t seed = 7;
+    // Odd key counts exercise the scalar tail of the vector kernels.
+    for (const int keyCount : { 1, 3, 4, 27, MAX_KEY_COUNT_IN_A_KEYBOARD }) {
+        for (int j = 0; j < 200; ++j) {
+            fillProbabilities(j, &seed, probabilities);
+            memcpy(scalarProbabilities, probabilities, sizeof(probabilities));
+            const float inputCharProbability = 1.0f - static_cast<float>(j % 7) * 0.1f;
+            const float sumOfProbabilityDensities =
+                    (j % 17 == 0) ? 1e-30f : 0.001f + static_cast<float>(j) * 0.37f;
+            KeyProbabilityKernels::normalizeProbabilities(keyCount, inputCharProbability,
+                    sumOfProbabilityDensities, probabilities);
+            KeyProbabilityKernels::normalizeProbabilitiesScalar(keyCount, inputCharProbability,
+                    sumOfProbabilityDensities, scalarProbabilities);
+            for (int i = 0; i < MAX_KEY_COUNT_IN_A_KEYBOARD; ++i) {
+                ASSERT_EQ(toBits(scalarProbabilities[i]), toBits(probabilities[i]))
+                        << "key " << i << " of " << keyCount;
+            }
+        }
+    }
+}
+
+TEST(KeyProbabilityKernelsTest, TestSuppressProbabilitiesIsBitExact) {
+    float probabilities0[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    float probabilities1[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    float scalarProbabilities0[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    float suppressions[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    float scalarSuppressions[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    uint32_t seed = 11;
+    for (const int keyCount : { 1, 3, 4, 27, MAX_KEY_COUNT_IN_A_KEYBOARD }) {
+        for (int j = 0; j < 200; ++j) {
+            fillProbabilities(j, &seed, probabilities0);
+            fillProbabilities(j + 1, &seed, probabilities1);
+            memcpy(scalarProbabilities0, probabilities0, sizeof(probabilities0));
+            const float suppressionRate = 0.1f + static_cast<float>(j % 9) * 0.1f;
+            KeyProbabilityKernels::suppressProbabilities(keyCount, suppressionRate,
+                    probabilities1, probabilities0, suppressions);
+            KeyProbabilityKernels::suppressProbabilitiesScalar(keyCount, suppressionRate,
+                    probabilities1, scalarProbabilities0, scalarSuppressions);
+            for (int i = 0; i < keyCount; ++i) {
+                ASSERT_EQ(toBits(scalarProbabilities0[i]), toBits(probabilities0[i]))
+                        << "key " << i << " of " << keyCount;
+                ASSERT_EQ(toBits(scalarSuppressions[i]), toBits(suppressions[i]))
+                        << "key " << i << " of " << keyCount;
+            }
+            for (int i = keyCount; i < MAX_KEY_COUNT_IN_A_KEYBOARD; ++i) {
+                ASSERT_EQ(toBits(scalarProbabilities0[i]), toBits(probabilities0[i]));
+            }
+        }
+    }
+}
+
+TEST(KeyProbabilityKernelsTest, TestSuppressProbabilities) {
+    float probabilities0[] = { 0.5f, 0.2f, 0.3f, 0.0f, 0.4f };
+    const float probabilities1[] = { 0.4f, 0.6f, 0.3f, 0.1f, 0.8f };
+    float suppressions[5];
+    KeyProbabilityKernels::suppressProbabilities(5 /* keyCount */, 0.5f /* suppressionRate */,
+            probabilities1, probabilities0, suppressions);
+    const float expectedProbabilities0[] = { 0.5f, 0.1f, 0.3f, 0.0f, 0.2f };
+    const float expectedSuppressions[] = { 0.0f, 0.1f, 0.0f, 0.0f, 0.2f };
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_FLOAT_EQ(expectedProbabilities0[i], probabilities0[i]);
+        EXPECT_FLOAT_EQ(expectedSuppressions[i], suppressions[i]);
+    }
+}
+
+}  // namespace
+}  // namespace latinime
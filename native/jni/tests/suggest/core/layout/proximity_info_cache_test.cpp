@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/proximity_info_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "suggest/core/layout/proximity_info.h"
+#include "test_utils/suggest_test_utils.h"
+#include "utils/memory_report.h"
+
+namespace latinime {
+namespace {
+
+using tests::SuggestTestUtils;
+
+ProximityInfo *createProximityInfo() {
+    return SuggestTestUtils::createQwertyProximityInfo().release();
+}
+
+TEST(ProximityInfoCacheTest, TestAcquire) {
+    ProximityInfoCache cache(2 /* maxCachedLayoutCount */);
+    EXPECT_EQ(nullptr, cache.acquire(1));
+    ProximityInfo *const proximityInfo = cache.add(1, createProximityInfo());
+    ASSERT_NE(nullptr, proximityInfo);
+    EXPECT_EQ(proximityInfo, cache.acquire(1));
+    EXPECT_EQ(nullptr, cache.acquire(2));
+    EXPECT_TRUE(cache.release(proximityInfo));
+    EXPECT_TRUE(cache.release(proximityInfo));
+    EXPECT_FALSE(cache.release(proximityInfo));
+    // Released layouts stay in the cache.
+    EXPECT_EQ(proximityInfo, cache.acquire(1));
+    EXPECT_EQ(1, cache.getLayoutCount());
+    EXPECT_TRUE(cache.release(proximityInfo));
+}
+
+TEST(ProximityInfoCacheTest, TestEviction) {
+    ProximityInfoCache cache(2 /* maxCachedLayoutCount */);
+    ProximityInfo *const proximityInfo1 = cache.add(1, createProximityInfo());
+    ProximityInfo *const proximityInfo2 = cache.add(2, createProximityInfo());
+    EXPECT_TRUE(cache.release(proximityInfo2));
+    // Makes the layout 2 the least recently used one.
+    EXPECT_EQ(proximityInfo1, cache.acquire(1));
+    ProximityInfo *const proximityInfo3 = cache.add(3, createProximityInfo());
+    EXPECT_EQ(2, cache.getCachedLayoutCount());
+    EXPECT_EQ(nullptr, cache.acquire(2));
+    EXPECT_EQ(2, cache.getLayoutCount());
+
+    // The layout 1 is evicted but still used.
+    EXPECT_TRUE(cache.release(proximityInfo3));
+    EXPECT_EQ(proximityInfo3, cache.acquire(3));
+    ProximityInfo *const proximityInfo4 = cache.add(4, createProximityInfo());
+    EXPECT_EQ(nullptr, cache.acquire(1));
+    EXPECT_EQ(3, cache.getLayoutCount());
+    EXPECT_TRUE(cache.release(proximityInfo1));
+    EXPECT_TRUE(cache.release(proximityInfo1));
+    EXPECT_EQ(2, cache.getLayoutCount());
+    EXPECT_TRUE(cache.release(proximityInfo3));
+    EXPECT_TRUE(cache.release(proximityInfo4));
+    EXPECT_EQ(2, cache.getCachedLayoutCount());
+}
+
+TEST(ProximityInfoCacheTest, TestNoFingerprint) {
+    ProximityInfoCache cache(2 /* maxCachedLayoutCount */);
+    ProximityInfo *const proximityInfo =
+            cache.add(ProximityInfoCache::NO_FINGERPRINT, createProximityInfo());
+    EXPECT_EQ(0, cache.getCachedLayoutCount());
+    EXPECT_EQ(nullptr, cache.acquire(ProximityInfoCache::NO_FINGERPRINT));
+    EXPECT_TRUE(cache.release(proximityInfo));
+    EXPECT_EQ(0, cache.getLayoutCount());
+}
+
+TEST(ProximityInfoCacheTest, TestMemoryReport) {
+    ProximityInfoCache cache(2 /* maxCachedLayoutCount */);
+    ProximityInfo *const cachedProximityInfo = cache.add(1, createProximityInfo());
+    ProximityInfo *const proximityInfo =
+            cache.add(ProximityInfoCache::NO_FINGERPRINT, createProximityInfo());
+    const int64_t layoutHeapSize = cachedProximityInfo->getMemoryUsage().getHeapSize();
+    MemoryReport memoryReport;
+    cache.getMemoryReport(&memoryReport);
+    ASSERT_EQ(1u, memoryReport.getComponents().size());
+    const MemoryReport::Component &component = memoryReport.getComponents()[0];
+    EXPECT_EQ("proximity_info", component.getName());
+    EXPECT_EQ(0, component.getMemoryUsage().getMappedSize());
+    EXPECT_GT(component.getMemoryUsage().getHeapSize(), 2 * layoutHeapSize);
+
+    // The layout without a fingerprint is freed when released; the cached one stays.
+    EXPECT_TRUE(cache.release(proximityInfo));
+    EXPECT_TRUE(cache.release(cachedProximityInfo));
+    MemoryReport memoryReportAfterRelease;
+    cache.getMemoryReport(&memoryReportAfterRelease);
+    const int64_t heapSizeAfterRelease = memoryReportAfterRelease.getTotal().getHeapSize();
+    EXPECT_GT(heapSizeAfterRelease, layoutHeapSize);
+    EXPECT_LT(heapSizeAfterRelease, 2 * layoutHeapSize);
+}
+
+}  // namespace
+}  // namespace latinime
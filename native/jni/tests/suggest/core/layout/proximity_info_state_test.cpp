@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/proximity_info_state.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "defines.h"
+#include "suggest/core/layout/proximity_info.h"
+#include "suggest/core/layout/touch_position_correction_utils.h"
+#include "test_utils/suggest_test_utils.h"
+
+namespace latinime {
+namespace {
+
+using tests::SuggestTestUtils;
+
+const float MAX_POINT_TO_KEY_LENGTH = 2.0f;
+
+void initInputParams(const ProximityInfo *const proximityInfo,
+        const SuggestTestUtils::InputTrace &trace, const int inputSize,
+        ProximityInfoState *const state) {
+    state->initInputParams(0 /* pointerId */, MAX_POINT_TO_KEY_LENGTH, proximityInfo,
+            trace.mCodePoints.data(), inputSize, trace.mXCoordinates.data(),
+            trace.mYCoordinates.data(), trace.mTimes.data(), trace.mPointerIds.data(),
+            true /* isGeometric */, nullptr /* locale */);
+}
+
+void expectSameStates(const ProximityInfo *const proximityInfo,
+        const ProximityInfoState &expected, const ProximityInfoState &actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (int i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected.getInputX(i), actual.getInputX(i));
+        EXPECT_EQ(expected.getInputY(i), actual.getInputY(i));
+        EXPECT_EQ(expected.getInputIndexOfSampledPoint(i), actual.getInputIndexOfSampledPoint(i));
+        EXPECT_FLOAT_EQ(expected.getSpeedRate(i), actual.getSpeedRate(i));
+        EXPECT_EQ(expected.getBeelineSpeedPercentile(i), actual.getBeelineSpeedPercentile(i));
+        for (int keyId = NOT_AN_INDEX; keyId < proximityInfo->getKeyCount(); ++keyId) {
+            EXPECT_FLOAT_EQ(expected.getProbability(i, keyId), actual.getProbability(i, keyId));
+        }
+    }
+    int expectedString[MAX_WORD_LENGTH];
+    int actualString[MAX_WORD_LENGTH];
+    EXPECT_FLOAT_EQ(expected.getMostProbableString(expectedString),
+            actual.getMostProbableString(actualString));
+    for (int i = 0; i < MAX_WORD_LENGTH; ++i) {
+        EXPECT_EQ(expectedString[i], actualString[i]);
+    }
+}
+
+TEST(ProximityInfoStateTest, TestAppendTouchPoints) {
+    const std::unique_ptr<ProximityInfo> proximityInfo =
+            SuggestTestUtils::createQwertyProximityInfo();
+    const SuggestTestUtils::InputTrace trace = SuggestTestUtils::createGestureTrace("keyboard");
+    const int prefixSize = trace.size() / 2;
+
+    ProximityInfoState reinitializedState;
+    initInputParams(proximityInfo.get(), trace, prefixSize, &reinitializedState);
+    initInputParams(proximityInfo.get(), trace, trace.size(), &reinitializedState);
+    ASSERT_TRUE(reinitializedState.isContinuousSuggestionPossible());
+
+    ProximityInfoState appendedState;
+    initInputParams(proximityInfo.get(), trace, prefixSize, &appendedState);
+    EXPECT_TRUE(appendedState.isSavedInputPrefixOf(proximityInfo.get(), trace.size(),
+            trace.mXCoordinates.data(), trace.mYCoordinates.data(), trace.mTimes.data()));
+    ASSERT_TRUE(appendedState.appendTouchPoints(0 /* pointerId */,
+            trace.mXCoordinates.data() + prefixSize, trace.mYCoordinates.data() + prefixSize,
+            trace.mTimes.data() + prefixSize, trace.size() - prefixSize));
+    EXPECT_TRUE(appendedState.isContinuousSuggestionPossible());
+    EXPECT_EQ(trace.size(), appendedState.getSavedInputSize());
+
+    expectSameStates(proximityInfo.get(), reinitializedState, appendedState);
+}
+
+TEST(ProximityInfoStateTest, TestAppendTouchPointsAgainstFullInit) {
+    const std::unique_ptr<ProximityInfo> proximityInfo =
+            SuggestTestUtils::createQwertyProximityInfo();
+    for (const std::string word : { "keyboard", "hello", "question" }) {
+        const SuggestTestUtils::InputTrace trace = SuggestTestUtils::createGestureTrace(word);
+        const int prefixSize = trace.size() / 2;
+
+        ProximityInfoState prefixState;
+        initInputParams(proximityInfo.get(), trace, prefixSize, &prefixState);
+        ProximityInfoState fullState;
+        initInputParams(proximityInfo.get(), trace, trace.size(), &fullState);
+        ProximityInfoState appendedState;
+        initInputParams(proximityInfo.get(), trace, prefixSize, &appendedState);
+        ASSERT_TRUE(appendedState.appendTouchPoints(0 /* pointerId */,
+                trace.mXCoordinates.data() + prefixSize, trace.mYCoordinates.data() + prefixSize,
+                trace.mTimes.data() + prefixSize, trace.size() - prefixSize));
+
+        // The appended points are sampled as if all the points were given at once.
+        ASSERT_EQ(fullState.size(), appendedState.size()) << word;
+        for (int i = 0; i < fullState.size(); ++i) {
+            EXPECT_EQ(fullState.getInputX(i), appendedState.getInputX(i)) << word;
+            EXPECT_EQ(fullState.getInputY(i), appendedState.getInputY(i)) << word;
+            EXPECT_EQ(fullState.getInputIndexOfSampledPoint(i),
+                    appendedState.getInputIndexOfSampledPoint(i)) << word;
+        }
+        // The last two points of the prefix are sampled again. The speed rates of the points
+        // before them are relative to the average speed of the prefix and are not refreshed, as
+        // in the continuous suggestion by initInputParams().
+        const int resampledStartIndex = prefixState.size() - 2;
+        ASSERT_GT(resampledStartIndex, 0) << word;
+        for (int i = 0; i < fullState.size(); ++i) {
+            const ProximityInfoState &expectedState =
+                    (i < resampledStartIndex) ? prefixState : fullState;
+            EXPECT_FLOAT_EQ(expectedState.getSpeedRate(i), appendedState.getSpeedRate(i))
+                    << word << " " << i;
+            EXPECT_EQ(expectedState.getBeelineSpeedPercentile(i),
+                    appendedState.getBeelineSpeedPercentile(i)) << word << " " << i;
+        }
+        int fullString[MAX_WORD_LENGTH];
+        int appendedString[MAX_WORD_LENGTH];
+        fullState.getMostProbableString(fullString);
+        appendedState.getMostProbableString(appendedString);
+        for (int i = 0; i < MAX_WORD_LENGTH; ++i) {
+            EXPECT_EQ(fullString[i], appendedString[i]) << word;
+        }
+    }
+}
+
+TEST(ProximityInfoStateTest, TestProbabilities) {
+    const std::unique_ptr<ProximityInfo> proximityInfo =
+            SuggestTestUtils::createQwertyProximityInfo();
+    const SuggestTestUtils::InputTrace trace = SuggestTestUtils::createGestureTrace("keyboard");
+    ProximityInfoState state;
+    initInputParams(proximityInfo.get(), trace, trace.size(), &state);
+    ASSERT_GT(state.size(), 0);
+    const float maxValue = static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    for (int i = 0; i < state.size(); ++i) {
+        EXPECT_LT(state.getProbability(i, NOT_AN_INDEX), maxValue);
+        EXPECT_FLOAT_EQ(maxValue, state.getProbability(i, MAX_KEY_COUNT_IN_A_KEYBOARD));
+        int nearKeyCount = 0;
+        for (int keyId = 0; keyId < proximityInfo->getKeyCount(); ++keyId) {
+            if (state.getProbability(i, keyId) < maxValue) {
+                EXPECT_GE(state.getProbability(i, keyId), 0.0f);
+                ++nearKeyCount;
+            }
+        }
+        EXPECT_GT(nearKeyCount, 0);
+    }
+    int mostProbableString[MAX_WORD_LENGTH];
+    state.getMostProbableString(mostProbableString);
+    EXPECT_EQ('k', mostProbableString[0]);
+}
+
+TEST(ProximityInfoStateTest, TestAppendTouchPointsWithoutGeometricInput) {
+    const std::unique_ptr<ProximityInfo> proximityInfo =
+            SuggestTestUtils::createQwertyProximityInfo();
+    const SuggestTestUtils::InputTrace trace = SuggestTestUtils::createTypingTrace("hello");
+    const std::vector<int> locale = SuggestTestUtils::toCodePoints("en_US");
+    ProximityInfoState state;
+    EXPECT_FALSE(state.appendTouchPoints(0 /* pointerId */, trace.mXCoordinates.data(),
+            trace.mYCoordinates.data(), trace.mTimes.data(), trace.size()));
+    state.initInputParams(0 /* pointerId */, MAX_POINT_TO_KEY_LENGTH, proximityInfo.get(),
+            trace.mCodePoints.data(), trace.size(), trace.mXCoordinates.data(),
+            trace.mYCoordinates.data(), trace.mTimes.data(), trace.mPointerIds.data(),
+            false /* isGeometric */, &locale);
+    EXPECT_FALSE(state.appendTouchPoints(0 /* pointerId */, trace.mXCoordinates.data(),
+            trace.mYCoordinates.data(), trace.mTimes.data(), trace.size()));
+    EXPECT_FALSE(state.isSavedInputPrefixOf(proximityInfo.get(), trace.size(),
+            trace.mXCoordinates.data(), trace.mYCoordinates.data(), trace.mTimes.data()));
+}
+
+TEST(ProximityInfoStateTest, TestSweetSpotFactors) {
+    const std::unique_ptr<ProximityInfo> proximityInfo =
+            SuggestTestUtils::createQwertyProximityInfo();
+    SuggestTestUtils::InputTrace trace = SuggestTestUtils::createTypingTrace("zebra");
+    for (int i = 0; i < trace.size(); ++i) {
+        trace.mXCoordinates[i] += i * 7;
+        trace.mYCoordinates[i] -= i * 5;
+    }
+    const std::vector<int> locale = SuggestTestUtils::toCodePoints("en_US");
+    ProximityInfoState state;
+    state.initInputParams(0 /* pointerId */, MAX_POINT_TO_KEY_LENGTH, proximityInfo.get(),
+            trace.mCodePoints.data(), trace.size(), trace.mXCoordinates.data(),
+            trace.mYCoordinates.data(), trace.mTimes.data(), trace.mPointerIds.data(),
+            false /* isGeometric */, &locale);
+    ASSERT_EQ(trace.size(), state.size());
+    for (int i = 0; i < state.size(); ++i) {
+        for (int codePoint = 'a'; codePoint <= 'z'; ++codePoint) {
+            EXPECT_FLOAT_EQ(TouchPositionCorrectionUtils::getSweetSpotFactor(
+                    state.touchPositionCorrectionEnabled(),
+                    state.getPointToKeyLength(i, codePoint)),
+                    state.getPointToKeySweetSpotFactor(i, codePoint));
+        }
+        // Code points without a key fall back to the length of the point.
+        EXPECT_FLOAT_EQ(TouchPositionCorrectionUtils::getSweetSpotFactor(
+                state.touchPositionCorrectionEnabled(), state.getPointToKeyLength(i, '1')),
+                state.getPointToKeySweetSpotFactor(i, '1'));
+    }
+}
+
+TEST(ProximityInfoStateTest, TestSavedInputPrefix) {
+    const std::unique_ptr<ProximityInfo> proximityInfo =
+            SuggestTestUtils::createQwertyProximityInfo();
+    const SuggestTestUtils::InputTrace trace = SuggestTestUtils::createGestureTrace("keyboard");
+    SuggestTestUtils::InputTrace otherTrace = trace;
+    otherTrace.mXCoordinates[trace.size() / 2 - 1] += 1;
+    ProximityInfoState state;
+    initInputParams(proximityInfo.get(), trace, trace.size() / 2, &state);
+    EXPECT_TRUE(state.isSavedInputPrefixOf(proximityInfo.get(), trace.size(),
+            trace.mXCoordinates.data(), trace.mYCoordinates.data(), trace.mTimes.data()));
+    EXPECT_FALSE(state.isSavedInputPrefixOf(proximityInfo.get(), trace.size(),
+            otherTrace.mXCoordinates.data(), otherTrace.mYCoordinates.data(),
+            otherTrace.mTimes.data()));
+    EXPECT_FALSE(state.isSavedInputPrefixOf(proximityInfo.get(), trace.size() / 2 - 1,
+            trace.mXCoordinates.data(), trace.mYCoordinates.data(), trace.mTimes.data()));
+}
+
+}  // namespace
+}  // namespace latinime
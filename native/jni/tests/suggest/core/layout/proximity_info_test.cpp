@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/proximity_info.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "defines.h"
+
+namespace latinime {
+namespace {
+
+const int KEYBOARD_WIDTH = 300;
+const int KEYBOARD_HEIGHT = 200;
+const int GRID_WIDTH = 7;
+const int GRID_HEIGHT = 5;
+const int MOST_COMMON_KEY_WIDTH = 30;
+const int MOST_COMMON_KEY_HEIGHT = 50;
+
+class ProximityInfoTest : public ::testing::Test {
+ protected:
+    // Keys of various sizes and a wide space key. Every grid cell lists all the keys.
+    void SetUp() override {
+        for (int i = 0; i < 12; ++i) {
+            mKeyXs.push_back((i % 6) * 50 + (i / 6) * 13);
+            mKeyYs.push_back((i / 6) * 60);
+            mKeyWidths.push_back(MOST_COMMON_KEY_WIDTH + (i % 3) * 7);
+            mKeyHeights.push_back(MOST_COMMON_KEY_HEIGHT - (i % 4) * 5);
+            mCodePoints.push_back('a' + i);
+        }
+        mKeyXs.push_back(40);
+        mKeyYs.push_back(150);
+        mKeyWidths.push_back(200);
+        mKeyHeights.push_back(MOST_COMMON_KEY_HEIGHT);
+        mCodePoints.push_back(KEYCODE_SPACE);
+        std::vector<int> proximityChars(GRID_WIDTH * GRID_HEIGHT * MAX_PROXIMITY_CHARS_SIZE,
+                NOT_A_CODE_POINT);
+        for (int cell = 0; cell < GRID_WIDTH * GRID_HEIGHT; ++cell) {
+            for (size_t i = 0; i < mCodePoints.size(); ++i) {
+                proximityChars[cell * MAX_PROXIMITY_CHARS_SIZE + i] = mCodePoints[i];
+            }
+        }
+        mProximityInfo.reset(new ProximityInfo(KEYBOARD_WIDTH, KEYBOARD_HEIGHT, GRID_WIDTH,
+                GRID_HEIGHT, MOST_COMMON_KEY_WIDTH, MOST_COMMON_KEY_HEIGHT,
+                proximityChars.data(), static_cast<int>(proximityChars.size()),
+                static_cast<int>(mCodePoints.size()), mKeyXs.data(), mKeyYs.data(),
+                mKeyWidths.data(), mKeyHeights.data(), mCodePoints.data(),
+                nullptr /* sweetSpotCenterXs */, nullptr /* sweetSpotCenterYs */,
+                nullptr /* sweetSpotRadii */));
+    }
+
+    // The proximity code points computed by measuring every listed key.
+    std::vector<int> getExpectedProximities(const int primaryCodePoint, const int x,
+            const int y) const {
+        std::vector<int> proximities = { primaryCodePoint };
+        for (size_t i = 0; i < mCodePoints.size(); ++i) {
+            if (mCodePoints[i] == primaryCodePoint) {
+                continue;
+            }
+            const int left = mKeyXs[i];
+            const int top = mKeyYs[i];
+            const int right = left + mKeyWidths[i];
+            const int bottom = top + mKeyHeights[i];
+            const bool onKey = x >= left && x < right + 1 && y >= top && y < bottom;
+            const int dx = x - std::min(std::max(x, left), right);
+            const int dy = y - std::min(std::max(y, top), bottom);
+            if (onKey || dx * dx + dy * dy < MOST_COMMON_KEY_WIDTH * MOST_COMMON_KEY_WIDTH) {
+                proximities.push_back(mCodePoints[i]);
+            }
+        }
+        return proximities;
+    }
+
+    std::vector<int> mKeyXs;
+    std::vector<int> mKeyYs;
+    std::vector<int> mKeyWidths;
+    std::vector<int> mKeyHeights;
+    std::vector<int> mCodePoints;
+    std::unique_ptr<ProximityInfo> mProximityInfo;
+};
+
+TEST_F(ProximityInfoTest, TestInitializeProximities) {
+    // No additional proximity characters are defined for this locale.
+    const std::vector<int> locale = { 'f', 'r' };
+    int proximities[MAX_PROXIMITY_CHARS_SIZE];
+    for (int y = 0; y < KEYBOARD_HEIGHT; ++y) {
+        for (int x = 0; x < KEYBOARD_WIDTH; ++x) {
+            const int primaryCodePoint = 'a' + (x + y) % 12;
+            mProximityInfo->initializeProximities(&primaryCodePoint, &x, &y, 1 /* inputSize */,
+                    proximities, &locale);
+            const std::vector<int> expectedProximities =
+                    getExpectedProximities(primaryCodePoint, x, y);
+            for (int i = 0; i < MAX_PROXIMITY_CHARS_SIZE; ++i) {
+                const int expected = (i < static_cast<int>(expectedProximities.size()))
+                        ? expectedProximities[i] : NOT_A_CODE_POINT;
+                ASSERT_EQ(expected, proximities[i]) << "at (" << x << ", " << y << ")";
+            }
+        }
+    }
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/result/suggestion_results.h"
+
+#include <gtest/gtest.h>
+
+#include "suggest/core/dictionary/dictionary.h"
+
+namespace latinime {
+namespace {
+
+void addWord(SuggestionResults *const suggestionResults, const int codePoint, const int score) {
+    const int codePoints[] = { codePoint };
+    suggestionResults->addSuggestion(codePoints, 1 /* codePointCount */, score,
+            Dictionary::KIND_CORRECTION, NOT_AN_INDEX, NOT_A_FIRST_WORD_CONFIDENCE);
+}
+
+TEST(SuggestionResultsTest, TestAddSuggestionsFrom) {
+    SuggestionResults mergedResults(3 /* maxSuggestionCount */);
+    SuggestionResults mainResults(3 /* maxSuggestionCount */);
+    addWord(&mainResults, 'a', 100);
+    addWord(&mainResults, 'b', 80);
+    SuggestionResults userResults(3 /* maxSuggestionCount */);
+    addWord(&userResults, 'c', 60);
+    addWord(&userResults, 'd', 10);
+
+    mergedResults.addSuggestionsFrom(&mainResults, 1.0f /* scoreWeight */,
+            0 /* sourceDictionaryIndex */);
+    mergedResults.addSuggestionsFrom(&userResults, 2.0f /* scoreWeight */,
+            1 /* sourceDictionaryIndex */);
+    EXPECT_EQ(0, mainResults.getSuggestionCount());
+    EXPECT_EQ(0, userResults.getSuggestionCount());
+    ASSERT_EQ(3, mergedResults.getSuggestionCount());
+    int scores[3];
+    mergedResults.getSortedScores(scores);
+    EXPECT_EQ(120, scores[0]);
+    EXPECT_EQ(100, scores[1]);
+    EXPECT_EQ(80, scores[2]);
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/session/suggestion_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "suggest/core/dictionary/dictionary.h"
+#include "suggest/core/result/suggestion_results.h"
+
+namespace latinime {
+namespace {
+
+const int TEST_INPUT_CAPACITY = 8;
+
+std::vector<int32_t> createBuffer() {
+    std::vector<int32_t> buffer(
+            SuggestionBuffer::getRequiredBufferSize(TEST_INPUT_CAPACITY) / sizeof(int32_t), 0);
+    buffer[SuggestionBuffer::LAYOUT_VERSION] = SuggestionBuffer::CURRENT_LAYOUT_VERSION;
+    buffer[SuggestionBuffer::INPUT_CAPACITY] = TEST_INPUT_CAPACITY;
+    return buffer;
+}
+
+TEST(SuggestionBufferTest, TestIsValid) {
+    std::vector<int32_t> buffer = createBuffer();
+    const size_t bufferSize = buffer.size() * sizeof(int32_t);
+    EXPECT_TRUE(SuggestionBuffer(buffer.data(), bufferSize).isValid());
+    EXPECT_FALSE(SuggestionBuffer(buffer.data(), bufferSize - sizeof(int32_t)).isValid());
+
+    buffer[SuggestionBuffer::INPUT_SIZE] = TEST_INPUT_CAPACITY + 1;
+    EXPECT_FALSE(SuggestionBuffer(buffer.data(), bufferSize).isValid());
+    buffer[SuggestionBuffer::INPUT_SIZE] = TEST_INPUT_CAPACITY;
+    EXPECT_TRUE(SuggestionBuffer(buffer.data(), bufferSize).isValid());
+
+    buffer[SuggestionBuffer::OPTION_COUNT] = SuggestionBuffer::MAX_OPTION_COUNT + 1;
+    EXPECT_FALSE(SuggestionBuffer(buffer.data(), bufferSize).isValid());
+    buffer[SuggestionBuffer::OPTION_COUNT] = 0;
+
+    buffer[SuggestionBuffer::LAYOUT_VERSION] = SuggestionBuffer::CURRENT_LAYOUT_VERSION + 1;
+    EXPECT_FALSE(SuggestionBuffer(buffer.data(), bufferSize).isValid());
+}
+
+TEST(SuggestionBufferTest, TestSections) {
+    std::vector<int32_t> buffer = createBuffer();
+    const SuggestionBuffer suggestionBuffer(buffer.data(), buffer.size() * sizeof(int32_t));
+    EXPECT_EQ(buffer.data() + SuggestionBuffer::HEADER_FIELD_COUNT,
+            suggestionBuffer.getXCoordinates());
+    EXPECT_EQ(suggestionBuffer.getXCoordinates() + TEST_INPUT_CAPACITY,
+            suggestionBuffer.getYCoordinates());
+    EXPECT_EQ(buffer.data() + buffer.size(), suggestionBuffer.getOutTypes() + MAX_RESULTS);
+
+    suggestionBuffer.setWeightOfLangModelVsSpatialModel(0.25f);
+    EXPECT_FLOAT_EQ(0.25f, suggestionBuffer.getWeightOfLangModelVsSpatialModel());
+}
+
+TEST(SuggestionBufferTest, TestOutputSuggestions) {
+    std::vector<int32_t> buffer = createBuffer();
+    const SuggestionBuffer suggestionBuffer(buffer.data(), buffer.size() * sizeof(int32_t));
+    SuggestionResults suggestionResults(MAX_RESULTS);
+    const int word1[] = { 'a', 'b' };
+    const int word2[] = { 'c' };
+    suggestionResults.addSuggestion(word1, 2 /* codePointCount */, 100 /* score */,
+            Dictionary::KIND_CORRECTION, NOT_AN_INDEX, 5 /* autoCommitFirstWordConfidence */);
+    suggestionResults.addSuggestion(word2, 1 /* codePointCount */, 50 /* score */,
+            Dictionary::KIND_COMPLETION, NOT_AN_INDEX, 3 /* autoCommitFirstWordConfidence */);
+    suggestionResults.outputSuggestions(&suggestionBuffer);
+
+    EXPECT_EQ(2, *suggestionBuffer.getOutSuggestionCount());
+    // Suggestions are output from the worst one.
+    EXPECT_EQ('c', suggestionBuffer.getOutCodePoints()[0]);
+    EXPECT_EQ(0, suggestionBuffer.getOutCodePoints()[1]);
+    EXPECT_EQ('a', suggestionBuffer.getOutCodePoints()[MAX_WORD_LENGTH]);
+    EXPECT_EQ('b', suggestionBuffer.getOutCodePoints()[MAX_WORD_LENGTH + 1]);
+    EXPECT_EQ(0, suggestionBuffer.getOutCodePoints()[MAX_WORD_LENGTH + 2]);
+    EXPECT_EQ(50, suggestionBuffer.getOutScores()[0]);
+    EXPECT_EQ(100, suggestionBuffer.getOutScores()[1]);
+    EXPECT_EQ(static_cast<int>(Dictionary::KIND_CORRECTION), suggestionBuffer.getOutTypes()[1]);
+    EXPECT_EQ(5, *suggestionBuffer.getOutAutoCommitFirstWordConfidence());
+}
+
+}  // namespace
+}  // namespace latinime
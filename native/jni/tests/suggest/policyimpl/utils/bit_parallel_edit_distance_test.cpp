@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/utils/bit_parallel_edit_distance.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "suggest/policyimpl/utils/damerau_levenshtein_edit_distance_policy.h"
+#include "suggest/policyimpl/utils/edit_distance.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+namespace {
+
+int getEditDistance(const std::vector<int> &codePoints0, const std::vector<int> &codePoints1) {
+    const BitParallelEditDistance editDistance((CodePointArrayView(codePoints0)));
+    return editDistance.getEditDistance(CodePointArrayView(codePoints1));
+}
+
+int getDynamicProgrammingEditDistance(const std::vector<int> &codePoints0,
+        const std::vector<int> &codePoints1) {
+    DamerauLevenshteinEditDistancePolicy policy(codePoints0.data(), codePoints0.size(),
+            codePoints1.data(), codePoints1.size());
+    return static_cast<int>(EditDistance::getEditDistance(&policy));
+}
+
+TEST(BitParallelEditDistanceTest, TestEditDistance) {
+    EXPECT_EQ(0, getEditDistance({}, {}));
+    EXPECT_EQ(0, getEditDistance({ 1 }, { 1 }));
+    EXPECT_EQ(0, getEditDistance({ 1, 2, 3 }, { 1, 2, 3 }));
+
+    EXPECT_EQ(1, getEditDistance({ 1 }, {}));
+    EXPECT_EQ(1, getEditDistance({}, { 100 }));
+    EXPECT_EQ(5, getEditDistance({}, { 1, 2, 3, 4, 5 }));
+
+    EXPECT_EQ(1, getEditDistance({ 0 }, { 100 }));
+    EXPECT_EQ(5, getEditDistance({ 1, 2, 3, 4, 5 }, { 11, 12, 13, 14, 15 }));
+
+    EXPECT_EQ(1, getEditDistance({ 1 }, { 1, 2 }));
+    EXPECT_EQ(2, getEditDistance({ 1, 2 }, { 0, 1, 2, 3 }));
+    EXPECT_EQ(2, getEditDistance({ 0, 1, 2, 3 }, { 1, 2 }));
+
+    EXPECT_EQ(1, getEditDistance({ 1, 2 }, { 2, 1 }));
+    EXPECT_EQ(2, getEditDistance({ 1, 2, 3, 4 }, { 2, 1, 4, 3 }));
+    // Adjacent transpositions cannot be edited again.
+    EXPECT_EQ(3, getEditDistance({ 'c', 'a' }, { 'a', 'b', 'c' }));
+}
+
+TEST(BitParallelEditDistanceTest, TestCaseAndAccents) {
+    EXPECT_EQ(0, getEditDistance({ 'H', 'e', 'l', 'l', 'o' }, { 'h', 'E', 'L', 'l', 'o' }));
+    // U+00E9 is LATIN SMALL LETTER E WITH ACUTE.
+    EXPECT_EQ(0, getEditDistance({ 'c', 'a', 'f', 'e' }, { 'c', 'a', 'f', 0xE9 }));
+    EXPECT_EQ(1, getEditDistance({ 0x3042, 0x3044 }, { 0x3042, 0x3046 }));
+}
+
+TEST(BitParallelEditDistanceTest, TestMaxQueryLength) {
+    std::vector<int> query;
+    for (int i = 0; i < BitParallelEditDistance::MAX_QUERY_LENGTH; ++i) {
+        query.push_back('a' + i % 26);
+    }
+    std::vector<int> candidate = query;
+    EXPECT_EQ(0, getEditDistance(query, candidate));
+    candidate.pop_back();
+    EXPECT_EQ(1, getEditDistance(query, candidate));
+    candidate.push_back('z');
+    candidate.push_back('z');
+    EXPECT_EQ(2, getEditDistance(query, candidate));
+}
+
+TEST(BitParallelEditDistanceTest, TestSameAsDynamicProgramming) {
+    static const int CODE_POINTS[] = { 'a', 'b', 'c', 'A', 'B', 'd', 0xE0, 0x3042 };
+    uint32_t seed = 1;
+    for (int i = 0; i < 5000; ++i) {
+        std::vector<int> codePoints[2];
+        for (std::vector<int> &codePointArray : codePoints) {
+            seed = seed * 1103515245u + 12345u;
+            const int length = static_cast<int>((seed >> 16) % 13);
+            for (int j = 0; j < length; ++j) {
+                seed = seed * 1103515245u + 12345u;
+                codePointArray.push_back(CODE_POINTS[(seed >> 16) % NELEMS(CODE_POINTS)]);
+            }
+        }
+        EXPECT_EQ(getDynamicProgrammingEditDistance(codePoints[0], codePoints[1]),
+                getEditDistance(codePoints[0], codePoints[1]));
+    }
+}
+
+TEST(BitParallelEditDistanceTest, TestGetEditDistances) {
+    const std::vector<int> query = { 'w', 'o', 'r', 'l', 'd' };
+    const std::vector<std::vector<int>> words = { { 'w', 'o', 'r', 'l', 'd' },
+            { 'w', 'o', 'r', 'd' }, { 'w', 'r', 'o', 'l', 'd' }, { 'h', 'e', 'l', 'l', 'o' }, {} };
+    std::vector<CodePointArrayView> candidates;
+    for (const std::vector<int> &word : words) {
+        candidates.emplace_back(word);
+    }
+    std::vector<int> distances(candidates.size());
+    const BitParallelEditDistance editDistance((CodePointArrayView(query)));
+    editDistance.getEditDistances(candidates.data(), candidates.size(), distances.data());
+    const std::vector<int> expectedDistances = { 0, 1, 1, 4, 5 };
+    EXPECT_EQ(expectedDistances, distances);
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_SUGGEST_TEST_UTILS_H
+#define LATINIME_SUGGEST_TEST_UTILS_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "defines.h"
+#include "dictionary/property/historical_info.h"
+#include "dictionary/property/ngram_context.h"
+#include "dictionary/property/unigram_property.h"
+#include "dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "dictionary/utils/format_utils.h"
+#include "suggest/core/dictionary/dictionary.h"
+#include "suggest/core/layout/proximity_info.h"
+#include "suggest/core/result/suggestion_results.h"
+#include "suggest/core/session/dic_traverse_session.h"
+#include "suggest/core/session/suggestion_buffer.h"
+#include "suggest/core/suggest_options.h"
+#include "utils/int_array_view.h"
+
+namespace latinime {
+namespace tests {
+
+// Builds the native objects of a suggestion search without a Java VM: a QWERTY layout laid out
+// like the phone keyboard, on-memory dictionaries and touch traces for typed or gestured words.
+class SuggestTestUtils {
+ public:
+    static const int KEYBOARD_WIDTH = 1080;
+    static const int KEYBOARD_HEIGHT = 640;
+    static const int KEY_WIDTH = 108;
+    static const int KEY_HEIGHT = 160;
+    static const int GRID_WIDTH = 32;
+    static const int GRID_HEIGHT = 16;
+
+    // A trace of touch points; a typed word has one point per letter.
+    struct InputTrace {
+        std::vector<int> mCodePoints;
+        std::vector<int> mXCoordinates;
+        std::vector<int> mYCoordinates;
+        std::vector<int> mTimes;
+        std::vector<int> mPointerIds;
+
+        int size() const { return static_cast<int>(mXCoordinates.size()); }
+    };
+
+    static std::unique_ptr<ProximityInfo> createQwertyProximityInfo() {
+        std::vector<Key> keys;
+        getQwertyKeys(&keys);
+        const int keyCount = static_cast<int>(keys.size());
+        std::vector<int> keyXs(keyCount), keyYs(keyCount), keyWidths(keyCount),
+                keyHeights(keyCount), keyCodePoints(keyCount);
+        for (int i = 0; i < keyCount; ++i) {
+            keyXs[i] = keys[i].mX;
+            keyYs[i] = keys[i].mY;
+            keyWidths[i] = keys[i].mWidth;
+            keyHeights[i] = keys[i].mHeight;
+            keyCodePoints[i] = keys[i].mCodePoint;
+        }
+        // Same as ProximityInfo.computeNearestNeighbors() in Java: every cell lists the keys
+        // whose edge is within 1.2 key widths of the cell center.
+        const int cellWidth = (KEYBOARD_WIDTH + GRID_WIDTH - 1) / GRID_WIDTH;
+        const int cellHeight = (KEYBOARD_HEIGHT + GRID_HEIGHT - 1) / GRID_HEIGHT;
+        const int threshold = KEY_WIDTH * 12 / 10;
+        std::vector<int> proximityChars(GRID_WIDTH * GRID_HEIGHT * MAX_PROXIMITY_CHARS_SIZE,
+                NOT_A_CODE_POINT);
+        for (int cellIndex = 0; cellIndex < GRID_WIDTH * GRID_HEIGHT; ++cellIndex) {
+            const int centerX = (cellIndex % GRID_WIDTH) * cellWidth + cellWidth / 2;
+            const int centerY = (cellIndex / GRID_WIDTH) * cellHeight + cellHeight / 2;
+            int count = 0;
+            for (const Key &key : keys) {
+                if (count < MAX_PROXIMITY_CHARS_SIZE
+                        && key.getSquaredDistanceToEdge(centerX, centerY)
+                                < threshold * threshold) {
+                    proximityChars[cellIndex * MAX_PROXIMITY_CHARS_SIZE + count] =
+                            key.mCodePoint;
+                    ++count;
+                }
+            }
+        }
+        return std::unique_ptr<ProximityInfo>(new ProximityInfo(KEYBOARD_WIDTH, KEYBOARD_HEIGHT,
+                GRID_WIDTH, GRID_HEIGHT, KEY_WIDTH, KEY_HEIGHT, proximityChars.data(),
+                static_cast<int>(proximityChars.size()), keyCount, keyXs.data(), keyYs.data(),
+                keyWidths.data(), keyHeights.data(), keyCodePoints.data(),
+                nullptr /* sweetSpotCenterXs */, nullptr /* sweetSpotCenterYs */,
+                nullptr /* sweetSpotRadii */));
+    }
+
+    // Creates an updatable on-memory v4 dictionary containing the given words.
+    static std::unique_ptr<Dictionary> createDictionary(const std::vector<std::string> &words,
+            const std::vector<int> &probabilities) {
+        DictionaryHeaderStructurePolicy::AttributeMap attributeMap;
+        DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+                DictionaryStructureWithBufferPolicyFactory::newPolicyForOnMemoryDict(
+                        FormatUtils::VERSION_403, toCodePoints("en"), &attributeMap);
+        if (!policy) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < words.size(); ++i) {
+            const std::vector<int> codePoints = toCodePoints(words[i]);
+            const UnigramProperty unigramProperty(false /* representsBeginningOfSentence */,
+                    false /* isNotAWord */, false /* isPossiblyOffensive */, probabilities[i],
+                    HistoricalInfo());
+            if (!policy->addUnigramEntry(CodePointArrayView(codePoints), &unigramProperty)) {
+                return nullptr;
+            }
+        }
+        return std::unique_ptr<Dictionary>(new Dictionary(std::move(policy)));
+    }
+
+    // Taps the center of the key of every letter, one tap every 150 ms. The touch points are
+    // moved by up to a quarter key from the centers in a deterministic way.
+    static InputTrace createTypingTrace(const std::string &word) {
+        InputTrace trace;
+        for (size_t i = 0; i < word.size(); ++i) {
+            int x = 0;
+            int y = 0;
+            if (!getKeyCenter(word[i], &x, &y)) {
+                continue;
+            }
+            const int jitter = static_cast<int>((i * 7) % 5) - 2;
+            trace.mCodePoints.push_back(word[i]);
+            trace.mXCoordinates.push_back(x + jitter * KEY_WIDTH / 8);
+            trace.mYCoordinates.push_back(y - jitter * KEY_HEIGHT / 8);
+            trace.mTimes.push_back(static_cast<int>(i) * 150);
+            trace.mPointerIds.push_back(0);
+        }
+        return trace;
+    }
+
+    // Moves in straight lines between the key centers of the letters, sampling a point every
+    // 10 ms at a speed of one key width per 50 ms.
+    static InputTrace createGestureTrace(const std::string &word) {
+        InputTrace trace;
+        int prevX = NOT_A_COORDINATE;
+        int prevY = NOT_A_COORDINATE;
+        int time = 0;
+        for (const char c : word) {
+            int x = 0;
+            int y = 0;
+            if (!getKeyCenter(c, &x, &y)) {
+                continue;
+            }
+            if (prevX != NOT_A_COORDINATE) {
+                const int distance = std::max(std::abs(x - prevX), std::abs(y - prevY));
+                const int stepCount = std::max(1, distance * 5 / KEY_WIDTH);
+                for (int step = 1; step < stepCount; ++step) {
+                    time += 10;
+                    addPoint(prevX + (x - prevX) * step / stepCount,
+                            prevY + (y - prevY) * step / stepCount, time, &trace);
+                }
+                time += 10;
+            }
+            addPoint(x, y, time, &trace);
+            prevX = x;
+            prevY = y;
+        }
+        return trace;
+    }
+
+    // Searches the dictionary for the trace without previous words.
+    static void getSuggestions(const Dictionary *const dictionary,
+            DicTraverseSession *const traverseSession, ProximityInfo *const proximityInfo,
+            InputTrace *const trace, const bool isGesture,
+            SuggestionResults *const outSuggestionResults) {
+        getSuggestionsWithWeight(dictionary, traverseSession, proximityInfo, trace, isGesture,
+                NOT_A_WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL, outSuggestionResults);
+    }
+
+    // Same as getSuggestions() but with the given weight of the language model, as passed in
+    // and out of BinaryDictionary.getSuggestions() in Java.
+    static void getSuggestionsWithWeight(const Dictionary *const dictionary,
+            DicTraverseSession *const traverseSession, ProximityInfo *const proximityInfo,
+            InputTrace *const trace, const bool isGesture,
+            const float weightOfLangModelVsSpatialModel,
+            SuggestionResults *const outSuggestionResults) {
+        const std::vector<int> options = createOptions(isGesture, false /* useFullEditDistance */);
+        const SuggestOptions suggestOptions(options.data(), options.size());
+        const NgramContext emptyNgramContext;
+        dictionary->getSuggestions(proximityInfo, traverseSession, trace->mXCoordinates.data(),
+                trace->mYCoordinates.data(), trace->mTimes.data(), trace->mPointerIds.data(),
+                trace->mCodePoints.data(), trace->size(), &emptyNgramContext, &suggestOptions,
+                weightOfLangModelVsSpatialModel, outSuggestionResults);
+    }
+
+    // Searches the dictionaries for the trace in one call as
+    // Dictionary::getSuggestionsFromDictionaries() does, without previous words.
+    static void getSuggestionsFromDictionaries(
+            const std::vector<const Dictionary *> &dictionaries,
+            const std::vector<DicTraverseSession *> &traverseSessions,
+            const std::vector<float> &dictionaryWeights, ProximityInfo *const proximityInfo,
+            InputTrace *const trace, const bool isGesture,
+            SuggestionResults *const outSuggestionResults) {
+        const std::vector<int> options = createOptions(isGesture, false /* useFullEditDistance */);
+        const SuggestOptions suggestOptions(options.data(), options.size());
+        const std::vector<const SuggestOptions *> suggestOptionsList(dictionaries.size(),
+                &suggestOptions);
+        const NgramContext emptyNgramContext;
+        Dictionary::getSuggestionsFromDictionaries(dictionaries.data(), traverseSessions.data(),
+                suggestOptionsList.data(), dictionaryWeights.data(),
+                static_cast<int>(dictionaries.size()), proximityInfo,
+                trace->mXCoordinates.data(), trace->mYCoordinates.data(), trace->mTimes.data(),
+                trace->mPointerIds.data(), trace->mCodePoints.data(), trace->size(),
+                &emptyNgramContext, NOT_A_WEIGHT_OF_LANG_MODEL_VS_SPATIAL_MODEL,
+                outSuggestionResults);
+    }
+
+    // Returns the options in the order of com.android.inputmethod.latin.NativeSuggestOptions.
+    static std::vector<int> createOptions(const bool isGesture, const bool useFullEditDistance) {
+        return { isGesture ? 1 : 0 /* isGesture */, useFullEditDistance ? 1 : 0,
+                0 /* blockOffensiveWords */, 0 /* spaceAwareGestureEnabled */,
+                1000 /* weightForLocaleInThousands */ };
+    }
+
+    // Returns the suggested words from the best one. suggestionResults gets empty.
+    static std::vector<std::string> getSortedWords(SuggestionResults *const suggestionResults) {
+        return getSortedSuggestions(suggestionResults, false /* withScores */);
+    }
+
+    // Same as getSortedWords() but the words are followed by their scores as "word:score".
+    static std::vector<std::string> getSortedWordsWithScores(
+            SuggestionResults *const suggestionResults) {
+        return getSortedSuggestions(suggestionResults, true /* withScores */);
+    }
+
+    static std::vector<int> toCodePoints(const std::string &str) {
+        return std::vector<int>(str.begin(), str.end());
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(SuggestTestUtils);
+
+    static std::vector<std::string> getSortedSuggestions(
+            SuggestionResults *const suggestionResults, const bool withScores) {
+        std::vector<int32_t> buffer(SuggestionBuffer::getRequiredBufferSize(
+                0 /* inputCapacity */) / sizeof(int32_t), 0);
+        const SuggestionBuffer suggestionBuffer(buffer.data(), buffer.size() * sizeof(int32_t));
+        suggestionResults->outputSuggestions(&suggestionBuffer);
+        std::vector<std::string> words;
+        // Suggestions are output from the worst one.
+        for (int i = *suggestionBuffer.getOutSuggestionCount() - 1; i >= 0; --i) {
+            std::string word;
+            for (const int *codePoint = suggestionBuffer.getOutCodePoints() + i * MAX_WORD_LENGTH;
+                    *codePoint != 0; ++codePoint) {
+                word.push_back(static_cast<char>(*codePoint));
+            }
+            if (withScores) {
+                word += ":" + std::to_string(suggestionBuffer.getOutScores()[i]);
+            }
+            words.push_back(word);
+        }
+        return words;
+    }
+
+    struct Key {
+        int mCodePoint;
+        int mX;
+        int mY;
+        int mWidth;
+        int mHeight;
+
+        int getSquaredDistanceToEdge(const int x, const int y) const {
+            const int edgeX = std::min(std::max(x, mX), mX + mWidth);
+            const int edgeY = std::min(std::max(y, mY), mY + mHeight);
+            return (x - edgeX) * (x - edgeX) + (y - edgeY) * (y - edgeY);
+        }
+    };
+
+    static void getQwertyKeys(std::vector<Key> *const outKeys) {
+        static const char *const ROWS[] = { "qwertyuiop", "asdfghjkl", "zxcvbnm" };
+        for (int row = 0; row < static_cast<int>(NELEMS(ROWS)); ++row) {
+            const int rowLength = static_cast<int>(strlen(ROWS[row]));
+            const int left = (KEYBOARD_WIDTH - rowLength * KEY_WIDTH) / 2;
+            for (int i = 0; i < rowLength; ++i) {
+                outKeys->push_back(
+                        { ROWS[row][i], left + i * KEY_WIDTH, row * KEY_HEIGHT, KEY_WIDTH,
+                                KEY_HEIGHT });
+            }
+        }
+        outKeys->push_back({ KEYCODE_SPACE, KEY_WIDTH * 5 / 2, KEY_HEIGHT * 3, KEY_WIDTH * 5,
+                KEY_HEIGHT });
+    }
+
+    static bool getKeyCenter(const int codePoint, int *const outX, int *const outY) {
+        std::vector<Key> keys;
+        getQwertyKeys(&keys);
+        for (const Key &key : keys) {
+            if (key.mCodePoint == codePoint) {
+                *outX = key.mX + key.mWidth / 2;
+                *outY = key.mY + key.mHeight / 2;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void addPoint(const int x, const int y, const int time, InputTrace *const trace) {
+        trace->mCodePoints.push_back(NOT_A_CODE_POINT);
+        trace->mXCoordinates.push_back(x);
+        trace->mYCoordinates.push_back(y);
+        trace->mTimes.push_back(time);
+        trace->mPointerIds.push_back(0);
+    }
+};
+
+} // namespace tests
+} // namespace latinime
+#endif // LATINIME_SUGGEST_TEST_UTILS_H
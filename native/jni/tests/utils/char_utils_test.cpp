@@ -18,6 +18,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "defines.h"
 
 namespace latinime {
@@ -101,6 +103,48 @@ TEST(CharUtilsTest, TestToBaseCodePoint) {
     EXPECT_EQ(0x1F36A /* COOKIE */, CharUtils::toBaseCodePoint(0x1F36A /* COOKIE */));
 }
 
+TEST(CharUtilsTest, TestCodePointsAtTableBoundaries) {
+    // The delta doesn't fit in a signed 16-bit integer.
+    EXPECT_EQ(0x1D79 /* LATIN SMALL LETTER INSULAR G */,
+            CharUtils::toLowerCase(0xA77D /* LATIN CAPITAL LETTER INSULAR G */));
+    EXPECT_EQ(0xFF41 /* FULLWIDTH LATIN SMALL LETTER A */,
+            CharUtils::toLowerCase(0xFF21 /* FULLWIDTH LATIN CAPITAL LETTER A */));
+    EXPECT_EQ(0xFFFF, CharUtils::toLowerCase(0xFFFF));
+    EXPECT_EQ(0xFFFF, CharUtils::toBaseCodePoint(0xFFFF));
+    // Code points out of the BMP map to themselves even if their lower 16 bits are capitals.
+    EXPECT_EQ(0x100C0, CharUtils::toLowerCase(0x100C0));
+    EXPECT_EQ(0x100C0, CharUtils::toBaseCodePoint(0x100C0));
+    EXPECT_EQ(0x10FFFF, CharUtils::toBaseLowerCase(0x10FFFF));
+    EXPECT_EQ(NOT_A_CODE_POINT, CharUtils::toLowerCase(NOT_A_CODE_POINT));
+    EXPECT_EQ(NOT_A_CODE_POINT, CharUtils::toBaseCodePoint(NOT_A_CODE_POINT));
+    EXPECT_EQ(CODE_POINT_BEGINNING_OF_SENTENCE,
+            CharUtils::toBaseLowerCase(CODE_POINT_BEGINNING_OF_SENTENCE));
+}
+
+TEST(CharUtilsTest, TestToLowerCaseCodePoints) {
+    // All ASCII, mixed with non-ASCII, and the tail.
+    const std::vector<int> codePoints = { 'H', 'e', 'L', 'L', 'O', 0x00C9, 'x', 'Y',
+            0x0410, 0x04D0, NOT_A_CODE_POINT, 0x1F36A, 'Z', '@', 0x00E0 };
+    for (size_t count = 0; count <= codePoints.size(); ++count) {
+        std::vector<int> lowerCase(count);
+        CharUtils::toLowerCaseCodePoints(codePoints.data(), static_cast<int>(count),
+                lowerCase.data());
+        std::vector<int> baseLowerCase(codePoints.begin(), codePoints.begin() + count);
+        CharUtils::toBaseLowerCaseCodePoints(baseLowerCase.data(), static_cast<int>(count),
+                baseLowerCase.data());
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(CharUtils::toLowerCase(codePoints[i]), lowerCase[i]);
+            EXPECT_EQ(CharUtils::toBaseLowerCase(codePoints[i]), baseLowerCase[i]);
+        }
+    }
+    std::vector<int> baseLowerCase(codePoints.size());
+    CharUtils::toBaseLowerCaseCodePoints(codePoints.data(), static_cast<int>(codePoints.size()),
+            baseLowerCase.data());
+    const std::vector<int> expected = { 'h', 'e', 'l', 'l', 'o', 'e', 'x', 'y',
+            0x0430, 0x0430, NOT_A_CODE_POINT, 0x1F36A, 'z', '@', 'a' };
+    EXPECT_EQ(expected, baseLowerCase);
+}
+
 TEST(CharUtilsTest, TestIsIntentionalOmissionCodePoint) {
     EXPECT_TRUE(CharUtils::isIntentionalOmissionCodePoint('\''));
     EXPECT_TRUE(CharUtils::isIntentionalOmissionCodePoint('-'));
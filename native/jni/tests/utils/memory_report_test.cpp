@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/memory_report.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+namespace latinime {
+namespace {
+
+TEST(MemoryReportTest, TestComponents) {
+    MemoryReport memoryReport;
+    memoryReport.addComponent("trie", MemoryUsage::mapped(100, 50));
+    memoryReport.addComponent("cache", MemoryUsage::heap(30, 10));
+    memoryReport.addComponent("trie", MemoryUsage::heap(20, 5));
+    ASSERT_EQ(2u, memoryReport.getComponents().size());
+    const MemoryUsage &trieUsage = memoryReport.getComponents()[0].getMemoryUsage();
+    EXPECT_EQ("trie", memoryReport.getComponents()[0].getName());
+    EXPECT_EQ(100, trieUsage.getMappedSize());
+    EXPECT_EQ(50, trieUsage.getResidentSize());
+    EXPECT_EQ(20, trieUsage.getHeapSize());
+    EXPECT_EQ(5, trieUsage.getWastedSize());
+    const MemoryUsage total = memoryReport.getTotal();
+    EXPECT_EQ(100, total.getMappedSize());
+    EXPECT_EQ(50, total.getResidentSize());
+    EXPECT_EQ(50, total.getHeapSize());
+    EXPECT_EQ(15, total.getWastedSize());
+
+    char result[256];
+    const int length = memoryReport.dump(result, NELEMS(result));
+    EXPECT_EQ("trie=100,50,20,5\ncache=0,0,30,10\ntotal=100,50,50,15\n", std::string(result));
+    EXPECT_EQ(static_cast<int>(strlen(result)), length);
+}
+
+TEST(MemoryReportTest, TestVectorMemoryUsage) {
+    std::vector<int> vector;
+    vector.reserve(10);
+    vector.resize(4);
+    const MemoryUsage memoryUsage = MemoryReport::getVectorMemoryUsage(vector);
+    EXPECT_EQ(static_cast<int64_t>(vector.capacity() * sizeof(int)), memoryUsage.getHeapSize());
+    EXPECT_EQ(static_cast<int64_t>((vector.capacity() - 4) * sizeof(int)),
+            memoryUsage.getWastedSize());
+    EXPECT_EQ(0, memoryUsage.getMappedSize());
+}
+
+TEST(MemoryReportTest, TestResidentSize) {
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t size = pageSize * 4;
+    void *const mappedRegion = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(MAP_FAILED, mappedRegion);
+    uint8_t *const bytes = static_cast<uint8_t *>(mappedRegion);
+    EXPECT_EQ(0, MemoryReport::getResidentSize(bytes, size));
+    bytes[pageSize] = 1;
+    EXPECT_EQ(static_cast<int64_t>(pageSize), MemoryReport::getResidentSize(bytes, size));
+    // Only the part of the resident page in the range is counted.
+    EXPECT_EQ(10, MemoryReport::getResidentSize(bytes + pageSize * 2 - 10, 20));
+    const MemoryUsage memoryUsage = MemoryReport::getMappedMemoryUsage(bytes, size);
+    EXPECT_EQ(static_cast<int64_t>(size), memoryUsage.getMappedSize());
+    EXPECT_EQ(static_cast<int64_t>(pageSize), memoryUsage.getResidentSize());
+    EXPECT_EQ(0, MemoryReport::getResidentSize(nullptr, size));
+    munmap(mappedRegion, size);
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/trace_counters.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace latinime {
+namespace {
+
+class TraceCountersTest : public ::testing::Test {
+ protected:
+    void TearDown() override {
+        TraceCounters::setEnabled(false);
+        TraceCounters::reset();
+    }
+};
+
+TEST_F(TraceCountersTest, TestDisabled) {
+    TraceCounters::setEnabled(false);
+    TraceCounters::reset();
+    TraceCounters::increment(TraceCounters::SUGGESTION_CALLS);
+    TraceCounters::countPush(TraceCounters::ACTIVE_DIC_NODES_PUSHED, TraceCounters::EVICTED);
+    TraceCounters::record(TraceCounters::FLUSH_TIME, 10);
+    {
+        TraceCounters::ScopedTimer timer(TraceCounters::SUGGESTION_OUTPUT_TIME);
+    }
+    EXPECT_EQ(0, TraceCounters::getCount(TraceCounters::SUGGESTION_CALLS));
+    EXPECT_EQ(0, TraceCounters::getCount(TraceCounters::ACTIVE_DIC_NODES_EVICTED));
+    EXPECT_EQ(0, TraceCounters::getSampleCount(TraceCounters::FLUSH_TIME));
+    EXPECT_EQ(0, TraceCounters::getSampleCount(TraceCounters::SUGGESTION_OUTPUT_TIME));
+}
+
+TEST_F(TraceCountersTest, TestCounters) {
+    TraceCounters::setEnabled(true);
+    TraceCounters::increment(TraceCounters::BIGRAM_CACHE_HITS);
+    TraceCounters::increment(TraceCounters::BIGRAM_CACHE_HITS);
+    TraceCounters::countPush(TraceCounters::TERMINAL_DIC_NODES_PUSHED, TraceCounters::PUSHED);
+    TraceCounters::countPush(TraceCounters::TERMINAL_DIC_NODES_PUSHED, TraceCounters::EVICTED);
+    TraceCounters::countPush(TraceCounters::TERMINAL_DIC_NODES_PUSHED, TraceCounters::DROPPED);
+    TraceCounters::countPush(TraceCounters::TERMINAL_DIC_NODES_PUSHED, TraceCounters::DROPPED);
+    EXPECT_EQ(2, TraceCounters::getCount(TraceCounters::BIGRAM_CACHE_HITS));
+    EXPECT_EQ(0, TraceCounters::getCount(TraceCounters::BIGRAM_CACHE_MISSES));
+    EXPECT_EQ(1, TraceCounters::getCount(TraceCounters::TERMINAL_DIC_NODES_PUSHED));
+    EXPECT_EQ(1, TraceCounters::getCount(TraceCounters::TERMINAL_DIC_NODES_EVICTED));
+    EXPECT_EQ(2, TraceCounters::getCount(TraceCounters::TERMINAL_DIC_NODES_DROPPED));
+
+    // Enabling again clears the counters.
+    TraceCounters::setEnabled(false);
+    TraceCounters::setEnabled(true);
+    EXPECT_EQ(0, TraceCounters::getCount(TraceCounters::BIGRAM_CACHE_HITS));
+}
+
+TEST_F(TraceCountersTest, TestHistograms) {
+    TraceCounters::setEnabled(true);
+    TraceCounters::record(TraceCounters::FLUSH_TIME, 0);
+    TraceCounters::record(TraceCounters::FLUSH_TIME, 1);
+    TraceCounters::record(TraceCounters::FLUSH_TIME, 5);
+    TraceCounters::record(TraceCounters::FLUSH_TIME, 7);
+    TraceCounters::record(TraceCounters::FLUSH_TIME, 1LL << 40);
+    EXPECT_EQ(5, TraceCounters::getSampleCount(TraceCounters::FLUSH_TIME));
+    EXPECT_EQ(13 + (1LL << 40), TraceCounters::getSampleSum(TraceCounters::FLUSH_TIME));
+    EXPECT_EQ(1, TraceCounters::getBucketCount(TraceCounters::FLUSH_TIME, 0));
+    EXPECT_EQ(1, TraceCounters::getBucketCount(TraceCounters::FLUSH_TIME, 1));
+    EXPECT_EQ(0, TraceCounters::getBucketCount(TraceCounters::FLUSH_TIME, 2));
+    EXPECT_EQ(2, TraceCounters::getBucketCount(TraceCounters::FLUSH_TIME, 3));
+    EXPECT_EQ(1, TraceCounters::getBucketCount(TraceCounters::FLUSH_TIME,
+            TraceCounters::HISTOGRAM_BUCKET_COUNT - 1));
+    EXPECT_EQ(0, TraceCounters::getBucketCount(TraceCounters::FLUSH_TIME,
+            TraceCounters::HISTOGRAM_BUCKET_COUNT));
+
+    {
+        TraceCounters::ScopedTimer timer(TraceCounters::SUGGESTION_SETUP_TIME);
+        timer.stop();
+    }
+    EXPECT_EQ(1, TraceCounters::getSampleCount(TraceCounters::SUGGESTION_SETUP_TIME));
+}
+
+TEST_F(TraceCountersTest, TestDump) {
+    TraceCounters::setEnabled(true);
+    TraceCounters::increment(TraceCounters::SUGGESTION_CALLS);
+    TraceCounters::record(TraceCounters::FLUSH_WITH_GC_TIME, 3);
+    char result[4096];
+    const int length = TraceCounters::dump(result, NELEMS(result));
+    const std::string dump(result);
+    EXPECT_EQ(static_cast<int>(dump.size()), length);
+    EXPECT_NE(std::string::npos, dump.find("SUGGESTION_CALLS=1\n"));
+    EXPECT_NE(std::string::npos, dump.find("BIGRAM_CACHE_MISSES=0\n"));
+    EXPECT_NE(std::string::npos, dump.find("FLUSH_WITH_GC_TIME=1,3,0,0,1,0,"));
+
+    // Truncated dumps are terminated.
+    char shortResult[10];
+    EXPECT_EQ(9, TraceCounters::dump(shortResult, NELEMS(shortResult)));
+    EXPECT_EQ("SUGGESTIO", std::string(shortResult));
+}
+
+}  // namespace
+}  // namespace latinime
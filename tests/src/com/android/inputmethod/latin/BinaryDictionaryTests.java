@@ -879,6 +879,46 @@ public class BinaryDictionaryTests {
         assertTrue(bigramSet.isEmpty());
     }
 
+    @Test
+    public void testGetNextWordProperties() {
+        final long seed = System.currentTimeMillis();
+        final Random random = new Random(seed);
+        final int UNIGRAM_COUNT = 1000;
+        final int BIGRAM_COUNT = 1000;
+        final int codePointSetSize = 20;
+        final int[] codePointSet = CodePointUtils.generateCodePointSet(codePointSetSize, random);
+        final BinaryDictionary binaryDictionary = getEmptyBinaryDictionary(FormatSpec.VERSION403);
+
+        final ArrayList<String> words = new ArrayList<>();
+        for (int i = 0; i < UNIGRAM_COUNT; i++) {
+            final String word = CodePointUtils.generateWord(random, codePointSet);
+            addUnigramWord(binaryDictionary, word, random.nextInt(0xFF));
+            words.add(word);
+        }
+        for (int i = 0; i < BIGRAM_COUNT; i++) {
+            final String word0 = words.get(random.nextInt(words.size()));
+            final String word1 = words.get(random.nextInt(words.size()));
+            if (!word0.equals(word1)) {
+                addBigramWords(binaryDictionary, word0, word1, random.nextInt(0xFF));
+            }
+        }
+
+        // The batched properties are the same as the ones read one word at a time.
+        final HashSet<String> wordSet = new HashSet<>(words);
+        int token = 0;
+        do {
+            final BinaryDictionary.GetNextWordPropertiesResult result =
+                    binaryDictionary.getNextWordProperties(token);
+            for (final WordProperty wordProperty : result.mWordProperties) {
+                assertEquals(binaryDictionary.getWordProperty(wordProperty.mWord,
+                        wordProperty.mIsBeginningOfSentence), wordProperty);
+                wordSet.remove(wordProperty.mWord);
+            }
+            token = result.mNextToken;
+        } while (token != 0);
+        assertTrue(wordSet.isEmpty());
+    }
+
     @Test
     public void testPossiblyOffensiveAttributeMaintained() {
         final BinaryDictionary binaryDictionary =